@@ -9,6 +9,7 @@
 #include "document_dummy.h"
 
 #include <QAbstractItemModelTester>
+#include <QSignalSpy>
 #include <QTest>
 
 QTEST_MAIN(FileTreeModelTest)
@@ -167,6 +168,9 @@ void FileTreeModelTest::buildTree_data()
     QTest::newRow("reverse stairs") << (QList<DummyDocument *>() << new DummyDocument("file:///c/bar.txt") << new DummyDocument("file:///c/a/foo.txt"))
                                     << (ResultNode() << (ResultNode("c", true) << ResultNode("bar.txt") << (ResultNode("a", true) << ResultNode("foo.txt"))));
 
+    QTest::newRow("prefix names") << (QList<DummyDocument *>() << new DummyDocument("file:///a/x/foo.txt") << new DummyDocument("file:///a/xy/bar.txt"))
+                                  << (ResultNode() << (ResultNode("x", true) << ResultNode("foo.txt")) << (ResultNode("xy", true) << ResultNode("bar.txt")));
+
     QTest::newRow("matching") << (QList<DummyDocument *>() << new DummyDocument("file:///a/x/foo.txt") << new DummyDocument("file:///b/x/bar.txt"))
                               << (ResultNode() << (ResultNode("a", true) << (ResultNode("x", true) << ResultNode("foo.txt")))
                                                << (ResultNode("b", true) << (ResultNode("x", true) << ResultNode("bar.txt"))));
@@ -314,6 +318,69 @@ void FileTreeModelTest::buildTreeBatchPrefill()
     qDeleteAll(documents);
 }
 
+// documents spread over some nested directories, in an order that jumps between them
+static QList<KTextEditor::Document *> manyDocuments(int count)
+{
+    QList<KTextEditor::Document *> documents;
+    documents.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        documents << new DummyDocument(QStringLiteral("file:///project/dir%1/sub%2/file%3.txt").arg(i % 20).arg((i / 20) % 5).arg(i));
+    }
+    return documents;
+}
+
+void FileTreeModelTest::buildTreeBatchLarge()
+{
+    const auto documents = manyDocuments(2000);
+
+    // the batch must result in the very same tree as adding one after the other
+    KateFileTreeModel single(nullptr, this);
+    QSignalSpy singleRowsInserted(&single, &QAbstractItemModel::rowsInserted);
+    for (auto *doc : documents) {
+        single.documentOpened(doc);
+    }
+    ResultNode expected;
+    walkTree(single, QModelIndex(), expected);
+
+    KateFileTreeModel batch(nullptr, this);
+    QAbstractItemModelTester tester(&batch, this);
+    QSignalSpy rowsInserted(&batch, &QAbstractItemModel::rowsInserted);
+    batch.documentsOpened(documents);
+    ResultNode root;
+    walkTree(batch, QModelIndex(), root);
+    QCOMPARE(root, expected);
+
+    // files for existing directories are inserted together
+    QVERIFY(rowsInserted.count() < singleRowsInserted.count() / 2);
+
+    // adding more to existing directories
+    const auto more = manyDocuments(200);
+    for (auto *doc : more) {
+        single.documentOpened(doc);
+    }
+    batch.documentsOpened(more);
+    expected = ResultNode();
+    walkTree(single, QModelIndex(), expected);
+    root = ResultNode();
+    walkTree(batch, QModelIndex(), root);
+    QCOMPARE(root, expected);
+
+    qDeleteAll(documents);
+    qDeleteAll(more);
+}
+
+void FileTreeModelTest::benchmarkDocumentsOpened()
+{
+    const auto documents = manyDocuments(10000);
+
+    QBENCHMARK {
+        KateFileTreeModel m(nullptr, nullptr);
+        m.documentsOpened(documents);
+    }
+
+    qDeleteAll(documents);
+}
+
 void FileTreeModelTest::walkTree(KateFileTreeModel &model, const QModelIndex &rootIndex, ResultNode &rootNode)
 {
     if (!model.hasChildren(rootIndex)) {
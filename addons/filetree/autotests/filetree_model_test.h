@@ -30,6 +30,8 @@ private Q_SLOTS:
     void buildTreeBatch();
     void buildTreeBatchPrefill_data();
     void buildTreeBatchPrefill();
+    void buildTreeBatchLarge();
+    void benchmarkDocumentsOpened();
 
     void listMode_data();
     void listMode();
@@ -95,6 +95,13 @@ public:
     const std::vector<ProxyItem *> &children() const;
     std::vector<ProxyItem *> &children();
 
+    /**
+     * Find the directory child with the given path.
+     * The path of a sub directory is always the path of its parent + '/' + its name,
+     * this allows to walk down a path with one lookup per level.
+     */
+    ProxyItemDir *dirChild(const QString &path) const;
+
     void setDoc(KTextEditor::Document *doc);
     KTextEditor::Document *doc() const;
 
@@ -117,6 +124,8 @@ private:
     QString m_documentName;
     ProxyItemDir *m_parent;
     std::vector<ProxyItem *> m_children;
+    // the directory children by path, the paths of directories never change
+    QHash<QString, ProxyItemDir *> m_dirChildren;
     int m_row;
     Flags m_flags;
 
@@ -149,9 +158,8 @@ class ProxyItemDir : public ProxyItem
 {
 public:
     ProxyItemDir(const QString &n, ProxyItemDir *p = nullptr)
-        : ProxyItem(n, p)
+        : ProxyItem(n, p, ProxyItem::Dir)
     {
-        setFlag(ProxyItem::Dir);
         updateDisplay();
 
         setIcon(QIcon::fromTheme(QStringLiteral("folder")));
@@ -234,6 +242,11 @@ int ProxyItem::addChild(ProxyItem *item)
     m_children.push_back(item);
     item->m_parent = static_cast<ProxyItemDir *>(this);
 
+    // the first directory with some path wins, like for a linear search
+    if (item->flag(Dir) && !item->flag(Widget)) {
+        m_dirChildren.try_emplace(item->path(), static_cast<ProxyItemDir *>(item));
+    }
+
     item->updateDisplay();
 
     return item_row;
@@ -241,18 +254,34 @@ int ProxyItem::addChild(ProxyItem *item)
 
 void ProxyItem::removeChild(ProxyItem *item)
 {
-    auto it = std::find(m_children.begin(), m_children.end(), item);
-    Q_ASSERT(it != m_children.end());
-    m_children.erase(it);
+    const size_t idx = item->m_row;
+    Q_ASSERT(idx < m_children.size() && m_children[idx] == item);
+    m_children.erase(m_children.begin() + idx);
 
-    auto idx = std::distance(m_children.begin(), it);
     for (size_t i = idx; i < m_children.size(); i++) {
         m_children[i]->m_row = i;
     }
 
+    if (auto it = m_dirChildren.find(item->path()); it != m_dirChildren.end() && it.value() == item) {
+        m_dirChildren.erase(it);
+
+        // some other directory with the same path might take over, should not happen in practice
+        for (ProxyItem *child : m_children) {
+            if (child->flag(Dir) && !child->flag(Widget) && child->path() == item->path()) {
+                m_dirChildren.insert(child->path(), static_cast<ProxyItemDir *>(child));
+                break;
+            }
+        }
+    }
+
     item->m_parent = nullptr;
 }
 
+ProxyItemDir *ProxyItem::dirChild(const QString &path) const
+{
+    return m_dirChildren.value(path);
+}
+
 ProxyItemDir *ProxyItem::parent() const
 {
     return m_parent;
@@ -481,8 +510,7 @@ void KateFileTreeModel::setShowFullPathOnRoots(bool s)
         m_root->clearFlag(ProxyItem::ShowFullPath);
     }
 
-    const auto rootChildren = m_root->children();
-    for (ProxyItem *root : rootChildren) {
+    for (ProxyItem *root : m_root->children()) {
         root->updateDisplay();
     }
 }
@@ -500,10 +528,7 @@ void KateFileTreeModel::initModel()
     endInsertRows();
 
     // add already existing documents
-    const auto documents = KTextEditor::Editor::instance()->application()->documents();
-    for (KTextEditor::Document *doc : documents) {
-        documentOpened(doc);
-    }
+    documentsOpened(KTextEditor::Editor::instance()->application()->documents());
 
     if (m_mainWindow) {
         QWidgetList widgets = m_mainWindow->widgets();
@@ -878,27 +903,125 @@ void KateFileTreeModel::setListMode(bool lm)
     }
 }
 
-void KateFileTreeModel::documentOpened(KTextEditor::Document *doc)
+ProxyItem *KateFileTreeModel::createDocumentItem(KTextEditor::Document *doc)
 {
     ProxyItem *item = new ProxyItem(QString());
     item->setDoc(doc);
 
     updateItemPathAndHost(item);
     setupIcon(item);
+    return item;
+}
+
+void KateFileTreeModel::documentOpened(KTextEditor::Document *doc)
+{
+    ProxyItem *item = createDocumentItem(doc);
     handleInsert(item);
     m_docmap[doc] = item;
     connectDocument(doc);
 }
 
+/**
+ * New items of a batch, grouped by the directory they go to, in the order of arrival.
+ */
+struct KateFileTreeModel::PendingInserts {
+    std::vector<std::pair<ProxyItemDir *, std::vector<ProxyItem *>>> groups;
+    QHash<ProxyItemDir *, size_t> groupForParent;
+
+    // parent for the directory part of a path, only valid until the tree structure changes
+    QHash<QString, ProxyItemDir *> parentForDirectory;
+};
+
 void KateFileTreeModel::documentsOpened(const QList<KTextEditor::Document *> &docs)
 {
+    PendingInserts pending;
     for (KTextEditor::Document *doc : docs) {
         if (m_docmap.contains(doc)) {
+            // the item might still be pending, the rename might remove directories
+            flushInserts(pending);
+            pending.parentForDirectory.clear();
             documentNameChanged(doc);
+            continue;
+        }
+
+        ProxyItem *item = createDocumentItem(doc);
+        m_docmap[doc] = item;
+        connectDocument(doc);
+
+        // the parent of a file only depends on its directory
+        ProxyItemDir *parent = nullptr;
+        const bool cacheable = !m_listMode && !item->flag(ProxyItem::Empty);
+        const QString directory = cacheable ? item->path().left(item->path().lastIndexOf(QLatin1Char('/')) + 1) : QString();
+        if (auto it = pending.parentForDirectory.constFind(directory); cacheable && it != pending.parentForDirectory.cend()) {
+            parent = it.value();
         } else {
-            documentOpened(doc);
+            parent = findExistingParent(item);
+            if (parent && cacheable) {
+                pending.parentForDirectory.insert(directory, parent);
+            }
         }
+
+        if (parent) {
+            auto [groupIt, inserted] = pending.groupForParent.try_emplace(parent, pending.groups.size());
+            if (inserted) {
+                pending.groups.emplace_back(parent, std::vector<ProxyItem *>());
+            }
+            pending.groups[groupIt.value()].second.push_back(item);
+            continue;
+        }
+
+        // new directories needed, this might restructure the tree, do it the slow way
+        flushInserts(pending);
+        pending.parentForDirectory.clear();
+        handleInsert(item);
     }
+
+    flushInserts(pending);
+}
+
+ProxyItemDir *KateFileTreeModel::findExistingParent(const ProxyItem *item) const
+{
+    if (m_listMode || item->flag(ProxyItem::Empty)) {
+        return m_root;
+    }
+
+    // same walk as in insertItemInto, but we give up if some directory is missing
+    ProxyItemDir *ptr = findRootNode(item->path());
+    if (!ptr) {
+        return nullptr;
+    }
+
+    QString tail = item->path();
+    tail.remove(0, ptr->path().length());
+    QStringList parts = tail.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+    if (!parts.isEmpty()) {
+        parts.pop_back();
+    }
+
+    for (const QString &part : std::as_const(parts)) {
+        ptr = findChildNode(ptr, part);
+        if (!ptr) {
+            return nullptr;
+        }
+    }
+    return ptr;
+}
+
+void KateFileTreeModel::flushInserts(PendingInserts &pending)
+{
+    for (auto &[parent, items] : pending.groups) {
+        const QModelIndex parent_index = (parent == m_root) ? QModelIndex() : createIndex(parent->row(), 0, parent);
+        const int first = parent->childCount();
+        beginInsertRows(parent_index, first, first + int(items.size()) - 1);
+        parent->children().reserve(first + items.size());
+        for (ProxyItem *item : items) {
+            parent->addChild(item);
+        }
+        endInsertRows();
+    }
+
+    pending.groups.clear();
+    pending.groupForParent.clear();
 }
 
 void KateFileTreeModel::documentModifiedChanged(KTextEditor::Document *doc)
@@ -1145,23 +1268,13 @@ void KateFileTreeModel::documentNameChanged(KTextEditor::Document *doc)
     Q_EMIT triggerViewChangeAfterNameChange(); // FIXME: heh, non-standard signal?
 }
 
-ProxyItemDir *KateFileTreeModel::findRootNode(const QString &name, const int r) const
+ProxyItemDir *KateFileTreeModel::findRootNode(const QString &name) const
 {
-    const auto rootChildren = m_root->children();
-    for (ProxyItem *item : rootChildren) {
-        if (!item->flag(ProxyItem::Dir)) {
-            continue;
-        }
-
-        // make sure we're actually matching against the right dir,
-        // previously the check below would match /foo/xy against /foo/x
-        // and return /foo/x rather than /foo/xy
-        // this seems a bit hackish, but is the simplest way to solve the
-        // current issue.
-        QString path = item->path().section(QLatin1Char('/'), 0, -r) + QLatin1Char('/');
-
-        if (name.startsWith(path)) {
-            return static_cast<ProxyItemDir *>(item);
+    // try all directories containing name, from the top
+    // we must match full path components, e.g. /foo/xy must not end up in a root /foo/x
+    for (qsizetype slash = name.indexOf(QLatin1Char('/')); slash != -1; slash = name.indexOf(QLatin1Char('/'), slash + 1)) {
+        if (ProxyItemDir *root = m_root->dirChild(name.left(slash))) {
+            return root;
         }
     }
 
@@ -1173,22 +1286,7 @@ ProxyItemDir *KateFileTreeModel::findChildNode(const ProxyItemDir *parent, const
     Q_ASSERT(parent != nullptr);
     Q_ASSERT(!name.isEmpty());
 
-    if (!parent->childCount()) {
-        return nullptr;
-    }
-
-    const auto children = parent->children();
-    for (ProxyItem *item : children) {
-        if (!item->flag(ProxyItem::Dir)) {
-            continue;
-        }
-
-        if (item->display() == name) {
-            return static_cast<ProxyItemDir *>(item);
-        }
-    }
-
-    return nullptr;
+    return parent->dirChild(parent->path() + QLatin1Char('/') + name);
 }
 
 void KateFileTreeModel::insertItemInto(ProxyItemDir *root, ProxyItem *item, bool move, ProxyItemDir **moveDest)
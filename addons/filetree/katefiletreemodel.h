@@ -77,6 +77,11 @@ public:
     bool showFullPathOnRoots(void) const;
     void setShowFullPathOnRoots(bool);
 
+    /**
+     * Add many documents at once, e.g. on session restore.
+     * Documents that end up in already existing directories are inserted with one
+     * row insertion per directory instead of one per document.
+     */
     void documentsOpened(const QList<KTextEditor::Document *> &);
     /* used strictly for the item coloring */
     void documentActivated(const KTextEditor::Document *);
@@ -100,7 +105,12 @@ Q_SIGNALS:
     void triggerViewChangeAfterNameChange();
 
 private:
-    ProxyItemDir *findRootNode(const QString &name, const int r = 1) const;
+    struct PendingInserts;
+
+    ProxyItemDir *findRootNode(const QString &name) const;
+    ProxyItemDir *findExistingParent(const ProxyItem *item) const;
+    void flushInserts(PendingInserts &pending);
+    ProxyItem *createDocumentItem(KTextEditor::Document *doc);
     static ProxyItemDir *findChildNode(const ProxyItemDir *parent, const QString &name);
     void insertItemInto(ProxyItemDir *root, ProxyItem *item, bool move = false, ProxyItemDir **moveDest = nullptr);
     void handleInsert(ProxyItem *item);
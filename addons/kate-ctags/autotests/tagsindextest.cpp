@@ -0,0 +1,191 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "tagsindextest.h"
+#include "tagsindex.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_MAIN(TagsIndexTest)
+
+static void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
+static Tags::TagList findAll(const TagsIndex &index, const QString &text, qsizetype chunkSize = 100)
+{
+    Tags::TagList matches;
+    index.findMatches(text, chunkSize, [&matches](Tags::TagList &&chunk) {
+        matches.append(std::move(chunk));
+        return true;
+    });
+    return matches;
+}
+
+static QStringList names(const Tags::TagList &tags)
+{
+    QStringList names;
+    for (const auto &tag : tags) {
+        names.push_back(tag.tag);
+    }
+    return names;
+}
+
+static const QByteArray s_tags =
+    "!_TAG_FILE_FORMAT\t2\t/extended format/\n"
+    "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+    "KateMainWindow\tkatemainwindow.h\t/^class KateMainWindow$/;\"\tc\n"
+    "createToolView\tkatemainwindow.cpp\t/^QWidget *KateMainWindow::createToolView()$/;\"\tkind:f\tclass:KateMainWindow\n"
+    "createToolView\tkatemdi.cpp\t/^QWidget *Sidebar::createToolView()$/;\"\tkind:f\tclass:Sidebar\n"
+    "main\tmain.cpp\t/^int main(int argc, char **argv)$/;\"\tf\n"
+    "mainWindow\tkateapp.cpp\t/^KateMainWindow *KateApp::mainWindow()$/;\"\tf\n";
+
+void TagsIndexTest::testMatches()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("tags"));
+    writeFile(fileName, s_tags);
+
+    auto index = TagsIndex::load(fileName);
+    QVERIFY(index);
+    QVERIFY(index->isUpToDate());
+    // the pseudo tags are no names, both createToolView lines belong to one name
+    QCOMPARE(index->nameCount(), 4);
+
+    // substring, the case is ignored
+    QCOMPARE(names(findAll(*index, QStringLiteral("mainwin"))), (QStringList{QStringLiteral("KateMainWindow"), QStringLiteral("mainWindow")}));
+    QCOMPARE(names(findAll(*index, QStringLiteral("TOOLVIEW"))), (QStringList{QStringLiteral("createToolView"), QStringLiteral("createToolView")}));
+    QCOMPARE(names(findAll(*index, QStringLiteral("ai"))), (QStringList{QStringLiteral("KateMainWindow"), QStringLiteral("main"), QStringLiteral("mainWindow")}));
+    QVERIFY(findAll(*index, QStringLiteral("nothing")).isEmpty());
+
+    const auto tags = findAll(*index, QStringLiteral("createtoolview"));
+    QCOMPARE(tags.size(), 2);
+    QCOMPARE(tags.at(1).file, QStringLiteral("katemdi.cpp"));
+    QCOMPARE(tags.at(1).pattern, QStringLiteral("/^QWidget *Sidebar::createToolView()$/"));
+    QCOMPARE(tags.at(1).type, QStringLiteral("function"));
+
+    // chunks until we say stop
+    int chunks = 0;
+    index->findMatches(QStringLiteral("main"), 1, [&chunks](Tags::TagList &&chunk) {
+        [&chunk] {
+            QCOMPARE(chunk.size(), 1);
+        }();
+        return ++chunks < 2;
+    });
+    QCOMPARE(chunks, 2);
+}
+
+void TagsIndexTest::testLineFormats()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("tags"));
+    writeFile(fileName,
+              "escaped\tfile.cpp\t/^a \\/ b\tc$/;\"\tv\n"
+              "lineNumber\tfile.cpp\t42;\"\tkind:function\n"
+              "noFields\tMakefile\t/^noFields:$/\n"
+              "windows\tfile.cpp\t/^windows$/;\"\tf\r\n");
+
+    auto index = TagsIndex::load(fileName);
+    QVERIFY(index);
+
+    auto tags = findAll(*index, QStringLiteral("escaped"));
+    QCOMPARE(tags.size(), 1);
+    QCOMPARE(tags.at(0).pattern, QStringLiteral("/^a \\/ b\tc$/"));
+    QCOMPARE(tags.at(0).type, QStringLiteral("variable"));
+
+    tags = findAll(*index, QStringLiteral("linenumber"));
+    QCOMPARE(tags.size(), 1);
+    QCOMPARE(tags.at(0).pattern, QStringLiteral("42"));
+
+    tags = findAll(*index, QStringLiteral("nofields"));
+    QCOMPARE(tags.size(), 1);
+    QCOMPARE(tags.at(0).type, QStringLiteral("macro"));
+
+    tags = findAll(*index, QStringLiteral("windows"));
+    QCOMPARE(tags.size(), 1);
+    QCOMPARE(tags.at(0).pattern, QStringLiteral("/^windows$/"));
+}
+
+void TagsIndexTest::testManyNames()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("tags"));
+
+    // unsorted and more names than fit into one block of the trigram filter
+    QByteArray content;
+    for (int i = 4999; i >= 0; --i) {
+        content += "symbol" + QByteArray::number(i) + "\tfile.cpp\t/^x$/;\"\tf\n";
+    }
+    content += "unique_needle\tfile.cpp\t/^x$/;\"\tf\n";
+    writeFile(fileName, content);
+
+    auto index = TagsIndex::load(fileName);
+    QVERIFY(index);
+    QCOMPARE(index->nameCount(), 5001);
+
+    QCOMPARE(findAll(*index, QStringLiteral("symbol499")).size(), 11);
+    QCOMPARE(findAll(*index, QStringLiteral("ymbol")).size(), 5000);
+    QCOMPARE(names(findAll(*index, QStringLiteral("needle"))), QStringList{QStringLiteral("unique_needle")});
+
+    // loading can be stopped
+    QVERIFY(!TagsIndex::load(fileName, [] {
+        return false;
+    }));
+}
+
+void TagsIndexTest::testLargeFile()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("tags"));
+
+    // bigger than a block the file is read in, lines and names span the blocks
+    QByteArray content;
+    for (int i = 0; i < 40000; ++i) {
+        const QByteArray name = "name" + QByteArray::number(i).rightJustified(5, '0');
+        content += name + "\tfirst.cpp\t/^" + name + "$/;\"\tf\n";
+        content += name + "\tsecond.cpp\t/^" + name + "$/;\"\tf\n";
+    }
+    QVERIFY(content.size() > 2 * 1024 * 1024);
+    writeFile(fileName, content);
+
+    auto index = TagsIndex::load(fileName);
+    QVERIFY(index);
+    QCOMPARE(index->nameCount(), 40000);
+
+    for (const char *needle : {"name00000", "name26214", "name39999"}) {
+        const auto tags = findAll(*index, QLatin1String(needle));
+        QCOMPARE(tags.size(), 2);
+        QCOMPARE(tags.at(0).tag, QLatin1String(needle));
+        QCOMPARE(tags.at(0).file, QStringLiteral("first.cpp"));
+        QCOMPARE(tags.at(1).file, QStringLiteral("second.cpp"));
+        QCOMPARE(tags.at(1).pattern, QStringLiteral("/^%1$/").arg(QLatin1String(needle)));
+    }
+}
+
+void TagsIndexTest::testChanged()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("tags"));
+    writeFile(fileName, s_tags);
+
+    auto index = TagsIndex::load(fileName);
+    QVERIFY(index);
+
+    // lines that moved are skipped instead of returning garbage
+    writeFile(fileName, "other\tfile.cpp\t/^other$/;\"\tf\n" + s_tags);
+    QVERIFY(!index->isUpToDate());
+    for (const auto &tag : findAll(*index, QStringLiteral("main"))) {
+        QVERIFY(tag.tag.contains(QLatin1String("main"), Qt::CaseInsensitive));
+    }
+
+    QVERIFY(!TagsIndex::load(dir.filePath(QStringLiteral("missing"))));
+}
+
+#include "moc_tagsindextest.cpp"
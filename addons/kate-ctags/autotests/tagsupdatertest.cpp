@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "tagsupdatertest.h"
+#include "tagsupdater.h"
+
+#include <QBuffer>
+#include <QTest>
+
+QTEST_MAIN(TagsUpdaterTest)
+
+static QByteArray merge(const QByteArray &tags, const QStringList &changedPaths, const QList<QByteArray> &newTags)
+{
+    QByteArray in = tags;
+    QBuffer inBuffer(&in);
+    inBuffer.open(QIODevice::ReadOnly);
+
+    QByteArray out;
+    QBuffer outBuffer(&out);
+    outBuffer.open(QIODevice::WriteOnly);
+
+    if (!TagsUpdater::mergeTags(inBuffer, outBuffer, changedPaths, newTags)) {
+        return {};
+    }
+    return out;
+}
+
+void TagsUpdaterTest::testMergeSorted()
+{
+    const QByteArray tags =
+        "!_TAG_FILE_FORMAT\t2\t/extended format/\n"
+        "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+        "Alpha\ta.cpp\t/^class Alpha$/;\"\tc\n"
+        "beta\tb.cpp\t/^void beta()$/;\"\tf\n"
+        "delta\ta.cpp\t/^void delta()$/;\"\tf\n"
+        "omega\tb.cpp\t/^void omega()$/;\"\tf";
+
+    // the tags of b.cpp are replaced, the ones of a.cpp stay as they are
+    const QByteArray merged = merge(tags,
+                                    {QStringLiteral("b.cpp")},
+                                    {"zeta\tb.cpp\t/^void zeta()$/;\"\tf\n", "Beta\tb.cpp\t/^class Beta$/;\"\tc\n", "gamma\tb.cpp\t/^void gamma()$/;\"\tf\n"});
+    QCOMPARE(merged,
+             QByteArray("!_TAG_FILE_FORMAT\t2\t/extended format/\n"
+                        "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+                        "Alpha\ta.cpp\t/^class Alpha$/;\"\tc\n"
+                        "Beta\tb.cpp\t/^class Beta$/;\"\tc\n"
+                        "delta\ta.cpp\t/^void delta()$/;\"\tf\n"
+                        "gamma\tb.cpp\t/^void gamma()$/;\"\tf\n"
+                        "zeta\tb.cpp\t/^void zeta()$/;\"\tf\n"));
+
+    // a file name that only starts like a changed one is no match
+    QCOMPARE(merge(tags, {QStringLiteral("b.c")}, {}), tags + '\n');
+}
+
+void TagsUpdaterTest::testMergeFoldCase()
+{
+    const QByteArray tags =
+        "!_TAG_FILE_SORTED\t2\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+        "alpha\ta.cpp\t/^void alpha()$/;\"\tf\n"
+        "Gamma\ta.cpp\t/^class Gamma$/;\"\tc\n";
+
+    const QByteArray merged = merge(tags, {QStringLiteral("b.cpp")}, {"beta\tb.cpp\t/^void beta()$/;\"\tf\n", "Delta\tb.cpp\t/^class Delta$/;\"\tc\n"});
+    QCOMPARE(merged,
+             QByteArray("!_TAG_FILE_SORTED\t2\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+                        "alpha\ta.cpp\t/^void alpha()$/;\"\tf\n"
+                        "beta\tb.cpp\t/^void beta()$/;\"\tf\n"
+                        "Delta\tb.cpp\t/^class Delta$/;\"\tc\n"
+                        "Gamma\ta.cpp\t/^class Gamma$/;\"\tc\n"));
+}
+
+void TagsUpdaterTest::testMergeUnsorted()
+{
+    const QByteArray tags =
+        "!_TAG_FILE_SORTED\t0\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+        "zeta\ta.cpp\t/^void zeta()$/;\"\tf\n"
+        "beta\tb.cpp\t/^void beta()$/;\"\tf\n"
+        "alpha\ta.cpp\t/^void alpha()$/;\"\tf\n";
+
+    // no order to keep, the new tags go to the end as they are
+    const QByteArray merged = merge(tags, {QStringLiteral("b.cpp")}, {"gamma\tb.cpp\t/^void gamma()$/;\"\tf\n", "beta\tb.cpp\t/^void beta()$/;\"\tf\n"});
+    QCOMPARE(merged,
+             QByteArray("!_TAG_FILE_SORTED\t0\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+                        "zeta\ta.cpp\t/^void zeta()$/;\"\tf\n"
+                        "alpha\ta.cpp\t/^void alpha()$/;\"\tf\n"
+                        "gamma\tb.cpp\t/^void gamma()$/;\"\tf\n"
+                        "beta\tb.cpp\t/^void beta()$/;\"\tf\n"));
+}
+
+void TagsUpdaterTest::testMergeRemovedDirectory()
+{
+    const QByteArray tags =
+        "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+        "alpha\t/nonexistent/src/old/a.cpp\t/^void alpha()$/;\"\tf\n"
+        "beta\t/nonexistent/src/b.cpp\t/^void beta()$/;\"\tf\n"
+        "gamma\t/nonexistent/src/old/sub/c.cpp\t/^void gamma()$/;\"\tf\n"
+        "omega\t/nonexistent/src/older.cpp\t/^void omega()$/;\"\tf\n";
+
+    // everything below a removed directory goes away
+    const QByteArray merged = merge(tags, {QStringLiteral("/nonexistent/src/old")}, {});
+    QCOMPARE(merged,
+             QByteArray("!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+                        "beta\t/nonexistent/src/b.cpp\t/^void beta()$/;\"\tf\n"
+                        "omega\t/nonexistent/src/older.cpp\t/^void omega()$/;\"\tf\n"));
+}
+
+#include "moc_tagsupdatertest.cpp"
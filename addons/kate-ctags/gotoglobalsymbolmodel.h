@@ -37,6 +37,13 @@ public:
         endResetModel();
     }
 
+    void appendSymbolsData(Tags::TagList rows)
+    {
+        beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + rows.size() - 1);
+        m_rows.append(std::move(rows));
+        endInsertRows();
+    }
+
 private:
     Tags::TagList m_rows;
 };
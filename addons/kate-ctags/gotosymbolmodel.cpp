@@ -6,8 +6,11 @@
 #include "gotosymbolmodel.h"
 
 #include "hostprocess.h"
+#include "katetaskscheduler.h"
 
 #include <KLocalizedString>
+#include <QFileInfo>
+#include <QIcon>
 #include <QProcess>
 #include <QStandardPaths>
 
@@ -16,6 +19,11 @@ GotoSymbolModel::GotoSymbolModel(QObject *parent)
 {
 }
 
+GotoSymbolModel::~GotoSymbolModel()
+{
+    KateTaskScheduler::self()->cancelAndWait(this);
+}
+
 int GotoSymbolModel::columnCount(const QModelIndex &) const
 {
     return 1;
@@ -32,6 +40,11 @@ QVariant GotoSymbolModel::data(const QModelIndex &index, int role) const
         return {};
     }
 
+    static const QIcon nsIcon = QIcon::fromTheme(QStringLiteral("code-block"));
+    static const QIcon classIcon = QIcon::fromTheme(QStringLiteral("code-class"));
+    static const QIcon funcIcon = QIcon::fromTheme(QStringLiteral("code-function"));
+    static const QIcon varIcon = QIcon::fromTheme(QStringLiteral("code-variable"));
+
     const auto &row = m_rows.at(index.row());
     if (role == Qt::DisplayRole) {
         if (index.column() == 0) {
@@ -39,7 +52,19 @@ QVariant GotoSymbolModel::data(const QModelIndex &index, int role) const
         }
     } else if (role == Qt::DecorationRole) {
         if (index.column() == 0) {
-            return row.icon;
+            switch (row.kind) {
+            case SymbolItem::Block:
+            case SymbolItem::Namespace:
+                return nsIcon;
+            case SymbolItem::Class:
+                return classIcon;
+            case SymbolItem::Function:
+                return funcIcon;
+            case SymbolItem::Variable:
+                return varIcon;
+            case SymbolItem::None:
+                return QIcon();
+            }
         }
     } else if (role == Qt::UserRole) {
         return row.line;
@@ -48,40 +73,89 @@ QVariant GotoSymbolModel::data(const QModelIndex &index, int role) const
     return QVariant();
 }
 
-void GotoSymbolModel::refresh(const QString &filePath)
+void GotoSymbolModel::refresh(const QString &filePath, qint64 revision)
 {
-    static const QIcon nsIcon = QIcon::fromTheme(QStringLiteral("code-block"));
-    static const QIcon classIcon = QIcon::fromTheme(QStringLiteral("code-class"));
-    static const QIcon funcIcon = QIcon::fromTheme(QStringLiteral("code-function"));
-    static const QIcon varIcon = QIcon::fromTheme(QStringLiteral("code-variable"));
-    static const QIcon defIcon = nsIcon;
+    auto scheduler = KateTaskScheduler::self();
+    scheduler->cancel(m_task);
+    const quint64 generation = ++m_generation;
+
+    // ctags reads the file, so it must not have changed on disk either
+    const QDateTime lastModified = QFileInfo(filePath).lastModified();
+    if (auto cached = m_cache.object(filePath); cached && cached->revision == revision && cached->lastModified == lastModified) {
+        setRows(cached->rows);
+        return;
+    }
 
-    beginResetModel();
-    m_rows.clear();
-    endResetModel();
+    setRows({});
 
     // only use ctags from PATH
     static const auto fullExecutablePath = safeExecutableName(QStringLiteral("ctags"));
     if (fullExecutablePath.isEmpty()) {
-        beginResetModel();
-        m_rows.append(SymbolItem{.name = i18n("CTags executable not found."), .line = -1, .icon = QIcon()});
-        endResetModel();
+        setRows({SymbolItem{.name = i18n("CTags executable not found."), .line = -1}});
+        return;
+    }
+
+    m_task = scheduler->schedule(
+        KateTaskScheduler::Interactive,
+        i18n("Loading symbols of %1", QFileInfo(filePath).fileName()),
+        [this, generation, filePath, revision, lastModified](KateTaskScheduler::Token &token) {
+            QProcess p;
+            startHostProcess(p, fullExecutablePath, {QStringLiteral("-x"), QStringLiteral("--_xformat=%{name}%{signature}\t%{kind}\t%{line}"), filePath});
+
+            bool finished = false;
+            while (!(finished = p.waitForFinished(50)) && p.state() != QProcess::NotRunning) {
+                if (token.isCanceled()) {
+                    p.kill();
+                    p.waitForFinished();
+                    return;
+                }
+            }
+
+            CachedSymbols symbols{.revision = revision, .lastModified = lastModified, .rows = {}};
+            if (finished) {
+                symbols.rows = parseTags(p.readAllStandardOutput());
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, filePath, finished, symbols = std::move(symbols)]() mutable {
+                    refreshDone(generation, filePath, finished, std::move(symbols));
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+void GotoSymbolModel::refreshDone(quint64 generation, const QString &filePath, bool ok, CachedSymbols symbols)
+{
+    // superseded by a later refresh
+    if (generation != m_generation) {
         return;
     }
 
-    QProcess p;
-    startHostProcess(p, fullExecutablePath, {QStringLiteral("-x"), QStringLiteral("--_xformat=%{name}%{signature}\t%{kind}\t%{line}"), filePath});
+    if (!ok) {
+        setRows({SymbolItem{.name = i18n("CTags executable failed to execute."), .line = -1}});
+        return;
+    }
 
-    QByteArray out;
-    if (p.waitForFinished()) {
-        out = p.readAllStandardOutput();
-    } else {
-        beginResetModel();
-        m_rows.append(SymbolItem{.name = i18n("CTags executable failed to execute."), .line = -1, .icon = QIcon()});
-        endResetModel();
+    if (symbols.rows.isEmpty()) {
+        setRows({SymbolItem{.name = i18n("CTags was unable to parse this file."), .line = -1}});
         return;
     }
 
+    setRows(symbols.rows);
+    m_cache.insert(filePath, new CachedSymbols(std::move(symbols)));
+}
+
+void GotoSymbolModel::setRows(QList<SymbolItem> rows)
+{
+    beginResetModel();
+    m_rows = std::move(rows);
+    endResetModel();
+    Q_EMIT refreshed();
+}
+
+QList<SymbolItem> GotoSymbolModel::parseTags(const QByteArray &out)
+{
     QList<SymbolItem> symItems;
     const auto tags = out.split('\n');
     symItems.reserve(tags.size());
@@ -100,54 +174,47 @@ void GotoSymbolModel::refresh(const QString &filePath)
 
         switch (items.at(1).at(0)) {
         case 'f':
-            item.icon = funcIcon;
+            item.kind = SymbolItem::Function;
             break;
         case 'm':
             if (items.at(1) == "method") {
-                item.icon = funcIcon;
+                item.kind = SymbolItem::Function;
             } else {
-                item.icon = defIcon;
+                item.kind = SymbolItem::Block;
             }
             break;
         case 'g':
             if (items.at(1) == "getter") {
-                item.icon = funcIcon;
+                item.kind = SymbolItem::Function;
             } else {
-                item.icon = defIcon;
+                item.kind = SymbolItem::Block;
             }
             break;
         case 'c':
         case 's':
             if (items.at(1) == "class" || items.at(1) == "struct") {
-                item.icon = classIcon;
+                item.kind = SymbolItem::Class;
             } else {
-                item.icon = defIcon;
+                item.kind = SymbolItem::Block;
             }
             break;
         case 'n':
             if (items.at(1) == "namespace") {
-                item.icon = nsIcon;
+                item.kind = SymbolItem::Namespace;
             }
             break;
         case 'v':
-            item.icon = varIcon;
+            item.kind = SymbolItem::Variable;
             break;
         default:
-            item.icon = defIcon;
+            item.kind = SymbolItem::Block;
             break;
         }
 
         item.line = items.at(2).toInt();
         symItems.append(item);
     }
-
-    beginResetModel();
-    if (!symItems.isEmpty()) {
-        m_rows = std::move(symItems);
-    } else {
-        m_rows.append(SymbolItem{.name = i18n("CTags was unable to parse this file."), .line = -1, .icon = QIcon()});
-    }
-    endResetModel();
+    return symItems;
 }
 
 #include "moc_gotosymbolmodel.cpp"
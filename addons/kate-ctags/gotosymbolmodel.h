@@ -6,13 +6,17 @@
 #pragma once
 
 #include <QAbstractTableModel>
-#include <QIcon>
+#include <QCache>
+#include <QDateTime>
 #include <QString>
 
 struct SymbolItem {
+    // no icons here, the items are created in a worker thread
+    enum Kind : quint8 { None, Block, Namespace, Class, Function, Variable };
+
     QString name;
     int line;
-    QIcon icon;
+    Kind kind = None;
 };
 
 class GotoSymbolModel : public QAbstractTableModel
@@ -21,13 +25,40 @@ class GotoSymbolModel : public QAbstractTableModel
 
 public:
     explicit GotoSymbolModel(QObject *parent = nullptr);
+    ~GotoSymbolModel() override;
 
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role) const override;
 
-    void refresh(const QString &filePath);
+    /**
+     * Run ctags on the file in the background, a refresh still running for the previous file is canceled.
+     * The symbols are cached per file, as long as neither the document @p revision nor the file changed.
+     */
+    void refresh(const QString &filePath, qint64 revision);
+
+Q_SIGNALS:
+    /**
+     * The rows were replaced with the symbols of the file.
+     */
+    void refreshed();
+
+private:
+    struct CachedSymbols {
+        qint64 revision;
+        QDateTime lastModified;
+        QList<SymbolItem> rows;
+    };
+
+    void setRows(QList<SymbolItem> rows);
+    void refreshDone(quint64 generation, const QString &filePath, bool ok, CachedSymbols symbols);
+    static QList<SymbolItem> parseTags(const QByteArray &out);
 
 private:
     QList<SymbolItem> m_rows;
+    QCache<QString, CachedSymbols> m_cache{32};
+
+    // to cancel and ignore superseded refreshes
+    quint64 m_task = 0;
+    quint64 m_generation = 0;
 };
@@ -9,7 +9,10 @@
 #include "gotosymbolmodel.h"
 #include "gotosymboltreeview.h"
 #include "kate_ctags_view.h"
+#include "katefilewatcher.h"
+#include "katetaskscheduler.h"
 #include "tags.h"
+#include "tagsindex.h"
 
 #include <QCoreApplication>
 #include <QKeyEvent>
@@ -21,11 +24,16 @@
 #include <QTextDocument>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 #include <KTextEditor/Document>
 #include <KTextEditor/MainWindow>
 #include <KTextEditor/Message>
 #include <KTextEditor/View>
 
+// more matches don't help the user, but make the list slow
+static constexpr qsizetype MaxGlobalSymbols = 10000;
+
 class CtagsGotoSymbolProxyModel : public QSortFilterProxyModel
 {
 public:
@@ -172,6 +180,12 @@ GotoSymbolWidget::GotoSymbolWidget(KTextEditor::MainWindow *mainWindow, KateCTag
     connect(m_treeView, &QTreeView::activated, this, &GotoSymbolWidget::slotReturnPressed);
     connect(m_proxyModel, &QSortFilterProxyModel::rowsInserted, this, &GotoSymbolWidget::reselectFirst);
     connect(m_proxyModel, &QSortFilterProxyModel::rowsRemoved, this, &GotoSymbolWidget::reselectFirst);
+    connect(m_symbolsModel, &GotoSymbolModel::refreshed, this, [this]() {
+        if (mode == Local) {
+            updateViewGeometry();
+            reselectFirst();
+        }
+    });
 
     QVBoxLayout *layout = new QVBoxLayout();
     layout->setSpacing(0);
@@ -184,6 +198,11 @@ GotoSymbolWidget::GotoSymbolWidget(KTextEditor::MainWindow *mainWindow, KateCTag
     m_lineEdit->installEventFilter(this);
 }
 
+GotoSymbolWidget::~GotoSymbolWidget()
+{
+    KateTaskScheduler::self()->cancelAndWait(this);
+}
+
 bool GotoSymbolWidget::eventFilter(QObject *obj, QEvent *event)
 {
     if (event->type() == QEvent::KeyPress || event->type() == QEvent::ShortcutOverride) {
@@ -224,22 +243,68 @@ bool GotoSymbolWidget::eventFilter(QObject *obj, QEvent *event)
     return QWidget::eventFilter(obj, event);
 }
 
-void GotoSymbolWidget::showSymbols(const QString &filePath)
+void GotoSymbolWidget::showSymbols(const QString &filePath, qint64 revision)
 {
     changeMode(Local);
     oldPos = m_mainWindow->activeView()->cursorPosition();
-    m_symbolsModel->refresh(filePath);
-    updateViewGeometry();
-    reselectFirst();
+    m_symbolsModel->refresh(filePath, revision);
 }
 
 void GotoSymbolWidget::showGlobalSymbols(const QString &tagFilePath)
 {
     changeMode(Global);
     m_tagFile = tagFilePath;
+    updateTagsIndex(false);
     updateViewGeometry();
 }
 
+void GotoSymbolWidget::updateTagsIndex(bool fileChanged)
+{
+    if (!fileChanged) {
+        if (m_tagsIndexLoading == m_tagFile || (m_tagsIndex && m_tagsIndex->fileName() == m_tagFile && m_tagsIndex->isUpToDate())) {
+            return;
+        }
+    }
+
+    if (!m_tagsFileWatch || m_tagsFileWatch->path() != m_tagFile) {
+        delete m_tagsFileWatch;
+        m_tagsFileWatch = KateFileWatcher::self()->watch(m_tagFile, this);
+        connect(m_tagsFileWatch, &KateFileWatch::changed, this, [this]() {
+            updateTagsIndex(true);
+        });
+    }
+
+    // the index of the previous version of the file is good enough until the new one is done
+    if (m_tagsIndex && m_tagsIndex->fileName() != m_tagFile) {
+        m_tagsIndex.reset();
+    }
+
+    auto scheduler = KateTaskScheduler::self();
+    scheduler->cancel(m_tagsIndexTask);
+    m_tagsIndexLoading = m_tagFile;
+    m_tagsIndexTask = scheduler->schedule(
+        m_tagsIndex ? KateTaskScheduler::Background : KateTaskScheduler::Visible,
+        i18n("Indexing %1", QFileInfo(m_tagFile).fileName()),
+        [this, tagFile = m_tagFile](KateTaskScheduler::Token &token) {
+            std::shared_ptr<const TagsIndex> index = TagsIndex::load(tagFile, [&token]() {
+                return token.checkpoint();
+            });
+            if (token.isCanceled()) {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, tagFile, index]() {
+                    if (tagFile == m_tagsIndexLoading) {
+                        m_tagsIndexLoading.clear();
+                        m_tagsIndex = index;
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
 void GotoSymbolWidget::loadGlobalSymbols(const QString &text)
 {
     if (m_tagFile.isEmpty() || !QFileInfo::exists(m_tagFile) || !QFileInfo(m_tagFile).isFile()) {
@@ -252,16 +317,63 @@ void GotoSymbolWidget::loadGlobalSymbols(const QString &text)
         return;
     }
 
-    QString currentWord = text;
-    Tags::TagList list = Tags::getPartialMatchesNoi8n(m_tagFile, currentWord);
+    // the tag file can be huge, read it in the background and show the matches as they come in
+    auto scheduler = KateTaskScheduler::self();
+    scheduler->cancel(m_globalSymbolsTask);
+    const quint64 generation = ++m_globalSymbolsGeneration;
+    m_globalSymbolsTask = scheduler->schedule(
+        KateTaskScheduler::Interactive,
+        i18n("Looking up tags"),
+        [this, generation, index = m_tagsIndex, tagFile = m_tagFile, text](KateTaskScheduler::Token &token) {
+            bool first = true;
+            qsizetype found = 0;
+            auto chunkReady = [this, generation, &first, &found, &token](Tags::TagList &&chunk) {
+                if (token.isCanceled()) {
+                    return false;
+                }
+                found += chunk.size();
+                QMetaObject::invokeMethod(
+                    this,
+                    [this, generation, first, chunk = std::move(chunk)]() mutable {
+                        globalSymbolsFound(generation, first, std::move(chunk));
+                    },
+                    Qt::QueuedConnection);
+                first = false;
+                return found < MaxGlobalSymbols;
+            };
+
+            if (index) {
+                // the index finds the longest word, the proxy model filters by the others
+                const auto words = text.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+                const auto longest = std::max_element(words.begin(), words.end(), [](const QString &l, const QString &r) {
+                    return l.size() < r.size();
+                });
+                if (longest != words.end()) {
+                    index->findMatches(*longest, 500, chunkReady);
+                }
+            } else {
+                // still indexing, look up the prefix in the file
+                Tags::getPartialMatchesNoi8n(tagFile, text, 500, chunkReady);
+            }
+        },
+        this);
+}
 
-    if (list.isEmpty()) {
+void GotoSymbolWidget::globalSymbolsFound(quint64 generation, bool first, Tags::TagList symbols)
+{
+    // superseded by a later lookup
+    if (generation != m_globalSymbolsGeneration || mode == Local) {
         return;
     }
 
-    m_globalSymbolsModel->setSymbolsData(std::move(list));
-    updateViewGeometry();
-    reselectFirst();
+    // the first chunk replaces the matches of the previous lookup, lookups without any match keep them
+    if (first) {
+        m_globalSymbolsModel->setSymbolsData(std::move(symbols));
+        updateViewGeometry();
+        reselectFirst();
+    } else {
+        m_globalSymbolsModel->appendSymbolsData(std::move(symbols));
+    }
 }
 
 void GotoSymbolWidget::slotReturnPressed()
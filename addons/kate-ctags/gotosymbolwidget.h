@@ -5,9 +5,13 @@
 */
 #pragma once
 
+#include "tags.h"
+
 #include <KTextEditor/Cursor>
 #include <QWidget>
 
+#include <memory>
+
 class GotoSymbolTreeView;
 class GotoSymbolModel;
 class QLineEdit;
@@ -16,6 +20,8 @@ class QTreeView;
 class GotoGlobalSymbolModel;
 class KateCTagsView;
 class GotoStyleDelegate;
+class KateFileWatch;
+class TagsIndex;
 
 namespace KTextEditor
 {
@@ -28,10 +34,11 @@ class GotoSymbolWidget : public QWidget
 
 public:
     explicit GotoSymbolWidget(KTextEditor::MainWindow *mainWindow, KateCTagsView *pluginView, QWidget *parent = nullptr);
+    ~GotoSymbolWidget() override;
 
     bool eventFilter(QObject *watched, QEvent *event) override;
     void updateViewGeometry();
-    void showSymbols(const QString &filePath);
+    void showSymbols(const QString &filePath, qint64 revision);
     void showGlobalSymbols(const QString &tagFilePath);
     void loadGlobalSymbols(const QString &text);
     void reselectFirst();
@@ -43,6 +50,8 @@ private Q_SLOTS:
 
 private:
     void changeMode(Mode newMode);
+    void globalSymbolsFound(quint64 generation, bool first, Tags::TagList symbols);
+    void updateTagsIndex(bool fileChanged);
 
 private:
     Mode mode;
@@ -56,4 +65,14 @@ private:
     QLineEdit *m_lineEdit;
     KTextEditor::Cursor oldPos;
     QString m_tagFile;
+
+    // to cancel and ignore superseded tag lookups
+    quint64 m_globalSymbolsTask = 0;
+    quint64 m_globalSymbolsGeneration = 0;
+
+    // index of the tags file, rebuilt in the background once the file changes
+    std::shared_ptr<const TagsIndex> m_tagsIndex;
+    KateFileWatch *m_tagsFileWatch = nullptr;
+    quint64 m_tagsIndexTask = 0;
+    QString m_tagsIndexLoading;
 };
@@ -22,6 +22,7 @@
 #include "kate_ctags_plugin.h"
 
 #include "hostprocess.h"
+#include "katetaskscheduler.h"
 
 #include <QCheckBox>
 #include <QFileDialog>
@@ -37,10 +38,29 @@
 
 K_PLUGIN_FACTORY_WITH_JSON(KateCTagsPluginFactory, "katectagsplugin.json", registerPlugin<KateCTagsPlugin>();)
 
+// how long after the start the common database is watched, if the user is idle by then
+static constexpr int GlobalSetupDelayMs = 5000;
+
 /******************************************************************/
 KateCTagsPlugin::KateCTagsPlugin(QObject *parent, const QVariantList &)
     : KTextEditor::Plugin(parent)
 {
+    m_globalSetupDelay.setSingleShot(true);
+    m_globalSetupDelay.setInterval(GlobalSetupDelayMs);
+    connect(&m_globalSetupDelay, &QTimer::timeout, this, &KateCTagsPlugin::setupGlobalUpdater);
+    m_globalSetupDelay.start();
+
+    readConfig();
+
+    // files written in place are not always seen by the watchers, saving a document is
+    auto editor = KTextEditor::Editor::instance();
+    connect(editor, &KTextEditor::Editor::documentCreated, this, [this](KTextEditor::Editor *, KTextEditor::Document *document) {
+        documentCreated(document);
+    });
+    const auto documents = editor->application()->documents();
+    for (auto document : documents) {
+        documentCreated(document);
+    }
 }
 
 /******************************************************************/
@@ -56,21 +76,73 @@ KTextEditor::ConfigPage *KateCTagsPlugin::configPage(int number, QWidget *parent
     if (number != 0) {
         return nullptr;
     }
-    return new KateCTagsConfigPage(parent);
+    return new KateCTagsConfigPage(parent, this);
 }
 
 /******************************************************************/
 void KateCTagsPlugin::readConfig()
 {
+    KConfigGroup config(KSharedConfig::openConfig(), QStringLiteral("CTags"));
+    m_autoUpdate = config.readEntry("AutoUpdate", true);
+
+    QStringList targets;
+    const int numEntries = config.readEntry(QStringLiteral("GlobalNumTargets"), 0);
+    for (int i = 0; i < numEntries; i++) {
+        auto target = config.readEntry(QLatin1String("GlobalTarget_") + QStringLiteral("%1").arg(i, 3), QString());
+        if (target.endsWith(QLatin1Char('/')) || target.endsWith(QLatin1Char('\\'))) {
+            target = target.left(target.size() - 1);
+        }
+        if (!target.isEmpty()) {
+            targets << target;
+        }
+    }
+
+    const QString file = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QLatin1String("/katectags/common_db");
+    m_globalTagsFile = m_autoUpdate ? file : QString();
+    m_globalTargets = targets;
+    m_globalCommand = config.readEntry(QStringLiteral("GlobalCommand"), DEFAULT_CTAGS_CMD);
+
+    // at startup the delay sets the updater up, later changes apply at once
+    if (!m_globalSetupDelay.isActive()) {
+        setupGlobalUpdater();
+    }
+
+    Q_EMIT configChanged();
+}
+
+/******************************************************************/
+void KateCTagsPlugin::setupGlobalUpdater()
+{
+    if (KateTaskScheduler::self()->isUserActive(KateTaskScheduler::Idle)) {
+        m_globalSetupDelay.start();
+        return;
+    }
+
+    m_globalUpdater.setup(m_globalTagsFile, m_globalTargets, m_globalCommand);
 }
 
 /******************************************************************/
-KateCTagsConfigPage::KateCTagsConfigPage(QWidget *parent)
+void KateCTagsPlugin::documentCreated(KTextEditor::Document *document)
+{
+    connect(document, &KTextEditor::Document::documentSavedOrUploaded, this, [this](KTextEditor::Document *document) {
+        if (!m_autoUpdate || !document->url().isLocalFile()) {
+            return;
+        }
+        const QString path = document->url().toLocalFile();
+        m_globalUpdater.fileSaved(path);
+        Q_EMIT fileSaved(path);
+    });
+}
+
+/******************************************************************/
+KateCTagsConfigPage::KateCTagsConfigPage(QWidget *parent, KateCTagsPlugin *plugin)
     : KTextEditor::ConfigPage(parent)
+    , m_plugin(plugin)
 {
     m_confUi.setupUi(this);
     m_confUi.cmdEdit->setText(DEFAULT_CTAGS_CMD);
     connect(m_confUi.cmdEdit, &QLineEdit::textEdited, this, &KateCTagsConfigPage::changed);
+    connect(m_confUi.autoUpdate, &QCheckBox::toggled, this, &KateCTagsConfigPage::changed);
 
     m_confUi.addButton->setToolTip(i18n("Add a directory to index."));
     m_confUi.addButton->setIcon(QIcon::fromTheme(QStringLiteral("list-add")));
@@ -124,7 +196,10 @@ void KateCTagsConfigPage::apply()
         nr = QStringLiteral("%1").arg(i, 3);
         config.writeEntry(QStringLiteral("GlobalTarget_") + nr, m_confUi.targetList->item(i)->text());
     }
+    config.writeEntry("AutoUpdate", m_confUi.autoUpdate->isChecked());
     config.sync();
+
+    m_plugin->readConfig();
 }
 
 /******************************************************************/
@@ -132,6 +207,7 @@ void KateCTagsConfigPage::reset()
 {
     KConfigGroup config(KSharedConfig::openConfig(), QStringLiteral("CTags"));
     m_confUi.cmdEdit->setText(config.readEntry(QStringLiteral("GlobalCommand"), DEFAULT_CTAGS_CMD));
+    m_confUi.autoUpdate->setChecked(config.readEntry("AutoUpdate", true));
 
     int numEntries = config.readEntry(QStringLiteral("GlobalNumTargets"), 0);
     QString nr;
@@ -219,6 +295,9 @@ void KateCTagsConfigPage::updateGlobalDB()
         return;
     }
 
+    // the whole file is regenerated, merging changes meanwhile would be in vain
+    m_plugin->m_globalUpdater.setSuspended(true);
+
     QStringList arguments = m_proc.splitCommand(m_confUi.cmdEdit->text());
     const QString command = arguments.takeFirst();
     arguments << QStringLiteral("-f") << file << targets;
@@ -226,6 +305,7 @@ void KateCTagsConfigPage::updateGlobalDB()
 
     if (!m_proc.waitForStarted(500)) {
         KMessageBox::error(nullptr, i18n("Failed to run. Error: %1, exit code: %2", m_proc.errorString(), m_proc.exitCode()));
+        m_plugin->m_globalUpdater.setSuspended(false);
         return;
     }
     m_confUi.updateDB->setDisabled(true);
@@ -241,6 +321,7 @@ void KateCTagsConfigPage::updateDone(int exitCode, QProcess::ExitStatus status)
         KMessageBox::error(this, i18n("The CTags command exited with code %1", exitCode));
     }
 
+    m_plugin->m_globalUpdater.setSuspended(false);
     m_confUi.updateDB->setDisabled(false);
     QApplication::restoreOverrideCursor();
 }
@@ -29,8 +29,11 @@
 #include <ktexteditor/mainwindow.h>
 
 #include "kate_ctags_view.h"
+#include "tagsupdater.h"
 #include "ui_CTagsGlobalConfig.h"
 
+#include <QTimer>
+
 //******************************************************************/
 class KateCTagsPlugin : public KTextEditor::Plugin
 {
@@ -51,7 +54,34 @@ public:
     KTextEditor::ConfigPage *configPage(int number = 0, QWidget *parent = nullptr) override;
     void readConfig();
 
+    /**
+     * Keep the tags files current while their files change?
+     */
+    bool autoUpdate() const
+    {
+        return m_autoUpdate;
+    }
+
     KateCTagsView *m_view = nullptr;
+
+    // keeps the common database current
+    TagsUpdater m_globalUpdater;
+
+Q_SIGNALS:
+    void configChanged();
+    void fileSaved(const QString &path);
+
+private:
+    void documentCreated(KTextEditor::Document *document);
+    void setupGlobalUpdater();
+
+    bool m_autoUpdate = true;
+
+    // watching the targets scans them, that waits until Kate is up and the user idle
+    QTimer m_globalSetupDelay;
+    QString m_globalTagsFile;
+    QStringList m_globalTargets;
+    QString m_globalCommand;
 };
 
 //******************************************************************/
@@ -59,7 +89,7 @@ class KateCTagsConfigPage : public KTextEditor::ConfigPage
 {
     Q_OBJECT
 public:
-    explicit KateCTagsConfigPage(QWidget *parent = nullptr);
+    explicit KateCTagsConfigPage(QWidget *parent, KateCTagsPlugin *plugin);
     ~KateCTagsConfigPage() override
     {
     }
@@ -85,4 +115,5 @@ private:
 
     QProcess m_proc;
     Ui_CTagsGlobalConfig m_confUi{};
+    KateCTagsPlugin *m_plugin;
 };
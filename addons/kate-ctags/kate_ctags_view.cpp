@@ -45,6 +45,7 @@
 KateCTagsView::KateCTagsView(KTextEditor::Plugin *plugin, KTextEditor::MainWindow *mainWin)
     : QObject(mainWin)
     , m_proc(nullptr)
+    , m_plugin(static_cast<KateCTagsPlugin *>(plugin))
 {
     KXMLGUIClient::setComponentName(QStringLiteral("katectags"), i18n("CTags"));
     setXMLFile(QStringLiteral("ui.rc"));
@@ -137,6 +138,12 @@ KateCTagsView::KateCTagsView(KTextEditor::Plugin *plugin, KTextEditor::MainWindo
         Utils::showMessage(error, QIcon(), i18n("CTags"), MessageType::Error);
     });
 
+    connect(m_ctagsUi.tagsFile->lineEdit(), &QLineEdit::editingFinished, this, &KateCTagsView::updateSessionUpdater);
+    connect(m_ctagsUi.tagsFile, &KUrlRequester::urlSelected, this, &KateCTagsView::updateSessionUpdater);
+    connect(m_ctagsUi.cmdEdit, &QLineEdit::editingFinished, this, &KateCTagsView::updateSessionUpdater);
+    connect(m_plugin, &KateCTagsPlugin::configChanged, this, &KateCTagsView::updateSessionUpdater);
+    connect(m_plugin, &KateCTagsPlugin::fileSaved, &m_sessionUpdater, &TagsUpdater::fileSaved);
+
     m_gotoSymbWidget.reset(new GotoSymbolWidget(mainWin, this));
     auto openLocal = actionCollection()->addAction(QStringLiteral("open_local_gts"));
     openLocal->setText(i18n("Go To Local Symbol"));
@@ -212,6 +219,7 @@ void KateCTagsView::readSessionConfig(const KConfigGroup &cg)
 
     QString sessionDB = cg.readEntry("SessionDatabase", QString());
     m_ctagsUi.tagsFile->setText(sessionDB);
+    updateSessionUpdater();
 }
 
 /******************************************************************/
@@ -525,14 +533,7 @@ void KateCTagsView::updateSessionDB()
         return;
     }
 
-    QStringList targets;
-    for (int i = 0; i < m_ctagsUi.targetList->count(); i++) {
-        auto target = m_ctagsUi.targetList->item(i)->text();
-        if (target.endsWith(QLatin1Char('/')) || target.endsWith(QLatin1Char('\\'))) {
-            target = target.left(target.size() - 1);
-        }
-        targets << target;
-    }
+    const QStringList targets = sessionTargets();
 
     QString pluginFolder = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QLatin1String("/katectags");
     QDir().mkpath(pluginFolder);
@@ -550,6 +551,9 @@ void KateCTagsView::updateSessionDB()
         return;
     }
 
+    // the whole file is regenerated, merging changes meanwhile would be in vain
+    m_sessionUpdater.setSuspended(true);
+
     QStringList arguments = m_proc.splitCommand(m_ctagsUi.cmdEdit->text());
     const QString command = arguments.takeFirst();
     arguments << QStringLiteral("-f") << m_ctagsUi.tagsFile->text() << targets;
@@ -560,6 +564,7 @@ void KateCTagsView::updateSessionDB()
                            QIcon(),
                            i18n("CTags"),
                            MessageType::Error);
+        m_sessionUpdater.setSuspended(false);
         return;
     }
     QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
@@ -582,6 +587,9 @@ void KateCTagsView::updateDone(int exitCode, QProcess::ExitStatus status)
     m_ctagsUi.updateButton->setDisabled(false);
     m_ctagsUi.updateButton2->setDisabled(false);
     QApplication::restoreOverrideCursor();
+
+    m_sessionUpdater.setSuspended(false);
+    updateSessionUpdater();
 }
 
 /******************************************************************/
@@ -603,12 +611,14 @@ void KateCTagsView::addTagTarget()
             new QListWidgetItem(urls[i], m_ctagsUi.targetList);
         }
     }
+    updateSessionUpdater();
 }
 
 /******************************************************************/
 void KateCTagsView::delTagTarget()
 {
     delete m_ctagsUi.targetList->currentItem();
+    updateSessionUpdater();
 }
 
 /******************************************************************/
@@ -622,6 +632,27 @@ bool KateCTagsView::listContains(const QString &target)
     return false;
 }
 
+/******************************************************************/
+QStringList KateCTagsView::sessionTargets() const
+{
+    QStringList targets;
+    for (int i = 0; i < m_ctagsUi.targetList->count(); i++) {
+        auto target = m_ctagsUi.targetList->item(i)->text();
+        if (target.endsWith(QLatin1Char('/')) || target.endsWith(QLatin1Char('\\'))) {
+            target = target.left(target.size() - 1);
+        }
+        targets << target;
+    }
+    return targets;
+}
+
+/******************************************************************/
+void KateCTagsView::updateSessionUpdater()
+{
+    const QString tagsFile = m_plugin->autoUpdate() ? m_ctagsUi.tagsFile->text() : QString();
+    m_sessionUpdater.setup(tagsFile, sessionTargets(), m_ctagsUi.cmdEdit->text());
+}
+
 /******************************************************************/
 bool KateCTagsView::eventFilter(QObject *obj, QEvent *event)
 {
@@ -659,7 +690,8 @@ void KateCTagsView::handleEsc(QEvent *e)
 
 void KateCTagsView::showSymbols()
 {
-    m_gotoSymbWidget->showSymbols(m_mWin->activeView()->document()->url().toLocalFile());
+    const auto doc = m_mWin->activeView()->document();
+    m_gotoSymbWidget->showSymbols(doc->url().toLocalFile(), doc->revision());
     m_gotoSymbWidget->show();
     m_gotoSymbWidget->setFocus();
 }
@@ -34,6 +34,7 @@
 #include <QTimer>
 
 #include "tags.h"
+#include "tagsupdater.h"
 
 #include "ui_kate_ctags.h"
 
@@ -46,6 +47,9 @@ typedef struct {
     KTextEditor::Cursor cursor;
 } TagJump;
 
+/******************************************************************/
+class KateCTagsPlugin;
+
 /******************************************************************/
 class KateCTagsView : public QObject, public KXMLGUIClient, public KTextEditor::SessionConfigInterface
 {
@@ -89,6 +93,8 @@ private Q_SLOTS:
 
 private:
     bool listContains(const QString &target);
+    QStringList sessionTargets() const;
+    void updateSessionUpdater();
 
     QString currentWord();
 
@@ -110,6 +116,10 @@ private:
     QProcess m_proc;
     QString m_commonDB;
 
+    KateCTagsPlugin *m_plugin;
+    // keeps the session database current
+    TagsUpdater m_sessionUpdater;
+
     QTimer m_editTimer;
     QStack<TagJump> m_jumpStack;
 };
@@ -8,6 +8,8 @@
 #include "tags.h"
 #include <stdio.h>
 
+#include <limits>
+
 namespace ctags
 {
 #include "readtags.h"
@@ -83,40 +85,56 @@ unsigned int Tags::numberOfMatches(const QString &tagpart, bool partial)
 Tags::TagList Tags::getPartialMatchesNoi8n(const QString &tagFile, const QString &tagpart)
 {
     setTagsFile(tagFile);
-    auto getExtension = [](const QString &fileUrl) -> QStringView {
-        int dotPos = fileUrl.lastIndexOf(QLatin1Char('.'));
-        if (dotPos > -1) {
-            return QStringView(fileUrl).mid(dotPos + 1);
-        }
-        return QStringView();
-    };
     Tags::TagList list;
+    getPartialMatchesNoi8n(tagFile, tagpart, std::numeric_limits<qsizetype>::max(), [&list](TagList &&chunk) {
+        list = std::move(chunk);
+        return true;
+    });
+    return list;
+}
+
+QString Tags::typeNoi8n(const char *kind, const QString &file)
+{
+    QStringView extension;
+    if (const int dotPos = file.lastIndexOf(QLatin1Char('.')); dotPos > -1) {
+        extension = QStringView(file).mid(dotPos + 1);
+    }
 
+    QString type = CTagsKinds::findKindNoi18n(kind, extension);
+    if (type.isEmpty() && file.endsWith(QLatin1String("Makefile"))) {
+        type = QStringLiteral("macro");
+    }
+    return type;
+}
+
+void Tags::getPartialMatchesNoi8n(const QString &tagFile, const QString &tagpart, qsizetype chunkSize, const std::function<bool(TagList &&chunk)> &chunkReady)
+{
     if (tagpart.isEmpty()) {
-        return list;
+        return;
     }
 
     ctags::tagFileInfo info;
-    ctags::tagFile *file = ctags::tagsOpen(_tagsfile.toLocal8Bit().constData(), &info);
+    ctags::tagFile *file = ctags::tagsOpen(tagFile.toLocal8Bit().constData(), &info);
     ctags::tagEntry entry;
 
+    Tags::TagList list;
     QByteArray tagpartBArray = tagpart.toLocal8Bit(); // for holding the char *
     if (ctags::tagsFind(file, &entry, tagpartBArray.data(), TAG_OBSERVECASE | TAG_PARTIALMATCH) == ctags::TagSuccess) {
         do {
             QString file = QString::fromLocal8Bit(entry.file);
-            QString type(CTagsKinds::findKindNoi18n(entry.kind, getExtension(file)));
-
-            if (type.isEmpty() && file.endsWith(QLatin1String("Makefile"))) {
-                type = QStringLiteral("macro");
-            }
-
+            QString type = typeNoi8n(entry.kind, file);
             list << TagEntry(QString::fromLocal8Bit(entry.name), type, file, QString::fromLocal8Bit(entry.address.pattern));
+            if (list.size() >= chunkSize && !chunkReady(std::exchange(list, {}))) {
+                break;
+            }
         } while (ctags::tagsFindNext(file, &entry) == ctags::TagSuccess);
     }
 
     ctags::tagsClose(file);
 
-    return list;
+    if (!list.isEmpty()) {
+        chunkReady(std::move(list));
+    }
 }
 
 Tags::TagList Tags::getMatches(const QString &tagpart, bool partial, const QStringList &types)
@@ -11,6 +11,8 @@
 #include <QString>
 #include <QStringList>
 
+#include <functional>
+
 class Tags
 {
 public:
@@ -55,6 +57,20 @@ public:
     static TagList getMatches(const QString &file, const QString &tagpart, bool partial, const QStringList &types = QStringList());
     static TagList getPartialMatchesNoi8n(const QString &tagFile, const QString &tagpart);
 
+    /**
+     * Like above, but hands out the matches in chunks of @p chunkSize while the tag file is read,
+     * until @p chunkReady returns false. Doesn't change the tags file, so it is safe to use in a thread.
+     */
+    static void getPartialMatchesNoi8n(const QString &tagFile,
+                                       const QString &tagpart,
+                                       qsizetype chunkSize,
+                                       const std::function<bool(TagList &&chunk)> &chunkReady);
+
+    /**
+     * Untranslated type of a tag of the given kind in @p file.
+     */
+    static QString typeNoi8n(const char *kind, const QString &file);
+
 private:
     static QString _tagsfile;
 };
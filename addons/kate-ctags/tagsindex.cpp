@@ -0,0 +1,351 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "tagsindex.h"
+
+#include <QByteArrayMatcher>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// names per block of the trigram filter
+static constexpr qsizetype NamesPerBlock = 1024;
+
+// how often the build checks whether to go on
+static constexpr qint64 CheckInterval = 65536;
+
+// how much of the file is read at once while we build the index
+static constexpr qint64 ReadSize = 1024 * 1024;
+
+static inline char toLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+static inline quint32 trigram(const char *p)
+{
+    return (quint32(uchar(p[0])) << 16) | (quint32(uchar(p[1])) << 8) | quint32(uchar(p[2]));
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+namespace
+{
+// the lines of one name while we build the index, the name is copied to a buffer of all names
+struct BuildSpan {
+    qsizetype name;
+    qint64 offset;
+    qint64 length;
+    quint32 nameLength;
+};
+
+// order by lower cased name, then by name to keep equal names together, then by position in the file
+bool spanLessThan(const char *names, const BuildSpan &l, const BuildSpan &r)
+{
+    const char *ln = names + l.name;
+    const char *rn = names + r.name;
+    const quint32 n = std::min(l.nameLength, r.nameLength);
+    for (quint32 i = 0; i < n; ++i) {
+        const uchar a = uchar(toLowerAscii(ln[i]));
+        const uchar b = uchar(toLowerAscii(rn[i]));
+        if (a != b) {
+            return a < b;
+        }
+    }
+    if (l.nameLength != r.nameLength) {
+        return l.nameLength < r.nameLength;
+    }
+    if (const int cmp = std::memcmp(ln, rn, n); cmp != 0) {
+        return cmp < 0;
+    }
+    return l.offset < r.offset;
+}
+
+bool sameName(const char *names, const BuildSpan &l, const BuildSpan &r)
+{
+    return l.nameLength == r.nameLength && std::memcmp(names + l.name, names + r.name, l.nameLength) == 0;
+}
+
+// parse a tag line like readtags does: name<TAB>file<TAB>address;"<TAB>fields
+bool parseLine(QByteArrayView line, QByteArrayView lowerName, Tags::TagEntry &entry)
+{
+    if (line.endsWith('\r')) {
+        line.chop(1);
+    }
+
+    // the file might have changed since we built the index
+    const qsizetype nameEnd = line.indexOf('\t');
+    if (nameEnd != lowerName.size()) {
+        return false;
+    }
+    for (qsizetype i = 0; i < nameEnd; ++i) {
+        if (toLowerAscii(line[i]) != lowerName[i]) {
+            return false;
+        }
+    }
+
+    const qsizetype fileEnd = line.indexOf('\t', nameEnd + 1);
+    if (fileEnd < 0) {
+        return false;
+    }
+
+    // search pattern or line number, an unterminated pattern spans the rest of the line
+    const qsizetype addressStart = fileEnd + 1;
+    qsizetype addressEnd = addressStart;
+    if (addressStart < line.size()) {
+        const char delimiter = line[addressStart];
+        if (delimiter == '/' || delimiter == '?') {
+            qsizetype p = addressStart;
+            do {
+                p = line.indexOf(delimiter, p + 1);
+            } while (p > 0 && line[p - 1] == '\\');
+            addressEnd = p < 0 ? line.size() : p + 1;
+        } else {
+            while (addressEnd < line.size() && isDigit(line[addressEnd])) {
+                ++addressEnd;
+            }
+        }
+    }
+
+    // the kind is either a field without key or the kind: field
+    QByteArray kind;
+    if (line.sliced(addressEnd).startsWith(";\"")) {
+        qsizetype fieldStart = addressEnd + 2;
+        while (fieldStart < line.size()) {
+            qsizetype fieldEnd = line.indexOf('\t', fieldStart);
+            fieldEnd = fieldEnd < 0 ? line.size() : fieldEnd;
+            const QByteArrayView field = line.sliced(fieldStart, fieldEnd - fieldStart);
+            const qsizetype colon = field.indexOf(':');
+            if (colon < 0 && !field.isEmpty()) {
+                kind = field.toByteArray();
+            } else if (colon >= 0 && field.first(colon) == "kind") {
+                kind = field.sliced(colon + 1).toByteArray();
+            }
+            fieldStart = fieldEnd + 1;
+        }
+    }
+
+    const QString file = QString::fromLocal8Bit(line.sliced(nameEnd + 1, fileEnd - nameEnd - 1));
+    entry.tag = QString::fromLocal8Bit(line.first(nameEnd));
+    entry.type = Tags::typeNoi8n(kind.isEmpty() ? nullptr : kind.constData(), file);
+    entry.file = file;
+    entry.pattern = QString::fromLocal8Bit(line.sliced(addressStart, addressEnd - addressStart));
+    return true;
+}
+}
+
+std::shared_ptr<TagsIndex> TagsIndex::load(const QString &fileName, const std::function<bool()> &keepGoing)
+{
+    const QFileInfo info(fileName);
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    auto index = std::shared_ptr<TagsIndex>(new TagsIndex);
+    index->m_fileName = fileName;
+    index->m_fileSize = info.size();
+    index->m_lastModified = info.lastModified();
+
+    // collect the lines, consecutive lines of a name end up in one span
+    QByteArray names;
+    std::vector<BuildSpan> spans;
+    QByteArray buffer;
+    qint64 bufferOffset = 0;
+    qint64 lineCount = 0;
+    bool atEnd = false;
+    while (!atEnd) {
+        // a file that shrinks meanwhile just ends early, the lookups check the lines they read
+        const QByteArray block = file.read(ReadSize);
+        atEnd = block.isEmpty();
+        buffer.append(block);
+
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        const char *line = begin;
+        while (line < end) {
+            const char *newLine = static_cast<const char *>(std::memchr(line, '\n', end - line));
+            if (!newLine && !atEnd) {
+                // the rest of the line comes with the next block
+                break;
+            }
+            const char *lineEnd = newLine ? newLine : end;
+            const char *next = newLine ? newLine + 1 : end;
+
+            if (keepGoing && ++lineCount % CheckInterval == 0 && !keepGoing()) {
+                return nullptr;
+            }
+
+            // skip the pseudo tags with the file format and co.
+            const char *tab = static_cast<const char *>(std::memchr(line, '\t', lineEnd - line));
+            if (tab && tab > line && !(line[0] == '!' && line[1] == '_')) {
+                const qint64 offset = bufferOffset + (line - begin);
+                const quint32 nameLength = quint32(tab - line);
+                BuildSpan *last = spans.empty() ? nullptr : &spans.back();
+                if (last && last->offset + last->length == offset && last->nameLength == nameLength
+                    && std::memcmp(names.constData() + last->name, line, nameLength) == 0
+                    && last->length + (next - line) <= std::numeric_limits<quint32>::max()) {
+                    last->length += next - line;
+                } else {
+                    spans.push_back(BuildSpan{.name = names.size(), .offset = offset, .length = next - line, .nameLength = nameLength});
+                    names.append(line, nameLength);
+                }
+            }
+            line = next;
+        }
+
+        bufferOffset += line - begin;
+        buffer.remove(0, line - begin);
+    }
+    file.close();
+
+    // ctags sorts the file in most cases already, but maybe not the way we need it
+    const auto lessThan = [n = names.constData()](const BuildSpan &l, const BuildSpan &r) {
+        return spanLessThan(n, l, r);
+    };
+    if (!std::is_sorted(spans.begin(), spans.end(), lessThan)) {
+        std::sort(spans.begin(), spans.end(), lessThan);
+    }
+
+    qsizetype namesSize = 0;
+    for (const auto &span : spans) {
+        namesSize += span.nameLength + 1;
+    }
+    index->m_names.reserve(namesSize);
+    index->m_spans.reserve(spans.size());
+
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const auto &span = spans[i];
+        if (i == 0 || !sameName(names.constData(), spans[i - 1], span)) {
+            index->m_nameStarts.push_back(index->m_names.size());
+            index->m_nameSpans.push_back(quint32(index->m_spans.size()));
+            for (quint32 c = 0; c < span.nameLength; ++c) {
+                index->m_names.append(toLowerAscii(names[span.name + c]));
+            }
+            index->m_names.append('\n');
+        }
+        index->m_spans.push_back(Span{.offset = span.offset, .length = quint32(span.length)});
+    }
+    index->m_nameStarts.push_back(index->m_names.size());
+    index->m_nameSpans.push_back(quint32(index->m_spans.size()));
+
+    // the names are our own lower cased copy now
+    spans = {};
+    names = {};
+
+    const qsizetype names = index->nameCount();
+    const qsizetype words = ((names + NamesPerBlock - 1) / NamesPerBlock + 63) / 64;
+    for (qsizetype name = 0; name < names; ++name) {
+        if (keepGoing && name % CheckInterval == 0 && !keepGoing()) {
+            return nullptr;
+        }
+
+        const char *n = index->m_names.constData() + index->m_nameStarts[name];
+        const qsizetype length = index->m_nameStarts[name + 1] - index->m_nameStarts[name] - 1;
+        const qsizetype block = name / NamesPerBlock;
+        for (qsizetype i = 0; i + 3 <= length; ++i) {
+            auto &blocks = index->m_trigramBlocks[trigram(n + i)];
+            if (blocks.empty()) {
+                blocks.resize(words);
+            }
+            blocks[block / 64] |= quint64(1) << (block % 64);
+        }
+    }
+
+    return index;
+}
+
+bool TagsIndex::isUpToDate() const
+{
+    const QFileInfo info(m_fileName);
+    return info.exists() && info.size() == m_fileSize && info.lastModified() == m_lastModified;
+}
+
+void TagsIndex::findMatches(const QString &text, qsizetype chunkSize, const std::function<bool(Tags::TagList &&chunk)> &chunkReady) const
+{
+    const QByteArray needle = text.toLocal8Bit().toLower();
+    const qsizetype names = nameCount();
+    if (needle.isEmpty() || names <= 0) {
+        return;
+    }
+
+    // only the blocks that contain all trigrams can contain the text
+    const qsizetype blockCount = (names + NamesPerBlock - 1) / NamesPerBlock;
+    std::vector<quint64> candidates((blockCount + 63) / 64, ~quint64(0));
+    for (qsizetype i = 0; i + 3 <= needle.size(); ++i) {
+        const auto it = m_trigramBlocks.constFind(trigram(needle.constData() + i));
+        if (it == m_trigramBlocks.cend()) {
+            return;
+        }
+        for (size_t word = 0; word < candidates.size(); ++word) {
+            candidates[word] &= it.value()[word];
+        }
+    }
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QByteArrayMatcher matcher(needle);
+    Tags::TagList matches;
+    for (qsizetype block = 0; block < blockCount; ++block) {
+        if (!(candidates[block / 64] & (quint64(1) << (block % 64)))) {
+            continue;
+        }
+
+        const qsizetype firstName = block * NamesPerBlock;
+        const qsizetype lastName = std::min(firstName + NamesPerBlock, names);
+        const qsizetype from = m_nameStarts[firstName];
+        const QByteArrayView blockNames(m_names.constData() + from, m_nameStarts[lastName] - from);
+
+        qsizetype name = firstName;
+        qsizetype pos = 0;
+        while ((pos = matcher.indexIn(blockNames, pos)) != -1) {
+            // the name that contains the match
+            name = std::upper_bound(m_nameStarts.begin() + name, m_nameStarts.begin() + lastName, from + pos) - m_nameStarts.begin() - 1;
+            readMatches(name, file, matches);
+            if (matches.size() >= chunkSize && !chunkReady(std::exchange(matches, {}))) {
+                return;
+            }
+
+            // one match per name is enough
+            pos = m_nameStarts[name + 1] - from;
+        }
+    }
+
+    if (!matches.isEmpty()) {
+        chunkReady(std::move(matches));
+    }
+}
+
+void TagsIndex::readMatches(qsizetype name, QFile &file, Tags::TagList &matches) const
+{
+    const QByteArrayView lowerName(m_names.constData() + m_nameStarts[name], m_nameStarts[name + 1] - m_nameStarts[name] - 1);
+    for (quint32 s = m_nameSpans[name]; s < m_nameSpans[name + 1]; ++s) {
+        const Span &span = m_spans[s];
+        if (!file.seek(span.offset)) {
+            return;
+        }
+
+        const QByteArray lines = file.read(span.length);
+        qsizetype start = 0;
+        while (start < lines.size()) {
+            qsizetype end = lines.indexOf('\n', start);
+            end = end < 0 ? lines.size() : end;
+            Tags::TagEntry entry;
+            if (parseLine(QByteArrayView(lines).sliced(start, end - start), lowerName, entry)) {
+                matches.push_back(std::move(entry));
+            }
+            start = end + 1;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#pragma once
+
+#include "tags.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+/**
+ * In memory index of a tags file for substring lookups of tag names.
+ *
+ * The file is read once in blocks to collect the tag names, which are kept lower cased and sorted
+ * in one buffer. For each trigram we remember which blocks of names contain it, a lookup
+ * only searches the blocks that contain all trigrams of the text.
+ *
+ * The index only keeps where the lines of a name are, they are read from the file for the matches.
+ * ctags might truncate and rewrite the file in place, so it is never mapped: accessing a mapping
+ * beyond the new end of the file would crash.
+ */
+class TagsIndex
+{
+public:
+    /**
+     * Build the index of the file, returns nullptr if the file can't be read.
+     * This takes a while for huge files, do it in a worker thread.
+     * Stops and returns nullptr once @p keepGoing returns false.
+     */
+    static std::shared_ptr<TagsIndex> load(const QString &fileName, const std::function<bool()> &keepGoing = {});
+
+    const QString &fileName() const
+    {
+        return m_fileName;
+    }
+
+    /**
+     * Did the file change since the index was built?
+     */
+    bool isUpToDate() const;
+
+    qsizetype nameCount() const
+    {
+        return qsizetype(m_nameStarts.size()) - 1;
+    }
+
+    /**
+     * Find the tags with names containing @p text, the case of ASCII letters is ignored.
+     * The matches are handed out in chunks of @p chunkSize until @p chunkReady returns false.
+     * Thread safe.
+     */
+    void findMatches(const QString &text, qsizetype chunkSize, const std::function<bool(Tags::TagList &&chunk)> &chunkReady) const;
+
+private:
+    TagsIndex() = default;
+
+    void readMatches(qsizetype name, QFile &file, Tags::TagList &matches) const;
+
+    // consecutive lines of one name in the file
+    struct Span {
+        qint64 offset;
+        quint32 length;
+    };
+
+    QString m_fileName;
+    qint64 m_fileSize = 0;
+    QDateTime m_lastModified;
+
+    // lower cased names, sorted and each terminated by a new line
+    QByteArray m_names;
+    // start of each name in m_names, with the end as last element
+    std::vector<qsizetype> m_nameStarts;
+    // first span of each name, with the span count as last element
+    std::vector<quint32> m_nameSpans;
+    std::vector<Span> m_spans;
+
+    // per trigram a bit for each block of names that contains it
+    QHash<quint32, std::vector<quint64>> m_trigramBlocks;
+};
@@ -0,0 +1,417 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "tagsupdater.h"
+
+#include "hostprocess.h"
+#include "katefilewatcher.h"
+#include "katetaskscheduler.h"
+
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// wait this long for more changes before we update the file
+static constexpr int UpdateDelayMs = 2000;
+
+// fewer files aren't worth another ctags process
+static constexpr qsizetype FilesPerShard = 64;
+
+// how often the merge checks whether to go on
+static constexpr qint64 CheckInterval = 65536;
+
+// version control data changes all the time, but has no tags
+static const QStringList IgnoredDirectories = {QStringLiteral(".git"), QStringLiteral(".hg"), QStringLiteral(".svn")};
+
+enum class SortOrder {
+    Unsorted,
+    Sorted,
+    FoldCase,
+};
+
+// like readtags compares names of files sorted with --sort=foldcase
+static bool foldCaseLessThan(const QByteArray &l, const QByteArray &r)
+{
+    const auto upper = [](char c) {
+        return (c >= 'a' && c <= 'z') ? uchar(c - ('a' - 'A')) : uchar(c);
+    };
+    const qsizetype n = std::min(l.size(), r.size());
+    for (qsizetype i = 0; i < n; ++i) {
+        const uchar a = upper(l[i]);
+        const uchar b = upper(r[i]);
+        if (a != b) {
+            return a < b;
+        }
+    }
+    return l.size() < r.size();
+}
+
+static bool isBelow(const QString &path, const QString &target)
+{
+    return path == target || (path.startsWith(target) && path.at(target.size()) == QLatin1Char('/'));
+}
+
+// re-tag the changed files with one ctags process per shard and merge the tags into the file
+static bool updateTagsFile(const QString &tagsFile, const QStringList &command, const QStringList &changed, KateTaskScheduler::Token &token)
+{
+    // removed files just lose their tags
+    QStringList existing;
+    for (const auto &path : changed) {
+        if (QFileInfo::exists(path)) {
+            existing.push_back(path);
+        }
+    }
+
+    QList<QByteArray> newTags;
+    if (!existing.isEmpty()) {
+        const qsizetype shardCount = std::clamp<qsizetype>(existing.size() / FilesPerShard, 1, std::max(1, QThread::idealThreadCount()));
+        std::vector<std::unique_ptr<QProcess>> processes;
+        for (qsizetype shard = 0; shard < shardCount; ++shard) {
+            QStringList arguments = command.mid(1);
+            arguments << QStringLiteral("--sort=no") << QStringLiteral("-f") << QStringLiteral("-");
+            for (qsizetype i = shard; i < existing.size(); i += shardCount) {
+                arguments.push_back(existing.at(i));
+            }
+            processes.push_back(std::make_unique<QProcess>());
+            startHostProcess(*processes.back(), command.first(), arguments, QProcess::ReadOnly);
+        }
+
+        // drain all of them in turns, a full pipe would block the process
+        bool running = true;
+        while (running) {
+            running = false;
+            for (const auto &process : processes) {
+                if (process->state() != QProcess::NotRunning) {
+                    process->waitForFinished(20);
+                    running = running || process->state() != QProcess::NotRunning;
+                }
+            }
+
+            if (running && !token.checkpoint()) {
+                for (const auto &process : processes) {
+                    process->kill();
+                    process->waitForFinished();
+                }
+                return false;
+            }
+        }
+
+        for (const auto &process : processes) {
+            if (process->error() != QProcess::UnknownError || process->exitStatus() != QProcess::NormalExit || process->exitCode() != 0) {
+                return false;
+            }
+
+            const auto lines = process->readAllStandardOutput().split('\n');
+            for (const auto &line : lines) {
+                if (!line.isEmpty() && !line.startsWith("!_")) {
+                    newTags.push_back(line + '\n');
+                }
+            }
+        }
+    }
+
+    QFile in(tagsFile);
+    QSaveFile out(tagsFile);
+    if (!in.open(QIODevice::ReadOnly) || !out.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    const bool merged = TagsUpdater::mergeTags(in, out, changed, std::move(newTags), [&token]() {
+        return token.checkpoint();
+    });
+    if (!merged) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+
+TagsUpdater::TagsUpdater(QObject *parent)
+    : QObject(parent)
+{
+    m_delay.setSingleShot(true);
+    m_delay.setInterval(UpdateDelayMs);
+    connect(&m_delay, &QTimer::timeout, this, &TagsUpdater::startUpdate);
+}
+
+TagsUpdater::~TagsUpdater()
+{
+    KateTaskScheduler::self()->cancelAndWait(this);
+}
+
+void TagsUpdater::setup(const QString &tagsFile, const QStringList &targets, const QString &command)
+{
+    m_command = QProcess::splitCommand(command);
+    if (tagsFile == m_tagsFile && targets == m_targets) {
+        return;
+    }
+
+    m_tagsFile = tagsFile;
+    m_targets = targets;
+    qDeleteAll(m_watches);
+    m_watches.clear();
+    m_delay.stop();
+    cancelTasks();
+    m_changed.clear();
+    m_updating.clear();
+    m_scanPending = false;
+
+    if (m_tagsFile.isEmpty()) {
+        return;
+    }
+
+    KateFileWatcher::Options options;
+    options.recursive = true;
+    options.ignore = IgnoredDirectories;
+    options.debounceMs = 500;
+    options.modifications = true;
+    for (const auto &target : std::as_const(m_targets)) {
+        auto watch = KateFileWatcher::self()->watch(target, options, this);
+        connect(watch, &KateFileWatch::changed, this, &TagsUpdater::filesChanged);
+        m_watches.push_back(watch);
+    }
+
+    findModifiedFiles();
+}
+
+void TagsUpdater::setSuspended(bool suspended)
+{
+    m_suspended = suspended;
+    if (m_suspended) {
+        // the regenerated file has the tags of the running update, too,
+        // tagging its files once more after it doesn't hurt
+        m_delay.stop();
+        cancelTasks();
+        return;
+    }
+
+    if (m_scanPending && !m_tagsFile.isEmpty()) {
+        findModifiedFiles();
+    }
+    if (!m_changed.isEmpty()) {
+        m_delay.start();
+    }
+}
+
+void TagsUpdater::cancelTasks()
+{
+    KateTaskScheduler::self()->cancelAndWait(this);
+    ++m_generation;
+
+    if (m_running) {
+        for (const auto &path : std::as_const(m_updating)) {
+            m_changed.insert(path);
+        }
+        m_updating.clear();
+        m_running = false;
+    }
+}
+
+void TagsUpdater::fileSaved(const QString &path)
+{
+    const bool below = std::any_of(m_targets.cbegin(), m_targets.cend(), [&path](const QString &target) {
+        return isBelow(path, target);
+    });
+    if (below && !m_tagsFile.isEmpty()) {
+        filesChanged({path});
+    }
+}
+
+void TagsUpdater::filesChanged(const QStringList &paths)
+{
+    for (const auto &path : paths) {
+        // our own writes, the tags file might be in one of the targets
+        if (!path.startsWith(m_tagsFile)) {
+            m_changed.insert(path);
+        }
+    }
+
+    if (!m_changed.isEmpty() && !m_suspended && !m_running) {
+        m_delay.start();
+    }
+}
+
+void TagsUpdater::findModifiedFiles()
+{
+    m_scanPending = true;
+    KateTaskScheduler::self()->schedule(
+        KateTaskScheduler::Idle,
+        i18n("Looking for files changed since the tags were generated"),
+        [this, generation = m_generation, tagsFile = m_tagsFile, targets = m_targets](KateTaskScheduler::Token &token) {
+            // nothing to compare with before the tags are generated once, the scan stays
+            // pending then and is done after a resume, that follows the generation
+            const QDateTime generated = QFileInfo(tagsFile).lastModified();
+            if (!generated.isValid()) {
+                return;
+            }
+
+            QStringList modified;
+            qint64 count = 0;
+            for (const auto &target : targets) {
+                if (const QFileInfo info(target); info.isFile() && info.lastModified() > generated) {
+                    modified.push_back(target);
+                }
+
+                QDirIterator it(target, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+                while (it.hasNext()) {
+                    const QString path = it.next();
+                    if (++count % 256 == 0 && !token.checkpoint()) {
+                        return;
+                    }
+
+                    const bool ignored = std::any_of(IgnoredDirectories.cbegin(), IgnoredDirectories.cend(), [&path](const QString &dir) {
+                        return path.contains(QLatin1Char('/') + dir + QLatin1Char('/'));
+                    });
+                    if (!ignored && it.fileInfo().lastModified() > generated) {
+                        modified.push_back(path);
+                    }
+                }
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, modified]() {
+                    if (generation != m_generation) {
+                        return;
+                    }
+                    m_scanPending = false;
+                    if (!modified.isEmpty()) {
+                        filesChanged(modified);
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+void TagsUpdater::startUpdate()
+{
+    if (m_running || m_suspended || m_changed.isEmpty() || m_command.isEmpty()) {
+        return;
+    }
+
+    // nothing to update, the tags have to be generated once first
+    if (!QFileInfo::exists(m_tagsFile)) {
+        m_changed.clear();
+        return;
+    }
+
+    m_updating = QStringList(m_changed.begin(), m_changed.end());
+    m_changed.clear();
+    std::sort(m_updating.begin(), m_updating.end());
+
+    m_running = true;
+    KateTaskScheduler::self()->schedule(
+        KateTaskScheduler::Background,
+        i18n("Updating tags of %1 files", m_updating.size()),
+        [this, generation = m_generation, tagsFile = m_tagsFile, command = m_command, changed = m_updating](KateTaskScheduler::Token &token) {
+            const bool updated = updateTagsFile(tagsFile, command, changed, token);
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, updated]() {
+                    if (generation != m_generation) {
+                        return;
+                    }
+
+                    // failed files wait for the next change, a broken command would just fail again
+                    const bool moreChanges = !m_changed.isEmpty();
+                    if (!updated) {
+                        for (const auto &path : std::as_const(m_updating)) {
+                            m_changed.insert(path);
+                        }
+                    }
+                    m_updating.clear();
+                    m_running = false;
+
+                    if (moreChanges && !m_suspended) {
+                        m_delay.start();
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+bool TagsUpdater::mergeTags(QIODevice &in, QIODevice &out, const QStringList &changedPaths, QList<QByteArray> newTags, const std::function<bool()> &keepGoing)
+{
+    // tags of these files are dropped, for removed paths and directories everything below them, too
+    QSet<QByteArray> files;
+    QList<QByteArray> directories;
+    for (const auto &path : changedPaths) {
+        const QByteArray localPath = path.toLocal8Bit();
+        files.insert(localPath);
+        if (!QFileInfo(path).isFile()) {
+            directories.push_back(localPath + '/');
+        }
+    }
+    const auto isChanged = [&files, &directories](const QByteArray &line) {
+        const qsizetype nameEnd = line.indexOf('\t');
+        const qsizetype fileEnd = nameEnd < 0 ? -1 : line.indexOf('\t', nameEnd + 1);
+        if (fileEnd < 0) {
+            return false;
+        }
+        const QByteArray file = QByteArray::fromRawData(line.constData() + nameEnd + 1, fileEnd - nameEnd - 1);
+        return files.contains(file) || std::any_of(directories.cbegin(), directories.cend(), [&file](const QByteArray &dir) {
+                   return file.startsWith(dir);
+               });
+    };
+
+    // the pseudo tags at the start tell how the file is sorted
+    SortOrder order = SortOrder::Unsorted;
+    QByteArray line;
+    while (!(line = in.readLine()).isEmpty() && line.startsWith("!_")) {
+        static const QByteArray sortedTag = QByteArrayLiteral("!_TAG_FILE_SORTED\t");
+        if (line.startsWith(sortedTag) && line.size() > sortedTag.size()) {
+            const char value = line.at(sortedTag.size());
+            order = value == '1' ? SortOrder::Sorted : value == '2' ? SortOrder::FoldCase : SortOrder::Unsorted;
+        }
+        out.write(line);
+    }
+
+    const auto lessThan = [order](const QByteArray &l, const QByteArray &r) {
+        return order == SortOrder::FoldCase ? foldCaseLessThan(l, r) : l < r;
+    };
+    if (order != SortOrder::Unsorted) {
+        std::sort(newTags.begin(), newTags.end(), lessThan);
+    }
+
+    // unchanged lines are copied as they are, the new ones go where they belong
+    qsizetype next = 0;
+    qint64 count = 0;
+    for (; !line.isEmpty(); line = in.readLine()) {
+        if (keepGoing && ++count % CheckInterval == 0 && !keepGoing()) {
+            return false;
+        }
+        if (isChanged(line)) {
+            continue;
+        }
+        if (!line.endsWith('\n')) {
+            line += '\n';
+        }
+
+        if (order != SortOrder::Unsorted) {
+            while (next < newTags.size() && lessThan(newTags.at(next), line)) {
+                out.write(newTags.at(next++));
+            }
+        }
+        out.write(line);
+    }
+
+    for (; next < newTags.size(); ++next) {
+        out.write(newTags.at(next));
+    }
+    return true;
+}
+
+#include "moc_tagsupdater.cpp"
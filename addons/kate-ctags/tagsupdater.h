@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+#include <functional>
+
+class KateFileWatch;
+class QIODevice;
+
+/**
+ * Keeps a tags file current in the background.
+ *
+ * The targets are watched for changes, changed files are re-tagged on their own and their tags
+ * merged into the tags file, instead of running ctags over all targets again. Files modified
+ * while Kate didn't run are found by their modification time once the updater is set up.
+ */
+class TagsUpdater : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TagsUpdater(QObject *parent = nullptr);
+    ~TagsUpdater() override;
+
+    /**
+     * Keep @p tagsFile current for the files below @p targets, re-tagging them with @p command.
+     * Nothing happens as long as the tags file doesn't exist, it has to be generated once.
+     * An empty tags file name stops the updates.
+     */
+    void setup(const QString &tagsFile, const QStringList &targets, const QString &command);
+
+    /**
+     * Pause while the whole tags file is regenerated, the changes are merged once resumed.
+     * A running update or scan is canceled and waited for, it would overwrite the regenerated file,
+     * so suspend before the regeneration starts. Both are started again once resumed.
+     */
+    void setSuspended(bool suspended);
+
+    /**
+     * A document got saved, it is re-tagged if it is below the targets.
+     * Files written in place are not always seen by the file watcher.
+     */
+    void fileSaved(const QString &path);
+
+    /**
+     * Copy the lines of @p in to @p out, without the tags of @p changedPaths and with @p newTags
+     * merged in, in the sort order the pseudo tags of the file specify.
+     * For removed paths and directories the tags of everything below them are dropped, too.
+     * Returns false once @p keepGoing returns false.
+     */
+    static bool mergeTags(QIODevice &in, QIODevice &out, const QStringList &changedPaths, QList<QByteArray> newTags, const std::function<bool()> &keepGoing = {});
+
+private:
+    void filesChanged(const QStringList &paths);
+    void cancelTasks();
+    void findModifiedFiles();
+    void startUpdate();
+
+private:
+    QString m_tagsFile;
+    QStringList m_targets;
+    QStringList m_command;
+
+    QList<KateFileWatch *> m_watches;
+
+    // files to re-tag, collected for a while to handle them in one go
+    QSet<QString> m_changed;
+    QTimer m_delay;
+
+    // files of the running update, tagged again if it fails or gets canceled
+    QStringList m_updating;
+
+    // bumped whenever our tasks are canceled, their late results are dropped then
+    quint64 m_generation = 0;
+    // the scan for modified files didn't finish yet, it is restarted after a suspension
+    bool m_scanPending = false;
+    bool m_running = false;
+    bool m_suspended = false;
+};
@@ -28,6 +28,7 @@
 #include "buildconfig.h"
 #include "hostprocess.h"
 #include "kate_buildplugin_debug.h"
+#include "katetrace.h"
 #include "qcmakefileapi.h"
 
 #include <QAction>
@@ -1488,6 +1489,8 @@ void KateBuildView::updateTextBrowser()
 /******************************************************************/
 void KateBuildView::slotReadReadyStdOut()
 {
+    KATE_TRACE_ZONE("build", "KateBuildView::slotReadReadyStdOut");
+
     // read data from procs stdout and add
     // the text to the end of the output
 
@@ -1535,6 +1538,8 @@ void KateBuildView::slotReadReadyStdOut()
 /******************************************************************/
 void KateBuildView::slotReadReadyStdErr()
 {
+    KATE_TRACE_ZONE("build", "KateBuildView::slotReadReadyStdErr");
+
     // FIXME This works for utf8 but not for all charsets
     QString l = QString::fromUtf8(m_proc.readAllStandardError());
     l.remove(QLatin1Char('\r'));
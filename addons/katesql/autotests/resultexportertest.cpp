@@ -0,0 +1,94 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "resultexportertest.h"
+#include "resultexporter.h"
+
+#include <QSqlField>
+#include <QTest>
+
+QTEST_MAIN(ResultExporterTest)
+
+static QSqlRecord columns()
+{
+    QSqlRecord record;
+    record.append(QSqlField(QStringLiteral("id"), QMetaType(QMetaType::LongLong)));
+    record.append(QSqlField(QStringLiteral("name"), QMetaType(QMetaType::QString)));
+    record.append(QSqlField(QStringLiteral("price"), QMetaType(QMetaType::Double)));
+    return record;
+}
+
+static QByteArray exportRows(const ResultExporter::Options &options)
+{
+    ResultExporter exporter(columns(), options);
+
+    QByteArray out;
+    exporter.appendHeader(out);
+    exporter.appendRow({qlonglong(1), QStringLiteral("plain"), 2.5}, out);
+    exporter.appendRow({qlonglong(2), QStringLiteral("say \"hi\", é"), QVariant(QMetaType(QMetaType::Double))}, out);
+    return out;
+}
+
+void ResultExporterTest::testDelimited_data()
+{
+    QTest::addColumn<QString>("delimiter");
+    QTest::addColumn<QChar>("stringsQuote");
+    QTest::addColumn<QChar>("numbersQuote");
+    QTest::addColumn<bool>("columnNames");
+    QTest::addColumn<bool>("lineNumbers");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::addRow("tsv") << QStringLiteral("\t") << QChar() << QChar() << false << false
+                         << QByteArray("1\tplain\t2.5\n2\tsay \"hi\", \xc3\xa9\t\n");
+    QTest::addRow("csv") << QStringLiteral(",") << QChar(u'"') << QChar() << true << false
+                         << QByteArray("\"id\",\"name\",\"price\"\n1,\"plain\",2.5\n2,\"say \"\"hi\"\", \xc3\xa9\",\n");
+    QTest::addRow("quoted numbers") << QStringLiteral(";") << QChar() << QChar(u'\'') << false << false
+                                    << QByteArray("'1';plain;'2.5'\n'2';say \"hi\", \xc3\xa9;''\n");
+    QTest::addRow("line numbers") << QStringLiteral("\t") << QChar() << QChar() << true << true
+                                  << QByteArray("\tid\tname\tprice\n1\t1\tplain\t2.5\n2\t2\tsay \"hi\", \xc3\xa9\t\n");
+}
+
+void ResultExporterTest::testDelimited()
+{
+    QFETCH(QString, delimiter);
+    QFETCH(QChar, stringsQuote);
+    QFETCH(QChar, numbersQuote);
+    QFETCH(bool, columnNames);
+    QFETCH(bool, lineNumbers);
+    QFETCH(QByteArray, expected);
+
+    ResultExporter::Options options;
+    options.fieldDelimiter = delimiter;
+    options.stringsQuoteChar = stringsQuote;
+    options.numbersQuoteChar = numbersQuote;
+    options.columnNames = columnNames;
+    options.lineNumbers = lineNumbers;
+
+    QCOMPARE(exportRows(options), expected);
+}
+
+void ResultExporterTest::testJsonLines()
+{
+    ResultExporter::Options options;
+    options.format = ResultExporter::Format::JsonLines;
+    // only for delimited text
+    options.columnNames = true;
+
+    QCOMPARE(exportRows(options),
+             QByteArray("{\"id\":1,\"name\":\"plain\",\"price\":2.5}\n"
+                        "{\"id\":2,\"name\":\"say \\\"hi\\\", \xc3\xa9\",\"price\":null}\n"));
+
+    QSqlRecord record;
+    record.append(QSqlField(QStringLiteral("a\"b"), QMetaType(QMetaType::QString)));
+    record.append(QSqlField(QStringLiteral("data"), QMetaType(QMetaType::QByteArray)));
+    record.append(QSqlField(QStringLiteral("flag"), QMetaType(QMetaType::Bool)));
+    ResultExporter exporter(record, options);
+
+    QByteArray out;
+    exporter.appendRow({QStringLiteral("tab\tline\n\x01"), QByteArray("\x00\xff", 2), true}, out);
+    QCOMPARE(out, QByteArray("{\"a\\\"b\":\"tab\\tline\\n\\u0001\",\"data\":\"AP8=\",\"flag\":true}\n"));
+}
+
+#include "moc_resultexportertest.cpp"
@@ -0,0 +1,135 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "resultstoretest.h"
+#include "resultstore.h"
+
+#include <QSqlField>
+#include <QTest>
+
+QTEST_MAIN(ResultStoreTest)
+
+static QSqlRecord columns()
+{
+    QSqlRecord record;
+    record.append(QSqlField(QStringLiteral("id"), QMetaType(QMetaType::Int)));
+    record.append(QSqlField(QStringLiteral("price"), QMetaType(QMetaType::Double)));
+    record.append(QSqlField(QStringLiteral("name"), QMetaType(QMetaType::QString)));
+    record.append(QSqlField(QStringLiteral("data"), QMetaType(QMetaType::QByteArray)));
+    return record;
+}
+
+static QVariantList row(int i)
+{
+    return {i, i * 0.5, QStringLiteral("name %1").arg(i), QByteArray::number(i)};
+}
+
+// a store with the rows 0 to count, fetched in chunks of chunkRows
+static void fill(ResultStore &store, int count, int chunkRows)
+{
+    ResultChunk chunk(columns());
+    for (int i = 0; i < count; ++i) {
+        chunk.appendRow(row(i));
+        if (chunk.rowCount() == chunkRows) {
+            store.append(std::exchange(chunk, ResultChunk(columns())));
+        }
+    }
+    store.append(chunk);
+}
+
+void ResultStoreTest::testTypes()
+{
+    ResultChunk chunk(columns());
+    chunk.appendRow(row(7));
+    chunk.appendRow({QVariant(), QVariant(), QVariant(QMetaType(QMetaType::QString)), QVariant()});
+    QCOMPARE(chunk.rowCount(), 2);
+    QCOMPARE(chunk.columnCount(), 4);
+
+    QCOMPARE(chunk.value(0, 0).typeId(), QMetaType::LongLong);
+    QCOMPARE(chunk.value(0, 0).toInt(), 7);
+    QCOMPARE(chunk.value(0, 1).typeId(), QMetaType::Double);
+    QCOMPARE(chunk.value(0, 1).toDouble(), 3.5);
+    QCOMPARE(chunk.value(0, 2), QVariant(QStringLiteral("name 7")));
+    QCOMPARE(chunk.value(0, 3), QVariant(QByteArray("7")));
+
+    // nulls keep the type of their column
+    for (int column = 0; column < 3; ++column) {
+        QVERIFY(chunk.value(1, column).isNull());
+    }
+    QCOMPARE(chunk.value(1, 0).typeId(), QMetaType::Int);
+    QCOMPARE(chunk.value(1, 2).typeId(), QMetaType::QString);
+}
+
+void ResultStoreTest::testFallback()
+{
+    // SQLite may hand out text for a column declared as integer
+    ResultChunk chunk(columns());
+    chunk.appendRow(row(1));
+    chunk.appendRow({QStringLiteral("two"), 2.5, QStringLiteral("name 2"), QByteArray("2")});
+    chunk.appendRow(row(3));
+
+    QCOMPARE(chunk.value(0, 0).toInt(), 1);
+    QCOMPARE(chunk.value(1, 0), QVariant(QStringLiteral("two")));
+    QCOMPARE(chunk.value(2, 0).toInt(), 3);
+    QCOMPARE(chunk.value(1, 2), QVariant(QStringLiteral("name 2")));
+}
+
+void ResultStoreTest::testChunks()
+{
+    ResultStore store;
+    fill(store, 2500, 1000);
+    QCOMPARE(store.rowCount(), 2500);
+    QCOMPARE(store.spilledChunks(), 0);
+
+    for (int i : {0, 999, 1000, 1001, 2499}) {
+        QCOMPARE(store.value(i, 0).toInt(), i);
+        QCOMPARE(store.value(i, 2).toString(), QStringLiteral("name %1").arg(i));
+    }
+    QVERIFY(!store.value(2500, 0).isValid());
+    QVERIFY(!store.value(0, 4).isValid());
+
+    store.clear();
+    QCOMPARE(store.rowCount(), 0);
+    QCOMPARE(store.memoryUsage(), 0);
+}
+
+void ResultStoreTest::testSpill()
+{
+    constexpr qint64 Limit = 256 * 1024;
+    ResultStore store(Limit);
+    fill(store, 100000, 1000);
+    QCOMPARE(store.rowCount(), 100000);
+
+    // the oldest chunks went to disk, the memory stays below the limit
+    QVERIFY(store.spilledChunks() > 0);
+    QVERIFY(store.memoryUsage() <= Limit);
+
+    // and they read back the same, in any order
+    for (int i : {0, 99999, 500, 50000, 1, 99000}) {
+        QCOMPARE(store.value(i, 0).toInt(), i);
+        QCOMPARE(store.value(i, 1).toDouble(), i * 0.5);
+        QCOMPARE(store.value(i, 2).toString(), QStringLiteral("name %1").arg(i));
+        QCOMPARE(store.value(i, 3).toByteArray(), QByteArray::number(i));
+    }
+    for (int i = 0; i < store.rowCount(); ++i) {
+        QCOMPARE(store.value(i, 0).toInt(), i);
+    }
+}
+
+void ResultStoreTest::benchmarkScan()
+{
+    ResultStore store(1024 * 1024);
+    fill(store, 200000, 1000);
+
+    QBENCHMARK {
+        qint64 sum = 0;
+        for (int i = 0; i < store.rowCount(); ++i) {
+            sum += store.value(i, 0).toLongLong();
+        }
+        QCOMPARE(sum, qint64(199999) * 200000 / 2);
+    }
+}
+
+#include "moc_resultstoretest.cpp"
@@ -0,0 +1,20 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#pragma once
+
+#include <QObject>
+
+class ResultStoreTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTypes();
+    void testFallback();
+    void testChunks();
+    void testSpill();
+    void benchmarkScan();
+};
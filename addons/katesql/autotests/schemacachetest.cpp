@@ -0,0 +1,139 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "schemacachetest.h"
+#include "schemacache.h"
+
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTest>
+
+QTEST_MAIN(SchemaCacheTest)
+
+// two connections to databases of their own
+static const QString First = QStringLiteral("first");
+static const QString Second = QStringLiteral("second");
+
+static bool exec(const QString &connection, const QString &text)
+{
+    QSqlQuery query(QSqlDatabase::database(connection));
+    return query.exec(text);
+}
+
+void SchemaCacheTest::init()
+{
+    if (!QSqlDatabase::isDriverAvailable(QStringLiteral("QSQLITE"))) {
+        QSKIP("The SQLite driver is not available");
+    }
+    QVERIFY(m_dir.isValid());
+
+    for (const QString &connection : {First, Second}) {
+        QFile::remove(m_dir.filePath(connection));
+
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+        db.setDatabaseName(m_dir.filePath(connection));
+        QVERIFY(db.open());
+        QVERIFY(exec(connection, QStringLiteral("CREATE TABLE numbers (id INTEGER PRIMARY KEY, name TEXT)")));
+        QVERIFY(exec(connection, QStringLiteral("CREATE VIEW names AS SELECT name FROM numbers")));
+    }
+}
+
+void SchemaCacheTest::cleanup()
+{
+    QSqlDatabase::removeDatabase(First);
+    QSqlDatabase::removeDatabase(Second);
+}
+
+void SchemaCacheTest::testTables()
+{
+    SchemaCache cache;
+
+    QCOMPARE(cache.tables(First, QSql::Tables), QStringList({QStringLiteral("numbers")}));
+    QCOMPARE(cache.tables(First, QSql::Views), QStringList({QStringLiteral("names")}));
+
+    // the server is not asked again
+    QVERIFY(exec(First, QStringLiteral("CREATE TABLE words (word TEXT)")));
+    QCOMPARE(cache.tables(First, QSql::Tables), QStringList({QStringLiteral("numbers")}));
+
+    // the other connection has its own
+    QVERIFY(exec(Second, QStringLiteral("CREATE TABLE words (word TEXT)")));
+    QCOMPARE(cache.tables(Second, QSql::Tables).size(), 2);
+}
+
+void SchemaCacheTest::testRecord()
+{
+    SchemaCache cache;
+
+    const QSqlRecord record = cache.record(First, QStringLiteral("numbers"));
+    QCOMPARE(record.count(), 2);
+    QCOMPARE(record.fieldName(1), QStringLiteral("name"));
+    QVERIFY(cache.primaryIndex(First, QStringLiteral("numbers")).contains(QStringLiteral("id")));
+
+    QVERIFY(exec(First, QStringLiteral("ALTER TABLE numbers ADD COLUMN value REAL")));
+    QCOMPARE(cache.record(First, QStringLiteral("numbers")).count(), 2);
+}
+
+void SchemaCacheTest::testLoaded()
+{
+    SchemaCache cache;
+
+    // nothing is loaded for these
+    QVERIFY(cache.loadedTables(First).isEmpty());
+    QVERIFY(cache.loadedRecords(First).isEmpty());
+
+    cache.tables(First, QSql::Tables);
+    cache.tables(First, QSql::Views);
+    cache.tables(First, QSql::SystemTables);
+    QCOMPARE(cache.loadedTables(First), QStringList({QStringLiteral("numbers"), QStringLiteral("names")}));
+    QVERIFY(cache.loadedRecords(First).isEmpty());
+
+    cache.record(First, QStringLiteral("numbers"));
+    const QHash<QString, QSqlRecord> records = cache.loadedRecords(First);
+    QCOMPARE(records.size(), 1);
+    QCOMPARE(records.value(QStringLiteral("numbers")).count(), 2);
+
+    QVERIFY(cache.loadedTables(Second).isEmpty());
+}
+
+void SchemaCacheTest::testInvalidate()
+{
+    SchemaCache cache;
+
+    cache.tables(First, QSql::Tables);
+    cache.record(First, QStringLiteral("numbers"));
+    cache.tables(Second, QSql::Tables);
+
+    QVERIFY(exec(First, QStringLiteral("CREATE TABLE words (word TEXT)")));
+    QVERIFY(exec(First, QStringLiteral("ALTER TABLE numbers ADD COLUMN value REAL")));
+    QVERIFY(exec(Second, QStringLiteral("CREATE TABLE words (word TEXT)")));
+
+    cache.invalidate(First);
+
+    QVERIFY(cache.loadedRecords(First).isEmpty());
+    QCOMPARE(cache.tables(First, QSql::Tables).size(), 2);
+    QCOMPARE(cache.record(First, QStringLiteral("numbers")).count(), 3);
+
+    // the other connection is kept
+    QCOMPARE(cache.tables(Second, QSql::Tables).size(), 1);
+}
+
+void SchemaCacheTest::testClosed()
+{
+    SchemaCache cache;
+
+    QSqlDatabase::database(First, false).close();
+
+    // a closed connection is neither opened nor remembered as empty
+    QVERIFY(cache.tables(First, QSql::Tables).isEmpty());
+    QVERIFY(cache.record(First, QStringLiteral("numbers")).isEmpty());
+    QVERIFY(!QSqlDatabase::database(First, false).isOpen());
+
+    QVERIFY(QSqlDatabase::database(First, false).open());
+    QCOMPARE(cache.tables(First, QSql::Tables), QStringList({QStringLiteral("numbers")}));
+    QCOMPARE(cache.record(First, QStringLiteral("numbers")).count(), 2);
+}
+
+#include "moc_schemacachetest.cpp"
@@ -0,0 +1,27 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class SchemaCacheTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void testTables();
+    void testRecord();
+    void testLoaded();
+    void testInvalidate();
+    void testClosed();
+
+private:
+    QTemporaryDir m_dir;
+};
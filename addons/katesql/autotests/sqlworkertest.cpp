@@ -0,0 +1,317 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#include "sqlworkertest.h"
+#include "sqlworker.h"
+
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTest>
+
+#include <map>
+
+QTEST_MAIN(SQLWorkerTest)
+
+// the SQLite database all tests run on, with the rows 1 to RowCount
+static const QString Fixture = QStringLiteral("fixture");
+static constexpr int RowCount = 5000;
+
+namespace
+{
+struct Query {
+    QSqlRecord columns;
+    ResultStore rows;
+    int batches = 0;
+    QByteArray data;
+    bool finished = false;
+    bool isSelect = false;
+    qint64 count = -1;
+    QSqlError error;
+};
+
+/**
+ * What the worker reported, per query. The signals arrive queued in the test thread.
+ */
+class Receiver : public QObject
+{
+public:
+    explicit Receiver(SQLWorker &worker)
+    {
+        connect(&worker, &SQLWorker::columnsReady, this, [this](quint64 id, const QSqlRecord &columns) {
+            queries[id].columns = columns;
+        });
+        connect(&worker, &SQLWorker::rowsReady, this, [this](quint64 id, const ResultChunk &rows) {
+            queries[id].rows.append(rows);
+            ++queries[id].batches;
+        });
+        connect(&worker, &SQLWorker::dataReady, this, [this](quint64 id, const QByteArray &data) {
+            queries[id].data.append(data);
+            ++queries[id].batches;
+        });
+        connect(&worker, &SQLWorker::finished, this, [this](quint64 id, bool isSelect, qint64 count) {
+            queries[id].finished = true;
+            queries[id].isSelect = isSelect;
+            queries[id].count = count;
+            done.append(id);
+        });
+        connect(&worker, &SQLWorker::failed, this, [this](quint64 id, const QSqlError &error) {
+            queries[id].error = error;
+            done.append(id);
+        });
+    }
+
+    std::map<quint64, Query> queries;
+    QList<quint64> done;
+};
+}
+
+void SQLWorkerTest::initTestCase()
+{
+    if (!QSqlDatabase::isDriverAvailable(QStringLiteral("QSQLITE"))) {
+        QSKIP("The SQLite driver is not available");
+    }
+    QVERIFY(m_dir.isValid());
+
+    QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), Fixture);
+    db.setDatabaseName(m_dir.filePath(QStringLiteral("fixture.sqlite")));
+    QVERIFY(db.open());
+
+    QSqlQuery query(db);
+    QVERIFY(query.exec(QStringLiteral("CREATE TABLE numbers (id INTEGER PRIMARY KEY, name TEXT)")));
+    QVERIFY(db.transaction());
+    QVERIFY(query.prepare(QStringLiteral("INSERT INTO numbers (id, name) VALUES (?, ?)")));
+    for (int i = 1; i <= RowCount; ++i) {
+        query.bindValue(0, i);
+        query.bindValue(1, QStringLiteral("name %1").arg(i));
+        QVERIFY(query.exec());
+    }
+    QVERIFY(db.commit());
+}
+
+void SQLWorkerTest::cleanupTestCase()
+{
+    QSqlDatabase::removeDatabase(Fixture);
+}
+
+void SQLWorkerTest::testSelect()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    const quint64 id = worker.runQuery(QStringLiteral("SELECT id, name FROM numbers ORDER BY id"));
+    QTRY_VERIFY(receiver.done.contains(id));
+
+    const Query &query = receiver.queries[id];
+    QVERIFY(!query.error.isValid());
+    QVERIFY(query.finished);
+    QVERIFY(query.isSelect);
+    QCOMPARE(query.count, qint64(RowCount));
+    QCOMPARE(query.columns.count(), 2);
+    QCOMPARE(query.columns.fieldName(1), QStringLiteral("name"));
+
+    // the rows come in batches, in order
+    QVERIFY(query.batches > 1);
+    QCOMPARE(query.rows.rowCount(), RowCount);
+    QCOMPARE(query.rows.value(0, 0).toInt(), 1);
+    QCOMPARE(query.rows.value(0, 1).toString(), QStringLiteral("name 1"));
+    QCOMPARE(query.rows.value(RowCount - 1, 0).toInt(), RowCount);
+}
+
+void SQLWorkerTest::testUpdate()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    const quint64 id = worker.runQuery(QStringLiteral("UPDATE numbers SET name = name WHERE id <= 10"));
+    QTRY_VERIFY(receiver.done.contains(id));
+
+    const Query &query = receiver.queries[id];
+    QVERIFY(query.finished);
+    QVERIFY(!query.isSelect);
+    QCOMPARE(query.count, qint64(10));
+    QCOMPARE(query.rows.rowCount(), 0);
+}
+
+void SQLWorkerTest::testError()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    const quint64 id = worker.runQuery(QStringLiteral("SELECT * FROM missing"));
+    QTRY_VERIFY(receiver.done.contains(id));
+
+    const Query &query = receiver.queries[id];
+    QVERIFY(!query.finished);
+    QVERIFY(query.error.isValid());
+}
+
+void SQLWorkerTest::testOrder()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    const quint64 first = worker.runQuery(QStringLiteral("SELECT * FROM numbers"));
+    const quint64 second = worker.runQuery(QStringLiteral("SELECT COUNT(*) FROM numbers"));
+    QVERIFY(first != second);
+    QTRY_COMPARE(receiver.done.size(), 2);
+    QCOMPARE(receiver.done, QList<quint64>({first, second}));
+    QCOMPARE(receiver.queries[second].rows.rowCount(), 1);
+    QCOMPARE(receiver.queries[second].rows.value(0, 0).toInt(), RowCount);
+}
+
+void SQLWorkerTest::testCancel()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    // far more rows than can be fetched before the cancel arrives
+    constexpr int Generated = 100000000;
+    const quint64 canceled = worker.runQuery(
+        QStringLiteral("WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < %1) SELECT i FROM n").arg(Generated));
+    QTRY_VERIFY(receiver.queries[canceled].batches > 0);
+    worker.cancel(canceled);
+
+    // the worker is free for the next query
+    const quint64 next = worker.runQuery(QStringLiteral("SELECT 1"));
+    QTRY_VERIFY(receiver.done.contains(next));
+
+    QCOMPARE(receiver.done, QList<quint64>({next}));
+    QVERIFY(!receiver.queries[canceled].finished);
+    QVERIFY(receiver.queries[canceled].rows.rowCount() < Generated);
+    QVERIFY(receiver.queries[next].finished);
+}
+
+void SQLWorkerTest::testExport()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    ResultExporter::Options options;
+    options.fieldDelimiter = QStringLiteral(",");
+    options.stringsQuoteChar = QLatin1Char('"');
+    options.columnNames = true;
+
+    const QString fileName = m_dir.filePath(QStringLiteral("export.csv"));
+    const quint64 id = worker.exportQuery(QStringLiteral("SELECT id, name FROM numbers ORDER BY id"), fileName, options);
+    QTRY_VERIFY(receiver.done.contains(id));
+
+    const Query &query = receiver.queries[id];
+    QVERIFY(!query.error.isValid());
+    QVERIFY(query.finished);
+    QCOMPARE(query.count, qint64(RowCount));
+    // nothing is handed out, it is all in the file
+    QVERIFY(query.data.isEmpty());
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    // the header and the empty part after the last newline
+    QCOMPARE(lines.size(), RowCount + 2);
+    QCOMPARE(lines.at(0), QByteArray("\"id\",\"name\""));
+    QCOMPARE(lines.at(1), QByteArray("1,\"name 1\""));
+    QCOMPARE(lines.at(RowCount), QByteArray("%1,\"name %1\"").replace("%1", QByteArray::number(RowCount)));
+    QVERIFY(lines.last().isEmpty());
+}
+
+void SQLWorkerTest::testExportData()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    ResultExporter::Options options;
+    options.format = ResultExporter::Format::JsonLines;
+
+    const quint64 id = worker.exportQuery(QStringLiteral("SELECT id, name FROM numbers WHERE id <= 2 ORDER BY id"), QString(), options);
+    QTRY_VERIFY(receiver.done.contains(id));
+
+    const Query &query = receiver.queries[id];
+    QVERIFY(query.finished);
+    QCOMPARE(query.count, qint64(2));
+    QCOMPARE(query.data, QByteArray("{\"id\":1,\"name\":\"name 1\"}\n{\"id\":2,\"name\":\"name 2\"}\n"));
+}
+
+void SQLWorkerTest::testExportCancel()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    const QString fileName = m_dir.filePath(QStringLiteral("canceled.tsv"));
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("previous export\n");
+    }
+
+    // the rows are written in blocks of a MiB, give it some of those before canceling
+    constexpr int Generated = 100000000;
+    const quint64 canceled = worker.exportQuery(
+        QStringLiteral("WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < %1) SELECT i, 'row ' || i FROM n").arg(Generated),
+        fileName,
+        ResultExporter::Options());
+    QTest::qWait(500);
+    worker.cancel(canceled);
+
+    const quint64 next = worker.runQuery(QStringLiteral("SELECT 1"));
+    QTRY_VERIFY(receiver.done.contains(next));
+    QCOMPARE(receiver.done, QList<quint64>({next}));
+
+    // a canceled export leaves the file as it was
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), QByteArray("previous export\n"));
+}
+
+void SQLWorkerTest::testReadOnly_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("readOnly");
+
+    QTest::newRow("select") << QStringLiteral("SELECT * FROM t;") << true;
+    QTest::newRow("lower case") << QStringLiteral("  select a from t where b = 'insert'") << true;
+    QTest::newRow("comments") << QStringLiteral("-- delete it all\n/* update */ SELECT 1") << true;
+    QTest::newRow("cte") << QStringLiteral("WITH x AS (SELECT 1) SELECT * FROM x") << true;
+    QTest::newRow("values") << QStringLiteral("VALUES (1), (2)") << true;
+    QTest::newRow("insert") << QStringLiteral("INSERT INTO t VALUES (1)") << false;
+    QTest::newRow("returning") << QStringLiteral("DELETE FROM t RETURNING *") << false;
+    QTest::newRow("writing cte") << QStringLiteral("WITH x AS (UPDATE t SET a = 1 RETURNING a) SELECT * FROM x") << false;
+    QTest::newRow("select into") << QStringLiteral("SELECT * INTO t2 FROM t") << false;
+    QTest::newRow("sequence") << QStringLiteral("SELECT nextval('s')") << false;
+    QTest::newRow("locking") << QStringLiteral("SELECT * FROM t FOR UPDATE") << false;
+    QTest::newRow("two statements") << QStringLiteral("SELECT 1; DROP TABLE t") << false;
+    QTest::newRow("hidden by a comment") << QStringLiteral("/* SELECT */ DROP TABLE t") << false;
+    QTest::newRow("empty") << QString() << false;
+}
+
+void SQLWorkerTest::testReadOnly()
+{
+    QFETCH(QString, text);
+    QFETCH(bool, readOnly);
+
+    QCOMPARE(SQLWorker::isReadOnly(text), readOnly);
+}
+
+void SQLWorkerTest::benchmarkExport()
+{
+    SQLWorker worker(Fixture);
+    Receiver receiver(worker);
+
+    ResultExporter::Options options;
+    options.fieldDelimiter = QStringLiteral(",");
+    options.stringsQuoteChar = QLatin1Char('"');
+
+    // a million rows of a number, a text and a real
+    const QString text = QStringLiteral(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 1000000) SELECT i, 'name \"' || i || '\"', i * 0.5 FROM n");
+    const QString fileName = m_dir.filePath(QStringLiteral("benchmark.csv"));
+
+    QBENCHMARK {
+        const quint64 id = worker.exportQuery(text, fileName, options);
+        QTRY_VERIFY_WITH_TIMEOUT(receiver.done.contains(id), 60000);
+        QVERIFY(receiver.queries[id].finished);
+    }
+}
+
+#include "moc_sqlworkertest.cpp"
@@ -0,0 +1,34 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class SQLWorkerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testSelect();
+    void testUpdate();
+    void testError();
+    void testOrder();
+    void testCancel();
+    void testExport();
+    void testExportData();
+    void testExportCancel();
+    void testReadOnly_data();
+    void testReadOnly();
+
+    void benchmarkExport();
+
+private:
+    QTemporaryDir m_dir;
+};
@@ -21,7 +21,7 @@ inline bool isNumeric(const int type)
 }
 
 DataOutputModel::DataOutputModel(QObject *parent)
-    : CachedSqlQueryModel(parent, 1000)
+    : QueryResultModel(parent)
 {
     m_useSystemLocale = false;
 
@@ -40,15 +40,6 @@ DataOutputModel::~DataOutputModel()
     qDeleteAll(m_styles);
 }
 
-void DataOutputModel::clear()
-{
-    beginResetModel();
-
-    CachedSqlQueryModel::clear();
-
-    endResetModel();
-}
-
 void DataOutputModel::readConfig()
 {
     KConfigGroup config(KSharedConfig::openConfig(), QStringLiteral("KateSQLPlugin"));
@@ -95,10 +86,10 @@ void DataOutputModel::setUseSystemLocale(bool useSystemLocale)
 QVariant DataOutputModel::data(const QModelIndex &index, int role) const
 {
     if (role == Qt::EditRole) {
-        return CachedSqlQueryModel::data(index, role);
+        return QueryResultModel::data(index, role);
     }
 
-    const QVariant value(CachedSqlQueryModel::data(index, Qt::DisplayRole));
+    const QVariant value(QueryResultModel::data(index, Qt::DisplayRole));
     const auto type = value.typeId();
 
     if (value.isNull()) {
@@ -214,7 +205,7 @@ QVariant DataOutputModel::data(const QModelIndex &index, int role) const
         return value;
     }
 
-    return CachedSqlQueryModel::data(index, role);
+    return QueryResultModel::data(index, role);
 }
 
 #include "moc_dataoutputmodel.cpp"
@@ -8,10 +8,10 @@
 
 struct OutputStyle;
 
-#include "cachedsqlquerymodel.h"
+#include "queryresultmodel.h"
 
 /// provide colors and styles
-class DataOutputModel : public CachedSqlQueryModel
+class DataOutputModel : public QueryResultModel
 {
     Q_OBJECT
 
@@ -24,7 +24,6 @@ public:
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
-    void clear() override;
     void readConfig();
 
 private:
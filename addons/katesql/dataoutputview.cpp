@@ -7,6 +7,7 @@
 #include "dataoutputview.h"
 
 #include <QCursor>
+#include <QHeaderView>
 #include <QMenu>
 
 DataOutputView::DataOutputView(QWidget *parent)
@@ -14,9 +15,35 @@ DataOutputView::DataOutputView(QWidget *parent)
 {
     setContextMenuPolicy(Qt::CustomContextMenu);
 
+    // results can have millions of rows, nothing may look at all of them: the rows share one
+    // height and the columns are sized for the rows in view
+    setWordWrap(false);
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    horizontalHeader()->setResizeContentsPrecision(0);
+
     connect(this, &DataOutputView::customContextMenuRequested, this, &DataOutputView::slotCustomContextMenuRequested);
 }
 
+int DataOutputView::sizeHintForVisibleRows() const
+{
+    if (!model() || model()->rowCount() == 0) {
+        return 0;
+    }
+
+    const int first = qMax(0, rowAt(0));
+    int last = rowAt(viewport()->height() - 1);
+    if (last < 0) {
+        last = model()->rowCount() - 1;
+    }
+
+    int height = 0;
+    for (int row = first; row <= last; ++row) {
+        height = qMax(height, sizeHintForRow(row));
+    }
+
+    return height;
+}
+
 void DataOutputView::slotCustomContextMenuRequested(const QPoint &pos)
 {
     Q_UNUSED(pos);
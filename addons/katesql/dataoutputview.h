@@ -15,6 +15,9 @@ class DataOutputView : public QTableView
 public:
     explicit DataOutputView(QWidget *parent = nullptr);
 
+    /// the height the rows in view need
+    int sizeHintForVisibleRows() const;
+
 private Q_SLOTS:
     void slotCustomContextMenuRequested(const QPoint &pos);
 };
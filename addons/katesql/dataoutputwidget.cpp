@@ -25,20 +25,25 @@
 #include <QClipboard>
 #include <QElapsedTimer>
 #include <QFile>
+#include <QSaveFile>
 #include <QHeaderView>
+#include <QItemSelection>
+#include <QLabel>
 #include <QLayout>
 #include <QSize>
-#include <QSqlError>
-#include <QSqlQuery>
+#include <QSqlField>
+#include <QSqlRecord>
 #include <QStyle>
-#include <QTextStream>
 #include <QTime>
 #include <QTimer>
 
+#include <algorithm>
+
 DataOutputWidget::DataOutputWidget(QWidget *parent)
     : QWidget(parent)
     , m_model(new DataOutputModel(this))
     , m_view(new DataOutputView(this))
+    , m_rowCountLabel(new QLabel(this))
     , m_isEmpty(true)
 {
     m_view->setModel(m_model);
@@ -89,6 +94,8 @@ DataOutputWidget::DataOutputWidget(QWidget *parent)
     connect(toggleAction, &QAction::triggered, this, &DataOutputWidget::slotToggleLocale);
 
     m_dataLayout->addWidget(m_view);
+    m_dataLayout->addWidget(m_rowCountLabel);
+    m_rowCountLabel->hide();
 
     layout->addWidget(toolbar);
     layout->addLayout(m_dataLayout);
@@ -101,29 +108,33 @@ DataOutputWidget::~DataOutputWidget()
 {
 }
 
-void DataOutputWidget::showQueryResultSets(QSqlQuery &query)
+void DataOutputWidget::showQueryResult(const QSqlRecord &columns)
 {
     /// TODO: loop resultsets if > 1
-    /// NOTE from Qt Documentation:
-    /// When one of the statements is a non-select statement a count of affected rows
-    /// may be available instead of a result set.
-
-    if (!query.isSelect() || query.lastError().isValid()) {
-        return;
-    }
 
-    m_model->setQuery(std::move(query));
+    m_model->setColumns(columns);
 
     m_isEmpty = false;
-
-    QTimer::singleShot(0, this, &DataOutputWidget::resizeColumnsToContents);
+    updateRowCount();
 
     raise();
 }
 
+void DataOutputWidget::appendRows(const ResultChunk &rows)
+{
+    const bool first = m_model->rowCount() == 0;
+
+    m_model->appendRows(rows);
+    updateRowCount();
+
+    // the columns are sized for the first rows, later ones don't make them jump
+    if (first) {
+        QTimer::singleShot(0, this, &DataOutputWidget::resizeColumnsToContents);
+    }
+}
+
 void DataOutputWidget::clearResults()
 {
-    // avoid crash when calling QSqlQueryModel::clear() after removing connection from the QSqlDatabase list
     if (m_isEmpty) {
         return;
     }
@@ -131,6 +142,7 @@ void DataOutputWidget::clearResults()
     m_model->clear();
 
     m_isEmpty = true;
+    updateRowCount();
 
     /// HACK needed to refresh headers. please correct if there's a better way
     m_view->horizontalHeader()->hide();
@@ -155,15 +167,33 @@ void DataOutputWidget::resizeRowsToContents()
         return;
     }
 
-    m_view->resizeRowsToContents();
-
-    int h = m_view->rowHeight(0);
+    // all rows get the height of the rows in view, measuring each of them takes too long
+    int h = m_view->sizeHintForVisibleRows();
 
     if (h > 0) {
         m_view->verticalHeader()->setDefaultSectionSize(h);
     }
 }
 
+void DataOutputWidget::setFetching(bool fetching)
+{
+    m_fetching = fetching;
+    updateRowCount();
+}
+
+void DataOutputWidget::updateRowCount()
+{
+    if (m_isEmpty) {
+        m_rowCountLabel->hide();
+        return;
+    }
+
+    const int rows = m_model->rowCount();
+    m_rowCountLabel->setText(m_fetching ? i18ncp("@info", "%1 row, fetching more…", "%1 rows, fetching more…", rows)
+                                        : i18ncp("@info", "%1 row", "%1 rows", rows));
+    m_rowCountLabel->show();
+}
+
 void DataOutputWidget::slotToggleLocale()
 {
     m_model->setUseSystemLocale(!m_model->useSystemLocale());
@@ -175,22 +205,15 @@ void DataOutputWidget::slotCopySelected()
         return;
     }
 
-    while (m_model->canFetchMore()) {
-        m_model->fetchMore();
-    }
+    const ResultExporter::Options options;
 
-    if (!m_view->selectionModel()->hasSelection()) {
-        m_view->selectAll();
+    // copy what the grid has, never run the query again for it
+    if (isWholeResultSelected()) {
+        exportFetchedRows(ExportTarget::Clipboard, QString(), options);
+        return;
     }
 
-    QString text;
-    QTextStream stream(&text);
-
-    exportData(stream);
-
-    if (!text.isEmpty()) {
-        QApplication::clipboard()->setText(text);
-    }
+    writeExport(ExportTarget::Clipboard, exportSelection(options));
 }
 
 void DataOutputWidget::slotExport()
@@ -199,14 +222,6 @@ void DataOutputWidget::slotExport()
         return;
     }
 
-    while (m_model->canFetchMore()) {
-        m_model->fetchMore();
-    }
-
-    if (!m_view->selectionModel()->hasSelection()) {
-        m_view->selectAll();
-    }
-
     ExportWizard wizard(this);
 
     if (wizard.exec() != QDialog::Accepted) {
@@ -217,27 +232,75 @@ void DataOutputWidget::slotExport()
     bool outputInClipboard = wizard.field(QStringLiteral("outClipboard")).toBool();
     bool outputInFile = wizard.field(QStringLiteral("outFile")).toBool();
 
-    bool exportColumnNames = wizard.field(QStringLiteral("exportColumnNames")).toBool();
-    bool exportLineNumbers = wizard.field(QStringLiteral("exportLineNumbers")).toBool();
-
-    Options opt = NoOptions;
+    ResultExporter::Options options;
 
-    if (exportColumnNames) {
-        opt |= ExportColumnNames;
-    }
-    if (exportLineNumbers) {
-        opt |= ExportLineNumbers;
+    if (wizard.field(QStringLiteral("formatJsonLines")).toBool()) {
+        options.format = ResultExporter::Format::JsonLines;
     }
 
+    options.columnNames = wizard.field(QStringLiteral("exportColumnNames")).toBool();
+    options.lineNumbers = wizard.field(QStringLiteral("exportLineNumbers")).toBool();
+
     bool quoteStrings = wizard.field(QStringLiteral("checkQuoteStrings")).toBool();
     bool quoteNumbers = wizard.field(QStringLiteral("checkQuoteNumbers")).toBool();
 
-    QChar stringsQuoteChar = (quoteStrings) ? wizard.field(QStringLiteral("quoteStringsChar")).toString().at(0) : QLatin1Char('\0');
-    QChar numbersQuoteChar = (quoteNumbers) ? wizard.field(QStringLiteral("quoteNumbersChar")).toString().at(0) : QLatin1Char('\0');
+    if (quoteStrings) {
+        options.stringsQuoteChar = wizard.field(QStringLiteral("quoteStringsChar")).toString().at(0);
+    }
+    if (quoteNumbers) {
+        options.numbersQuoteChar = wizard.field(QStringLiteral("quoteNumbersChar")).toString().at(0);
+    }
+
+    options.fieldDelimiter = wizard.field(QStringLiteral("fieldDelimiter")).toString();
+
+    /// FIXME: ugly workaround...
+    options.fieldDelimiter.replace(QLatin1String("\\t"), QLatin1String("\t"));
+    options.fieldDelimiter.replace(QLatin1String("\\r"), QLatin1String("\r"));
+    options.fieldDelimiter.replace(QLatin1String("\\n"), QLatin1String("\n"));
+
+    ExportTarget target = ExportTarget::Document;
+    QString url;
+
+    if (outputInClipboard) {
+        target = ExportTarget::Clipboard;
+    } else if (outputInFile) {
+        target = ExportTarget::File;
+        url = wizard.field(QStringLiteral("outFileUrl")).toString();
+    } else if (!outputInDocument) {
+        return;
+    }
+
+    if (isWholeResultSelected()) {
+        if (m_fetching) {
+            Q_EMIT exportRequested(target, url, options);
+        } else {
+            exportFetchedRows(target, url, options);
+        }
+        return;
+    }
+
+    const QByteArray data = exportSelection(options);
+
+    if (target != ExportTarget::File) {
+        writeExport(target, data);
+        return;
+    }
 
-    QString fieldDelimiter = wizard.field(QStringLiteral("fieldDelimiter")).toString();
+    QFile file(url);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate) || file.write(data) != data.size()) {
+        KMessageBox::error(this, xi18nc("@info", "Unable to open file <filename>%1</filename>", url));
+    }
+}
 
-    if (outputInDocument) {
+void DataOutputWidget::writeExport(ExportTarget target, const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return;
+    }
+
+    if (target == ExportTarget::Clipboard) {
+        QApplication::clipboard()->setText(QString::fromUtf8(data));
+    } else if (target == ExportTarget::Document) {
         KTextEditor::MainWindow *mw = KTextEditor::Editor::instance()->application()->activeMainWindow();
         KTextEditor::View *kv = mw->activeView();
 
@@ -245,133 +308,130 @@ void DataOutputWidget::slotExport()
             return;
         }
 
-        QString text;
-        QTextStream stream(&text);
+        kv->insertText(QString::fromUtf8(data));
+        kv->setFocus();
+    }
+}
 
-        exportData(stream, stringsQuoteChar, numbersQuoteChar, fieldDelimiter, opt);
+void DataOutputWidget::exportFetchedRows(ExportTarget target, const QString &fileName, const ResultExporter::Options &options)
+{
+    // written in blocks, a big result is not copied into one more buffer
+    static constexpr qsizetype BlockSize = 1024 * 1024;
 
-        kv->insertText(text);
-        kv->setFocus();
-    } else if (outputInClipboard) {
-        QString text;
-        QTextStream stream(&text);
+    const ResultStore &store = m_model->rows();
+    const int columnCount = m_model->columnCount();
 
-        exportData(stream, stringsQuoteChar, numbersQuoteChar, fieldDelimiter, opt);
+    QSaveFile file(fileName);
+    if (target == ExportTarget::File && !file.open(QIODevice::WriteOnly)) {
+        KMessageBox::error(this, xi18nc("@info", "Unable to open file <filename>%1</filename>", fileName));
+        return;
+    }
 
-        QApplication::clipboard()->setText(text);
-    } else if (outputInFile) {
-        QString url = wizard.field(QStringLiteral("outFileUrl")).toString();
-        QFile data(url);
-        if (data.open(QFile::WriteOnly | QFile::Truncate)) {
-            QTextStream stream(&data);
+    ResultExporter exporter(m_model->record(), options);
 
-            exportData(stream, stringsQuoteChar, numbersQuoteChar, fieldDelimiter, opt);
+    QByteArray data;
+    exporter.appendHeader(data);
 
-            stream.flush();
-        } else {
-            KMessageBox::error(this, xi18nc("@info", "Unable to open file <filename>%1</filename>", url));
+    QVariantList values(columnCount);
+
+    for (int row = 0; row < store.rowCount(); ++row) {
+        for (int col = 0; col < columnCount; ++col) {
+            values[col] = store.value(row, col);
+        }
+        exporter.appendRow(values, data);
+
+        if (target == ExportTarget::File && data.size() >= BlockSize) {
+            file.write(data);
+            data.clear();
         }
     }
+
+    if (target != ExportTarget::File) {
+        writeExport(target, data);
+        return;
+    }
+
+    file.write(data);
+    if (!file.commit()) {
+        KMessageBox::error(this, xi18nc("@info", "Unable to write file <filename>%1</filename>", fileName));
+    }
 }
 
-void DataOutputWidget::exportData(QTextStream &stream,
-                                  const QChar stringsQuoteChar,
-                                  const QChar numbersQuoteChar,
-                                  const QString &fieldDelimiter,
-                                  const Options opt)
+bool DataOutputWidget::isWholeResultSelected() const
 {
-    QItemSelectionModel *selectionModel = m_view->selectionModel();
+    const QItemSelection selection = m_view->selectionModel()->selection();
 
-    if (!selectionModel->hasSelection()) {
-        return;
+    if (selection.isEmpty()) {
+        return true;
     }
 
-    QString fixedFieldDelimiter = fieldDelimiter;
+    // select all gives one range
+    if (selection.size() != 1) {
+        return false;
+    }
 
-    /// FIXME: ugly workaround...
-    fixedFieldDelimiter.replace(QLatin1String("\\t"), QLatin1String("\t"));
-    fixedFieldDelimiter.replace(QLatin1String("\\r"), QLatin1String("\r"));
-    fixedFieldDelimiter.replace(QLatin1String("\\n"), QLatin1String("\n"));
+    const QItemSelectionRange &range = selection.first();
+    return range.top() == 0 && range.left() == 0 && range.bottom() == m_model->rowCount() - 1 && range.right() == m_model->columnCount() - 1;
+}
+
+QByteArray DataOutputWidget::exportSelection(const ResultExporter::Options &options) const
+{
+    QItemSelectionModel *selectionModel = m_view->selectionModel();
+
+    if (!selectionModel->hasSelection()) {
+        return QByteArray();
+    }
 
     QElapsedTimer t;
     t.start();
 
-    QSet<int> columns;
-    QSet<int> rows;
-    QHash<QPair<int, int>, QString> snapshot;
+    QList<int> columns;
+    QList<int> rows;
+    QHash<QPair<int, int>, QVariant> snapshot;
 
     const QModelIndexList selectedIndexes = selectionModel->selectedIndexes();
 
     snapshot.reserve(selectedIndexes.count());
 
     for (const QModelIndex &index : selectedIndexes) {
-        const QVariant data = index.data(Qt::UserRole);
-
         const int col = index.column();
         const int row = index.row();
 
-        if (!columns.contains(col)) {
-            columns.insert(col);
-        }
-        if (!rows.contains(row)) {
-            rows.insert(row);
-        }
+        columns.append(col);
+        rows.append(row);
 
-        if (data.typeId() < 7) // is numeric or boolean
-        {
-            if (numbersQuoteChar != QLatin1Char('\0')) {
-                snapshot[qMakePair(row, col)] = numbersQuoteChar + data.toString() + numbersQuoteChar;
-            } else {
-                snapshot[qMakePair(row, col)] = data.toString();
-            }
-        } else {
-            if (stringsQuoteChar != QLatin1Char('\0')) {
-                snapshot[qMakePair(row, col)] = stringsQuoteChar + data.toString() + stringsQuoteChar;
-            } else {
-                snapshot[qMakePair(row, col)] = data.toString();
-            }
-        }
+        // the value as it came from the database
+        snapshot[qMakePair(row, col)] = index.data(Qt::EditRole);
     }
 
-    if (opt.testFlag(ExportColumnNames)) {
-        if (opt.testFlag(ExportLineNumbers)) {
-            stream << fixedFieldDelimiter;
-        }
-
-        QSetIterator<int> j(columns);
-        while (j.hasNext()) {
-            const QVariant data = m_model->headerData(j.next(), Qt::Horizontal);
-
-            if (stringsQuoteChar != QLatin1Char('\0')) {
-                stream << stringsQuoteChar + data.toString() + stringsQuoteChar;
-            } else {
-                stream << data.toString();
-            }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
 
-            if (j.hasNext()) {
-                stream << fixedFieldDelimiter;
-            }
-        }
-        stream << "\n";
+    const QSqlRecord record = m_model->record();
+    QSqlRecord selectedColumns;
+    for (const int col : std::as_const(columns)) {
+        selectedColumns.append(record.field(col));
     }
 
-    for (const int row : std::as_const(rows)) {
-        if (opt.testFlag(ExportLineNumbers)) {
-            stream << row + 1 << fixedFieldDelimiter;
-        }
+    ResultExporter exporter(selectedColumns, options);
 
-        QSetIterator<int> j(columns);
-        while (j.hasNext()) {
-            stream << snapshot.value(qMakePair(row, j.next()));
+    QByteArray data;
+    exporter.appendHeader(data);
 
-            if (j.hasNext()) {
-                stream << fixedFieldDelimiter;
-            }
+    QVariantList values(columns.size());
+
+    for (const int row : std::as_const(rows)) {
+        for (qsizetype i = 0; i < columns.size(); ++i) {
+            values[i] = snapshot.value(qMakePair(row, columns.at(i)));
         }
-        stream << "\n";
+        exporter.appendRow(values, data);
     }
 
     qDebug() << "Export in" << t.elapsed() << "msecs";
+
+    return data;
 }
 
 #include "moc_dataoutputwidget.cpp"
@@ -6,12 +6,15 @@
 
 #pragma once
 
-class QTextStream;
 class QVBoxLayout;
-class QSqlQuery;
+class QLabel;
+class QSqlRecord;
+class ResultChunk;
 class DataOutputModel;
 class DataOutputView;
 
+#include "resultexporter.h"
+
 #include <QWidget>
 
 class DataOutputWidget : public QWidget
@@ -19,18 +22,16 @@ class DataOutputWidget : public QWidget
     Q_OBJECT
 
 public:
-    enum Option { NoOptions = 0x0, ExportColumnNames = 0x1, ExportLineNumbers = 0x2 };
-
-    Q_DECLARE_FLAGS(Options, Option)
+    enum class ExportTarget { Document, Clipboard, File };
 
     DataOutputWidget(QWidget *parent);
     ~DataOutputWidget() override;
 
-    void exportData(QTextStream &stream,
-                    const QChar stringsQuoteChar = QLatin1Char('\0'),
-                    const QChar numbersQuoteChar = QLatin1Char('\0'),
-                    const QString &fieldDelimiter = QStringLiteral("\t"),
-                    const Options opt = NoOptions);
+    /// the selected cells, the rows and columns in order
+    QByteArray exportSelection(const ResultExporter::Options &options) const;
+
+    /// export all rows fetched so far, the query isn't run again
+    void exportFetchedRows(DataOutputWidget::ExportTarget target, const QString &fileName, const ResultExporter::Options &options);
 
     DataOutputModel *model() const
     {
@@ -42,7 +43,9 @@ public:
     }
 
 public Q_SLOTS:
-    void showQueryResultSets(QSqlQuery &query);
+    void showQueryResult(const QSqlRecord &columns);
+    void appendRows(const ResultChunk &rows);
+    void setFetching(bool fetching);
     void resizeColumnsToContents();
     void resizeRowsToContents();
     void clearResults();
@@ -51,14 +54,30 @@ public Q_SLOTS:
     void slotCopySelected();
     void slotExport();
 
+    /// put exported text where it was asked for, files are written by the exporter
+    void writeExport(DataOutputWidget::ExportTarget target, const QByteArray &data);
+
+Q_SIGNALS:
+    /**
+     * All rows of the result are to be exported while they are still being fetched.
+     * @p fileName is empty for the other targets.
+     */
+    void exportRequested(DataOutputWidget::ExportTarget target, const QString &fileName, const ResultExporter::Options &options);
+
+private:
+    void updateRowCount();
+
+    /// nothing or everything is selected
+    bool isWholeResultSelected() const;
+
 private:
     QVBoxLayout *m_dataLayout;
 
     /// TODO: manage multiple views for query with multiple resultsets
     DataOutputModel *m_model;
     DataOutputView *m_view;
+    QLabel *m_rowCountLabel;
 
     bool m_isEmpty;
+    bool m_fetching = false;
 };
-
-Q_DECLARE_OPERATORS_FOR_FLAGS(DataOutputWidget::Options)
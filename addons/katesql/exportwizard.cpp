@@ -51,7 +51,10 @@ ExportOutputPage::ExportOutputPage(QWidget *parent)
 
     fileUrl = new KUrlRequester(this);
     fileUrl->setMode(KFile::File);
-    fileUrl->setNameFilters({i18n("Comma Separated Values") + QLatin1String(" (*.csv)"), i18n("All files") + QLatin1String(" (*)")});
+    fileUrl->setNameFilters({i18n("Comma Separated Values") + QLatin1String(" (*.csv)"),
+                             i18n("Tab Separated Values") + QLatin1String(" (*.tsv)"),
+                             i18n("JSON Lines") + QLatin1String(" (*.jsonl)"),
+                             i18n("All files") + QLatin1String(" (*)")});
 
     fileLayout->addWidget(fileUrl);
 
@@ -98,6 +101,17 @@ ExportFormatPage::ExportFormatPage(QWidget *parent)
 
     QVBoxLayout *layout = new QVBoxLayout();
 
+    QGroupBox *formatGroupBox = new QGroupBox(i18nc("@title:group", "Format"), this);
+    QVBoxLayout *formatLayout = new QVBoxLayout();
+
+    delimitedRadioButton = new QRadioButton(i18nc("@option:radio Export format", "Delimited text, like CSV"), formatGroupBox);
+    jsonLinesRadioButton = new QRadioButton(i18nc("@option:radio Export format", "JSON Lines, one object per row"), formatGroupBox);
+
+    formatLayout->addWidget(delimitedRadioButton);
+    formatLayout->addWidget(jsonLinesRadioButton);
+
+    formatGroupBox->setLayout(formatLayout);
+
     QGroupBox *headersGroupBox = new QGroupBox(i18nc("@title:group", "Headers"), this);
     QVBoxLayout *headersLayout = new QVBoxLayout();
 
@@ -140,12 +154,14 @@ ExportFormatPage::ExportFormatPage(QWidget *parent)
 
     delimitersGroupBox->setLayout(delimitersLayout);
 
+    layout->addWidget(formatGroupBox);
     layout->addWidget(headersGroupBox);
     layout->addWidget(quoteGroupBox);
     layout->addWidget(delimitersGroupBox);
 
     setLayout(layout);
 
+    registerField(QStringLiteral("formatJsonLines"), jsonLinesRadioButton);
     registerField(QStringLiteral("exportColumnNames"), exportColumnNamesCheckBox);
     registerField(QStringLiteral("exportLineNumbers"), exportLineNumbersCheckBox);
     registerField(QStringLiteral("checkQuoteStrings"), quoteStringsCheckBox);
@@ -156,10 +172,16 @@ ExportFormatPage::ExportFormatPage(QWidget *parent)
 
     connect(quoteStringsCheckBox, &QCheckBox::toggled, quoteStringsLine, &KLineEdit::setEnabled);
     connect(quoteNumbersCheckBox, &QCheckBox::toggled, quoteNumbersLine, &KLineEdit::setEnabled);
+
+    // JSON has names, quotes and delimiters of its own
+    connect(delimitedRadioButton, &QRadioButton::toggled, headersGroupBox, &QGroupBox::setEnabled);
+    connect(delimitedRadioButton, &QRadioButton::toggled, quoteGroupBox, &QGroupBox::setEnabled);
+    connect(delimitedRadioButton, &QRadioButton::toggled, delimitersGroupBox, &QGroupBox::setEnabled);
 }
 
 void ExportFormatPage::initializePage()
 {
+    delimitedRadioButton->setChecked(true);
     exportColumnNamesCheckBox->setChecked(true);
     exportLineNumbersCheckBox->setChecked(false);
     quoteStringsCheckBox->setChecked(false);
@@ -174,6 +196,10 @@ void ExportFormatPage::initializePage()
 
 bool ExportFormatPage::validatePage()
 {
+    if (jsonLinesRadioButton->isChecked()) {
+        return true;
+    }
+
     if ((quoteStringsCheckBox->isChecked() && quoteStringsLine->text().isEmpty())
         || (quoteNumbersCheckBox->isChecked() && quoteNumbersLine->text().isEmpty())) {
         return false;
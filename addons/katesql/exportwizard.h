@@ -46,6 +46,8 @@ public:
     bool validatePage() override;
 
 private:
+    QRadioButton *delimitedRadioButton;
+    QRadioButton *jsonLinesRadioButton;
     QCheckBox *exportColumnNamesCheckBox;
     QCheckBox *exportLineNumbersCheckBox;
     QCheckBox *quoteStringsCheckBox;
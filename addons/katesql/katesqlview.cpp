@@ -12,6 +12,7 @@
 #include "outputwidget.h"
 #include "schemabrowserwidget.h"
 #include "schemawidget.h"
+#include "sqlcompletionmodel.h"
 #include "sqlmanager.h"
 #include "textoutputwidget.h"
 
@@ -25,13 +26,15 @@
 #include <KConfig>
 #include <KConfigGroup>
 #include <KLocalizedString>
+#include <KMessageBox>
 #include <KSharedConfig>
 #include <KXMLGUIFactory>
 #include <QAction>
 
 #include <QActionGroup>
 #include <QMenu>
-#include <QSqlQuery>
+#include <QProgressDialog>
+#include <QSqlRecord>
 #include <QString>
 #include <QWidgetAction>
 
@@ -77,11 +80,28 @@ KateSQLView::KateSQLView(KTextEditor::Plugin *plugin, KTextEditor::MainWindow *m
     connect(m_connectionsGroup, &QActionGroup::triggered, this, &KateSQLView::slotConnectionSelectedFromMenu);
     connect(m_manager, &SQLManager::error, this, &KateSQLView::slotError);
     connect(m_manager, &SQLManager::success, this, &KateSQLView::slotSuccess);
-    connect(m_manager, &SQLManager::queryActivated, this, &KateSQLView::slotQueryActivated);
+    connect(m_manager, &SQLManager::queryStarted, this, &KateSQLView::slotQueryRunning);
+    connect(m_manager, &SQLManager::queryFinished, this, &KateSQLView::slotQueryRunning);
+    connect(m_manager, &SQLManager::queryColumns, this, &KateSQLView::slotQueryColumns);
+    connect(m_manager, &SQLManager::queryRows, m_outputWidget->dataOutputWidget(), &DataOutputWidget::appendRows);
+    connect(m_manager, &SQLManager::exportProgress, this, &KateSQLView::slotExportProgress);
+    connect(m_manager, &SQLManager::exportData, this, &KateSQLView::slotExportData);
+    connect(m_manager, &SQLManager::exportFinished, this, &KateSQLView::slotExportFinished);
+    connect(m_outputWidget->dataOutputWidget(), &DataOutputWidget::exportRequested, this, &KateSQLView::slotExportRequested);
     connect(m_manager, &SQLManager::connectionCreated, this, &KateSQLView::slotConnectionCreated);
     connect(m_manager, &SQLManager::connectionAboutToBeClosed, this, &KateSQLView::slotConnectionAboutToBeClosed);
     connect(m_connectionsComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &KateSQLView::slotConnectionChanged);
 
+    // table and column names in SQL documents
+    m_completion = new SQLCompletionModel(m_manager->schemaCache(), this);
+    connect(m_mainWindow, &KTextEditor::MainWindow::viewCreated, this, [this](KTextEditor::View *view) {
+        view->registerCompletionModel(m_completion);
+    });
+    const auto views = m_mainWindow->views();
+    for (KTextEditor::View *view : views) {
+        view->registerCompletionModel(m_completion);
+    }
+
     stateChanged(QStringLiteral("has_connection_selected"), KXMLGUIClient::StateReverse);
 }
 
@@ -89,6 +109,11 @@ KateSQLView::~KateSQLView()
 {
     m_mainWindow->guiFactory()->removeClient(this);
 
+    const auto views = m_mainWindow->views();
+    for (KTextEditor::View *view : views) {
+        view->unregisterCompletionModel(m_completion);
+    }
+
     delete m_outputToolView;
     delete m_schemaBrowserToolView;
 
@@ -130,12 +155,12 @@ void KateSQLView::setupActions()
     action->setIcon(QIcon::fromTheme(QStringLiteral("quickopen")));
     connect(action, &QAction::triggered, this, &KateSQLView::slotRunQuery);
 
-    /// TODO: stop sql query
-    //   action = collection->addAction("sql_stop");
-    //   action->setText( i18n("Stop query") );
-    //   action->setIcon( KIcon("process-stop") );
-    //   action->setShortcut( QKeySequence(Qt::ALT | Qt::Key_F5) );
-    //   connect( action , SIGNAL(triggered()) , this , SLOT(stopQuery()));
+    action = collection->addAction(QStringLiteral("query_stop"));
+    action->setText(i18nc("@action:inmenu", "Stop Query"));
+    action->setIcon(QIcon::fromTheme(QStringLiteral("process-stop")));
+    collection->setDefaultShortcut(action, QKeySequence(Qt::ALT | Qt::Key_F5));
+    action->setEnabled(false);
+    connect(action, &QAction::triggered, this, &KateSQLView::slotStopQuery);
 }
 
 void KateSQLView::slotSQLMenuAboutToShow()
@@ -180,6 +205,7 @@ void KateSQLView::slotConnectionChanged(int index)
         stateChanged(QStringLiteral("has_connection_selected"), (connection.isEmpty()) ? KXMLGUIClient::StateReverse : KXMLGUIClient::StateNoReverse);
 
         m_schemaBrowserWidget->schemaWidget()->buildTree(connection);
+        m_completion->setConnection(connection);
     }
 }
 
@@ -282,8 +308,6 @@ void KateSQLView::slotConnectionReconnect()
 
 void KateSQLView::slotConnectionAboutToBeClosed(const QString &name)
 {
-    /// must delete the QSqlQuery object inside the model before closing connection
-
     if (name == m_currentResultsetConnection) {
         m_outputWidget->dataOutputWidget()->clearResults();
     }
@@ -317,6 +341,93 @@ void KateSQLView::slotRunQuery()
     m_manager->runQuery(text, connection);
 }
 
+void KateSQLView::slotStopQuery()
+{
+    m_manager->stopQuery();
+}
+
+void KateSQLView::slotQueryRunning()
+{
+    action(QStringLiteral("query_stop"))->setEnabled(m_manager->isQueryRunning());
+    m_outputWidget->dataOutputWidget()->setFetching(m_manager->isQueryRunning());
+}
+
+void KateSQLView::slotExportRequested(DataOutputWidget::ExportTarget target, const QString &fileName, const ResultExporter::Options &options)
+{
+    DataOutputWidget *dataOutput = m_outputWidget->dataOutputWidget();
+
+    if (!m_manager->canExportResult()) {
+        dataOutput->exportFetchedRows(target, fileName, options);
+        return;
+    }
+
+    const auto answer = KMessageBox::questionTwoActionsCancel(m_mainWindow->window(),
+                                                              i18nc("@info",
+                                                                    "Not all rows of the result have been fetched yet.\n"
+                                                                    "Run the query again to export all of its rows? "
+                                                                    "The rows it returns now may differ from the ones shown."),
+                                                              i18nc("@title:window", "Export"),
+                                                              KGuiItem(i18nc("@action:button", "Run Query Again"), QStringLiteral("view-refresh")),
+                                                              KGuiItem(i18nc("@action:button", "Export Fetched Rows"), QStringLiteral("document-export")));
+
+    if (answer == KMessageBox::Cancel) {
+        return;
+    }
+
+    if (answer == KMessageBox::SecondaryAction) {
+        dataOutput->exportFetchedRows(target, fileName, options);
+        return;
+    }
+
+    // the export takes over, the grid keeps the rows it has
+    m_manager->stopQuery();
+
+    m_exportTarget = target;
+    m_exportData.clear();
+
+    if (!m_exportProgress) {
+        m_exportProgress = new QProgressDialog(m_mainWindow->window());
+        m_exportProgress->setWindowTitle(i18nc("@title:window", "Export"));
+        m_exportProgress->setMinimumDuration(500);
+        // busy until the export finished, the value stays at the maximum
+        m_exportProgress->setRange(0, 0);
+        m_exportProgress->setAutoReset(false);
+        connect(m_exportProgress, &QProgressDialog::canceled, m_manager, &SQLManager::stopExport);
+    }
+
+    // shows up unless the export is done quickly
+    m_exportProgress->setLabelText(i18nc("@info", "Exporting the result…"));
+    m_exportProgress->setValue(0);
+
+    // the query runs again, all rows are exported and not only the ones fetched so far
+    m_manager->exportResult(target == DataOutputWidget::ExportTarget::File ? fileName : QString(), options);
+}
+
+void KateSQLView::slotExportProgress(qint64 rows)
+{
+    if (m_exportProgress) {
+        m_exportProgress->setLabelText(i18ncp("@info", "Exported %1 row…", "Exported %1 rows…", rows));
+    }
+}
+
+void KateSQLView::slotExportData(const QByteArray &data)
+{
+    m_exportData.append(data);
+}
+
+void KateSQLView::slotExportFinished(bool success)
+{
+    if (m_exportProgress) {
+        m_exportProgress->reset();
+    }
+
+    if (success) {
+        m_outputWidget->dataOutputWidget()->writeExport(m_exportTarget, m_exportData);
+    }
+
+    m_exportData.clear();
+}
+
 void KateSQLView::slotError(const QString &message)
 {
     m_outputWidget->textOutputWidget()->showErrorMessage(message);
@@ -331,15 +442,13 @@ void KateSQLView::slotSuccess(const QString &message)
     m_mainWindow->showToolView(m_outputToolView);
 }
 
-void KateSQLView::slotQueryActivated(QSqlQuery &query, const QString &connection)
+void KateSQLView::slotQueryColumns(const QSqlRecord &columns, const QString &connection)
 {
-    if (query.isSelect()) {
-        m_currentResultsetConnection = connection;
+    m_currentResultsetConnection = connection;
 
-        m_outputWidget->dataOutputWidget()->showQueryResultSets(query);
-        m_outputWidget->setCurrentWidget(m_outputWidget->dataOutputWidget());
-        m_mainWindow->showToolView(m_outputToolView);
-    }
+    m_outputWidget->dataOutputWidget()->showQueryResult(columns);
+    m_outputWidget->setCurrentWidget(m_outputWidget->dataOutputWidget());
+    m_mainWindow->showToolView(m_outputToolView);
 }
 
 void KateSQLView::slotConnectionCreated(const QString &name)
@@ -21,14 +21,19 @@
 class KateSQLOutputWidget;
 class SchemaBrowserWidget;
 class SQLManager;
+class SQLCompletionModel;
 
 class KConfigBase;
 class KComboBox;
 
-class QSqlQuery;
+class QSqlRecord;
 class QActionGroup;
+class QProgressDialog;
+
+#include "dataoutputwidget.h"
 
 #include <KXMLGUIClient>
+#include <QPointer>
 
 #include <ktexteditor/mainwindow.h>
 #include <ktexteditor/sessionconfiginterface.h>
@@ -56,9 +61,15 @@ public Q_SLOTS:
     void slotConnectionReconnect();
     void slotConnectionChanged(int currentIndex);
     void slotRunQuery();
+    void slotStopQuery();
     void slotError(const QString &message);
     void slotSuccess(const QString &message);
-    void slotQueryActivated(QSqlQuery &query, const QString &connection);
+    void slotQueryColumns(const QSqlRecord &columns, const QString &connection);
+    void slotQueryRunning();
+    void slotExportRequested(DataOutputWidget::ExportTarget target, const QString &fileName, const ResultExporter::Options &options);
+    void slotExportProgress(qint64 rows);
+    void slotExportData(const QByteArray &data);
+    void slotExportFinished(bool success);
     void slotConnectionCreated(const QString &name);
     void slotGlobalSettingsChanged();
     void slotSQLMenuAboutToShow();
@@ -83,5 +94,11 @@ private:
 
     QString m_currentResultsetConnection;
 
+    QPointer<QProgressDialog> m_exportProgress;
+    DataOutputWidget::ExportTarget m_exportTarget = DataOutputWidget::ExportTarget::Document;
+    QByteArray m_exportData;
+
+    SQLCompletionModel *m_completion;
+
     KTextEditor::MainWindow *m_mainWindow;
 };
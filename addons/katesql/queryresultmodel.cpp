@@ -0,0 +1,89 @@
+/*
+SPDX-FileCopyrightText: 2010 Marco Mentasti <marcomentasti@gmail.com>
+
+SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#include "queryresultmodel.h"
+
+QueryResultModel::QueryResultModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int QueryResultModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.rowCount();
+}
+
+int QueryResultModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_columns.count();
+}
+
+QVariant QueryResultModel::data(const QModelIndex &item, int role) const
+{
+    if (!item.isValid()) {
+        return QVariant();
+    }
+
+    if (role != Qt::DisplayRole && role != Qt::EditRole) {
+        return QVariant();
+    }
+
+    return m_rows.value(item.row(), item.column());
+}
+
+QVariant QueryResultModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < m_columns.count()) {
+        return m_columns.fieldName(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+QSqlRecord QueryResultModel::record() const
+{
+    return m_columns;
+}
+
+const ResultStore &QueryResultModel::rows() const
+{
+    return m_rows;
+}
+
+void QueryResultModel::setColumns(const QSqlRecord &columns)
+{
+    beginResetModel();
+
+    m_columns = columns;
+    m_rows.clear();
+
+    endResetModel();
+}
+
+void QueryResultModel::appendRows(const ResultChunk &rows)
+{
+    if (rows.rowCount() == 0) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), m_rows.rowCount(), m_rows.rowCount() + rows.rowCount() - 1);
+
+    m_rows.append(rows);
+
+    endInsertRows();
+}
+
+void QueryResultModel::clear()
+{
+    beginResetModel();
+
+    m_columns.clear();
+    m_rows.clear();
+
+    endResetModel();
+}
+
+#include "moc_queryresultmodel.cpp"
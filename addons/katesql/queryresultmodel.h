@@ -0,0 +1,37 @@
+/*
+SPDX-FileCopyrightText: 2010 Marco Mentasti <marcomentasti@gmail.com>
+
+SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#pragma once
+
+#include "resultstore.h"
+
+#include <QAbstractTableModel>
+#include <QSqlRecord>
+
+/// the result of a query, filled with the rows as the worker fetches them
+class QueryResultModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit QueryResultModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &item, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    QSqlRecord record() const;
+    /// the rows fetched so far
+    const ResultStore &rows() const;
+
+    void setColumns(const QSqlRecord &columns);
+    void appendRows(const ResultChunk &rows);
+    void clear();
+
+private:
+    QSqlRecord m_columns;
+    ResultStore m_rows;
+};
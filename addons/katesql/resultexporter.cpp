@@ -0,0 +1,215 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "resultexporter.h"
+
+#include <QLocale>
+
+#include <cmath>
+
+// the types exported as numbers, like the numeric and boolean ones of the result grid
+static bool isNumber(const QVariant &value)
+{
+    return value.typeId() < QMetaType::QChar;
+}
+
+static void appendQuoted(QByteArrayView text, char quote, QByteArray &out)
+{
+    out.append(quote);
+    for (const char c : text) {
+        // a quote in the text is doubled, as in RFC 4180
+        if (c == quote) {
+            out.append(quote);
+        }
+        out.append(c);
+    }
+    out.append(quote);
+}
+
+static void appendJsonString(QByteArrayView text, QByteArray &out)
+{
+    static constexpr char Hex[] = "0123456789abcdef";
+
+    out.append('"');
+    for (const char c : text) {
+        switch (c) {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        default:
+            if (uchar(c) < 0x20) {
+                out.append("\\u00");
+                out.append(Hex[uchar(c) >> 4]);
+                out.append(Hex[uchar(c) & 0xf]);
+            } else {
+                out.append(c);
+            }
+        }
+    }
+    out.append('"');
+}
+
+static void appendText(const QVariant &value, QByteArray &out)
+{
+    // an empty field, a null number would convert to 0
+    if (value.isNull()) {
+        return;
+    }
+
+    switch (value.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+        out.append(QByteArray::number(value.toLongLong()));
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULongLong:
+        out.append(QByteArray::number(value.toULongLong()));
+        break;
+    case QMetaType::QByteArray:
+        out.append(value.toByteArray());
+        break;
+    default:
+        out.append(value.toString().toUtf8());
+    }
+}
+
+ResultExporter::ResultExporter(const QSqlRecord &columns, const Options &options)
+    : m_options(options)
+    , m_delimiter(options.fieldDelimiter.toUtf8())
+{
+    for (int i = 0; i < columns.count(); ++i) {
+        m_names.append(columns.fieldName(i));
+
+        QByteArray key;
+        appendJsonString(columns.fieldName(i).toUtf8(), key);
+        key.append(':');
+        m_jsonKeys.append(key);
+    }
+}
+
+void ResultExporter::appendHeader(QByteArray &out) const
+{
+    if (m_options.format != Format::Delimited || !m_options.columnNames) {
+        return;
+    }
+
+    if (m_options.lineNumbers) {
+        out.append(m_delimiter);
+    }
+
+    for (qsizetype i = 0; i < m_names.size(); ++i) {
+        if (i > 0) {
+            out.append(m_delimiter);
+        }
+
+        if (!m_options.stringsQuoteChar.isNull()) {
+            appendQuoted(m_names.at(i).toUtf8(), m_options.stringsQuoteChar.toLatin1(), out);
+        } else {
+            out.append(m_names.at(i).toUtf8());
+        }
+    }
+    out.append('\n');
+}
+
+void ResultExporter::appendRow(const QVariantList &row, QByteArray &out)
+{
+    ++m_line;
+
+    if (m_options.format == Format::JsonLines) {
+        appendJson(row, out);
+    } else {
+        appendDelimited(row, out);
+    }
+}
+
+void ResultExporter::appendDelimited(const QVariantList &row, QByteArray &out) const
+{
+    if (m_options.lineNumbers) {
+        out.append(QByteArray::number(m_line));
+        out.append(m_delimiter);
+    }
+
+    for (qsizetype i = 0; i < row.size(); ++i) {
+        if (i > 0) {
+            out.append(m_delimiter);
+        }
+
+        const QVariant &value = row.at(i);
+        const QChar quote = isNumber(value) ? m_options.numbersQuoteChar : m_options.stringsQuoteChar;
+
+        if (quote.isNull()) {
+            appendText(value, out);
+        } else if (value.isNull()) {
+            // no need to double anything
+            out.append(quote.toLatin1());
+            out.append(quote.toLatin1());
+        } else {
+            QByteArray text;
+            appendText(value, text);
+            appendQuoted(text, quote.toLatin1(), out);
+        }
+    }
+    out.append('\n');
+}
+
+void ResultExporter::appendJson(const QVariantList &row, QByteArray &out) const
+{
+    out.append('{');
+
+    for (qsizetype i = 0; i < row.size(); ++i) {
+        if (i > 0) {
+            out.append(',');
+        }
+        out.append(m_jsonKeys.at(i));
+
+        const QVariant &value = row.at(i);
+        if (value.isNull()) {
+            out.append("null");
+            continue;
+        }
+
+        switch (value.typeId()) {
+        case QMetaType::Bool:
+            out.append(value.toBool() ? "true" : "false");
+            break;
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            appendText(value, out);
+            break;
+        case QMetaType::Double:
+        case QMetaType::Float: {
+            const double d = value.toDouble();
+            if (std::isfinite(d)) {
+                out.append(QByteArray::number(d, 'g', QLocale::FloatingPointShortest));
+            } else {
+                out.append("null");
+            }
+            break;
+        }
+        case QMetaType::QByteArray:
+            appendJsonString(value.toByteArray().toBase64(), out);
+            break;
+        default:
+            appendJsonString(value.toString().toUtf8(), out);
+        }
+    }
+
+    out.append("}\n");
+}
@@ -0,0 +1,61 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QChar>
+#include <QMetaType>
+#include <QSqlRecord>
+#include <QString>
+#include <QVariantList>
+
+/**
+ * Formats rows of a result as delimited text, like CSV or TSV, or as JSON Lines.
+ *
+ * The rows are appended to a buffer in UTF-8, the caller writes it out in large blocks.
+ */
+class ResultExporter
+{
+public:
+    enum class Format { Delimited, JsonLines };
+
+    struct Options {
+        Format format = Format::Delimited;
+        QString fieldDelimiter = QStringLiteral("\t");
+        // a null character quotes nothing
+        QChar stringsQuoteChar;
+        QChar numbersQuoteChar;
+        bool columnNames = false;
+        bool lineNumbers = false;
+    };
+
+    ResultExporter(const QSqlRecord &columns, const Options &options);
+
+    /**
+     * The column names if they are exported, comes first.
+     */
+    void appendHeader(QByteArray &out) const;
+
+    /**
+     * @p row must have a value for each column.
+     */
+    void appendRow(const QVariantList &row, QByteArray &out);
+
+private:
+    void appendDelimited(const QVariantList &row, QByteArray &out) const;
+    void appendJson(const QVariantList &row, QByteArray &out) const;
+
+private:
+    const Options m_options;
+    const QByteArray m_delimiter;
+    QStringList m_names;
+    // the quoted JSON names, with their colon
+    QList<QByteArray> m_jsonKeys;
+    qint64 m_line = 0;
+};
+
+Q_DECLARE_METATYPE(ResultExporter::Options)
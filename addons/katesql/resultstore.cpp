@@ -0,0 +1,367 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "resultstore.h"
+
+#include <QBitArray>
+#include <QDataStream>
+#include <QDebug>
+#include <QSqlField>
+#include <QTemporaryFile>
+
+#include <algorithm>
+
+// how many spilled chunks are kept after reading them back
+static constexpr size_t LoadedChunks = 8;
+
+static bool isInteger(int typeId)
+{
+    switch (typeId) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Long:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool isReal(int typeId)
+{
+    return typeId == QMetaType::Double || typeId == QMetaType::Float;
+}
+
+// BEGIN ResultChunk
+
+ResultChunk::ResultChunk(const QSqlRecord &columns)
+{
+    m_columns.resize(columns.count());
+
+    for (int i = 0; i < columns.count(); ++i) {
+        Column &column = m_columns[i];
+        column.metaType = columns.field(i).metaType();
+
+        const int typeId = column.metaType.id();
+        if (isInteger(typeId) && typeId != QMetaType::ULongLong) {
+            column.type = Column::Integer;
+        } else if (isReal(typeId)) {
+            column.type = Column::Real;
+        } else if (typeId == QMetaType::QString) {
+            column.type = Column::Text;
+        }
+    }
+}
+
+void ResultChunk::appendRow(const QVariantList &row)
+{
+    Q_ASSERT(row.size() == columnCount());
+
+    for (int i = 0; i < columnCount(); ++i) {
+        m_columns[i].append(row.at(i));
+    }
+    ++m_rowCount;
+}
+
+QVariant ResultChunk::value(int row, int column) const
+{
+    return m_columns[column].value(row);
+}
+
+qint64 ResultChunk::bytes() const
+{
+    qint64 bytes = 0;
+
+    for (const Column &column : m_columns) {
+        bytes += column.integers.size() * sizeof(qint64);
+        bytes += column.reals.size() * sizeof(double);
+        bytes += column.text.size() * sizeof(QChar) + column.textEnds.size() * sizeof(qsizetype);
+        bytes += column.nulls.size() / 8;
+
+        for (const QVariant &value : column.variants) {
+            bytes += sizeof(QVariant);
+            if (value.typeId() == QMetaType::QString) {
+                bytes += value.toString().size() * sizeof(QChar);
+            } else if (value.typeId() == QMetaType::QByteArray) {
+                bytes += value.toByteArray().size();
+            }
+        }
+    }
+
+    return bytes;
+}
+
+void ResultChunk::write(QDataStream &stream) const
+{
+    stream << qint32(m_rowCount) << qint32(m_columns.size());
+
+    for (const Column &column : m_columns) {
+        QBitArray nulls(column.nulls.size());
+        for (size_t i = 0; i < column.nulls.size(); ++i) {
+            nulls.setBit(i, column.nulls[i]);
+        }
+
+        stream << quint8(column.type) << qint32(column.metaType.id()) << nulls;
+
+        switch (column.type) {
+        case Column::Integer:
+            stream << column.integers;
+            break;
+        case Column::Real:
+            stream << column.reals;
+            break;
+        case Column::Text:
+            stream << column.text << column.textEnds;
+            break;
+        case Column::Variant:
+            stream << column.variants;
+            break;
+        }
+    }
+}
+
+void ResultChunk::read(QDataStream &stream)
+{
+    qint32 rowCount = 0;
+    qint32 columnCount = 0;
+    stream >> rowCount >> columnCount;
+
+    m_rowCount = rowCount;
+    m_columns.assign(columnCount, Column());
+
+    for (Column &column : m_columns) {
+        quint8 type = 0;
+        qint32 typeId = 0;
+        QBitArray nulls;
+        stream >> type >> typeId >> nulls;
+
+        column.type = Column::Type(type);
+        column.metaType = QMetaType(typeId);
+        column.nulls.resize(nulls.size());
+        for (qsizetype i = 0; i < nulls.size(); ++i) {
+            column.nulls[i] = nulls.testBit(i);
+        }
+
+        switch (column.type) {
+        case Column::Integer:
+            stream >> column.integers;
+            break;
+        case Column::Real:
+            stream >> column.reals;
+            break;
+        case Column::Text:
+            stream >> column.text >> column.textEnds;
+            break;
+        case Column::Variant:
+            stream >> column.variants;
+            break;
+        }
+    }
+}
+
+void ResultChunk::Column::append(const QVariant &value)
+{
+    const bool null = value.isNull();
+    const int typeId = value.typeId();
+
+    // a value the column can't hold unboxed
+    if ((type == Integer && !null && (!isInteger(typeId) || typeId == QMetaType::ULongLong))
+        || (type == Real && !null && !isReal(typeId) && !isInteger(typeId)) || (type == Text && !null && typeId != QMetaType::QString)) {
+        toVariants();
+    }
+
+    nulls.push_back(null);
+
+    switch (type) {
+    case Integer:
+        integers.append(null ? 0 : value.toLongLong());
+        break;
+    case Real:
+        reals.append(null ? 0.0 : value.toDouble());
+        break;
+    case Text:
+        if (!null) {
+            text.append(value.toString());
+        }
+        textEnds.append(text.size());
+        break;
+    case Variant:
+        variants.append(value);
+        break;
+    }
+}
+
+QVariant ResultChunk::Column::value(int row) const
+{
+    if (nulls[row]) {
+        return type == Variant ? variants.at(row) : QVariant(metaType);
+    }
+
+    switch (type) {
+    case Integer:
+        return QVariant::fromValue(integers.at(row));
+    case Real:
+        return reals.at(row);
+    case Text: {
+        const qsizetype begin = row > 0 ? textEnds.at(row - 1) : 0;
+        return text.mid(begin, textEnds.at(row) - begin);
+    }
+    case Variant:
+        break;
+    }
+
+    return variants.at(row);
+}
+
+void ResultChunk::Column::toVariants()
+{
+    QVariantList values;
+    values.reserve(qsizetype(nulls.size()) + 1);
+    for (size_t row = 0; row < nulls.size(); ++row) {
+        values.append(value(int(row)));
+    }
+
+    type = Variant;
+    integers.clear();
+    reals.clear();
+    text.clear();
+    textEnds.clear();
+    variants = std::move(values);
+}
+
+// END ResultChunk
+
+// BEGIN ResultStore
+
+ResultStore::ResultStore(qint64 memoryLimit)
+    : m_memoryLimit(memoryLimit)
+{
+}
+
+ResultStore::~ResultStore() = default;
+
+void ResultStore::append(const ResultChunk &chunk)
+{
+    if (chunk.rowCount() == 0) {
+        return;
+    }
+
+    Entry &entry = m_entries.emplace_back();
+    entry.firstRow = m_rowCount;
+    entry.bytes = chunk.bytes();
+    entry.chunk = std::make_shared<const ResultChunk>(chunk);
+
+    m_rowCount += chunk.rowCount();
+    m_memoryUsage += entry.bytes;
+
+    if (m_memoryUsage > m_memoryLimit) {
+        spill();
+    }
+}
+
+void ResultStore::clear()
+{
+    m_entries.clear();
+    m_loaded.clear();
+    m_spillFile.reset();
+    m_rowCount = 0;
+    m_memoryUsage = 0;
+}
+
+QVariant ResultStore::value(int row, int column) const
+{
+    if (row < 0 || row >= m_rowCount) {
+        return QVariant();
+    }
+
+    auto it = std::upper_bound(m_entries.begin(), m_entries.end(), row, [](int target, const Entry &entry) {
+        return target < entry.firstRow;
+    });
+    const Entry &entry = *std::prev(it);
+
+    const auto chunk = entry.chunk ? entry.chunk : load(entry);
+    if (!chunk || column < 0 || column >= chunk->columnCount()) {
+        return QVariant();
+    }
+
+    return chunk->value(row - entry.firstRow, column);
+}
+
+int ResultStore::spilledChunks() const
+{
+    return int(std::count_if(m_entries.begin(), m_entries.end(), [](const Entry &entry) {
+        return !entry.chunk;
+    }));
+}
+
+void ResultStore::spill()
+{
+    if (!m_spillFile) {
+        m_spillFile = std::make_unique<QTemporaryFile>();
+        if (!m_spillFile->open()) {
+            qDebug() << "can't spill query results to disk:" << m_spillFile->errorString();
+            m_spillFile.reset();
+            return;
+        }
+    }
+
+    QDataStream stream(m_spillFile.get());
+
+    // the newest chunk stays, it is the one shown while fetching
+    for (size_t i = 0; i + 1 < m_entries.size() && m_memoryUsage > m_memoryLimit; ++i) {
+        Entry &entry = m_entries[i];
+        if (!entry.chunk) {
+            continue;
+        }
+
+        m_spillFile->seek(m_spillFile->size());
+        entry.offset = m_spillFile->pos();
+        entry.chunk->write(stream);
+        if (stream.status() != QDataStream::Ok) {
+            qDebug() << "can't spill query results to disk:" << m_spillFile->errorString();
+            entry.offset = -1;
+            return;
+        }
+
+        entry.chunk.reset();
+        m_memoryUsage -= entry.bytes;
+    }
+
+    m_spillFile->flush();
+}
+
+std::shared_ptr<const ResultChunk> ResultStore::load(const Entry &entry) const
+{
+    auto cached = std::find_if(m_loaded.begin(), m_loaded.end(), [&entry](const auto &loaded) {
+        return loaded.first == entry.offset;
+    });
+    if (cached != m_loaded.end()) {
+        return cached->second;
+    }
+
+    if (!m_spillFile || !m_spillFile->seek(entry.offset)) {
+        return nullptr;
+    }
+
+    auto chunk = std::make_shared<ResultChunk>();
+    QDataStream stream(m_spillFile.get());
+    chunk->read(stream);
+
+    m_loaded.emplace_front(entry.offset, chunk);
+    if (m_loaded.size() > LoadedChunks) {
+        m_loaded.pop_back();
+    }
+
+    return chunk;
+}
+
+// END ResultStore
@@ -0,0 +1,139 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QMetaType>
+#include <QSqlRecord>
+#include <QString>
+#include <QVariant>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QDataStream;
+class QTemporaryFile;
+
+/**
+ * A batch of rows of a result, stored per column.
+ *
+ * Integer, real and text columns keep their values unboxed, a column that gets a value of another
+ * type than its field announced falls back to variants.
+ */
+class ResultChunk
+{
+public:
+    explicit ResultChunk(const QSqlRecord &columns = QSqlRecord());
+
+    int rowCount() const
+    {
+        return m_rowCount;
+    }
+
+    int columnCount() const
+    {
+        return int(m_columns.size());
+    }
+
+    /**
+     * @p row must have a value for each column.
+     */
+    void appendRow(const QVariantList &row);
+
+    QVariant value(int row, int column) const;
+
+    /**
+     * Roughly the memory the values take, in bytes.
+     */
+    qint64 bytes() const;
+
+    void write(QDataStream &stream) const;
+    void read(QDataStream &stream);
+
+private:
+    struct Column {
+        enum Type : quint8 { Integer, Real, Text, Variant };
+
+        Type type = Variant;
+        // the type of the nulls
+        QMetaType metaType;
+        QList<qint64> integers;
+        QList<double> reals;
+        // all texts in one, each ends at its offset
+        QString text;
+        QList<qsizetype> textEnds;
+        QVariantList variants;
+        std::vector<bool> nulls;
+
+        void append(const QVariant &value);
+        QVariant value(int row) const;
+        void toVariants();
+    };
+
+    std::vector<Column> m_columns;
+    int m_rowCount = 0;
+};
+
+Q_DECLARE_METATYPE(ResultChunk)
+
+/**
+ * All rows of a result, in the chunks they were fetched in.
+ *
+ * Once the chunks take more memory than the limit, the oldest ones are written to a temporary
+ * file. They are read back on access, a few of them stay cached.
+ */
+class ResultStore
+{
+public:
+    static constexpr qint64 DefaultMemoryLimit = 256 * 1024 * 1024;
+
+    explicit ResultStore(qint64 memoryLimit = DefaultMemoryLimit);
+    ~ResultStore();
+
+    void append(const ResultChunk &chunk);
+    void clear();
+
+    int rowCount() const
+    {
+        return m_rowCount;
+    }
+
+    QVariant value(int row, int column) const;
+
+    /**
+     * The memory the chunks not written to disk take, in bytes.
+     */
+    qint64 memoryUsage() const
+    {
+        return m_memoryUsage;
+    }
+
+    int spilledChunks() const;
+
+private:
+    struct Entry {
+        int firstRow = 0;
+        qint64 bytes = 0;
+        // null once spilled
+        std::shared_ptr<const ResultChunk> chunk;
+        qint64 offset = -1;
+    };
+
+    void spill();
+    std::shared_ptr<const ResultChunk> load(const Entry &entry) const;
+
+private:
+    const qint64 m_memoryLimit;
+    std::vector<Entry> m_entries;
+    int m_rowCount = 0;
+    qint64 m_memoryUsage = 0;
+    std::unique_ptr<QTemporaryFile> m_spillFile;
+
+    // the spilled chunks read last, by offset
+    mutable std::deque<std::pair<qint64, std::shared_ptr<const ResultChunk>>> m_loaded;
+};
@@ -0,0 +1,93 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "schemacache.h"
+
+#include <QSqlDatabase>
+
+QStringList SchemaCache::tables(const QString &connection, QSql::TableType type)
+{
+    Schema &schema = m_schemas[connection];
+
+    const auto it = schema.tables.constFind(type);
+    if (it != schema.tables.cend()) {
+        return it.value();
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(connection, false);
+    if (!db.isOpen()) {
+        return {};
+    }
+
+    const QStringList tables = db.tables(type);
+    schema.tables.insert(type, tables);
+    return tables;
+}
+
+std::optional<SchemaCache::Table> SchemaCache::table(const QString &connection, const QString &table)
+{
+    Schema &schema = m_schemas[connection];
+
+    const auto it = schema.fields.constFind(table);
+    if (it != schema.fields.cend()) {
+        return it.value();
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(connection, false);
+    if (!db.isOpen()) {
+        return std::nullopt;
+    }
+
+    const Table loaded{db.record(table), db.primaryIndex(table)};
+    schema.fields.insert(table, loaded);
+    return loaded;
+}
+
+QSqlRecord SchemaCache::record(const QString &connection, const QString &table)
+{
+    const std::optional<Table> t = this->table(connection, table);
+    return t ? t->record : QSqlRecord();
+}
+
+QSqlIndex SchemaCache::primaryIndex(const QString &connection, const QString &table)
+{
+    const std::optional<Table> t = this->table(connection, table);
+    return t ? t->primaryIndex : QSqlIndex();
+}
+
+QStringList SchemaCache::loadedTables(const QString &connection) const
+{
+    const auto it = m_schemas.constFind(connection);
+    if (it == m_schemas.cend()) {
+        return {};
+    }
+
+    QStringList tables;
+    for (const QSql::TableType type : {QSql::Tables, QSql::Views}) {
+        tables += it->tables.value(type);
+    }
+    return tables;
+}
+
+QHash<QString, QSqlRecord> SchemaCache::loadedRecords(const QString &connection) const
+{
+    QHash<QString, QSqlRecord> records;
+
+    const auto it = m_schemas.constFind(connection);
+    if (it == m_schemas.cend()) {
+        return records;
+    }
+
+    for (auto t = it->fields.cbegin(); t != it->fields.cend(); ++t) {
+        records.insert(t.key(), t->record);
+    }
+    return records;
+}
+
+void SchemaCache::invalidate(const QString &connection)
+{
+    m_schemas.remove(connection);
+}
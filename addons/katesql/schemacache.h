@@ -0,0 +1,62 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QSqlIndex>
+#include <QSqlRecord>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+/**
+ * The schema of the connections, asked from the server once and kept until refreshed.
+ *
+ * Everything is loaded on first use: the table names per type, the fields and primary key per
+ * table. The schema browser and the SQL completion share it, so neither asks the server again for
+ * what the other already loaded. Nothing is loaded from a connection that is not open.
+ */
+class SchemaCache
+{
+public:
+    QStringList tables(const QString &connection, QSql::TableType type);
+    QSqlRecord record(const QString &connection, const QString &table);
+    QSqlIndex primaryIndex(const QString &connection, const QString &table);
+
+    /**
+     * The tables and views as far as they are loaded, the server is not asked.
+     */
+    QStringList loadedTables(const QString &connection) const;
+
+    /**
+     * The fields of the tables that are loaded, by table.
+     */
+    QHash<QString, QSqlRecord> loadedRecords(const QString &connection) const;
+
+    /**
+     * Forget the schema of @p connection, the next use loads it again.
+     */
+    void invalidate(const QString &connection);
+
+private:
+    struct Table {
+        QSqlRecord record;
+        QSqlIndex primaryIndex;
+    };
+
+    struct Schema {
+        // by QSql::TableType
+        QHash<int, QStringList> tables;
+        QHash<QString, Table> fields;
+    };
+
+    std::optional<Table> table(const QString &connection, const QString &table);
+
+private:
+    QHash<QString, Schema> m_schemas;
+};
@@ -5,6 +5,7 @@
 */
 
 #include "schemawidget.h"
+#include "schemacache.h"
 #include "sqlmanager.h"
 
 #include <KLocalizedString>
@@ -76,6 +77,9 @@ void SchemaWidget::buildTree(const QString &connection)
 
 void SchemaWidget::refresh()
 {
+    // the only place the schema is asked from the server again
+    m_manager->schemaCache()->invalidate(m_connectionName);
+
     buildTree(m_connectionName);
 }
 
@@ -111,8 +115,8 @@ void SchemaWidget::buildTables(QTreeWidgetItem *tablesItem)
     systemTablesItem->setIcon(0, QIcon::fromTheme(QStringLiteral("folder")));
     systemTablesItem->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
 
-    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-    QStringList tables = db.tables(QSql::SystemTables);
+    SchemaCache *cache = m_manager->schemaCache();
+    QStringList tables = cache->tables(m_connectionName, QSql::SystemTables);
 
     for (const QString &table : std::as_const(tables)) {
         QTreeWidgetItem *item = new QTreeWidgetItem(systemTablesItem, SystemTableType);
@@ -121,7 +125,7 @@ void SchemaWidget::buildTables(QTreeWidgetItem *tablesItem)
         item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
     }
 
-    tables = db.tables(QSql::Tables);
+    tables = cache->tables(m_connectionName, QSql::Tables);
 
     for (const QString &table : std::as_const(tables)) {
         QTreeWidgetItem *item = new QTreeWidgetItem(tablesItem, TableType);
@@ -139,9 +143,7 @@ void SchemaWidget::buildViews(QTreeWidgetItem *viewsItem)
         return;
     }
 
-    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-
-    const QStringList views = db.tables(QSql::Views);
+    const QStringList views = m_manager->schemaCache()->tables(m_connectionName, QSql::Views);
 
     for (const QString &view : views) {
         QTreeWidgetItem *item = new QTreeWidgetItem(viewsItem, ViewType);
@@ -159,12 +161,12 @@ void SchemaWidget::buildFields(QTreeWidgetItem *tableItem)
         return;
     }
 
-    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    SchemaCache *cache = m_manager->schemaCache();
 
     QString tableName = tableItem->text(0);
 
-    QSqlIndex pk = db.primaryIndex(tableName);
-    QSqlRecord rec = db.record(tableName);
+    QSqlIndex pk = cache->primaryIndex(m_connectionName, tableName);
+    QSqlRecord rec = cache->record(m_connectionName, tableName);
 
     for (int i = 0; i < rec.count(); ++i) {
         QSqlField f = rec.field(i);
@@ -312,7 +314,7 @@ QString SchemaWidget::generateStatement(QSqlDriver::StatementType statementType)
     case ViewType: {
         QString tableName = item->text(0);
 
-        QSqlRecord rec = db.record(tableName);
+        QSqlRecord rec = m_manager->schemaCache()->record(m_connectionName, tableName);
 
         // set all fields to a value (NULL)
         // values are needed to generate update and insert statements
@@ -327,7 +329,7 @@ QString SchemaWidget::generateStatement(QSqlDriver::StatementType statementType)
 
     case FieldType: {
         QString tableName = item->parent()->text(0);
-        QSqlRecord rec = db.record(tableName);
+        QSqlRecord rec = m_manager->schemaCache()->record(m_connectionName, tableName);
 
         // get the selected column...
         QSqlField field = rec.field(item->text(0));
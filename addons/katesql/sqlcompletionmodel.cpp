@@ -0,0 +1,142 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "sqlcompletionmodel.h"
+#include "schemacache.h"
+
+#include <KTextEditor/Document>
+#include <KTextEditor/View>
+
+#include <QIcon>
+#include <QSqlRecord>
+
+SQLCompletionModel::SQLCompletionModel(SchemaCache *cache, QObject *parent)
+    : KTextEditor::CodeCompletionModel(parent)
+    , m_cache(cache)
+{
+}
+
+void SQLCompletionModel::setConnection(const QString &connection)
+{
+    m_connection = connection;
+}
+
+bool SQLCompletionModel::isSqlDocument(KTextEditor::Document *document)
+{
+    // SQL, SQL (MySQL), SQL (PostgreSQL)...
+    return document->mode().startsWith(QLatin1String("SQL"), Qt::CaseInsensitive);
+}
+
+void SQLCompletionModel::completionInvoked(KTextEditor::View *view, const KTextEditor::Range &range, InvocationType)
+{
+    beginResetModel();
+
+    m_matches.clear();
+
+    if (!m_connection.isEmpty() && isSqlDocument(view->document())) {
+        // loads the names of the tables once
+        const QStringList tables = m_cache->tables(m_connection, QSql::Tables) + m_cache->tables(m_connection, QSql::Views);
+
+        const QString table = qualifyingTable(view->document(), range.start());
+
+        if (!table.isEmpty()) {
+            appendFields(table, m_cache->record(m_connection, table));
+        } else {
+            for (const QString &name : tables) {
+                m_matches.push_back({Completion::Table, name, QString()});
+            }
+
+            // only the columns already known, not all tables are asked for theirs
+            const QHash<QString, QSqlRecord> records = m_cache->loadedRecords(m_connection);
+            for (auto it = records.cbegin(); it != records.cend(); ++it) {
+                appendFields(it.key(), it.value());
+            }
+        }
+    }
+
+    endResetModel();
+}
+
+void SQLCompletionModel::appendFields(const QString &table, const QSqlRecord &record)
+{
+    for (int i = 0; i < record.count(); ++i) {
+        m_matches.push_back({Completion::Field, record.fieldName(i), table});
+    }
+}
+
+QString SQLCompletionModel::qualifyingTable(KTextEditor::Document *document, const KTextEditor::Cursor &position)
+{
+    const QString line = document->line(position.line()).left(position.column());
+
+    if (!line.endsWith(QLatin1Char('.'))) {
+        return QString();
+    }
+
+    // the identifier before the dot, maybe quoted
+    qsizetype end = line.size() - 1;
+    if (end > 0 && (line.at(end - 1) == QLatin1Char('"') || line.at(end - 1) == QLatin1Char('`') || line.at(end - 1) == QLatin1Char(']'))) {
+        --end;
+    }
+
+    qsizetype start = end;
+    while (start > 0 && (line.at(start - 1).isLetterOrNumber() || line.at(start - 1) == QLatin1Char('_') || line.at(start - 1) == QLatin1Char('$'))) {
+        --start;
+    }
+
+    const QString name = line.mid(start, end - start);
+    if (name.isEmpty()) {
+        return QString();
+    }
+
+    // unquoted names are folded by the server, match them whatever their case
+    const QStringList tables = m_cache->loadedTables(m_connection);
+    for (const QString &table : tables) {
+        if (table.compare(name, Qt::CaseInsensitive) == 0) {
+            return table;
+        }
+    }
+
+    return QString();
+}
+
+bool SQLCompletionModel::shouldStartCompletion(KTextEditor::View *view, const QString &insertedText, bool userInsertion, const KTextEditor::Cursor &position)
+{
+    if (m_connection.isEmpty() || !isSqlDocument(view->document())) {
+        return false;
+    }
+
+    return Controller::shouldStartCompletion(view, insertedText, userInsertion, position);
+}
+
+int SQLCompletionModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_matches.size());
+}
+
+QVariant SQLCompletionModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= int(m_matches.size())) {
+        return {};
+    }
+
+    const Completion &match = m_matches.at(index.row());
+
+    if (role == Qt::DisplayRole) {
+        if (index.column() == KTextEditor::CodeCompletionModel::Name) {
+            return match.text;
+        } else if (index.column() == KTextEditor::CodeCompletionModel::Postfix && match.kind == Completion::Field) {
+            return match.table;
+        }
+    } else if (role == Qt::DecorationRole && index.column() == KTextEditor::CodeCompletionModel::Icon) {
+        static const QIcon tableIcon(QLatin1String(":/katesql/pics/16-actions-sql-table.png"));
+        static const QIcon fieldIcon(QLatin1String(":/katesql/pics/16-actions-sql-field.png"));
+        return match.kind == Completion::Table ? tableIcon : fieldIcon;
+    }
+
+    return {};
+}
+
+#include "moc_sqlcompletionmodel.cpp"
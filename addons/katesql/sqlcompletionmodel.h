@@ -0,0 +1,62 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+class SchemaCache;
+class QSqlRecord;
+
+#include <ktexteditor/codecompletionmodel.h>
+#include <ktexteditor/codecompletionmodelcontrollerinterface.h>
+
+#include <vector>
+
+/**
+ * Completes the table, view and column names of the selected connection in SQL documents.
+ *
+ * The names come from the schema cache the schema browser fills, the server is asked only for
+ * what was not loaded yet: the table names once, the columns of a table once it is qualified.
+ */
+class SQLCompletionModel : public KTextEditor::CodeCompletionModel, public KTextEditor::CodeCompletionModelControllerInterface
+{
+    Q_OBJECT
+
+    Q_INTERFACES(KTextEditor::CodeCompletionModelControllerInterface)
+
+    using Controller = KTextEditor::CodeCompletionModelControllerInterface;
+
+public:
+    SQLCompletionModel(SchemaCache *cache, QObject *parent = nullptr);
+
+    void setConnection(const QString &connection);
+
+    void completionInvoked(KTextEditor::View *view, const KTextEditor::Range &range, InvocationType invocationType) override;
+    bool shouldStartCompletion(KTextEditor::View *view, const QString &insertedText, bool userInsertion, const KTextEditor::Cursor &position) override;
+
+    int rowCount(const QModelIndex &parent) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+
+    static bool isSqlDocument(KTextEditor::Document *document);
+
+private:
+    struct Completion {
+        enum Kind { Table, Field } kind;
+        QString text;
+        // the table of a field
+        QString table;
+    };
+
+    /**
+     * The table @p position is qualified with, like in "table.", the way the server names it.
+     */
+    QString qualifyingTable(KTextEditor::Document *document, const KTextEditor::Cursor &position);
+    void appendFields(const QString &table, const QSqlRecord &record);
+
+private:
+    SchemaCache *const m_cache;
+    QString m_connection;
+    std::vector<Completion> m_matches;
+};
@@ -6,6 +6,7 @@
 
 #include "sqlmanager.h"
 #include "connectionmodel.h"
+#include "sqlworker.h"
 
 #include <KConfig>
 #include <KConfigGroup>
@@ -16,7 +17,6 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSqlDatabase>
-#include <QSqlDriver>
 #include <QSqlError>
 
 #include <qt6keychain/keychain.h>
@@ -29,6 +29,8 @@ SQLManager::SQLManager(QObject *parent)
 
 SQLManager::~SQLManager()
 {
+    qDeleteAll(m_workers);
+
     for (int i = 0; i < m_model->rowCount(); i++) {
         QString connection = m_model->data(m_model->index(i), Qt::DisplayRole).toString();
         QSqlDatabase::removeDatabase(connection);
@@ -41,6 +43,8 @@ void SQLManager::createConnection(const Connection &conn)
 {
     if (QSqlDatabase::contains(conn.name)) {
         qDebug() << "connection" << conn.name << "already exist";
+        removeWorker(conn.name);
+        m_schemaCache.invalidate(conn.name);
         QSqlDatabase::removeDatabase(conn.name);
     }
 
@@ -150,6 +154,18 @@ void SQLManager::reopenConnection(const QString &name)
 {
     Q_EMIT connectionAboutToBeClosed(name);
 
+    if (name == m_queryConnection) {
+        stopQuery();
+    }
+    if (name == m_exportConnection) {
+        stopExport();
+    }
+    forgetResult(name);
+    if (SQLWorker *w = m_workers.value(name)) {
+        w->reset();
+    }
+    m_schemaCache.invalidate(name);
+
     QSqlDatabase db = QSqlDatabase::database(name);
 
     db.close();
@@ -216,12 +232,19 @@ ConnectionModel *SQLManager::connectionModel()
     return m_model;
 }
 
+SchemaCache *SQLManager::schemaCache()
+{
+    return &m_schemaCache;
+}
+
 void SQLManager::removeConnection(const QString &name)
 {
     Q_EMIT connectionAboutToBeClosed(name);
 
     m_model->removeConnection(name);
 
+    removeWorker(name);
+    m_schemaCache.invalidate(name);
     QSqlDatabase::removeDatabase(name);
 
     Q_EMIT connectionRemoved(name);
@@ -302,48 +325,214 @@ void SQLManager::runQuery(const QString &text, const QString &connection)
         return;
     }
 
-    QSqlDatabase db = QSqlDatabase::database(connection);
-    QSqlQuery query(db);
+    // only the results of the last query are shown
+    stopQuery();
 
-    if (!query.prepare(text)) {
-        QSqlError err = query.lastError();
+    m_queryConnection = connection;
+    m_queryText = text;
+    m_queryId = worker(connection)->runQuery(text);
 
-        if (err.type() == QSqlError::ConnectionError) {
-            m_model->setStatus(connection, Connection::OFFLINE);
-        }
+    Q_EMIT queryStarted(connection);
+}
 
-        Q_EMIT error(err.text());
+void SQLManager::stopQuery()
+{
+    if (!isQueryRunning()) {
         return;
     }
 
-    if (!query.exec()) {
-        QSqlError err = query.lastError();
+    if (SQLWorker *w = m_workers.value(m_queryConnection)) {
+        w->cancel(m_queryId);
+    }
 
-        if (err.type() == QSqlError::ConnectionError) {
-            m_model->setStatus(connection, Connection::OFFLINE);
-        }
+    // the worker cancels everything queued before, an export too
+    if (m_exportConnection == m_queryConnection && m_exportId < m_queryId) {
+        stopExport();
+    }
 
-        Q_EMIT error(err.text());
+    queryDone();
+
+    Q_EMIT success(i18nc("@info", "Query canceled"));
+}
+
+bool SQLManager::isQueryRunning() const
+{
+    return m_queryId != 0;
+}
+
+bool SQLManager::canExportResult() const
+{
+    // running anything else again could change the database
+    return !m_resultText.isEmpty() && SQLWorker::isReadOnly(m_resultText);
+}
+
+void SQLManager::exportResult(const QString &fileName, const ResultExporter::Options &options)
+{
+    if (!canExportResult()) {
+        Q_EMIT error(i18nc("@info", "There is no result to export"));
+        Q_EMIT exportFinished(false);
         return;
     }
 
-    QString message;
+    if (!isValidAndOpen(m_resultConnection)) {
+        Q_EMIT exportFinished(false);
+        return;
+    }
+
+    stopExport();
+
+    m_exportConnection = m_resultConnection;
+    m_exportId = worker(m_exportConnection)->exportQuery(m_resultText, fileName, options);
+}
+
+void SQLManager::stopExport()
+{
+    if (m_exportId == 0) {
+        return;
+    }
+
+    if (SQLWorker *w = m_workers.value(m_exportConnection)) {
+        w->cancel(m_exportId);
+    }
+
+    exportDone(false);
+
+    Q_EMIT success(i18nc("@info", "Export canceled"));
+}
+
+SQLWorker *SQLManager::worker(const QString &connection)
+{
+    SQLWorker *&w = m_workers[connection];
+
+    if (!w) {
+        w = new SQLWorker(connection);
+        connect(w, &SQLWorker::columnsReady, this, &SQLManager::slotQueryColumns);
+        connect(w, &SQLWorker::rowsReady, this, &SQLManager::slotQueryRows);
+        connect(w, &SQLWorker::finished, this, &SQLManager::slotQueryFinished);
+        connect(w, &SQLWorker::failed, this, &SQLManager::slotQueryFailed);
+        connect(w, &SQLWorker::progress, this, &SQLManager::slotExportProgress);
+        connect(w, &SQLWorker::dataReady, this, &SQLManager::slotExportData);
+    }
+
+    return w;
+}
+
+void SQLManager::removeWorker(const QString &connection)
+{
+    if (connection == m_queryConnection) {
+        stopQuery();
+    }
+    if (connection == m_exportConnection) {
+        stopExport();
+    }
+    forgetResult(connection);
+
+    // waits for a statement that is still executing
+    delete m_workers.take(connection);
+}
+
+void SQLManager::queryDone()
+{
+    m_queryId = 0;
+    m_queryConnection.clear();
+
+    Q_EMIT queryFinished();
+}
+
+void SQLManager::exportDone(bool success)
+{
+    m_exportId = 0;
+    m_exportConnection.clear();
+
+    Q_EMIT exportFinished(success);
+}
+
+void SQLManager::forgetResult(const QString &connection)
+{
+    if (connection == m_resultConnection) {
+        m_resultConnection.clear();
+        m_resultText.clear();
+    }
+}
+
+// the signals of the workers arrive queued, the query may have been canceled since
+
+void SQLManager::slotQueryColumns(quint64 id, const QSqlRecord &columns)
+{
+    if (id == m_queryId) {
+        m_resultConnection = m_queryConnection;
+        m_resultText = m_queryText;
+
+        Q_EMIT queryColumns(columns, m_queryConnection);
+    }
+}
+
+void SQLManager::slotQueryRows(quint64 id, const ResultChunk &rows)
+{
+    if (id == m_queryId) {
+        Q_EMIT queryRows(rows);
+    }
+}
+
+void SQLManager::slotQueryFinished(quint64 id, bool isSelect, qint64 rows)
+{
+    if (id == m_exportId) {
+        exportDone(true);
+        Q_EMIT success(i18ncp("@info", "%1 record exported", "%1 records exported", rows));
+        return;
+    }
+
+    if (id != m_queryId) {
+        return;
+    }
 
     /// TODO: improve messages
-    if (query.isSelect()) {
-        if (!query.driver()->hasFeature(QSqlDriver::QuerySize)) {
-            message = i18nc("@info", "Query completed successfully");
-        } else {
-            int nRowsSelected = query.size();
-            message = i18ncp("@info", "%1 record selected", "%1 records selected", nRowsSelected);
-        }
+    QString message;
+
+    if (isSelect) {
+        message = i18ncp("@info", "%1 record selected", "%1 records selected", rows);
     } else {
-        int nRowsAffected = query.numRowsAffected();
-        message = i18ncp("@info", "%1 row affected", "%1 rows affected", nRowsAffected);
+        message = i18ncp("@info", "%1 row affected", "%1 rows affected", rows);
     }
 
+    queryDone();
+
     Q_EMIT success(message);
-    Q_EMIT queryActivated(query, connection);
+}
+
+void SQLManager::slotQueryFailed(quint64 id, const QSqlError &err)
+{
+    if (id == m_exportId) {
+        exportDone(false);
+        Q_EMIT error(err.text());
+        return;
+    }
+
+    if (id != m_queryId) {
+        return;
+    }
+
+    if (err.type() == QSqlError::ConnectionError) {
+        m_model->setStatus(m_queryConnection, Connection::OFFLINE);
+    }
+
+    queryDone();
+
+    Q_EMIT error(err.text());
+}
+
+void SQLManager::slotExportProgress(quint64 id, qint64 rows)
+{
+    if (id == m_exportId) {
+        Q_EMIT exportProgress(rows);
+    }
+}
+
+void SQLManager::slotExportData(quint64 id, const QByteArray &data)
+{
+    if (id == m_exportId) {
+        Q_EMIT exportData(data);
+    }
 }
 
 #include "moc_sqlmanager.cpp"
@@ -8,10 +8,16 @@
 
 class ConnectionModel;
 class KConfigGroup;
+class SQLWorker;
 
 #include "connection.h"
+#include "resultexporter.h"
+#include "resultstore.h"
+#include "schemacache.h"
 
-#include <QSqlQuery>
+#include <QHash>
+#include <QSqlError>
+#include <QSqlRecord>
 #include <QUrl>
 
 class SQLManager : public QObject
@@ -23,9 +29,12 @@ public:
     ~SQLManager() override;
 
     ConnectionModel *connectionModel();
+    SchemaCache *schemaCache();
     void createConnection(const Connection &conn);
     static bool testConnection(const Connection &conn, QSqlError &error);
     bool isValidAndOpen(const QString &connection);
+    bool isQueryRunning() const;
+    bool canExportResult() const;
 
     int storeCredentials(const Connection &conn);
     int readCredentials(const QString &name, QString &password);
@@ -39,6 +48,14 @@ public Q_SLOTS:
     void loadConnections(const KConfigGroup &connectionsGroup);
     void saveConnections(KConfigGroup *connectionsGroup);
     void runQuery(const QString &text, const QString &connection);
+    void stopQuery();
+
+    /**
+     * Run the query of the result shown again and export all its rows, without going through
+     * the result grid. With an empty @p fileName the text comes with exportData.
+     */
+    void exportResult(const QString &fileName, const ResultExporter::Options &options);
+    void stopExport();
 
 protected:
     static void saveConnection(KConfigGroup *connectionsGroup, const Connection &conn);
@@ -48,11 +65,49 @@ Q_SIGNALS:
     void connectionRemoved(const QString &name);
     void connectionAboutToBeClosed(const QString &name);
 
-    void queryActivated(QSqlQuery &query, const QString &connection);
+    void queryStarted(const QString &connection);
+    void queryColumns(const QSqlRecord &columns, const QString &connection);
+    void queryRows(const ResultChunk &rows);
+    void queryFinished();
+
+    void exportProgress(qint64 rows);
+    void exportData(const QByteArray &data);
+    void exportFinished(bool success);
 
     void error(const QString &message);
     void success(const QString &message);
 
+private:
+    SQLWorker *worker(const QString &connection);
+    void removeWorker(const QString &connection);
+    void queryDone();
+    void exportDone(bool success);
+    void forgetResult(const QString &connection);
+
+    void slotQueryColumns(quint64 id, const QSqlRecord &columns);
+    void slotQueryRows(quint64 id, const ResultChunk &rows);
+    void slotQueryFinished(quint64 id, bool isSelect, qint64 rows);
+    void slotQueryFailed(quint64 id, const QSqlError &err);
+    void slotExportProgress(quint64 id, qint64 rows);
+    void slotExportData(quint64 id, const QByteArray &data);
+
 private:
     ConnectionModel *m_model;
+
+    // the queries of a connection run one after the other in its worker
+    QHash<QString, SQLWorker *> m_workers;
+
+    SchemaCache m_schemaCache;
+
+    // the query whose results are shown, there is at most one
+    QString m_queryConnection;
+    QString m_queryText;
+    quint64 m_queryId = 0;
+
+    // the select whose rows are shown, exports run it again
+    QString m_resultConnection;
+    QString m_resultText;
+
+    QString m_exportConnection;
+    quint64 m_exportId = 0;
 };
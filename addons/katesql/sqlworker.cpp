@@ -0,0 +1,265 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "sqlworker.h"
+
+#include <QDeadlineTimer>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include <utility>
+
+// rows are handed out once this many are fetched or the interval passed, whatever comes first
+static constexpr int BatchSize = 1000;
+static constexpr int BatchInterval = 100;
+
+// exported text is written in blocks of about this size
+static constexpr qsizetype ExportBufferSize = 1024 * 1024;
+
+static std::atomic<int> s_workers = 0;
+// unique over all workers, the results of the query of one are never taken for another
+static std::atomic<quint64> s_lastId = 0;
+
+SQLWorker::SQLWorker(const QString &connection, QObject *parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_workerConnection(QStringLiteral("%1 (worker %2)").arg(connection).arg(++s_workers))
+{
+    m_thread.setMaxThreadCount(1);
+    m_thread.setExpiryTimeout(-1);
+    m_thread.setObjectName(QStringLiteral("katesql worker"));
+}
+
+SQLWorker::~SQLWorker()
+{
+    cancel(m_lastId);
+
+    // the connection must be closed in the thread that opened it
+    m_thread.start([this]() {
+        QSqlDatabase::removeDatabase(m_workerConnection);
+    });
+    m_thread.waitForDone();
+}
+
+quint64 SQLWorker::runQuery(const QString &text)
+{
+    const quint64 id = ++s_lastId;
+    m_lastId = id;
+    m_thread.start([this, id, text]() {
+        execute(id, text);
+    });
+    return id;
+}
+
+quint64 SQLWorker::exportQuery(const QString &text, const QString &fileName, const ResultExporter::Options &options)
+{
+    const quint64 id = ++s_lastId;
+    m_lastId = id;
+    m_thread.start([this, id, text, fileName, options]() {
+        exportTo(id, text, fileName, options);
+    });
+    return id;
+}
+
+void SQLWorker::cancel(quint64 id)
+{
+    if (id > m_canceled.load(std::memory_order_relaxed)) {
+        m_canceled.store(id, std::memory_order_relaxed);
+    }
+}
+
+void SQLWorker::reset()
+{
+    m_reset = true;
+}
+
+bool SQLWorker::isReadOnly(const QString &text)
+{
+    // comments and string literals can't hide a statement from the checks below
+    static const QRegularExpression noise(QStringLiteral(R"(--[^\n]*|/\*.*?\*/|'(?:[^']|'')*')"), QRegularExpression::DotMatchesEverythingOption);
+    QString statement = text;
+    statement.replace(noise, QStringLiteral(" "));
+    statement = statement.trimmed();
+    if (statement.endsWith(QLatin1Char(';'))) {
+        statement.chop(1);
+    }
+
+    // one statement only
+    if (statement.contains(QLatin1Char(';'))) {
+        return false;
+    }
+
+    static const QRegularExpression reading(QStringLiteral(R"(^(SELECT|WITH|VALUES|TABLE)\b)"), QRegularExpression::CaseInsensitiveOption);
+    if (!reading.match(statement).hasMatch()) {
+        return false;
+    }
+
+    // data modifying CTEs, SELECT INTO, FOR UPDATE locks, procedures, sequences
+    static const QRegularExpression writing(QStringLiteral(R"(\b(INSERT|UPDATE|DELETE|MERGE|INTO|CALL|EXEC|EXECUTE|LOCK|NEXTVAL|SETVAL)\b)"),
+                                            QRegularExpression::CaseInsensitiveOption);
+    return !writing.match(statement).hasMatch();
+}
+
+std::optional<QSqlQuery> SQLWorker::start(quint64 id, const QString &text)
+{
+    if (isCanceled(id)) {
+        return std::nullopt;
+    }
+
+    if (m_reset.exchange(false) && QSqlDatabase::contains(m_workerConnection)) {
+        QSqlDatabase::removeDatabase(m_workerConnection);
+    }
+    if (!QSqlDatabase::contains(m_workerConnection)) {
+        QSqlDatabase::cloneDatabase(m_connection, m_workerConnection);
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(m_workerConnection, false);
+    if (!db.isOpen() && !db.open()) {
+        Q_EMIT failed(id, db.lastError());
+        return std::nullopt;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if (!query.prepare(text) || !query.exec()) {
+        if (!isCanceled(id)) {
+            Q_EMIT failed(id, query.lastError());
+        }
+        return std::nullopt;
+    }
+
+    if (isCanceled(id)) {
+        return std::nullopt;
+    }
+
+    if (!query.isSelect()) {
+        Q_EMIT finished(id, false, query.numRowsAffected());
+        return std::nullopt;
+    }
+
+    return query;
+}
+
+void SQLWorker::execute(quint64 id, const QString &text)
+{
+    std::optional<QSqlQuery> query = start(id, text);
+    if (!query) {
+        return;
+    }
+
+    const QSqlRecord columns = query->record();
+    const int columnCount = columns.count();
+    Q_EMIT columnsReady(id, columns);
+
+    qint64 rowCount = 0;
+    ResultChunk batch(columns);
+    QVariantList row(columnCount);
+    QDeadlineTimer deadline(BatchInterval);
+
+    while (query->next()) {
+        if (isCanceled(id)) {
+            return;
+        }
+
+        for (int column = 0; column < columnCount; ++column) {
+            row[column] = query->value(column);
+        }
+        batch.appendRow(row);
+        ++rowCount;
+
+        if (batch.rowCount() >= BatchSize || deadline.hasExpired()) {
+            Q_EMIT rowsReady(id, std::exchange(batch, ResultChunk(columns)));
+            deadline.setRemainingTime(BatchInterval);
+        }
+    }
+
+    if (batch.rowCount() > 0) {
+        Q_EMIT rowsReady(id, batch);
+    }
+
+    if (query->lastError().isValid()) {
+        Q_EMIT failed(id, query->lastError());
+        return;
+    }
+
+    Q_EMIT finished(id, true, rowCount);
+}
+
+void SQLWorker::exportTo(quint64 id, const QString &text, const QString &fileName, const ResultExporter::Options &options)
+{
+    std::optional<QSqlQuery> query = start(id, text);
+    if (!query) {
+        return;
+    }
+
+    // an existing file is only replaced once all is written
+    QSaveFile file(fileName);
+    if (!fileName.isEmpty() && !file.open(QIODevice::WriteOnly)) {
+        Q_EMIT failed(id, QSqlError(file.errorString(), QString(), QSqlError::UnknownError));
+        return;
+    }
+
+    const QSqlRecord columns = query->record();
+    const int columnCount = columns.count();
+    ResultExporter exporter(columns, options);
+
+    QByteArray buffer;
+    buffer.reserve(ExportBufferSize + ExportBufferSize / 4);
+    exporter.appendHeader(buffer);
+
+    const auto flush = [&]() {
+        if (fileName.isEmpty()) {
+            Q_EMIT dataReady(id, buffer);
+        } else if (file.write(buffer) != buffer.size()) {
+            return false;
+        }
+        buffer.resize(0);
+        return true;
+    };
+
+    qint64 rowCount = 0;
+    QVariantList row(columnCount);
+    QDeadlineTimer deadline(BatchInterval);
+
+    while (query->next()) {
+        if (isCanceled(id)) {
+            return;
+        }
+
+        for (int column = 0; column < columnCount; ++column) {
+            row[column] = query->value(column);
+        }
+        exporter.appendRow(row, buffer);
+        ++rowCount;
+
+        if (buffer.size() >= ExportBufferSize && !flush()) {
+            Q_EMIT failed(id, QSqlError(file.errorString(), QString(), QSqlError::UnknownError));
+            return;
+        }
+
+        if (deadline.hasExpired()) {
+            Q_EMIT progress(id, rowCount);
+            deadline.setRemainingTime(BatchInterval);
+        }
+    }
+
+    if (query->lastError().isValid()) {
+        Q_EMIT failed(id, query->lastError());
+        return;
+    }
+
+    if (!flush() || (!fileName.isEmpty() && !file.commit())) {
+        Q_EMIT failed(id, QSqlError(file.errorString(), QString(), QSqlError::UnknownError));
+        return;
+    }
+
+    Q_EMIT finished(id, true, rowCount);
+}
+
+#include "moc_sqlworker.cpp"
@@ -0,0 +1,103 @@
+/*
+   SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "resultexporter.h"
+#include "resultstore.h"
+
+#include <QObject>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QThreadPool>
+
+#include <atomic>
+#include <optional>
+
+/**
+ * Runs the queries of one connection in a thread of its own, one after the other.
+ *
+ * The worker opens a copy of the connection in its thread, the connection of the GUI thread is
+ * only used to clone it. The rows of a result are fetched forward only and handed out in batches,
+ * or exported as they come. The signals are emitted from the worker thread.
+ */
+class SQLWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SQLWorker(const QString &connection, QObject *parent = nullptr);
+    ~SQLWorker() override;
+
+    /**
+     * Queue @p text, returns the id the signals for it carry.
+     */
+    quint64 runQuery(const QString &text);
+
+    /**
+     * Queue @p text and write its rows to @p fileName, with dataReady instead if that is empty.
+     * The export ends with finished or failed like a query.
+     */
+    quint64 exportQuery(const QString &text, const QString &fileName, const ResultExporter::Options &options);
+
+    /**
+     * Stop the query @p id and the ones queued before it, no more signals are emitted for them.
+     * QtSql can't interrupt a statement, one that is executing still runs to its end but nothing
+     * of its result is fetched.
+     */
+    void cancel(quint64 id);
+
+    /**
+     * The settings of the connection changed, the next query clones it again.
+     */
+    void reset();
+
+    /**
+     * Is @p text a single statement that only reads, like a plain SELECT? Only such a query is
+     * safe to run again, e.g. to export its result. This is a conservative guess, a user
+     * defined function with side effects is not detected.
+     */
+    static bool isReadOnly(const QString &text);
+
+Q_SIGNALS:
+    void columnsReady(quint64 id, const QSqlRecord &columns);
+    void rowsReady(quint64 id, const ResultChunk &rows);
+
+    // for exports
+    void progress(quint64 id, qint64 rows);
+    void dataReady(quint64 id, const QByteArray &data);
+
+    /**
+     * For a select @p rows is the number of rows fetched, otherwise the number of rows affected.
+     */
+    void finished(quint64 id, bool isSelect, qint64 rows);
+    void failed(quint64 id, const QSqlError &error);
+
+private:
+    bool isCanceled(quint64 id) const
+    {
+        return id <= m_canceled.load(std::memory_order_relaxed);
+    }
+
+    // in the worker thread
+
+    /**
+     * Execute @p text, returns the query if it has rows to fetch.
+     */
+    std::optional<QSqlQuery> start(quint64 id, const QString &text);
+    void execute(quint64 id, const QString &text);
+    void exportTo(quint64 id, const QString &text, const QString &fileName, const ResultExporter::Options &options);
+
+private:
+    const QString m_connection;
+    const QString m_workerConnection;
+    quint64 m_lastId = 0;
+    std::atomic<quint64> m_canceled = 0;
+    std::atomic<bool> m_reset = false;
+    // one thread that doesn't expire, the connection belongs to it
+    QThreadPool m_thread;
+};
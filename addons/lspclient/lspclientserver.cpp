@@ -7,6 +7,8 @@
 #include "lspclientserver.h"
 
 #include "hostprocess.h"
+#include "kateresourceusage.h"
+#include "katetrace.h"
 #include "lspclient_debug.h"
 
 #include "ktexteditor_utils.h"
@@ -1472,6 +1474,8 @@ private:
             qCInfo(LSPCLIENT) << "got message payload size " << length;
             qCDebug(LSPCLIENT) << "message payload:\n" << payload;
 
+            KateTrace::Zone zone("lsp", "LSPClientServer::processMessage");
+            KateResourceUsage::CpuScope cpu("LSP");
             rapidjson::Document doc;
             doc.ParseInsitu(payload.data());
             if (doc.HasParseError()) {
@@ -1480,6 +1484,11 @@ private:
             }
 
             rapidjson::GenericObject result = doc.GetObject();
+            if (zone.isActive()) {
+                if (auto it = result.FindMember(MEMBER_METHOD); it != result.MemberEnd() && it->value.IsString()) {
+                    zone.setDetail(QString::fromUtf8(it->value.GetString()));
+                }
+            }
             auto memIdIt = result.FindMember(MEMBER_ID);
             int msgid = -1;
             if (memIdIt != result.MemberEnd()) {
@@ -11,6 +11,7 @@
 #include "lspclientservermanager.h"
 
 #include "hostprocess.h"
+#include "kateresourceusage.h"
 #include "ktexteditor_utils.h"
 #include "lspclient_debug.h"
 
@@ -272,6 +273,26 @@ public:
         auto projectPlugin = app->plugin(PROJECT_PLUGIN);
         m_projectPlugin = projectPlugin;
         monitorProjects(projectPlugin);
+
+        KateResourceUsage::self()->addReporter(QStringLiteral("LSP"), this, [this](KateResourceUsage::Report &report) {
+            qint64 servers = 0;
+            for (const auto &modeServers : std::as_const(m_servers)) {
+                servers += modeServers.size();
+            }
+            report.add(QStringLiteral("Servers"), servers);
+
+            // pending incremental changes not yet sent to the servers
+            qint64 changes = 0;
+            qint64 changedCharacters = 0;
+            for (const auto &info : std::as_const(m_docs)) {
+                changes += info.changes.size();
+                for (const auto &change : info.changes) {
+                    changedCharacters += change.text.size();
+                }
+            }
+            report.add(QStringLiteral("Tracked documents"), m_docs.size());
+            report.add(QStringLiteral("Pending changes"), changes, changedCharacters * qint64(sizeof(QChar)));
+        });
     }
 
     ~LSPClientServerManagerImpl() override
@@ -21,6 +21,7 @@
 #include "stashdialog.h"
 
 #include <commitfilesview.h>
+#include <gitobjectreader.h>
 #include <gitprocess.h>
 
 #include <KColorScheme>
@@ -688,28 +689,22 @@ void GitWidget::openAtHEAD(const QString &file)
         return;
     }
 
-    auto args = QStringList{QStringLiteral("show"), QStringLiteral("--textconv")};
-    args.append(QStringLiteral(":") + file);
-    auto git = gitp(args);
-    startHostProcess(*git, QProcess::ReadOnly);
+    // read the blob through the shared cat-file process instead of spawning "git show"
+    auto reader = GitObjectReader::instance(m_activeGitDirPath);
+    reader->readObject(QStringLiteral(":") + file, this, [this, file](const GitObject &object) {
+        if (object.type != GitObject::Blob) {
+            sendMessage(i18n("Failed to open file at HEAD: %1", file), true);
+            return;
+        }
 
-    connect(git, &QProcess::finished, this, [this, file, git](int exitCode, QProcess::ExitStatus es) {
-        if (es != QProcess::NormalExit || exitCode != 0) {
-            sendMessage(i18n("Failed to open file at HEAD: %1", QString::fromUtf8(git->readAllStandardError())), true);
-        } else {
-            auto view = m_mainWin->openUrl(QUrl());
-            if (view) {
-                view->document()->setText(QString::fromUtf8(git->readAllStandardOutput()));
-                auto mode = KTextEditor::Editor::instance()->repository().definitionForFileName(file).name();
-                view->document()->setHighlightingMode(mode);
-                view->document()->setModified(false); // no save file dialog when closing
-            }
+        auto view = m_mainWin->openUrl(QUrl());
+        if (view) {
+            view->document()->setText(QString::fromUtf8(object.data));
+            auto mode = KTextEditor::Editor::instance()->repository().definitionForFileName(file).name();
+            view->document()->setHighlightingMode(mode);
+            view->document()->setModified(false); // no save file dialog when closing
         }
-        git->deleteLater();
     });
-
-    git->setArguments(args);
-    startHostProcess(*git, QProcess::ReadOnly);
 }
 
 void GitWidget::showDiff(const QString &file, bool staged)
@@ -17,6 +17,8 @@
 #include <QTextDocument>
 
 #include <json_utils.h>
+#include <katefilewatcher.h>
+#include <katetaskscheduler.h>
 #include <ktexteditor_utils.h>
 
 #include <QApplication>
@@ -29,6 +31,7 @@
 #include <QJsonParseError>
 #include <QMimeData>
 #include <QPlainTextDocumentLayout>
+#include <memory>
 #include <utility>
 
 bool KateProjectModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent)
@@ -122,9 +125,8 @@ Qt::ItemFlags KateProjectModel::flags(const QModelIndex &index) const
     return flags;
 }
 
-KateProject::KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, const QString &fileName)
-    : m_threadPool(threadPool)
-    , m_plugin(plugin)
+KateProject::KateProject(KateProjectPlugin *plugin, const QString &fileName)
+    : m_plugin(plugin)
     , m_fileBacked(true)
     , m_fileName(QFileInfo(fileName).absoluteFilePath())
     , m_baseDir(QFileInfo(fileName).absolutePath())
@@ -133,8 +135,9 @@ KateProject::KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, con
     m_model.m_project = this;
 
     // ensure we get notified for project file changes
-    connect(&m_plugin->fileWatcher(), &QFileSystemWatcher::fileChanged, this, &KateProject::slotFileChanged);
-    m_plugin->fileWatcher().addPath(m_fileName);
+    connect(KateFileWatcher::self()->watch(m_fileName, this), &KateFileWatch::changed, this, [this]() {
+        reload();
+    });
 
     // try to load the project map from our file, will start worker thread, too
     reload();
@@ -143,9 +146,8 @@ KateProject::KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, con
     updateProjectRoots();
 }
 
-KateProject::KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, const QVariantMap &globalProject, const QString &directory)
-    : m_threadPool(threadPool)
-    , m_plugin(plugin)
+KateProject::KateProject(KateProjectPlugin *plugin, const QVariantMap &globalProject, const QString &directory)
+    : m_plugin(plugin)
     , m_fileBacked(false)
     , m_fileName(QDir(QDir(directory).absolutePath()).filePath(QStringLiteral(".kateproject")))
     , m_baseDir(QDir(directory).absolutePath())
@@ -164,11 +166,6 @@ KateProject::KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, con
 KateProject::~KateProject()
 {
     saveNotesDocument();
-
-    // stop watching if we have some real project file
-    if (m_fileBacked && !m_fileName.isEmpty()) {
-        m_plugin->fileWatcher().removePath(m_fileName);
-    }
 }
 
 bool KateProject::reload(bool force)
@@ -351,21 +348,37 @@ bool KateProject::load(const QVariantMap &globalProject, bool force)
         }
     }
 
-    auto column = m_model.invisibleRootItem()->takeColumn(0);
+    // free the old items later, whoever drops the last reference deletes them,
+    // a cleanup task that is canceled before it ran does so at once
+    const auto deleteItems = [](QList<QStandardItem *> *items) {
+        qDeleteAll(*items);
+        delete items;
+    };
+    std::shared_ptr<QList<QStandardItem *>> column(new QList<QStandardItem *>(m_model.invisibleRootItem()->takeColumn(0)), deleteItems);
     m_untrackedDocumentsRoot = nullptr;
     m_file2Item.reset();
-    auto deleter = QRunnable::create([column = std::move(column)] {
-        qDeleteAll(column);
-    });
-    m_threadPool.start(deleter);
-
-    // let's run the stuff in our own thread pool
+    auto scheduler = KateTaskScheduler::self();
+    scheduler->schedule(
+        KateTaskScheduler::Idle,
+        i18n("Cleaning up project %1", name()),
+        [column](KateTaskScheduler::Token &) mutable {
+            column.reset();
+        },
+        m_plugin);
+
+    // let's run the stuff in the shared scheduler, the plugin cancels and waits for it in its destructor
     // do manual queued connect, as only run() is done in extra thread, object stays in this one
-    auto w = new KateProjectWorker(m_baseDir, indexDir, m_projectMap, force);
-    connect(w, &KateProjectWorker::loadDone, this, &KateProject::loadProjectDone, Qt::QueuedConnection);
-    connect(w, &KateProjectWorker::loadIndexDone, this, &KateProject::loadIndexDone, Qt::QueuedConnection);
-    connect(w, &KateProjectWorker::errorOccurred, this, onErrorOccurred, Qt::QueuedConnection);
-    m_threadPool.start(w);
+    auto w = std::make_shared<KateProjectWorker>(m_baseDir, indexDir, m_projectMap, force);
+    connect(w.get(), &KateProjectWorker::loadDone, this, &KateProject::loadProjectDone, Qt::QueuedConnection);
+    connect(w.get(), &KateProjectWorker::loadIndexDone, this, &KateProject::loadIndexDone, Qt::QueuedConnection);
+    connect(w.get(), &KateProjectWorker::errorOccurred, this, onErrorOccurred, Qt::QueuedConnection);
+    scheduler->schedule(
+        KateTaskScheduler::Visible,
+        i18n("Loading project %1", name()),
+        [w](KateTaskScheduler::Token &) {
+            w->run();
+        },
+        m_plugin);
 
     // we are done here
     return true;
@@ -667,13 +680,6 @@ void KateProject::unregisterUntrackedItem(const KateProjectItem *item)
     }
 }
 
-void KateProject::slotFileChanged(const QString &file)
-{
-    if (file == m_fileName) {
-        reload();
-    }
-}
-
 void KateProject::updateProjectRoots()
 {
     m_projectRoots.clear();
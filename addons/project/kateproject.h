@@ -51,7 +51,6 @@ typedef std::shared_ptr<KateProjectIndex> KateProjectSharedProjectIndex;
 Q_DECLARE_METATYPE(KateProjectSharedProjectIndex)
 
 class KateProjectPlugin;
-class QThreadPool;
 
 /**
  * Class representing a project.
@@ -69,22 +68,20 @@ public:
      * Construct project by reading from given file.
      * Success can be checked later by using isValid().
      *
-     * @param threadPool thread pool to be used by worker threads
-     * @param plugin our plugin instance, for config & file system watcher
+     * @param plugin our plugin instance, for config
      * @param fileName fileName to load the project from
      */
-    KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, const QString &fileName);
+    KateProject(KateProjectPlugin *plugin, const QString &fileName);
 
     /**
      * Construct project from given data for given base directory
      * Success can be checked later by using isValid().
      *
-     * @param threadPool thread pool to be used by worker threads
-     * @param plugin our plugin instance, for config & file system watcher
+     * @param plugin our plugin instance, for config
      * @param globalProject globalProject object content
      * @param directory project base directory
      */
-    KateProject(QThreadPool &threadPool, KateProjectPlugin *plugin, const QVariantMap &globalProject, const QString &directory);
+    KateProject(KateProjectPlugin *plugin, const QVariantMap &globalProject, const QString &directory);
 
     /**
      * deconstruct project
@@ -173,6 +170,14 @@ public:
         return m_file2Item ? m_file2Item->keys() : QStringList();
     }
 
+    /**
+     * Number of files in the project, cheaper than files().size()
+     */
+    qsizetype fileCount() const
+    {
+        return m_file2Item ? m_file2Item->size() : 0;
+    }
+
     /**
      * get item for file
      * @param file file to get item for
@@ -293,12 +298,6 @@ private Q_SLOTS:
 
     void slotModifiedOnDisk(KTextEditor::Document *document, bool isModified, KTextEditor::Document::ModifiedOnDiskReason reason);
 
-    /**
-     * did some project file change?
-     * @param file name of file that did change
-     */
-    void slotFileChanged(const QString &file);
-
 Q_SIGNALS:
     /**
      * Emitted on project map changes.
@@ -335,11 +334,6 @@ private:
     void updateProjectRoots();
 
 private:
-    /**
-     * thread pool used for project worker
-     */
-    QThreadPool &m_threadPool;
-
     /**
      * Project plugin (configuration)
      */
@@ -13,6 +13,8 @@
 #include "ktexteditor_utils.h"
 
 #include <kateapp.h>
+#include <kateresourceusage.h>
+#include <katetaskscheduler.h>
 
 #include <ktexteditor/application.h>
 #include <ktexteditor/editor.h>
@@ -75,10 +77,22 @@ KateProjectPlugin::KateProjectPlugin(QObject *parent, const QVariantList &)
     // forward to meta-object system friendly version
     connect(this, &KateProjectPlugin::projectCreated, this, &KateProjectPlugin::projectAdded);
     connect(this, &KateProjectPlugin::pluginViewProjectClosing, this, &KateProjectPlugin::projectRemoved);
+
+    KateResourceUsage::self()->addReporter(QStringLiteral("Projects"), this, [this](KateResourceUsage::Report &report) {
+        qint64 files = 0;
+        for (const auto project : std::as_const(m_projects)) {
+            files += project->fileCount();
+        }
+        report.add(QStringLiteral("Projects"), m_projects.size());
+        report.add(QStringLiteral("Project items"), files);
+    });
 }
 
 KateProjectPlugin::~KateProjectPlugin()
 {
+    // the loading and cleanup tasks of our projects run with us as context
+    KateTaskScheduler::self()->cancelAndWait(this);
+
     unregisterVariables();
 
     for (KateProject *project : std::as_const(m_projects)) {
@@ -112,7 +126,7 @@ KateProject *KateProjectPlugin::createProjectForFileName(const QString &fileName
         return project;
     }
 
-    KateProject *project = new KateProject(m_threadPool, this, fileName);
+    KateProject *project = new KateProject(this, fileName);
     if (!project->isValid()) {
         delete project;
         return nullptr;
@@ -409,7 +423,7 @@ KateProject *KateProjectPlugin::createProjectForDirectoryWithProjectMap(const QD
         return project;
     }
 
-    KateProject *project = new KateProject(m_threadPool, this, projectMap, dir.absolutePath());
+    KateProject *project = new KateProject(this, projectMap, dir.absolutePath());
     if (!project->isValid()) {
         delete project;
         return nullptr;
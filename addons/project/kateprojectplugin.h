@@ -9,9 +9,6 @@
 
 #include <unordered_map>
 
-#include <QFileSystemWatcher>
-#include <QThreadPool>
-
 #include <KTextEditor/Document>
 #include <KTextEditor/Plugin>
 #include <KTextEditor/SessionConfigInterface>
@@ -152,15 +149,6 @@ public:
     void setRestoreProjectsForSession(bool enabled);
     bool restoreProjectsForSession() const;
 
-    /**
-     * filesystem watcher to keep track of all project files
-     * and auto-reload
-     */
-    QFileSystemWatcher &fileWatcher()
-    {
-        return m_fileWatcher;
-    }
-
     /**
      * Search for already loaded project for directory.
      * Avoids that we double-load stuff for same one.
@@ -249,12 +237,6 @@ private:
      */
     QList<KateProject *> m_projects;
 
-    /**
-     * filesystem watcher to keep track of all project files
-     * and auto-reload
-     */
-    QFileSystemWatcher m_fileWatcher;
-
     /**
      * Mapping document => project
      */
@@ -289,9 +271,4 @@ private:
     // git features
     ClickAction m_singleClickAction = ClickAction::ShowDiff;
     ClickAction m_doubleClickAction = ClickAction::StageUnstage;
-
-    /**
-     * thread pool for our workers
-     */
-    QThreadPool m_threadPool;
 };
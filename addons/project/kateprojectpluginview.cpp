@@ -11,6 +11,7 @@
 #include "fileutil.h"
 #include "gitprocess.h"
 #include "gitwidget.h"
+#include "katefilewatcher.h"
 #include "kateproject.h"
 #include "kateprojectinfoview.h"
 #include "kateprojectinfoviewindex.h"
@@ -134,12 +135,6 @@ KateProjectPluginView::KateProjectPluginView(KateProjectPlugin *plugin, KTextEdi
         }
     });
 
-    connect(&m_plugin->fileWatcher(), &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
-        if (m_gitChangedWatcherFile == path) {
-            slotUpdateStatus(true);
-        }
-    });
-
     /**
      * create views for all already existing projects
      * will create toolviews on demand!
@@ -301,11 +296,6 @@ KateProjectPluginView::~KateProjectPluginView()
      * cu gui client
      */
     m_mainWindow->guiFactory()->removeClient(this);
-
-    // Don't watch what nobody use, the old project...
-    if (!m_gitChangedWatcherFile.isEmpty()) {
-        m_plugin->fileWatcher().removePath(m_gitChangedWatcherFile);
-    }
 }
 
 void KateProjectPluginView::slotConfigUpdated()
@@ -553,10 +543,8 @@ void KateProjectPluginView::slotCurrentChanged(int index)
     }
 
     // Don't watch what nobody use, the old project...
-    if (!m_gitChangedWatcherFile.isEmpty()) {
-        m_plugin->fileWatcher().removePath(m_gitChangedWatcherFile);
-        m_gitChangedWatcherFile.clear();
-    }
+    delete m_gitChangedWatch;
+    m_gitChangedWatch = nullptr;
 
     // ...and start watching the new one
     slotUpdateStatus(true);
@@ -742,10 +730,8 @@ void KateProjectPluginView::slotHandleProjectClosing(KateProject *project)
     m_projectsComboGit->removeItem(index);
 
     // Stop watching what no one is interesting anymore
-    if (!m_gitChangedWatcherFile.isEmpty()) {
-        m_plugin->fileWatcher().removePath(m_gitChangedWatcherFile);
-        m_gitChangedWatcherFile.clear();
-    }
+    delete m_gitChangedWatch;
+    m_gitChangedWatch = nullptr;
 
     // inform onward
     Q_EMIT pluginProjectRemoved(project->baseDir(), project->name());
@@ -834,13 +820,17 @@ void KateProjectPluginView::slotUpdateStatus(bool visible)
 
     if (auto widget = gitWidget(); widget && widget->isInitialized()) {
         // To support separate-git-dir always use dotGitPath
-        // We need to add the path every time again because it's always a different file
-        if (!m_gitChangedWatcherFile.isEmpty()) {
-            m_plugin->fileWatcher().removePath(m_gitChangedWatcherFile);
-        }
-        m_gitChangedWatcherFile = widget->indexPath();
-        if (!m_gitChangedWatcherFile.isEmpty()) {
-            m_plugin->fileWatcher().addPath(m_gitChangedWatcherFile);
+        // git replaces the index on each change, the watcher follows the new file for us
+        const QString indexPath = widget->indexPath();
+        if (!m_gitChangedWatch || m_gitChangedWatch->path() != indexPath) {
+            delete m_gitChangedWatch;
+            m_gitChangedWatch = nullptr;
+            if (!indexPath.isEmpty()) {
+                m_gitChangedWatch = KateFileWatcher::self()->watch(indexPath, this);
+                connect(m_gitChangedWatch, &KateFileWatch::changed, this, [this]() {
+                    slotUpdateStatus(true);
+                });
+            }
         }
         widget->updateStatus();
     }
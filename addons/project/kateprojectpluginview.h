@@ -26,6 +26,7 @@ class KateProject;
 class KateProjectPlugin;
 class KateProjectInfoView;
 class GitWidget;
+class KateFileWatch;
 
 typedef QMap<QString, QString> QStringMap;
 Q_DECLARE_METATYPE(QStringMap)
@@ -315,10 +316,9 @@ private:
 
 private:
     /**
-     * Watches for changes to .git/index
-     * If this is non-empty, we registered that file in the project watcher
+     * Watches for changes to .git/index of the current project
      */
-    QString m_gitChangedWatcherFile;
+    KateFileWatch *m_gitChangedWatch = nullptr;
 
     /**
      * our plugin
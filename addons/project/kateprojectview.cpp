@@ -8,6 +8,7 @@
 #include "kateprojectview.h"
 #include "gitprocess.h"
 #include "gitwidget.h"
+#include "katefilewatcher.h"
 #include "kateprojectfiltermodel.h"
 #include "kateprojectplugin.h"
 #include "kateprojectpluginview.h"
@@ -67,19 +68,9 @@ KateProjectView::KateProjectView(KateProjectPluginView *pluginView, KateProject
     QMetaObject::invokeMethod(this, &KateProjectView::checkAndRefreshGit, Qt::QueuedConnection);
 
     connect(m_project, &KateProject::modelChanged, this, &KateProjectView::checkAndRefreshGit);
-    connect(&m_pluginView->plugin()->fileWatcher(), &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
-        if (m_branchChangedWatcherFile == path) {
-            m_project->reload(true);
-        }
-    });
 }
 
-KateProjectView::~KateProjectView()
-{
-    if (!m_branchChangedWatcherFile.isEmpty()) {
-        m_pluginView->plugin()->fileWatcher().removePath(m_branchChangedWatcherFile);
-    }
-}
+KateProjectView::~KateProjectView() = default;
 
 void KateProjectView::selectFile(const QString &file)
 {
@@ -114,22 +105,20 @@ void KateProjectView::checkAndRefreshGit()
      * Not in a git repo or git was removed
      */
     if (!dotGitPath.has_value()) {
-        if (!m_branchChangedWatcherFile.isEmpty()) {
-            m_pluginView->plugin()->fileWatcher().removePath(m_branchChangedWatcherFile);
-            m_branchChangedWatcherFile.clear();
-        }
+        delete m_branchChangedWatch;
+        m_branchChangedWatch = nullptr;
     } else {
+        // git replaces HEAD on checkout, the watcher follows the new file for us
         const QString fileToWatch = dotGitPath.value() + QStringLiteral(".git/HEAD");
-        // fileToWatch == m_branchChangedWatcherFile can be true, but doesn't matter. We MUST always
-        // re add the file otherwise it will not work.
-
-        if (!m_branchChangedWatcherFile.isEmpty()) {
-            m_pluginView->plugin()->fileWatcher().removePath(m_branchChangedWatcherFile);
-            m_branchChangedWatcherFile.clear();
+        if (m_branchChangedWatch && m_branchChangedWatch->path() != fileToWatch) {
+            delete m_branchChangedWatch;
+            m_branchChangedWatch = nullptr;
         }
-        if (QFileInfo::exists(fileToWatch)) {
-            m_branchChangedWatcherFile = fileToWatch;
-            m_pluginView->plugin()->fileWatcher().addPath(m_branchChangedWatcherFile);
+        if (!m_branchChangedWatch && QFileInfo::exists(fileToWatch)) {
+            m_branchChangedWatch = KateFileWatcher::self()->watch(fileToWatch, this);
+            connect(m_branchChangedWatch, &KateFileWatch::changed, this, [this]() {
+                m_project->reload(true);
+            });
         }
     }
     m_pluginView->updateGitBranchButton(m_project);
@@ -18,6 +18,7 @@ class BranchesDialog;
 class QToolButton;
 class QStackedWidget;
 class FileHistoryWidget;
+class KateFileWatch;
 
 /**
  * Class representing a view of a project.
@@ -95,9 +96,8 @@ private:
 
     /**
      * watches for changes to .git/HEAD
-     * If this is non-empty, we registered that file in the project watcher
      */
-    QString m_branchChangedWatcherFile;
+    KateFileWatch *m_branchChangedWatch = nullptr;
 
     /**
      * filter timer
@@ -10,6 +10,8 @@
 #include "kateprojectitem.h"
 
 #include "hostprocess.h"
+#include "kateresourceusage.h"
+#include "katetrace.h"
 #include <bytearraysplitter.h>
 #include <gitprocess.h>
 
@@ -41,6 +43,12 @@ KateProjectWorker::KateProjectWorker(const QString &baseDir, const QString &inde
 
 void KateProjectWorker::run()
 {
+    KateTrace::Zone zone("project", "KateProjectWorker::run");
+    if (zone.isActive()) {
+        zone.setDetail(m_baseDir);
+    }
+    KateResourceUsage::CpuScope cpu("Projects");
+
     /**
      * Create dummy top level parent item and empty map inside shared pointers
      * then load the project recursively
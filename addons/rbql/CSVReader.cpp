@@ -0,0 +1,276 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "CSVReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const char *find(QByteArrayView text, qsizetype from, char c)
+{
+    return static_cast<const char *>(std::memchr(text.data() + from, c, text.size() - from));
+}
+
+static QByteArrayView chopCarriageReturn(QByteArrayView text)
+{
+    return text.endsWith('\r') ? text.chopped(1) : text;
+}
+
+// cut @p text to at most @p size bytes without leaving half of a UTF-8 sequence at the end
+static void truncateUtf8(QByteArray &text, qsizetype size)
+{
+    if (text.size() <= size) {
+        return;
+    }
+
+    text.truncate(size);
+    qsizetype lead = size;
+    while (lead > 0 && (uchar(text.at(lead - 1)) & 0xc0) == 0x80) {
+        --lead;
+    }
+    if (lead == 0 || uchar(text.at(lead - 1)) < 0xc0) {
+        return;
+    }
+
+    const uchar c = text.at(lead - 1);
+    const qsizetype length = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+    if (size - (lead - 1) < length) {
+        text.truncate(lead - 1);
+    }
+}
+
+CSVReader::CSVReader(char separator, qsizetype maxRecordSize)
+    : m_separator(separator)
+    , m_maxRecordSize(maxRecordSize)
+{
+}
+
+void CSVReader::feed(QByteArrayView text, QList<QStringList> &records)
+{
+    const qsizetype size = text.size();
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        // look at no more than fits into the record, one byte more to notice it's too long
+        const qsizetype limit = std::min(size, pos + m_maxRecordSize - m_recordSize - m_field.size() + 1);
+
+        switch (m_state) {
+        case State::FieldStart:
+            if (m_fields.isEmpty()) {
+                if (const qsizetype next = parseLine(text, pos, records); next >= 0) {
+                    pos = next;
+                    break;
+                }
+            }
+
+            if (text.at(pos) == '"') {
+                m_state = State::Quoted;
+                ++pos;
+            } else {
+                m_state = State::Field;
+            }
+            break;
+
+        case State::Field: {
+            // a quote inside an unquoted field is just a character
+            qsizetype end = pos;
+            while (end < limit && text.at(end) != m_separator && text.at(end) != '\n') {
+                ++end;
+            }
+            m_field.append(text.sliced(pos, end - pos));
+            if (end == limit) {
+                pos = end;
+                break;
+            }
+
+            if (text.at(end) == m_separator) {
+                finishField();
+            } else {
+                if (m_field.endsWith('\r')) {
+                    m_field.chop(1);
+                }
+                // skip empty lines
+                if (!m_fields.isEmpty() || !m_field.isEmpty()) {
+                    finishRecord(records);
+                }
+            }
+            m_state = State::FieldStart;
+            pos = end + 1;
+            break;
+        }
+
+        case State::Quoted:
+            // up to the quote that is not doubled
+            if (const char *quote = find(text.first(limit), pos, '"')) {
+                const qsizetype q = quote - text.data();
+                m_field.append(text.sliced(pos, q - pos));
+                m_state = State::Quote;
+                pos = q + 1;
+            } else {
+                m_field.append(text.sliced(pos, limit - pos));
+                pos = limit;
+            }
+            break;
+
+        case State::Quote:
+            if (text.at(pos) == '"') {
+                m_field.append('"');
+                m_state = State::Quoted;
+                ++pos;
+            } else {
+                m_state = State::AfterQuoted;
+            }
+            break;
+
+        case State::AfterQuoted: {
+            // anything between the closing quote and the separator is kept, like most readers do
+            const char c = text.at(pos++);
+            if (c == m_separator) {
+                finishField();
+                m_state = State::FieldStart;
+            } else if (c == '\n') {
+                finishRecord(records);
+                m_state = State::FieldStart;
+            } else if (c == '\r') {
+                finishRecord(records);
+                m_state = State::LineFeed;
+            } else {
+                m_field.append(c);
+            }
+            break;
+        }
+
+        case State::LineFeed:
+            if (text.at(pos) == '\n') {
+                ++pos;
+            }
+            m_state = State::FieldStart;
+            break;
+
+        case State::Skip:
+            if (const char *newline = find(text, pos, '\n')) {
+                pos = newline - text.data() + 1;
+                m_state = State::FieldStart;
+            } else {
+                pos = size;
+            }
+            break;
+        }
+
+        // cut it, most likely a quote that is never closed
+        if (m_recordSize + m_field.size() > m_maxRecordSize) {
+            truncateUtf8(m_field, m_maxRecordSize - m_recordSize);
+            finishRecord(records);
+            m_state = State::Skip;
+            ++m_truncatedRecords;
+        }
+    }
+}
+
+void CSVReader::finish(QList<QStringList> &records)
+{
+    switch (m_state) {
+    case State::FieldStart:
+        // a separator at the very end still starts an empty field
+        if (!m_fields.isEmpty()) {
+            finishRecord(records);
+        }
+        break;
+    case State::Field:
+        if (m_field.endsWith('\r')) {
+            m_field.chop(1);
+        }
+        if (!m_fields.isEmpty() || !m_field.isEmpty()) {
+            finishRecord(records);
+        }
+        break;
+    case State::Quoted:
+    case State::Quote:
+    case State::AfterQuoted:
+        // a quote that is not terminated takes the rest of the text
+        finishRecord(records);
+        break;
+    case State::LineFeed:
+    case State::Skip:
+        break;
+    }
+
+    m_state = State::FieldStart;
+}
+
+qsizetype CSVReader::parseLine(QByteArrayView text, qsizetype from, QList<QStringList> &records) const
+{
+    const char *newline = find(text, from, '\n');
+    if (!newline) {
+        return -1;
+    }
+
+    const qsizetype end = newline - text.data();
+    const QByteArrayView line = chopCarriageReturn(text.sliced(from, end - from));
+
+    // a quote can continue the record on the next lines, a line that might be too long
+    // is left to the slow path, too, so the cut doesn't depend on where the chunks end
+    if (line.size() > m_maxRecordSize || std::memchr(line.data(), '"', line.size())) {
+        return -1;
+    }
+
+    if (line.isEmpty()) {
+        return end + 1;
+    }
+
+    QStringList fields;
+    qsizetype start = 0;
+    while (const char *separator = find(line, start, m_separator)) {
+        const qsizetype pos = separator - line.data();
+        fields.append(QString::fromUtf8(line.sliced(start, pos - start)));
+        start = pos + 1;
+    }
+    fields.append(QString::fromUtf8(line.sliced(start)));
+    records.append(std::move(fields));
+
+    return end + 1;
+}
+
+void CSVReader::finishField()
+{
+    m_recordSize += m_field.size();
+    m_fields.append(QString::fromUtf8(m_field));
+    m_field.clear();
+}
+
+void CSVReader::finishRecord(QList<QStringList> &records)
+{
+    finishField();
+    records.append(std::move(m_fields));
+    m_fields = QStringList();
+    m_recordSize = 0;
+}
+
+char CSVReader::guessSeparator(QByteArrayView sample)
+{
+    const char *newline = find(sample, 0, '\n');
+    const QByteArrayView line = newline ? sample.first(newline - sample.data()) : sample;
+
+    char separator = ',';
+    qsizetype most = 0;
+
+    for (const char candidate : {',', '\t', ';', '|'}) {
+        qsizetype count = 0;
+        bool quoted = false;
+        for (const char c : line) {
+            if (c == '"') {
+                quoted = !quoted;
+            } else if (c == candidate && !quoted) {
+                ++count;
+            }
+        }
+
+        if (count > most) {
+            most = count;
+            separator = candidate;
+        }
+    }
+
+    return separator;
+}
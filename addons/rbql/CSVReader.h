@@ -0,0 +1,91 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QStringList>
+
+/**
+ * Splits UTF-8 CSV/TSV text into records as described in RFC 4180.
+ *
+ * Fields may be quoted, a quoted field can contain separators, newlines and doubled quotes. Empty
+ * fields are kept, empty lines are skipped. The text can be fed in chunks of any size, the parser
+ * state is kept between them so a record spanning chunks is not scanned twice. Lines without
+ * quotes are split with memchr, which most C libraries vectorize.
+ *
+ * A record longer than the size limit, e.g. after a quote that is never closed, is cut there and
+ * the rest of its line skipped, so a broken file doesn't end up in memory as one field. The
+ * separators don't count towards the limit. truncatedRecords() tells how often that happened.
+ */
+class CSVReader
+{
+public:
+    static constexpr qsizetype DefaultMaxRecordSize = 16 * 1024 * 1024;
+
+    explicit CSVReader(char separator, qsizetype maxRecordSize = DefaultMaxRecordSize);
+
+    /**
+     * Append the records that are complete with @p text to @p records.
+     */
+    void feed(QByteArrayView text, QList<QStringList> &records);
+
+    /**
+     * The text ended, append the last record if it had no newline.
+     */
+    void finish(QList<QStringList> &records);
+
+    /**
+     * The separator the first line of @p sample has most of, a comma if it has none.
+     */
+    static char guessSeparator(QByteArrayView sample);
+
+    /**
+     * Number of records cut at the size limit so far.
+     */
+    qsizetype truncatedRecords() const
+    {
+        return m_truncatedRecords;
+    }
+
+private:
+    enum class State {
+        // before a field, at the start of a record lines are split at once
+        FieldStart,
+        // in an unquoted field
+        Field,
+        // in a quoted field
+        Quoted,
+        // after a quote in a quoted field, closing it or doubled
+        Quote,
+        // the text between the closing quote and the separator
+        AfterQuoted,
+        // the record ended with a carriage return, skip a line feed after it
+        LineFeed,
+        // the record got too long, skip to the next line
+        Skip,
+    };
+
+    /**
+     * Split the whole line at @p from if it is in @p text and has no quotes.
+     * Returns where the next line starts or -1.
+     */
+    qsizetype parseLine(QByteArrayView text, qsizetype from, QList<QStringList> &records) const;
+    void finishField();
+    void finishRecord(QList<QStringList> &records);
+
+private:
+    const char m_separator;
+    const qsizetype m_maxRecordSize;
+
+    // the record that continues in the next chunk
+    State m_state = State::FieldStart;
+    QByteArray m_field;
+    QStringList m_fields;
+    // bytes of m_fields
+    qsizetype m_recordSize = 0;
+    qsizetype m_truncatedRecords = 0;
+};
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "RBQLStream.h"
+
+#include <QIODevice>
+#include <QJSEngine>
+#include <QStandardItemModel>
+
+// the file is read in chunks of this size, each is one batch of records
+static constexpr qint64 ChunkSize = 256 * 1024;
+
+RBQLInput::RBQLInput(QJSEngine *engine, QIODevice *device, char separator, const std::atomic<bool> &canceled)
+    : m_engine(engine)
+    , m_device(device)
+    , m_reader(separator)
+    , m_canceled(canceled)
+{
+    // Excel and co. start UTF-8 files with a byte order mark, it's no part of the first field
+    if (m_device->peek(3) == "\xef\xbb\xbf") {
+        m_device->skip(3);
+    }
+}
+
+bool RBQLInput::fill()
+{
+    if (m_next < m_records.size()) {
+        return true;
+    }
+
+    m_records.clear();
+    m_next = 0;
+
+    while (m_records.isEmpty() && !m_atEnd) {
+        if (m_canceled) {
+            return false;
+        }
+
+        const QByteArray chunk = m_device->read(ChunkSize);
+        if (chunk.isEmpty()) {
+            m_reader.finish(m_records);
+            m_atEnd = true;
+        } else {
+            m_reader.feed(chunk, m_records);
+        }
+    }
+
+    return !m_records.isEmpty();
+}
+
+QStringList RBQLInput::readRecord()
+{
+    if (!fill()) {
+        return {};
+    }
+    return m_records.at(m_next++);
+}
+
+QJSValue RBQLInput::nextBatch()
+{
+    if (!fill()) {
+        return m_engine->newArray();
+    }
+
+    QJSValue batch = m_engine->newArray(m_records.size() - m_next);
+    for (quint32 i = 0; m_next < m_records.size(); ++i, ++m_next) {
+        const QStringList &record = m_records.at(m_next);
+        QJSValue fields = m_engine->newArray(record.size());
+        for (int j = 0; j < record.size(); ++j) {
+            fields.setProperty(j, record.at(j));
+        }
+        batch.setProperty(i, fields);
+    }
+
+    return batch;
+}
+
+RBQLOutput::RBQLOutput(QStandardItemModel *model)
+    : m_model(model)
+{
+}
+
+void RBQLOutput::append(const QJSValue &rows)
+{
+    const int length = rows.property(QStringLiteral("length")).toInt();
+    for (int i = 0; i < length; ++i) {
+        const QJSValue colArray = rows.property(i);
+        const int colCount = colArray.property(QStringLiteral("length")).toInt();
+
+        QList<QStandardItem *> cols(colCount);
+        for (int c = 0; c < colCount; ++c) {
+            cols[c] = new QStandardItem(colArray.property(c).toString());
+        }
+
+        m_model->appendRow(cols);
+    }
+}
+
+#include "moc_RBQLStream.cpp"
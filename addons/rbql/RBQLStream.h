@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "CSVReader.h"
+
+#include <QJSValue>
+#include <QObject>
+
+#include <atomic>
+
+class QIODevice;
+class QJSEngine;
+class QStandardItemModel;
+
+/**
+ * The records of a CSV/TSV file for the rbql engine, read and handed out in batches
+ * so only a chunk of the file is in memory at a time. See RBQLStream.js.
+ */
+class RBQLInput : public QObject
+{
+    Q_OBJECT
+
+public:
+    RBQLInput(QJSEngine *engine, QIODevice *device, char separator, const std::atomic<bool> &canceled);
+
+    /**
+     * The next record, for the header before the query runs.
+     */
+    QStringList readRecord();
+
+    /**
+     * The next records as an array of arrays of strings, an empty one at the end.
+     */
+    Q_INVOKABLE QJSValue nextBatch();
+
+    /**
+     * Number of records cut because they were too long, see CSVReader.
+     */
+    qsizetype truncatedRecords() const
+    {
+        return m_reader.truncatedRecords();
+    }
+
+private:
+    /**
+     * Read until there are records, false if the end was reached without any.
+     */
+    bool fill();
+
+private:
+    QJSEngine *const m_engine;
+    QIODevice *const m_device;
+    CSVReader m_reader;
+    const std::atomic<bool> &m_canceled;
+    QList<QStringList> m_records;
+    qsizetype m_next = 0;
+    bool m_atEnd = false;
+};
+
+/**
+ * Takes the rows the rbql engine writes into a model, in batches.
+ */
+class RBQLOutput : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RBQLOutput(QStandardItemModel *model);
+
+    Q_INVOKABLE void append(const QJSValue &rows);
+
+private:
+    QStandardItemModel *const m_model;
+};
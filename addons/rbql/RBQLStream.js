@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs rbql queries on the records RBQLInput reads natively, writing the result to RBQLOutput.
+// Both are streamed in batches, neither the input nor the output is held as one table.
+
+class KateInputIterator extends rbql.TableIterator {
+    constructor(input, column_names) {
+        super([], column_names, true);
+        this.input = input;
+        this.batch = [];
+        this.pos = 0;
+    }
+
+    get_record() {
+        if (this.stopped)
+            return null;
+        if (this.pos >= this.batch.length) {
+            this.batch = this.input.nextBatch();
+            this.pos = 0;
+            if (this.batch.length == 0)
+                return null;
+        }
+        let record = this.batch[this.pos];
+        this.pos += 1;
+        this.nr += 1;
+        let num_fields = record.length;
+        if (!this.fields_info.has(num_fields))
+            this.fields_info.set(num_fields, this.nr);
+        return record;
+    }
+}
+
+class KateOutputWriter extends rbql.RBQLOutputWriter {
+    constructor(output) {
+        super();
+        this.output = output;
+        this.rows = [];
+        this.header = null;
+    }
+
+    write(fields) {
+        this.rows.push(fields);
+        if (this.rows.length >= 4096)
+            this.flush();
+        return true;
+    }
+
+    flush() {
+        if (this.rows.length) {
+            this.output.append(this.rows);
+            this.rows = [];
+        }
+    }
+
+    finish() {
+        this.flush();
+    }
+
+    set_header(header) {
+        this.header = header;
+    }
+}
+
+// returns the output column names, or null
+function kate_query(query_text, input, output, input_column_names, output_warnings) {
+    let writer = new KateOutputWriter(output);
+    rbql.query(query_text, new KateInputIterator(input, input_column_names), writer, output_warnings);
+    writer.flush();
+    return writer.header;
+}
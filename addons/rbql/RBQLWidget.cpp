@@ -3,13 +3,18 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "RBQLWidget.h"
+#include "RBQLStream.h"
 
 #include <QApplication>
+#include <QBuffer>
 #include <QCheckBox>
 #include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QJSValue>
 #include <QLabel>
 #include <QLineEdit>
+#include <QLocale>
 #include <QPushButton>
 #include <QStandardItemModel>
 #include <QTableView>
@@ -71,8 +76,16 @@ RBQLTab::RBQLTab(KTextEditor::MainWindow *mainWindow, RBQLWidget *parent)
     l->addLayout(hl);
 
     m_hasHeader = new QCheckBox(i18n("File has header"));
+    m_fileLineEdit = new QLineEdit(this);
+    m_fileLineEdit->setPlaceholderText(i18n("Current document"));
+    m_fileLineEdit->setToolTip(i18n("CSV/TSV file to query instead of the current document"));
+    m_browseBtn = new QPushButton(QIcon::fromTheme(QStringLiteral("document-open")), QString());
+    m_browseBtn->setToolTip(i18n("Select file to query"));
+    connect(m_browseBtn, &QAbstractButton::clicked, this, &RBQLTab::browseFile);
     hl = new QHBoxLayout();
     hl->addWidget(m_hasHeader);
+    hl->addWidget(m_fileLineEdit);
+    hl->addWidget(m_browseBtn);
     l->addLayout(hl);
 
     m_tableView = new QTableView(this);
@@ -92,6 +105,8 @@ RBQLTab::~RBQLTab()
 {
     m_queryExecutionFuture.disconnect(this);
     if (m_queryExecutionFuture.isRunning()) {
+        // stops reading, the engine finishes with the records it has
+        m_canceled = true;
         m_queryExecutionFuture.cancel();
         m_queryExecutionFuture.waitForFinished();
     }
@@ -108,21 +123,39 @@ void RBQLTab::exec()
         return;
     }
 
-    QString sep = getSeparatorForDocument();
-    if (sep.isEmpty()) {
-        reportError(i18n("Failed to get separator for current document. Not a CSV/TSV doc?"));
-        return;
-    }
+    // a file is read in the background, without opening it as a document
+    const QString fileName = m_fileLineEdit->text().trimmed();
+    char sep = 0;
+    QByteArray text;
 
-    m_errorLabel->setVisible(false);
+    if (!fileName.isEmpty()) {
+        const QFileInfo fi(fileName);
+        if (!fi.isFile() || !fi.isReadable()) {
+            reportError(i18n("Failed to open %1", fileName));
+            return;
+        }
+        if (fi.suffix().compare(u"tsv", Qt::CaseInsensitive) == 0 || fi.suffix().compare(u"tab", Qt::CaseInsensitive) == 0) {
+            sep = '\t';
+        }
+    } else {
+        const QString docSep = getSeparatorForDocument();
+        if (docSep.isEmpty()) {
+            reportError(i18n("Failed to get separator for current document. Not a CSV/TSV doc?"));
+            return;
+        }
+        sep = docSep.at(0).toLatin1();
 
-    auto d = m_mainWindow->activeView()->document();
-    QStringList lines = d->textLines(d->documentRange());
-    if (lines.empty()) {
-        reportError(i18n("Document is empty"));
-        return;
+        auto d = m_mainWindow->activeView()->document();
+        if (d->isEmpty()) {
+            reportError(i18n("Document is empty"));
+            return;
+        }
+        // the document can change while the query runs, take a compact snapshot
+        text = d->text().toUtf8();
     }
 
+    m_errorLabel->setVisible(false);
+
     initEngine();
 
     // delete old model
@@ -131,15 +164,23 @@ void RBQLTab::exec()
 
     bool includeHeader = m_hasHeader->isChecked();
 
-    QFuture<QStandardItemModel *> future = QtConcurrent::run(&RBQLTab::execQuery, this, std::move(sep), std::move(lines), includeHeader);
+    QFuture<QStandardItemModel *> future = QtConcurrent::run(&RBQLTab::execQuery, this, sep, fileName, std::move(text), includeHeader);
     m_queryExecutionFuture.setFuture(future);
 }
 
-QStandardItemModel *RBQLTab::execQuery(QString sep, QStringList lines, bool includeHeader)
+void RBQLTab::browseFile()
 {
-    if (lines.isEmpty()) {
-        return nullptr;
+    const QString fileName = QFileDialog::getOpenFileName(this,
+                                                          i18n("Query File"),
+                                                          QFileInfo(m_fileLineEdit->text()).path(),
+                                                          i18n("CSV/TSV files (*.csv *.tsv *.tab *.txt);;All files (*)"));
+    if (!fileName.isEmpty()) {
+        m_fileLineEdit->setText(fileName);
     }
+}
+
+QStandardItemModel *RBQLTab::execQuery(char sep, const QString &fileName, const QByteArray &text, bool includeHeader)
+{
     // csv data:
     /*
     name,city,popu
@@ -152,43 +193,45 @@ QStandardItemModel *RBQLTab::execQuery(QString sep, QStringList lines, bool incl
     // SELECT a1,a2 WHERE a3 <= 1000
     // SELECT NR,*
 
-    int i = 0;
-    QStringList header;
-    if (includeHeader) {
-        i = 1;
-        header = lines.at(0).split(sep, Qt::SkipEmptyParts);
-    }
+    QFile file(fileName);
+    QBuffer buffer;
+    QIODevice *device = &buffer;
 
-    QJSValue inputRecords = m_engine->newArray();
-    int recordIdx = 0;
-    for (; i < lines.size(); ++i) {
-        if (QStringView(lines.at(i)).trimmed().isEmpty()) {
-            continue;
+    if (!fileName.isEmpty()) {
+        if (!file.open(QIODevice::ReadOnly)) {
+            QMetaObject::invokeMethod(this, [err = file.errorString(), this] {
+                reportError(err);
+            });
+            return nullptr;
         }
-        auto line = lines.at(i).split(sep, Qt::SkipEmptyParts);
-        auto recordColumn = m_engine->newArray(line.size());
-        for (int j = 0; j < line.size(); ++j) {
-            recordColumn.setProperty(j, line[j]);
-        }
-        inputRecords.setProperty(recordIdx++, recordColumn);
+        device = &file;
+    } else {
+        buffer.setData(text);
+        buffer.open(QIODevice::ReadOnly);
     }
-    // clear
-    lines = {};
-    // qDebug() << "InputRecords:" << inputRecords.property(QStringLiteral("length")).toInt();
 
-    auto rbql = m_engine->globalObject().property(QStringLiteral("rbql"));
-    auto queryFn = rbql.property(QStringLiteral("query_table"));
-    QJSValueList args;
-    args << QJSValue(m_queryLineEdit->text());
-    args << inputRecords;
+    if (sep == 0) {
+        sep = CSVReader::guessSeparator(device->peek(64 * 1024));
+    }
 
-    QJSValue output = m_engine->newArray();
-    args << output;
+    // the records are read as the engine asks for them
+    RBQLInput input(m_engine.get(), device, sep, m_canceled);
+    QJSEngine::setObjectOwnership(&input, QJSEngine::CppOwnership);
 
-    QJSValue outputWarnings = m_engine->newArray();
-    args << outputWarnings;
+    QStringList header;
+    if (includeHeader) {
+        header = input.readRecord();
+    }
 
-    args << QJSValue(QJSValue::NullValue); // join_table
+    auto model = new QStandardItemModel();
+    RBQLOutput output(model);
+    QJSEngine::setObjectOwnership(&output, QJSEngine::CppOwnership);
+
+    auto queryFn = m_engine->globalObject().property(QStringLiteral("kate_query"));
+    QJSValueList args;
+    args << QJSValue(m_queryLineEdit->text());
+    args << m_engine->newQObject(&input);
+    args << m_engine->newQObject(&output);
 
     QJSValue inputColumnNames = [includeHeader, &header, this]() {
         if (includeHeader) {
@@ -200,47 +243,33 @@ QStandardItemModel *RBQLTab::execQuery(QString sep, QStringList lines, bool incl
         }
         return QJSValue(QJSValue::NullValue);
     }();
-    // qDebug() << "include Header" << header << inputColumnNames.property(QStringLiteral("length")).toInt();
     args << inputColumnNames; // input_column_names
 
-    args << QJSValue(QJSValue::NullValue); // join_column_names
-
-    QJSValue outputColumnNames = m_engine->newArray();
-    args << outputColumnNames;
+    QJSValue outputWarnings = m_engine->newArray();
+    args << outputWarnings;
 
-    auto result = queryFn.call(args);
-    if (result.isError()) {
-        QMetaObject::invokeMethod(this, [err = result.toString(), this] {
+    auto outputColumnNames = queryFn.call(args);
+    if (outputColumnNames.isError()) {
+        QMetaObject::invokeMethod(this, [err = outputColumnNames.toString(), this] {
             reportError(err);
         });
+        delete model;
         return nullptr;
     }
 
+    if (const qsizetype truncated = input.truncatedRecords()) {
+        const int count = outputWarnings.property(QStringLiteral("length")).toInt();
+        const QString limit = QLocale().formattedDataSize(CSVReader::DefaultMaxRecordSize);
+        outputWarnings.setProperty(count, i18np("One record was longer than %2 and got truncated", "%1 records were longer than %2 and got truncated", int(truncated), limit));
+    }
+
     QString warnings = outputWarnings.toString();
     if (!warnings.isEmpty()) {
-        QMetaObject::invokeMethod(this, [err = result.toString(), this] {
-            reportError(err);
+        QMetaObject::invokeMethod(this, [warnings, this] {
+            reportError(warnings);
         });
     }
 
-    auto model = new QStandardItemModel();
-
-    const int length = output.property(QStringLiteral("length")).toInt();
-    // qDebug() << "OutputLen:" << length;
-    for (int i = 0; i < length; ++i) {
-        auto cols = QList<QStandardItem *>();
-        auto colArray = output.property(i);
-        int colCount = colArray.property(QStringLiteral("length")).toInt();
-        cols.resize(colCount);
-
-        for (int c = 0; c < colCount; ++c) {
-            cols[c] = new QStandardItem(colArray.property(c).toString());
-        }
-
-        model->appendRow(cols);
-        // qDebug() << i << "-" << output.property(i).toString() << output.property(i).isArray();
-    }
-
     if (outputColumnNames.isArray()) {
         const int headerColumnsLength = outputColumnNames.property(QStringLiteral("length")).toInt();
         QStringList headerLabels;
@@ -278,6 +307,19 @@ void RBQLTab::initEngine()
     m_engine = std::make_unique<QJSEngine>();
     m_engine->installExtensions(QJSEngine::ConsoleExtension);
     auto res = m_engine->evaluate(QString::fromUtf8(file.readAll()));
+    if (res.isError()) {
+        qWarning() << "Failed to init engine" << res.toString();
+        reportError(QStringLiteral("Failed to init engine: %1").arg(res.toString()));
+        return;
+    }
+
+    QFile stream(QStringLiteral(":/rbql/RBQLStream.js"));
+    if (!stream.open(QFile::ReadOnly)) {
+        qWarning() << "Failed to open :/rbql/RBQLStream.js";
+        reportError(QStringLiteral("Failed to open :/rbql/RBQLStream.js"));
+        return;
+    }
+    res = m_engine->evaluate(QString::fromUtf8(stream.readAll()), stream.fileName());
     if (res.isError()) {
         qWarning() << "Failed to init engine" << res.toString();
         reportError(QStringLiteral("Failed to init engine: %1").arg(res.toString()));
@@ -303,9 +345,9 @@ QString RBQLTab::getSeparatorForDocument() const
         return QStringLiteral(",");
     } else if (d == QStringLiteral("tsv")) {
         return QStringLiteral("\t");
-    } else if ("csv (pipe)") {
+    } else if (d == u"csv (pipe)") {
         return QStringLiteral("|");
-    } else if ("csv (semicolon)") {
+    } else if (d == u"csv (semicolon)") {
         return QStringLiteral(";");
     }
     return {};
@@ -11,6 +11,8 @@
 #include <QStandardItemModel>
 #include <QTabWidget>
 
+#include <atomic>
+
 class RBQLWidget : public QWidget
 {
 public:
@@ -31,7 +33,9 @@ public:
 
 private:
     void exec();
-    QStandardItemModel *execQuery(QString sep, QStringList lines, bool includeHeader);
+    void browseFile();
+    /// reads @p fileName, or @p text if that is empty, guessing the separator if it is 0
+    QStandardItemModel *execQuery(char sep, const QString &fileName, const QByteArray &text, bool includeHeader);
     void onQueryExecuted();
     void initEngine();
     void reportError(const QString &error);
@@ -41,9 +45,12 @@ private:
     class QLineEdit *m_queryLineEdit;
     class QLabel *m_errorLabel;
     class QCheckBox *m_hasHeader;
+    class QLineEdit *m_fileLineEdit;
+    class QPushButton *m_browseBtn;
     class QPushButton *m_newTabBtn;
     class QPushButton *m_execBtn;
     class QTableView *m_tableView;
     std::unique_ptr<QJSEngine> m_engine;
     QFutureWatcher<QStandardItemModel *> m_queryExecutionFuture;
+    std::atomic<bool> m_canceled = false;
 };
@@ -0,0 +1,137 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "csvreadertest.h"
+#include "CSVReader.h"
+
+#include <QTest>
+
+QTEST_MAIN(CSVReaderTest)
+
+using Records = QList<QStringList>;
+
+static Records read(QByteArrayView text, char separator = ',')
+{
+    CSVReader reader(separator);
+    Records records;
+    reader.feed(text, records);
+    reader.finish(records);
+    return records;
+}
+
+void CSVReaderTest::testRecords_data()
+{
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<Records>("expected");
+
+    const QStringList ab{QStringLiteral("a"), QStringLiteral("b")};
+
+    QTest::addRow("simple") << QByteArray("a,b\n1,2\n") << Records{ab, {QStringLiteral("1"), QStringLiteral("2")}};
+    QTest::addRow("no final newline") << QByteArray("a,b") << Records{ab};
+    QTest::addRow("crlf") << QByteArray("a,b\r\na,b\r\n") << Records{ab, ab};
+    QTest::addRow("empty fields") << QByteArray(",b,\n") << Records{{QString(), QStringLiteral("b"), QString()}};
+    QTest::addRow("empty lines") << QByteArray("\na,b\n\r\n\na,b\n") << Records{ab, ab};
+    QTest::addRow("quoted separator") << QByteArray("\"a,b\",c\n") << Records{{QStringLiteral("a,b"), QStringLiteral("c")}};
+    QTest::addRow("quoted newline") << QByteArray("\"a\r\nb\",c\r\nd\n") << Records{{QStringLiteral("a\r\nb"), QStringLiteral("c")}, {QStringLiteral("d")}};
+    QTest::addRow("doubled quote") << QByteArray("\"say \"\"hi\"\"\",\"\"\n") << Records{{QStringLiteral("say \"hi\""), QString()}};
+    QTest::addRow("quote inside field") << QByteArray("5\" screen,b\n") << Records{{QStringLiteral("5\" screen"), QStringLiteral("b")}};
+    QTest::addRow("text after quote") << QByteArray("\"a\"b,c\n") << Records{{QStringLiteral("ab"), QStringLiteral("c")}};
+    QTest::addRow("unterminated quote") << QByteArray("a,\"b\nc") << Records{{QStringLiteral("a"), QStringLiteral("b\nc")}};
+    QTest::addRow("utf-8") << QByteArray("\xc3\xa9,\xe2\x82\xac\n") << Records{{QStringLiteral("é"), QStringLiteral("€")}};
+}
+
+void CSVReaderTest::testRecords()
+{
+    QFETCH(QByteArray, text);
+    QFETCH(Records, expected);
+
+    QCOMPARE(read(text), expected);
+}
+
+void CSVReaderTest::testChunks()
+{
+    const QByteArray text("id,name\r\n1,\"multi\r\nline, \"\"quoted\"\"\"\r\n2,\r\n\r\n3,\"\"\r\n4,last");
+    const Records expected = read(text);
+    QCOMPARE(expected.size(), 5);
+
+    // records split anywhere, even between a quote and the one doubling it
+    for (qsizetype size = 1; size < text.size(); ++size) {
+        CSVReader reader(',');
+        Records records;
+        for (qsizetype pos = 0; pos < text.size(); pos += size) {
+            reader.feed(QByteArrayView(text).sliced(pos, std::min(size, text.size() - pos)), records);
+        }
+        reader.finish(records);
+        QCOMPARE(records, expected);
+    }
+
+    // TSV
+    QCOMPARE(read("a\tb,c\n", '\t'), Records({{QStringLiteral("a"), QStringLiteral("b,c")}}));
+}
+
+void CSVReaderTest::testRecordSizeLimit()
+{
+    // a quote that is never closed is cut at the limit, reading goes on with the next line,
+    // the same happens to a long line without quotes, wherever the chunks end
+    QByteArray text("a,\"");
+    text += QByteArray(1000, 'x') + "\nb,c\n" + QByteArray(100, 'y') + "\nd\n";
+
+    for (const qsizetype size : {qsizetype(7), text.size()}) {
+        CSVReader reader(',', 64);
+        Records records;
+        for (qsizetype pos = 0; pos < text.size(); pos += size) {
+            reader.feed(QByteArrayView(text).sliced(pos, std::min(size, text.size() - pos)), records);
+        }
+        reader.finish(records);
+
+        QCOMPARE(records.size(), 4);
+        QCOMPARE(records.at(0), QStringList({QStringLiteral("a"), QString(63, QLatin1Char('x'))}));
+        QCOMPARE(records.at(1), QStringList({QStringLiteral("b"), QStringLiteral("c")}));
+        QCOMPARE(records.at(2), QStringList{QString(64, QLatin1Char('y'))});
+        QCOMPARE(records.at(3), QStringList{QStringLiteral("d")});
+        QCOMPARE(reader.truncatedRecords(), 2);
+    }
+
+    // no half characters at the cut
+    CSVReader reader(',', 4);
+    Records records;
+    reader.feed("\xe2\x82\xac\xe2\x82\xac\n", records);
+    QCOMPARE(records, Records{{QStringLiteral("€")}});
+}
+
+void CSVReaderTest::testGuessSeparator()
+{
+    QCOMPARE(CSVReader::guessSeparator("a,b,c\n1;2;3;4;5\n"), ',');
+    QCOMPARE(CSVReader::guessSeparator("a\tb\tc"), '\t');
+    QCOMPARE(CSVReader::guessSeparator("a;b;\"c,d,e\""), ';');
+    QCOMPARE(CSVReader::guessSeparator("a|b"), '|');
+    QCOMPARE(CSVReader::guessSeparator("single column"), ',');
+}
+
+void CSVReaderTest::benchmarkRead()
+{
+    // about 40 MiB, some of the fields quoted
+    QByteArray text;
+    for (int i = 0; i < 500000; ++i) {
+        text += QByteArray::number(i) + ",name " + QByteArray::number(i) + ",\"street " + QByteArray::number(i) + ", city\",12.5,,\"say \"\"hi\"\"\"\n";
+        text += QByteArray::number(i) + ",plain,fields,only,here,ok\n";
+    }
+
+    QBENCHMARK {
+        CSVReader reader(',');
+        Records records;
+        qsizetype count = 0;
+        // in chunks like RBQLInput reads them
+        for (qsizetype pos = 0; pos < text.size(); pos += 256 * 1024) {
+            reader.feed(QByteArrayView(text).sliced(pos, std::min<qsizetype>(256 * 1024, text.size() - pos)), records);
+            count += records.size();
+            records.clear();
+        }
+        reader.finish(records);
+        count += records.size();
+        QCOMPARE(count, qsizetype(1000000));
+    }
+}
+
+#include "moc_csvreadertest.cpp"
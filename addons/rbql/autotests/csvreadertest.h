@@ -0,0 +1,21 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QObject>
+
+class CSVReaderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRecords_data();
+    void testRecords();
+    void testChunks();
+    void testRecordSizeLimit();
+    void testGuessSeparator();
+
+    void benchmarkRead();
+};
@@ -5,6 +5,7 @@
 */
 
 #include "FolderFilesList.h"
+#include "katetrace.h"
 
 #include <QDebug>
 #include <QDir>
@@ -30,6 +31,11 @@ FolderFilesList::~FolderFilesList()
 
 void FolderFilesList::run()
 {
+    KateTrace::Zone zone("search", "FolderFilesList::run");
+    if (zone.isActive()) {
+        zone.setDetail(m_folder);
+    }
+
     m_files.clear();
 
     /**
@@ -125,6 +125,28 @@ void MatchModel::clear()
     endResetModel();
 }
 
+qint64 MatchModel::matchCount() const
+{
+    qint64 count = 0;
+    for (const auto &matchFile : m_matchFiles) {
+        count += matchFile.matches.size();
+    }
+    return count;
+}
+
+qint64 MatchModel::approximateMemoryUsage() const
+{
+    qint64 bytes = m_matchFiles.size() * qint64(sizeof(MatchFile));
+    for (const auto &matchFile : m_matchFiles) {
+        bytes += matchFile.fileUrl.toString().size() * qint64(sizeof(QChar));
+        for (const auto &match : matchFile.matches) {
+            const qsizetype characters = match.preMatchStr.size() + match.matchStr.size() + match.postMatchStr.size() + match.replaceText.size();
+            bytes += qint64(sizeof(KateSearchMatch)) + characters * qint64(sizeof(QChar));
+        }
+    }
+    return bytes;
+}
+
 /** This function returns the row index of the specified file.
  * If the file does not exist in the model, the file will be added to the model. */
 int MatchModel::matchFileRow(const QUrl &fileUrl, KTextEditor::Document *doc) const
@@ -128,6 +128,12 @@ public:
         return m_matchFiles.isEmpty();
     }
 
+    /** Number of matches over all files */
+    qint64 matchCount() const;
+
+    /** Estimate of the memory used by the matches and their context text */
+    qint64 approximateMemoryUsage() const;
+
     const QList<KateSearchMatch> &fileMatches(KTextEditor::Document *doc) const;
 
     void updateMatchRanges(const QList<KTextEditor::MovingRange *> &ranges);
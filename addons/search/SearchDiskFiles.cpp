@@ -6,6 +6,8 @@
 */
 
 #include "SearchDiskFiles.h"
+#include "kateresourceusage.h"
+#include "katetrace.h"
 
 #include <QDir>
 #include <QElapsedTimer>
@@ -24,6 +26,9 @@ SearchDiskFiles::SearchDiskFiles(SearchDiskFilesWorkList &worklist, const QRegul
 
 void SearchDiskFiles::run()
 {
+    KATE_TRACE_ZONE("search", "SearchDiskFiles::run");
+    KateResourceUsage::CpuScope cpu("Search");
+
     // do we need to search multiple lines?
     const bool multiLineSearch = m_regExp.patternOptions().testFlag(QRegularExpression::MultilineOption) && m_regExp.pattern().contains(QLatin1String("\\n"));
 
@@ -52,6 +57,10 @@ void SearchDiskFiles::run()
         }
 
         // let the right search algorithm compute the matches for this file
+        KateTrace::Zone zone("search", "SearchDiskFiles::searchFile");
+        if (zone.isActive()) {
+            zone.setDetail(fileName);
+        }
         QList<KateSearchMatch> matches;
         if (multiLineSearch) {
             matches = searchMultiLineRegExp(file);
@@ -5,6 +5,7 @@
 */
 
 #include "SearchOpenFiles.h"
+#include "katetrace.h"
 
 SearchOpenFiles::SearchOpenFiles(QObject *parent)
     : QObject(parent)
@@ -81,6 +82,11 @@ void SearchOpenFiles::doSearchNextFile(int startLine)
 
 int SearchOpenFiles::searchOpenFile(KTextEditor::Document *doc, const QRegularExpression &regExp, int startLine)
 {
+    KateTrace::Zone zone("search", "SearchOpenFiles::searchOpenFile");
+    if (zone.isActive()) {
+        zone.setDetail(doc->url().toString());
+    }
+
     if (m_statusTime.elapsed() > 100) {
         m_statusTime.restart();
         Q_EMIT searching(doc->url().toString());
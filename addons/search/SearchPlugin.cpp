@@ -34,6 +34,7 @@
 #include <QMenu>
 #include <QPoint>
 
+#include <kateresourceusage.h>
 #include <ktexteditor_utils.h>
 
 static QUrl localFileDirUp(const QUrl &url)
@@ -580,6 +581,20 @@ KatePluginSearchView::KatePluginSearchView(KTextEditor::Plugin *plugin, KTextEdi
     auto e = KTextEditor::Editor::instance();
     connect(e, &KTextEditor::Editor::configChanged, this, &KatePluginSearchView::updateViewColors);
     updateViewColors();
+
+    KateResourceUsage::self()->addReporter(QStringLiteral("Search"), this, [this](KateResourceUsage::Report &report) {
+        qint64 matches = 0;
+        qint64 bytes = 0;
+        for (int i = 0; i < m_ui.resultWidget->count(); ++i) {
+            if (auto results = qobject_cast<Results *>(m_ui.resultWidget->widget(i))) {
+                matches += results->matchModel.matchCount();
+                bytes += results->matchModel.approximateMemoryUsage();
+            }
+        }
+        report.add(QStringLiteral("Result tabs"), m_ui.resultWidget->count());
+        report.add(QStringLiteral("Matches"), matches, bytes);
+        report.add(QStringLiteral("Moving ranges"), m_matchRanges.size());
+    });
 }
 
 KatePluginSearchView::~KatePluginSearchView()
@@ -0,0 +1,330 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "symbolparsertest.h"
+#include "symbollexer.h"
+#include "symbolparser.h"
+
+#include <QTest>
+
+#include <algorithm>
+
+QTEST_MAIN(SymbolParserTest)
+
+using Language = SymbolParser::Language;
+
+static QStringList cppLines()
+{
+    QStringList lines;
+    lines << QStringLiteral("#include <stdio.h>") << QStringLiteral("#define LIMIT 10") << QString();
+    for (int i = 0; i < 50; ++i) {
+        lines << QStringLiteral("/* function %1 */").arg(i);
+        lines << QStringLiteral("static int function%1(int a, int b)").arg(i);
+        lines << QStringLiteral("{");
+        lines << QStringLiteral("    if (a > b) {");
+        lines << QStringLiteral("        return a;");
+        lines << QStringLiteral("    }");
+        lines << QStringLiteral("    return b;");
+        lines << QStringLiteral("}");
+        lines << QString();
+    }
+    return lines;
+}
+
+static void compareNodes(const SymbolNode &actual, const SymbolNode &expected)
+{
+    QCOMPARE(actual.text, expected.text);
+    QCOMPARE(actual.toolTip, expected.toolTip);
+    QCOMPARE(actual.line, expected.line);
+    QCOMPARE(actual.icon, expected.icon);
+    QCOMPARE(actual.expanded, expected.expanded);
+    QCOMPARE(actual.children.size(), expected.children.size());
+    auto child = actual.children.begin();
+    for (const auto &expectedChild : expected.children) {
+        compareNodes(*child++, expectedChild);
+    }
+}
+
+void SymbolParserTest::testCpp()
+{
+    const auto result = SymbolParser::parse(Language::Cpp, {}, cppLines(), nullptr);
+    QVERIFY(result);
+    QCOMPARE(result->root.children.size(), size_t(51));
+
+    const SymbolNode &macro = result->root.children.front();
+    QCOMPARE(macro.text, QStringLiteral("LIMIT"));
+    QCOMPARE(macro.line, 1);
+    QCOMPARE(macro.icon, SymbolNode::Context);
+
+    const SymbolNode &function = *std::next(result->root.children.begin());
+    QCOMPARE(function.text, QStringLiteral("function0"));
+    QCOMPARE(function.toolTip, QStringLiteral("int function0(int a, int b)"));
+    QCOMPARE(function.line, 4);
+    QCOMPARE(function.icon, SymbolNode::Class);
+
+    // a function starts at every comment line before it
+    QVERIFY(std::find(result->checkpoints.begin(), result->checkpoints.end(), 3) != result->checkpoints.end());
+    QVERIFY(std::find(result->checkpoints.begin(), result->checkpoints.end(), 5) == result->checkpoints.end());
+}
+
+void SymbolParserTest::testCppStrings()
+{
+    // the brace in the string doesn't end the function
+    const QStringList lines = {
+        QStringLiteral("static void first()"),
+        QStringLiteral("{"),
+        QStringLiteral("    const char *s = \"}\"; // }"),
+        QStringLiteral("}"),
+        QStringLiteral("static void second()"),
+        QStringLiteral("{"),
+        QStringLiteral("}"),
+    };
+
+    const auto result = SymbolParser::parse(Language::Cpp, {}, lines, nullptr);
+    QVERIFY(result);
+    QCOMPARE(result->root.children.size(), size_t(2));
+    QCOMPARE(result->root.children.front().text, QStringLiteral("first"));
+    QCOMPARE(result->root.children.back().text, QStringLiteral("second"));
+    QCOMPARE(result->root.children.back().line, 4);
+}
+
+void SymbolParserTest::testPython()
+{
+    const QStringList lines = {
+        QStringLiteral("class Foo:"),
+        QStringLiteral("    def bar(self):"),
+        QStringLiteral("        pass"),
+        QString(),
+        QStringLiteral("def baz(x):"),
+        QStringLiteral("    return x"),
+    };
+
+    SymbolParser::Options options;
+    options.tree = true;
+    const auto result = SymbolParser::parse(Language::Python, options, lines, nullptr);
+    QVERIFY(result);
+    QVERIFY(result->rootIsDecorated);
+    QCOMPARE(result->macroText, QStringLiteral("Show Functions"));
+
+    // the groups come first, then the symbols below them
+    QCOMPARE(result->root.children.size(), size_t(2));
+    const SymbolNode &classes = result->root.children.front();
+    const SymbolNode &functions = result->root.children.back();
+    QCOMPARE(classes.line, -1);
+    QCOMPARE(classes.children.size(), size_t(1));
+    QCOMPARE(classes.children.front().text, QStringLiteral("Foo"));
+    QCOMPARE(classes.children.front().children.size(), size_t(1));
+    QCOMPARE(classes.children.front().children.front().text, QStringLiteral("bar"));
+    QCOMPARE(classes.children.front().children.front().line, 1);
+    QCOMPARE(functions.children.size(), size_t(1));
+    QCOMPARE(functions.children.front().text, QStringLiteral("baz"));
+    QCOMPARE(functions.children.front().line, 4);
+}
+
+void SymbolParserTest::testPythonDocstrings()
+{
+    const QStringList lines = {
+        QStringLiteral("class Foo:"),
+        QStringLiteral("    \"\"\"A class."),
+        QStringLiteral("    def fake(self):"),
+        QStringLiteral("    \"\"\""),
+        QStringLiteral("    def bar(self):  # comment"),
+        QStringLiteral("        return '''"),
+        QStringLiteral("def no():"),
+        QStringLiteral("'''"),
+        QStringLiteral("def baz(x=\"#\"):"),
+    };
+
+    const auto result = SymbolParser::parse(Language::Python, {}, lines, nullptr);
+    QVERIFY(result);
+    QCOMPARE(result->root.children.size(), size_t(3));
+    auto node = result->root.children.begin();
+    QCOMPARE(node->text, QStringLiteral("Foo"));
+    QCOMPARE((++node)->text, QStringLiteral("bar"));
+    QCOMPARE(node->line, 4);
+    QCOMPARE((++node)->text, QStringLiteral("baz"));
+    QCOMPARE(node->line, 8);
+}
+
+void SymbolParserTest::testUnchanged()
+{
+    const auto previous = SymbolParser::parse(Language::Cpp, {}, cppLines(), nullptr);
+    QVERIFY(previous);
+    QCOMPARE(SymbolParser::parse(Language::Cpp, {}, cppLines(), previous), previous);
+
+    // parsed another way nothing can be reused
+    SymbolParser::Options options;
+    options.tree = true;
+    const auto tree = SymbolParser::parse(Language::Cpp, options, cppLines(), previous);
+    QVERIFY(tree);
+    QVERIFY(tree != previous);
+    QCOMPARE(tree->root.children.size(), size_t(3));
+}
+
+void SymbolParserTest::testIncremental_data()
+{
+    QTest::addColumn<bool>("tree");
+    QTest::addColumn<int>("line");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<QStringList>("inserted");
+
+    const QStringList newFunction = {QStringLiteral("void added()"), QStringLiteral("{"), QStringLiteral("}")};
+    for (bool tree : {false, true}) {
+        const char *mode = tree ? "tree" : "list";
+        QTest::addRow("%s: rename", mode) << tree << 193 << 1 << QStringList{QStringLiteral("static int renamed(int a, int b)")};
+        QTest::addRow("%s: insert function", mode) << tree << 111 << 0 << newFunction;
+        QTest::addRow("%s: insert in function", mode) << tree << 204 << 0 << QStringList{QStringLiteral("    a++;")};
+        QTest::addRow("%s: remove function", mode) << tree << 120 << 9 << QStringList();
+        QTest::addRow("%s: open comment", mode) << tree << 300 << 1 << QStringList{QStringLiteral("/* unterminated")};
+        QTest::addRow("%s: new macro", mode) << tree << 2 << 0 << QStringList{QStringLiteral("#define OTHER 1")};
+        QTest::addRow("%s: first line", mode) << tree << 0 << 1 << QStringList{QStringLiteral("#define FIRST 1")};
+        QTest::addRow("%s: append", mode) << tree << 453 << 0 << newFunction;
+        QTest::addRow("%s: remove end", mode) << tree << 400 << 53 << QStringList();
+    }
+}
+
+void SymbolParserTest::testIncremental()
+{
+    QFETCH(bool, tree);
+    QFETCH(int, line);
+    QFETCH(int, removed);
+    QFETCH(QStringList, inserted);
+
+    SymbolParser::Options options;
+    options.tree = tree;
+
+    QStringList lines = cppLines();
+    const auto previous = SymbolParser::parse(Language::Cpp, options, lines, nullptr);
+    QVERIFY(previous);
+
+    lines.remove(line, removed);
+    for (const auto &text : std::as_const(inserted)) {
+        lines.insert(line++, text);
+    }
+
+    // continuing from the previous run gives what parsing it all again does
+    const auto incremental = SymbolParser::parse(Language::Cpp, options, lines, previous);
+    const auto full = SymbolParser::parse(Language::Cpp, options, lines, nullptr);
+    QVERIFY(incremental);
+    QVERIFY(full);
+    compareNodes(incremental->root, full->root);
+    QCOMPARE(incremental->checkpoints, full->checkpoints);
+}
+
+void SymbolParserTest::testCanceled()
+{
+    QStringList lines;
+    for (int i = 0; i < 20; ++i) {
+        lines << cppLines();
+    }
+
+    int calls = 0;
+    const auto result = SymbolParser::parse(Language::Cpp, {}, lines, nullptr, [&calls]() {
+        return ++calls < 2;
+    });
+    QVERIFY(!result);
+    QCOMPARE(calls, 2);
+}
+
+static const SymbolLexer::Rules CRules = {
+    .lineComment = QLatin1String("//"),
+    .blockCommentStart = QLatin1String("/*"),
+    .blockCommentEnd = QLatin1String("*/"),
+    .quotes = QLatin1String("'\""),
+};
+
+void SymbolParserTest::testLexer_data()
+{
+    QTest::addColumn<bool>("keepQuotes");
+    QTest::addColumn<QString>("line");
+    QTest::addColumn<QString>("code");
+
+    QTest::addRow("code") << false << QStringLiteral("int a = b / c;") << QStringLiteral("int a = b / c;");
+    QTest::addRow("line comment") << false << QStringLiteral("int a; // comment") << QStringLiteral("int a; ");
+    QTest::addRow("inline comment") << false << QStringLiteral("int /* no */ a;") << QStringLiteral("int  a;");
+    QTest::addRow("strings") << false << QStringLiteral("f(\"a\", 'b')") << QStringLiteral("f(, )");
+    QTest::addRow("kept quotes") << true << QStringLiteral("f(\"a\", 'b')") << QStringLiteral("f(\"\", '')");
+    QTest::addRow("escaped quote") << true << QStringLiteral("f(\"a\\\"b\", c)") << QStringLiteral("f(\"\", c)");
+    QTest::addRow("escaped escape") << true << QStringLiteral("f(\"a\\\\\", c)") << QStringLiteral("f(\"\", c)");
+    QTest::addRow("comment in string") << false << QStringLiteral("s = \"http://kate\" + t") << QStringLiteral("s =  + t");
+    QTest::addRow("quote in comment") << false << QStringLiteral("a /* \" */ b") << QStringLiteral("a  b");
+    QTest::addRow("unterminated string") << true << QStringLiteral("s = \"abc") << QStringLiteral("s = \"");
+}
+
+void SymbolParserTest::testLexer()
+{
+    QFETCH(bool, keepQuotes);
+    QFETCH(QString, line);
+    QFETCH(QString, code);
+
+    SymbolLexer::Rules rules = CRules;
+    rules.keepQuotes = keepQuotes;
+    SymbolLexer lexer(rules);
+    QCOMPARE(lexer.strip(line), code);
+    QVERIFY(!lexer.inBlockComment());
+}
+
+void SymbolParserTest::testLexerBlockComment()
+{
+    SymbolLexer lexer(CRules);
+    QCOMPARE(lexer.strip(u"a /* b"), QStringLiteral("a "));
+    QVERIFY(lexer.inBlockComment());
+    QCOMPARE(lexer.strip(u"\"c // d"), QString());
+    QVERIFY(lexer.inBlockComment());
+    QCOMPARE(lexer.strip(u"e */ f"), QStringLiteral(" f"));
+    QVERIFY(!lexer.inBlockComment());
+}
+
+void SymbolParserTest::testLexerOtherBlockComment()
+{
+    // like Julia, the block comments start like the line comments
+    const SymbolLexer::Rules rules = {
+        .lineComment = QLatin1String("#"),
+        .blockCommentStart = QLatin1String("#="),
+        .blockCommentEnd = QLatin1String("=#"),
+        .otherBlockCommentStart = QLatin1String("\"\"\""),
+        .otherBlockCommentEnd = QLatin1String("\"\"\""),
+        .quotes = QLatin1String("\""),
+    };
+
+    SymbolLexer lexer(rules);
+    QCOMPARE(lexer.strip(u"a #= b =# c # d"), QStringLiteral("a  c "));
+    QVERIFY(!lexer.inBlockComment());
+    QCOMPARE(lexer.strip(u"e \"\"\" f =#"), QStringLiteral("e "));
+    QVERIFY(lexer.inBlockComment());
+    // only the end of the open comment ends it
+    QCOMPARE(lexer.strip(u"\"\"\" g \"h\""), QStringLiteral(" g "));
+    QVERIFY(!lexer.inBlockComment());
+}
+
+void SymbolParserTest::benchmarkParse_data()
+{
+    QTest::addColumn<SymbolParser::Language>("language");
+    QTest::addColumn<QStringList>("lines");
+
+    QStringList cpp;
+    QStringList ecma;
+    for (int i = 0; i < 100; ++i) {
+        cpp << cppLines();
+        ecma << QStringLiteral("// object %1").arg(i) << QStringLiteral("var object%1 = {").arg(i)
+             << QStringLiteral("    name: \"object /* %1 */\",").arg(i) << QStringLiteral("    run: function(a, b) { /* add */ return a + b; },")
+             << QStringLiteral("    stop: function() {") << QStringLiteral("        return 'done'; // stopped") << QStringLiteral("    }")
+             << QStringLiteral("};") << QString();
+    }
+    QTest::addRow("cpp") << SymbolParser::Language::Cpp << cpp;
+    QTest::addRow("ecma") << SymbolParser::Language::Ecma << ecma;
+}
+
+void SymbolParserTest::benchmarkParse()
+{
+    QFETCH(SymbolParser::Language, language);
+    QFETCH(QStringList, lines);
+
+    QBENCHMARK {
+        QVERIFY(SymbolParser::parse(language, {}, lines, nullptr));
+    }
+}
+
+#include "moc_symbolparsertest.cpp"
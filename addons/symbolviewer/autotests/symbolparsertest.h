@@ -0,0 +1,30 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QObject>
+
+class SymbolParserTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testCpp();
+    void testCppStrings();
+    void testPython();
+    void testPythonDocstrings();
+    void testUnchanged();
+    void testIncremental_data();
+    void testIncremental();
+    void testCanceled();
+    void testLexer_data();
+    void testLexer();
+    void testLexerBlockComment();
+    void testLexerOtherBlockComment();
+
+    void benchmarkParse_data();
+    void benchmarkParse();
+};
@@ -9,64 +9,53 @@
    SPDX-License-Identifier: GPL-2.0-or-later
 ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseBashSymbols(void)
+void SymbolParser::parseBashSymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *funcNode = nullptr;
-    QTreeWidgetItem *lastFuncNode = nullptr;
+    SymbolNode *node = nullptr;
+    SymbolNode *funcNode = nullptr;
 
     // It is necessary to change names
-    m_func->setText(i18n("Show Functions"));
+    m_result.functionText = i18n("Show Functions");
 
-    if (m_treeOn->isChecked()) {
-        funcNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        funcNode->setIcon(0, m_icon_function);
+    if (m_options.tree) {
+        funcNode = m_root->addChild(i18n("Functions"));
+        funcNode->icon = SymbolNode::Function;
 
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(funcNode);
+        if (m_options.expand) {
+            funcNode->expanded = true;
         }
-
-        lastFuncNode = funcNode;
-
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
-    KTextEditor::Document *kDoc = m_mainWindow->activeView()->document();
-
     static const QRegularExpression function_regexp(QLatin1String("^(function )?([a-zA-Z0-9-_]+) *\\( *\\)"));
     QRegularExpressionMatch match;
 
-    for (int i = 0; i < kDoc->lines(); i++) {
-        QString currline = kDoc->line(i).trimmed().simplified();
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!checkpoint(i)) {
+            break;
+        }
+        QString currline = m_lines.at(i).trimmed().simplified();
 
         if (currline.isEmpty() || currline.at(0) == QLatin1Char('#')) {
             continue;
         }
 
-        if (m_func->isChecked()) {
+        if (m_options.functions) {
             match = function_regexp.match(currline);
             if (match.hasMatch()) {
                 QString funcName = match.captured(2);
                 funcName.append(QLatin1String("()"));
 
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(funcNode, lastFuncNode);
-                    lastFuncNode = node;
+                if (m_options.tree) {
+                    node = funcNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
 
-                node->setText(0, funcName);
-                node->setIcon(0, m_icon_function);
-                node->setText(1, QString::number(i, 10));
+                node->text = funcName;
+                node->icon = SymbolNode::Function;
+                node->line = i;
             }
         }
     }
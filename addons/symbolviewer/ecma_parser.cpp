@@ -10,92 +10,37 @@
  *   SPDX-License-Identifier: GPL-2.0-or-later
  *                                                                         *
  ***************************************************************************/
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseEcmaSymbols(void)
-{
-    // make sure there is an active view to attach to
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
+static const SymbolLexer::Rules EcmaRules = {
+    .lineComment = QLatin1String("//"),
+    .blockCommentStart = QLatin1String("/*"),
+    .blockCommentEnd = QLatin1String("*/"),
+    .quotes = QLatin1String("'\""),
+};
 
+void SymbolParser::parseEcmaSymbols()
+{
     // a parsed class/function identifier
     QString identifier;
-    // temporary characters
-    QChar current, next, string_start = QLatin1Char('\0');
-    // whether we are in a multiline comment
-    bool in_comment = false;
+    // the current character
+    QChar current;
+    // strips comments and strings, keeps track of multiline comments
+    SymbolLexer lexer(EcmaRules);
     // indices into the string
     int c, function_start = 0;
     // a list of inserted nodes with the index being the brace depth at insertion
-    QList<QTreeWidgetItem *> nodes;
+    QList<SymbolNode *> nodes;
 
-    QTreeWidgetItem *node = nullptr;
-
-    if (m_treeOn->isChecked()) {
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
-    }
+    SymbolNode *node = nullptr;
 
     // read the document line by line
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
-    for (int i = 0; i < kv->lines(); i++) {
-        // get a line to process, trimming off whitespace
-        QString cl = kv->line(i).trimmed();
-        QString stripped; // the current line stripped of all comments and strings
-        bool in_string = false;
-        for (c = 0; c < cl.length(); c++) {
-            // get the current character and the next
-            current = cl.at(c);
-            if ((c + 1) < cl.length()) {
-                next = cl.at(c + 1);
-            } else {
-                next = QLatin1Char('\0');
-            }
-            // skip the rest of the line if we find a line comment
-            if ((!in_comment) && (current == QLatin1Char('/')) && (next == QLatin1Char('/'))) {
-                break;
-            }
-            // open/close multiline comments
-            if ((!in_string) && (current == QLatin1Char('/')) && (next == QLatin1Char('*'))) {
-                in_comment = true;
-                c++;
-                continue;
-            } else if ((in_comment) && (current == QLatin1Char('*')) && (next == QLatin1Char('/'))) {
-                in_comment = false;
-                c++;
-                continue;
-            }
-            // open strings
-            if ((!in_comment) && (!in_string)) {
-                if ((current == QLatin1Char('\'')) || (current == QLatin1Char('"'))) {
-                    string_start = current;
-                    in_string = true;
-                    continue;
-                }
-            }
-            // close strings
-            if (in_string) {
-                // skip escaped backslashes
-                if ((current == QLatin1Char('\\')) && (next == QLatin1Char('\\'))) {
-                    c++;
-                    continue;
-                }
-                // skip escaped string closures
-                if ((current == QLatin1Char('\\')) && (next == string_start)) {
-                    c++;
-                    continue;
-                } else if (current == string_start) {
-                    in_string = false;
-                    continue;
-                }
-            }
-            // add anything outside strings and comments to the stripped line
-            if ((!in_comment) && (!in_string)) {
-                stripped += current;
-            }
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!lexer.inBlockComment() && nodes.isEmpty() && node == nullptr && !checkpoint(i)) {
+            break;
         }
+        // the current line stripped of all comments and strings
+        const QString stripped = lexer.strip(QStringView(m_lines.at(i)).trimmed());
 
         // scan the stripped line
         for (c = 0; c < stripped.length(); c++) {
@@ -118,20 +63,20 @@ void KatePluginSymbolViewerView::parseEcmaSymbols(void)
                 // trim whitespace
                 identifier = identifier.trimmed();
                 // get the node to add the class entry to
-                if ((m_treeOn->isChecked()) && (!nodes.isEmpty())) {
-                    node = new QTreeWidgetItem(nodes.last());
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(node);
+                if ((m_options.tree) && (!nodes.isEmpty())) {
+                    node = nodes.last()->addChild();
+                    if (m_options.expand) {
+                        node->expanded = true;
                     }
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
                 // add an entry for the class
-                node->setText(0, identifier);
-                node->setIcon(0, m_icon_class);
-                node->setText(1, QString::number(i, 10));
-                if (m_expandOn->isChecked()) {
-                    m_symbols->expandItem(node);
+                node->text = identifier;
+                node->icon = SymbolNode::Class;
+                node->line = i;
+                if (m_options.expand) {
+                    node->expanded = true;
                 }
             } // (look for classes)
 
@@ -197,30 +142,30 @@ void KatePluginSymbolViewerView::parseEcmaSymbols(void)
                 // if we have a function identifier, make a node
                 if (identifier.length() > 0) {
                     // make a node for the function
-                    QTreeWidgetItem *parent = nullptr;
+                    SymbolNode *parent = nullptr;
                     if (!nodes.isEmpty()) {
                         parent = nodes.last();
                     }
-                    if ((m_treeOn->isChecked()) && (parent != nullptr)) {
-                        node = new QTreeWidgetItem(parent);
+                    if ((m_options.tree) && (parent != nullptr)) {
+                        node = parent->addChild();
                     } else {
-                        node = new QTreeWidgetItem(m_symbols);
+                        node = m_root->addChild();
                     }
                     // mark the parent as a class (if it's not the root level)
                     if (parent != nullptr) {
-                        parent->setIcon(0, m_icon_class);
+                        parent->icon = SymbolNode::Class;
                         // mark this function as a method of the parent
-                        node->setIcon(0, m_icon_function);
+                        node->icon = SymbolNode::Function;
                     }
                     // mark root-level functions as classes
                     else {
-                        node->setIcon(0, m_icon_class);
+                        node->icon = SymbolNode::Class;
                     }
                     // add the function
-                    node->setText(0, identifier);
-                    node->setText(1, QString::number(i, 10));
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(node);
+                    node->text = identifier;
+                    node->line = i;
+                    if (m_options.expand) {
+                        node->expanded = true;
                     }
                 }
             } // (look for functions)
@@ -245,24 +190,24 @@ void KatePluginSymbolViewerView::parseEcmaSymbols(void)
 
                 // if we have an id, make a node
                 if (identifier.length() > 0) {
-                    QTreeWidgetItem *parent = nullptr;
+                    SymbolNode *parent = nullptr;
                     if (!nodes.isEmpty()) {
                         parent = nodes.last();
                     }
-                    if ((m_treeOn->isChecked()) && (parent != nullptr)) {
-                        node = new QTreeWidgetItem(parent);
+                    if ((m_options.tree) && (parent != nullptr)) {
+                        node = parent->addChild();
                     } else {
-                        node = new QTreeWidgetItem(m_symbols);
+                        node = m_root->addChild();
                     }
 
                     // mark the node as a class
-                    node->setIcon(0, m_icon_class);
+                    node->icon = SymbolNode::Class;
 
                     // add the id
-                    node->setText(0, identifier);
-                    node->setText(1, QString::number(i, 10));
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(node);
+                    node->text = identifier;
+                    node->line = i;
+                    if (m_options.expand) {
+                        node->expanded = true;
                     }
                 }
             }
@@ -285,6 +230,5 @@ void KatePluginSymbolViewerView::parseEcmaSymbols(void)
                 }
             }
         } // (scan the stripped line)
-
     } // (iterate through lines of the document)
 }
@@ -11,14 +11,18 @@
  *                                                                         *
  ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseFortranSymbols(void)
-{
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
+// quotes in strings are doubled, “it''s”
+static const SymbolLexer::Rules FortranRules = {
+    .lineComment = QLatin1String("!"),
+    .quotes = QLatin1String("'\""),
+    .escape = QChar(),
+    .keepQuotes = true,
+};
 
+void SymbolParser::parseFortranSymbols()
+{
     QString subrStr(QStringLiteral("subroutine "));
     QString funcStr(QStringLiteral("function "));
     QString modStr(QStringLiteral("module "));
@@ -26,42 +30,37 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
     QString stripped;
     int fnd, block = 0, blockend = 0, paro = 0, parc = 0;
     bool mainprog;
+    SymbolLexer lexer(FortranRules);
 
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *subrNode = nullptr, *funcNode = nullptr, *modNode = nullptr;
-    QTreeWidgetItem *lastSubrNode = nullptr, *lastFuncNode = nullptr, *lastModNode = nullptr;
+    SymbolNode *node = nullptr;
+    SymbolNode *subrNode = nullptr, *funcNode = nullptr, *modNode = nullptr;
 
     // It is necessary to change names
-    m_macro->setText(i18n("Show Subroutines"));
-    m_struct->setText(i18n("Show Modules"));
-    m_func->setText(i18n("Show Functions"));
-
-    if (m_treeOn->isChecked()) {
-        funcNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        subrNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Subroutines")));
-        modNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Modules")));
-        funcNode->setIcon(0, m_icon_function);
-        modNode->setIcon(0, m_icon_block);
-        subrNode->setIcon(0, m_icon_context);
-
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(funcNode);
-            m_symbols->expandItem(subrNode);
-            m_symbols->expandItem(modNode);
+    m_result.macroText = i18n("Show Subroutines");
+    m_result.structText = i18n("Show Modules");
+    m_result.functionText = i18n("Show Functions");
+
+    if (m_options.tree) {
+        funcNode = m_root->addChild(i18n("Functions"));
+        subrNode = m_root->addChild(i18n("Subroutines"));
+        modNode = m_root->addChild(i18n("Modules"));
+        funcNode->icon = SymbolNode::Function;
+        modNode->icon = SymbolNode::Block;
+        subrNode->icon = SymbolNode::Context;
+
+        if (m_options.expand) {
+            funcNode->expanded = true;
+            subrNode->expanded = true;
+            modNode->expanded = true;
         }
-
-        lastSubrNode = subrNode;
-        lastFuncNode = funcNode;
-        lastModNode = modNode;
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
-    KTextEditor::Document *kDoc = m_mainWindow->activeView()->document();
-
-    for (int i = 0; i < kDoc->lines(); i++) {
-        QString currline = kDoc->line(i);
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (block == 0 && blockend == 0 && paro == 0 && parc == 0 && stripped.isEmpty() && !checkpoint(i)) {
+            break;
+        }
+        // without comments, their parentheses don't count
+        QString currline = lexer.strip(m_lines.at(i));
         currline = currline.trimmed();
         // currline = currline.simplified(); is this really needed ?
         // Fortran is case insensitive
@@ -71,7 +70,7 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
         if (currline.isEmpty()) {
             continue;
         }
-        if (currline.at(0) == QLatin1Char('!') || currline.at(0) == QLatin1Char('c')) {
+        if (currline.at(0) == QLatin1Char('c')) {
             comment = true;
         }
         // block=0;
@@ -106,7 +105,7 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
                 if (currline.startsWith(QLatin1String("program "))) {
                     mainprog = true;
                 }
-                if (m_macro->isChecked()) // not really a macro, but a subroutines
+                if (m_options.macros) // not really a macro, but a subroutines
                 {
                     stripped += QStringView(currline).right(currline.length());
                     stripped = stripped.simplified();
@@ -118,10 +117,6 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
                         stripped = currline.right(currline.length() - fnd - 1);
                     }
                     stripped.remove(QLatin1Char(' '));
-                    fnd = stripped.indexOf(QLatin1Char('!'));
-                    if (fnd > 0) {
-                        stripped.truncate(fnd);
-                    }
                     paro += currline.count(QLatin1Char(')'), Qt::CaseSensitive);
                     parc += currline.count(QLatin1Char('('), Qt::CaseSensitive);
 
@@ -131,15 +126,14 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
                             stripped.prepend(QLatin1String("Main: "));
                         }
                         if (stripped.indexOf(QLatin1Char('=')) == -1) {
-                            if (m_treeOn->isChecked()) {
-                                node = new QTreeWidgetItem(subrNode, lastSubrNode);
-                                lastSubrNode = node;
+                            if (m_options.tree) {
+                                node = subrNode->addChild();
                             } else {
-                                node = new QTreeWidgetItem(m_symbols);
+                                node = m_root->addChild();
                             }
-                            node->setText(0, stripped);
-                            node->setIcon(0, m_icon_context);
-                            node->setText(1, QString::number(i, 10));
+                            node->text = stripped;
+                            node->icon = SymbolNode::Context;
+                            node->line = i;
                         }
                         stripped.clear();
                         block = 0;
@@ -154,26 +148,21 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
 
             // Modules
             else if (block == 2) {
-                if (m_struct->isChecked()) // not really a struct, but a module
+                if (m_options.structures) // not really a struct, but a module
                 {
                     stripped = currline.right(currline.length());
                     stripped = stripped.simplified();
                     fnd = stripped.indexOf(QLatin1Char(' '));
                     stripped = currline.right(currline.length() - fnd - 1);
-                    fnd = stripped.indexOf(QLatin1Char('!'));
-                    if (fnd > 0) {
-                        stripped.truncate(fnd);
-                    }
                     if (stripped.indexOf(QLatin1Char('=')) == -1) {
-                        if (m_treeOn->isChecked()) {
-                            node = new QTreeWidgetItem(modNode, lastModNode);
-                            lastModNode = node;
+                        if (m_options.tree) {
+                            node = modNode->addChild();
                         } else {
-                            node = new QTreeWidgetItem(m_symbols);
+                            node = m_root->addChild();
                         }
-                        node->setText(0, stripped);
-                        node->setIcon(0, m_icon_context);
-                        node->setText(1, QString::number(i, 10));
+                        node->text = stripped;
+                        node->icon = SymbolNode::Context;
+                        node->line = i;
                     }
                     stripped.clear();
                 }
@@ -183,7 +172,7 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
 
             // Functions
             else if (block == 3) {
-                if (m_func->isChecked()) {
+                if (m_options.functions) {
                     stripped += QStringView(currline).right(currline.length());
                     stripped = stripped.trimmed();
                     stripped.remove(QLatin1String("function"));
@@ -191,25 +180,20 @@ void KatePluginSymbolViewerView::parseFortranSymbols(void)
                     stripped.remove(QLatin1Char('+'));
                     stripped.remove(QLatin1Char('$'));
                     stripped = stripped.simplified();
-                    fnd = stripped.indexOf(QLatin1Char('!'));
-                    if (fnd > 0) {
-                        stripped.truncate(fnd);
-                    }
                     stripped = stripped.trimmed();
                     paro += currline.count(QLatin1Char(')'), Qt::CaseSensitive);
                     parc += currline.count(QLatin1Char('('), Qt::CaseSensitive);
 
                     if (paro == parc && stripped.endsWith(QLatin1Char('&')) == false) {
                         stripped.remove(QLatin1Char('&'));
-                        if (m_treeOn->isChecked()) {
-                            node = new QTreeWidgetItem(funcNode, lastFuncNode);
-                            lastFuncNode = node;
+                        if (m_options.tree) {
+                            node = funcNode->addChild();
                         } else {
-                            node = new QTreeWidgetItem(m_symbols);
+                            node = m_root->addChild();
                         }
-                        node->setText(0, stripped);
-                        node->setIcon(0, m_icon_function);
-                        node->setText(1, QString::number(i, 10));
+                        node->text = stripped;
+                        node->icon = SymbolNode::Function;
+                        node->line = i;
                         stripped.clear();
                         block = 0;
                         paro = 0;
@@ -12,23 +12,28 @@
  *   SPDX-License-Identifier: LGPL-2.0-or-later
  *                                                                         *
  ***************************************************************************/
-#include "plugin_katesymbolviewer.h"
-
-#include <KTextEditor/Document>
+#include "symbolparser.h"
 
 enum class Type { Function, Structure, Macro, Method };
 
-void KatePluginSymbolViewerView::parseJuliaSymbols(void)
+// docstrings and #= =# are block comments for us, ' is no quote but also the adjoint operator
+static const SymbolLexer::Rules JuliaRules = {
+    .lineComment = QLatin1String("#"),
+    .blockCommentStart = QLatin1String("#="),
+    .blockCommentEnd = QLatin1String("=#"),
+    .otherBlockCommentStart = QLatin1String("\"\"\""),
+    .otherBlockCommentEnd = QLatin1String("\"\"\""),
+    .quotes = QLatin1String("\""),
+    .keepQuotes = true,
+};
+
+void SymbolParser::parseJuliaSymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
+    m_result.macroText = i18n("Show Macros");
+    m_result.structText = i18n("Show Structures");
+    m_result.functionText = i18n("Show Functions");
 
-    m_macro->setText(i18n("Show Macros"));
-    m_struct->setText(i18n("Show Structures"));
-    m_func->setText(i18n("Show Functions"));
-
-    bool commentLine = false;
+    SymbolLexer lexer(JuliaRules);
     bool terseFunctionExpresion = false;
 
     Type type;
@@ -42,45 +47,30 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
     QString mutable_kw;
     QString lastControl;
 
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *functionNode = nullptr, *mtdNode = nullptr, *clsNode = nullptr;
-    QTreeWidgetItem *lastMcrNode = nullptr, *lastMtdNode = nullptr, *lastClsNode = nullptr;
-    QTreeWidgetItem *macroNode = nullptr;
-    QTreeWidgetItem *lastMacroNode = nullptr;
-
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
+    SymbolNode *node = nullptr;
+    SymbolNode *functionNode = nullptr, *mtdNode = nullptr, *clsNode = nullptr;
+    SymbolNode *macroNode = nullptr;
 
-    if (m_treeOn->isChecked()) {
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Structures")));
-        functionNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        macroNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Macros")));
+    if (m_options.tree) {
+        clsNode = m_root->addChild(i18n("Structures"));
+        functionNode = m_root->addChild(i18n("Functions"));
+        macroNode = m_root->addChild(i18n("Macros"));
 
-        functionNode->setIcon(0, m_icon_function);
-        clsNode->setIcon(0, m_icon_class);
-        macroNode->setIcon(0, m_icon_context);
+        functionNode->icon = SymbolNode::Function;
+        clsNode->icon = SymbolNode::Class;
+        macroNode->icon = SymbolNode::Context;
 
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(functionNode);
-            m_symbols->expandItem(clsNode);
-            m_symbols->expandItem(macroNode);
+        if (m_options.expand) {
+            functionNode->expanded = true;
+            clsNode->expanded = true;
+            macroNode->expanded = true;
         }
-        lastClsNode = clsNode;
-        lastMcrNode = functionNode;
-        lastMacroNode = macroNode;
         mtdNode = clsNode;
-        lastMtdNode = clsNode;
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
     static const QString contStr(QChar(0x21b5));
     // static const QString contStr(0x21b5);
 
-    static const QRegularExpression comment_regexp(QLatin1String("[#]"), QRegularExpression::UseUnicodePropertiesOption);
-    static const QRegularExpression ml_docsctring_regexp(QLatin1String("\"\"\""), QRegularExpression::UseUnicodePropertiesOption);
-    static const QRegularExpression sl_docstring_regexp(QLatin1String("\"\"\"(.*)?\"\"\""), QRegularExpression::UseUnicodePropertiesOption);
-
     static const QRegularExpression class_regexp(QLatin1String("(@[a-zA-Z0-9_\\s]+)?(?:struct|mutable\\s+struct)\\s+([\\w!a-zA-Z0-9_.]+)"),
                                                  QRegularExpression::UseUnicodePropertiesOption);
 
@@ -99,10 +89,12 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
 
     QRegularExpressionMatch match;
 
-    for (int i = 0; i < kv->lines(); i++) {
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!lexer.inBlockComment() && !checkpoint(i)) {
+            break;
+        }
         int line = i;
-        int indexOfHash = -1;
-        QString cl = kv->line(i);
+        QString cl = m_lines.at(i);
         if (cl.isEmpty()) {
             continue;
         }
@@ -111,8 +103,8 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
         while (cl[cl.length() - 1] == QLatin1Char('\\')) {
             cl = cl.left(cl.length() - 1);
             i++;
-            if (i < kv->lines()) {
-                cl += kv->line(i);
+            if (i < lineCount()) {
+                cl += m_lines.at(i);
             } else {
                 break;
             }
@@ -121,15 +113,12 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
             }
         }
 
-        QString cl_sp = cl.simplified();
-
-        // strip away comments
-        indexOfHash = cl_sp.indexOf(QLatin1Char('#'));
-        if (indexOfHash > 0) {
-            cl_sp = cl_sp.left(indexOfHash - 1);
-        } else if (indexOfHash == 0) {
+        // strip away comments and doc strings
+        const QString cl_sp = lexer.strip(cl).simplified();
+        if (cl_sp.isEmpty()) {
             continue;
         }
+
         // skip asserts
         match = assert_regexp.match(cl_sp);
 
@@ -137,41 +126,6 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
             continue;
         }
 
-        // skip # comments
-        match = comment_regexp.match(cl_sp);
-
-        if (match.hasMatch()) {
-            continue;
-        }
-
-        // BEGIN skip doc strings """ ... """ or """
-        // """
-        //
-        match = ml_docsctring_regexp.match(cl_sp); // match """ anywhere
-
-        if (match.hasMatch()) {
-            match = sl_docstring_regexp.match(cl_sp);
-            if (match.hasMatch()) {
-                commentLine = false;
-                continue;
-
-            } else {
-                commentLine = !commentLine;
-                continue;
-            }
-        } else {
-            match = sl_docstring_regexp.match(cl_sp);
-            if (match.hasMatch()) {
-                commentLine = false;
-                continue;
-            }
-        }
-
-        if (commentLine) {
-            continue;
-        }
-        // END skip doc strings (""" ... """)
-
         terseFunctionExpresion = false;
 
         whereStmt.clear();
@@ -180,7 +134,6 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
 
         if (match.hasMatch()) {
             type = Type::Structure;
-
         } else {
             match = macro_regexp.match(cl_sp);
             if (match.hasMatch()) {
@@ -225,17 +178,14 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
                                 params += QLatin1String(" ");
                                 params += whereStmt;
                             }
-
                         } else {
                             continue;
                         }
-
                     } else {
                         name = match.captured(2);
                         params = match.captured(3);
                         whereStmt = match.captured(4);
                     }
-
                 } else if (type == Type::Macro) {
                     name = match.captured(1);
                     params = match.captured(3);
@@ -248,7 +198,6 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
                         if (whereStmt.isEmpty() && !params.contains(QLatin1String("where"))) {
                             params += QLatin1Char(' ');
                             params += contStr;
-
                         } else {
                             params += QLatin1String(" ");
                             params += whereStmt;
@@ -258,65 +207,60 @@ void KatePluginSymbolViewerView::parseJuliaSymbols(void)
                 }
             }
 
-            if (m_typesOn->isChecked()) {
+            if (m_options.types) {
                 name += params;
             }
 
-            if (m_func->isChecked() && type == Type::Structure) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(clsNode, lastClsNode);
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(node);
+            if (m_options.functions && type == Type::Structure) {
+                if (m_options.tree) {
+                    node = clsNode->addChild();
+                    if (m_options.expand) {
+                        node->expanded = true;
                     }
-                    lastClsNode = node;
-                    mtdNode = lastClsNode;
-                    lastMtdNode = lastClsNode;
+                    mtdNode = node;
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
 
-                node->setText(0, name);
-                node->setIcon(0, m_icon_class);
-                node->setText(1, QString::number(line, 10));
+                node->text = name;
+                node->icon = SymbolNode::Class;
+                node->line = line;
             }
 
-            if (m_struct->isChecked() && type == Type::Method) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(mtdNode, lastMtdNode);
-                    lastMtdNode = node;
+            if (m_options.structures && type == Type::Method) {
+                if (m_options.tree) {
+                    node = mtdNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
 
-                node->setText(0, name);
-                node->setIcon(0, m_icon_function);
-                node->setText(1, QString::number(line, 10));
+                node->text = name;
+                node->icon = SymbolNode::Function;
+                node->line = line;
             }
 
-            if (m_macro->isChecked() && type == Type::Function) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(functionNode, lastMcrNode);
-                    lastMcrNode = node;
+            if (m_options.macros && type == Type::Function) {
+                if (m_options.tree) {
+                    node = functionNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
 
-                node->setText(0, name);
-                node->setIcon(0, m_icon_function);
-                node->setText(1, QString::number(line, 10));
+                node->text = name;
+                node->icon = SymbolNode::Function;
+                node->line = line;
             }
 
-            if (m_macro->isChecked() && type == Type::Macro) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(macroNode, lastMacroNode);
-                    lastMacroNode = node;
+            if (m_options.macros && type == Type::Macro) {
+                if (m_options.tree) {
+                    node = macroNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
 
-                node->setText(0, name);
-                node->setIcon(0, m_icon_function);
-                node->setText(1, QString::number(line, 10));
+                node->text = name;
+                node->icon = SymbolNode::Function;
+                node->line = line;
             }
 
             name.clear();
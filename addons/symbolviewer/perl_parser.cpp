@@ -10,48 +10,44 @@
  *   SPDX-License-Identifier: GPL-2.0-or-later
  *                                                                         *
  ***************************************************************************/
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parsePerlSymbols(void)
-{
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
+// “sub a { # b” => “sub a { ”, strings are kept for “use lib 'path'”, POD blocks only start at the start of a line
+static const SymbolLexer::Rules PerlRules = {
+    .lineComment = QLatin1String("#"),
+};
 
-    m_macro->setText(i18n("Show Uses"));
-    m_struct->setText(i18n("Show Pragmas"));
-    m_func->setText(i18n("Show Subroutines"));
+void SymbolParser::parsePerlSymbols()
+{
+    m_result.macroText = i18n("Show Uses");
+    m_result.structText = i18n("Show Pragmas");
+    m_result.functionText = i18n("Show Subroutines");
     bool is_comment = false;
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *mcrNode = nullptr, *sctNode = nullptr, *clsNode = nullptr;
-    QTreeWidgetItem *lastMcrNode = nullptr, *lastSctNode = nullptr, *lastClsNode = nullptr;
-
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
+    SymbolLexer lexer(PerlRules);
+    SymbolNode *node = nullptr;
+    SymbolNode *mcrNode = nullptr, *sctNode = nullptr, *clsNode = nullptr;
 
     // kdDebug(13000)<<"Lines counted :"<<kv->numLines()<<endl;
-    if (m_treeOn->isChecked()) {
-        mcrNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Uses")));
-        sctNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Pragmas")));
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Subroutines")));
-        mcrNode->setIcon(0, m_icon_block);
-        sctNode->setIcon(0, m_icon_context);
-        clsNode->setIcon(0, m_icon_class);
+    if (m_options.tree) {
+        mcrNode = m_root->addChild(i18n("Uses"));
+        sctNode = m_root->addChild(i18n("Pragmas"));
+        clsNode = m_root->addChild(i18n("Subroutines"));
+        mcrNode->icon = SymbolNode::Block;
+        sctNode->icon = SymbolNode::Context;
+        clsNode->icon = SymbolNode::Class;
 
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(mcrNode);
-            m_symbols->expandItem(sctNode);
-            m_symbols->expandItem(clsNode);
+        if (m_options.expand) {
+            mcrNode->expanded = true;
+            sctNode->expanded = true;
+            clsNode->expanded = true;
         }
-        lastMcrNode = mcrNode;
-        lastSctNode = sctNode;
-        lastClsNode = clsNode;
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
-    for (int i = 0; i < kv->lines(); i++) {
-        QString cl = kv->line(i);
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!is_comment && !checkpoint(i)) {
+            break;
+        }
+        QString cl = m_lines.at(i);
         // qDebug()<< "Line " << i << " : "<< cl;
 
         if (cl.isEmpty() || cl.at(0) == QLatin1Char('#')) {
@@ -68,59 +64,56 @@ void KatePluginSymbolViewerView::parsePerlSymbols(void)
             continue;
         }
 
-        cl = cl.trimmed();
+        cl = lexer.strip(cl).trimmed();
         // qDebug()<<"Trimmed line " << i << " : "<< cl;
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^use +[A-Z]"))) == 0 && m_macro->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^use +[A-Z]"))) == 0 && m_options.macros) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^use +")));
             // stripped=stripped.replace( QRegularExpression(QLatin1String(";$")), "" ); // Doesn't work ??
             stripped = stripped.left(stripped.indexOf(QLatin1Char(';')));
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(mcrNode, lastMcrNode);
-                lastMcrNode = node;
+            if (m_options.tree) {
+                node = mcrNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_block);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Block;
+            node->line = i;
         }
 #if 1
-        if (cl.indexOf(QRegularExpression(QLatin1String("^use +[a-z]"))) == 0 && m_struct->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^use +[a-z]"))) == 0 && m_options.structures) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^use +")));
             stripped.remove(QRegularExpression(QLatin1String(";$")));
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(sctNode, lastSctNode);
-                lastMcrNode = node;
+            if (m_options.tree) {
+                node = sctNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_context);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Context;
+            node->line = i;
         }
 #endif
 #if 1
-        if (cl.indexOf(QRegularExpression(QLatin1String("^sub +"))) == 0 && m_func->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^sub +"))) == 0 && m_options.functions) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^sub +")));
             stripped.remove(QRegularExpression(QLatin1String("[{;] *$")));
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(clsNode, lastClsNode);
-                lastClsNode = node;
+            if (m_options.tree) {
+                node = clsNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, stripped);
+            node->text = stripped;
 
             if (!stripped.isEmpty() && stripped.at(0) == QLatin1Char('_')) {
-                node->setIcon(0, m_icon_function);
+                node->icon = SymbolNode::Function;
             } else {
-                node->setIcon(0, m_icon_class);
+                node->icon = SymbolNode::Class;
             }
 
-            node->setText(1, QString::number(i, 10));
+            node->line = i;
         }
 #endif
     }
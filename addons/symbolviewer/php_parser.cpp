@@ -12,47 +12,44 @@
  *                                                                         *
  ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 #include <QRegularExpression>
 
-void KatePluginSymbolViewerView::parsePhpSymbols(void)
+// literals are reduced to empty strings, “function a($b='nothing')” => “function a($b='')”
+static const SymbolLexer::Rules PhpRules = {
+    .lineComment = QLatin1String("//"),
+    .otherLineComment = QLatin1String("#"),
+    .blockCommentStart = QLatin1String("/*"),
+    .blockCommentEnd = QLatin1String("*/"),
+    .quotes = QLatin1String("'\""),
+    .keepQuotes = true,
+};
+
+void SymbolParser::parsePhpSymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *namespaceNode = nullptr, *defineNode = nullptr, *classNode = nullptr, *functionNode = nullptr;
-    QTreeWidgetItem *lastNamespaceNode = nullptr, *lastDefineNode = nullptr, *lastClassNode = nullptr, *lastFunctionNode = nullptr;
-
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
-
-    if (m_treeOn->isChecked()) {
-        namespaceNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Namespaces")));
-        defineNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Defines")));
-        classNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Classes")));
-        functionNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-
-        namespaceNode->setIcon(0, m_icon_context);
-        defineNode->setIcon(0, m_icon_typedef);
-        classNode->setIcon(0, m_icon_class);
-        functionNode->setIcon(0, m_icon_function);
-
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(namespaceNode);
-            m_symbols->expandItem(defineNode);
-            m_symbols->expandItem(classNode);
-            m_symbols->expandItem(functionNode);
+    SymbolNode *node = nullptr;
+    SymbolNode *namespaceNode = nullptr, *defineNode = nullptr, *classNode = nullptr, *functionNode = nullptr;
+    SymbolNode *lastClassNode = nullptr;
+
+    if (m_options.tree) {
+        namespaceNode = m_root->addChild(i18n("Namespaces"));
+        defineNode = m_root->addChild(i18n("Defines"));
+        classNode = m_root->addChild(i18n("Classes"));
+        functionNode = m_root->addChild(i18n("Functions"));
+
+        namespaceNode->icon = SymbolNode::Context;
+        defineNode->icon = SymbolNode::Typedef;
+        classNode->icon = SymbolNode::Class;
+        functionNode->icon = SymbolNode::Function;
+
+        if (m_options.expand) {
+            namespaceNode->expanded = true;
+            defineNode->expanded = true;
+            classNode->expanded = true;
+            functionNode->expanded = true;
         }
 
-        lastNamespaceNode = namespaceNode;
-        lastDefineNode = defineNode;
         lastClassNode = classNode;
-        lastFunctionNode = functionNode;
-
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
     // Namespaces: https://www.php.net/manual/en/language.namespaces.php
@@ -82,24 +79,24 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
     QStringList functionArgsList;
     QString nameWithTypes;
 
-    // replace literals by empty strings: “function a($b='nothing', $c="pretty \"cool\" string")” => “function ($b='', $c="")”
-    static const QRegularExpression literalRegExp(QLatin1String("([\"'])(?:\\\\.|[^\\\\])*\\1"), QRegularExpression::InvertedGreedinessOption);
-    // remove useless comments: “public/* static */ function a($b, $c=null) /* test */” => “public function a($b, $c=null)”
-    static const QRegularExpression blockCommentInline(QLatin1String("/\\*.*\\*/"), QRegularExpression::InvertedGreedinessOption);
+    // strips the comments: “public/* static */ function a($b, $c=null) /* test */” => “public function a($b, $c=null)”
+    SymbolLexer lexer(PhpRules);
 
     QRegularExpressionMatch match, matchClass, matchInterface, matchTrait, matchFunctionArg;
     QRegularExpressionMatchIterator matchFunctionArgs;
 
-    bool inBlockComment = false;
     bool inClass = false, inFunction = false;
 
     // QString debugBuffer("SymbolViewer(PHP), line %1 %2 → [%3]");
 
-    for (int i = 0; i < kv->lines(); i++) {
-        // kdDebug(13000) << debugBuffer.arg(i, 4).arg("=origin", 10).arg(kv->line(i));
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!lexer.inBlockComment() && !inClass && !inFunction && lastClassNode == classNode && !checkpoint(i)) {
+            break;
+        }
+        // kdDebug(13000) << debugBuffer.arg(i, 4).arg("=origin", 10).arg(m_lines.at(i));
 
         // keeping a copy of the line without any processing
-        QString realLine = kv->line(i);
+        QString realLine = m_lines.at(i);
 
         QString line = realLine.simplified();
 
@@ -108,67 +105,46 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
         // keeping a copy with literals for catching “defines()”
         QString lineWithliterals = line;
 
-        // reduce literals to empty strings to not match comments separators in literals
-        line.replace(literalRegExp, QLatin1String("\\1\\1"));
-
-        // kdDebug(13000) << debugBuffer.arg(i, 4).arg("-literals", 10).arg(line);
-        line.remove(blockCommentInline);
-
-        // kdDebug(13000) << debugBuffer.arg(i, 4).arg("-comments", 10).arg(line);
+        // reduce literals to empty strings to not match comments separators in literals, and remove the comments
+        const bool inBlockComment = lexer.inBlockComment();
+        line = lexer.strip(line);
 
-        // trying to find comments and to remove commented parts
-        if (const int pos = line.indexOf(QLatin1Char('#')); pos >= 0) {
-            line.truncate(pos);
-        }
-        if (const int pos = line.indexOf(QLatin1String("//")); pos >= 0) {
-            line.truncate(pos);
-        }
-        if (const int pos = line.indexOf(QLatin1String("/*")); pos >= 0) {
-            line.truncate(pos);
-            inBlockComment = true;
-        }
-        if (const int pos = line.indexOf(QLatin1String("*/")); pos >= 0) {
-            line = line.right(line.length() - pos - 2);
-            inBlockComment = false;
-        }
+        // trimming again after having removed the comments
+        line = line.simplified();
 
-        if (inBlockComment) {
+        // nothing but comment, the functions are found in the real line
+        if (inBlockComment && line.isEmpty()) {
             continue;
         }
-
-        // trimming again after having removed the comments
-        line = line.simplified();
         // kdDebug(13000) << debugBuffer.arg(i, 4).arg("+simplified", 10).arg(line);
 
         // detect NameSpaces
         match = namespaceRegExp.match(line);
         if (match.hasMatch()) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(namespaceNode, lastNamespaceNode);
-                if (m_expandOn->isChecked()) {
-                    m_symbols->expandItem(node);
+            if (m_options.tree) {
+                node = namespaceNode->addChild();
+                if (m_options.expand) {
+                    node->expanded = true;
                 }
-                lastNamespaceNode = node;
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, match.captured(1));
-            node->setIcon(0, m_icon_context);
-            node->setText(1, QString::number(i, 10));
+            node->text = match.captured(1);
+            node->icon = SymbolNode::Context;
+            node->line = i;
         }
 
         // detect defines
         match = defineRegExp.match(lineWithliterals);
         if (match.hasMatch()) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(defineNode, lastDefineNode);
-                lastDefineNode = node;
+            if (m_options.tree) {
+                node = defineNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, match.captured(2));
-            node->setIcon(0, m_icon_typedef);
-            node->setText(1, QString::number(i, 10));
+            node->text = match.captured(2);
+            node->icon = SymbolNode::Typedef;
+            node->line = i;
         }
 
         // detect classes, interfaces and trait
@@ -176,17 +152,18 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
         matchInterface = interfaceRegExp.match(line);
         matchTrait = traitRegExp.match(line);
         if (matchClass.hasMatch() || matchInterface.hasMatch() || matchTrait.hasMatch()) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(classNode, lastClassNode);
-                if (m_expandOn->isChecked()) {
-                    m_symbols->expandItem(node);
+            nameWithTypes.clear();
+            if (m_options.tree) {
+                node = classNode->addChild();
+                if (m_options.expand) {
+                    node->expanded = true;
                 }
                 lastClassNode = node;
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
             if (matchClass.hasMatch()) {
-                if (m_typesOn->isChecked()) {
+                if (m_options.types) {
                     nameWithTypes = matchClass.captured(3);
                     if (!matchClass.captured(1).trimmed().isEmpty() && !matchClass.captured(4).trimmed().isEmpty()) {
                         nameWithTypes +=
@@ -196,28 +173,28 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
                     } else if (!matchClass.captured(4).trimmed().isEmpty()) {
                         nameWithTypes += QLatin1String(" [") + matchClass.captured(4).trimmed() + QLatin1Char(']');
                     }
-                    node->setText(0, nameWithTypes);
+                    node->text = nameWithTypes;
                 } else {
-                    node->setText(0, matchClass.captured(3));
+                    node->text = matchClass.captured(3);
                 }
             } else if (matchInterface.hasMatch()) {
-                if (m_typesOn->isChecked()) {
+                if (m_options.types) {
                     nameWithTypes = matchInterface.captured(1) + QLatin1String(" [interface]");
-                    node->setText(0, nameWithTypes);
+                    node->text = nameWithTypes;
                 } else {
-                    node->setText(0, matchInterface.captured(1));
+                    node->text = matchInterface.captured(1);
                 }
             } else {
-                if (m_typesOn->isChecked()) {
+                if (m_options.types) {
                     nameWithTypes = matchTrait.captured(1) + QLatin1String(" [trait]");
-                    node->setText(0, nameWithTypes);
+                    node->text = nameWithTypes;
                 } else {
-                    node->setText(0, matchTrait.captured(1));
+                    node->text = matchTrait.captured(1);
                 }
             }
-            node->setIcon(0, m_icon_class);
-            node->setText(1, QString::number(i, 10));
-            node->setToolTip(0, nameWithTypes);
+            node->icon = SymbolNode::Class;
+            node->line = i;
+            node->toolTip = nameWithTypes;
             inClass = true;
             inFunction = false;
         }
@@ -225,43 +202,43 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
         // detect class constants
         match = constantRegExp.match(line);
         if (match.hasMatch()) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(lastClassNode);
+            if (m_options.tree) {
+                node = lastClassNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, match.captured(1));
-            node->setIcon(0, m_icon_typedef);
-            node->setText(1, QString::number(i, 10));
+            node->text = match.captured(1);
+            node->icon = SymbolNode::Typedef;
+            node->line = i;
         }
 
         // detect class variables
         if (inClass && !inFunction) {
             match = varRegExp.match(line);
             if (match.hasMatch()) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(lastClassNode);
+                if (m_options.tree) {
+                    node = lastClassNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
-                node->setText(0, match.captured(4));
-                node->setIcon(0, m_icon_variable);
-                node->setText(1, QString::number(i, 10));
+                node->text = match.captured(4);
+                node->icon = SymbolNode::Variable;
+                node->line = i;
             }
         }
 
         // detect functions
         match = functionRegExp.match(realLine);
         if (match.hasMatch()) {
-            if (m_treeOn->isChecked()) {
+            if (m_options.tree) {
                 if (match.captured(1).isEmpty() && match.captured(2).isEmpty()) {
                     inClass = false;
-                    node = new QTreeWidgetItem(lastFunctionNode);
+                    node = functionNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(lastClassNode);
+                    node = lastClassNode->addChild();
                 }
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
             QString functionArgs(match.captured(6));
@@ -273,15 +250,15 @@ void KatePluginSymbolViewerView::parsePhpSymbols(void)
             }
 
             nameWithTypes = match.captured(5) + QLatin1Char('(') + functionArgsList.join(QLatin1String(", ")) + QLatin1Char(')');
-            if (m_typesOn->isChecked()) {
-                node->setText(0, nameWithTypes);
+            if (m_options.types) {
+                node->text = nameWithTypes;
             } else {
-                node->setText(0, match.captured(5));
+                node->text = match.captured(5);
             }
 
-            node->setIcon(0, m_icon_function);
-            node->setText(1, QString::number(i, 10));
-            node->setToolTip(0, nameWithTypes);
+            node->icon = SymbolNode::Function;
+            node->line = i;
+            node->toolTip = nameWithTypes;
 
             functionArgsList.clear();
 
@@ -38,6 +38,7 @@
  ***************************************************************************/
 
 #include "plugin_katesymbolviewer.h"
+#include "katetaskscheduler.h"
 
 #include <KConfigGroup>
 #include <KFuzzyMatcher>
@@ -56,6 +57,22 @@
 
 #include <QHeaderView>
 
+#include <algorithm>
+
+// how far we look ahead for an item that is still there, the ones in between are gone
+static constexpr int LookAhead = 64;
+
+// sorts the way QTreeWidget does, the items stay in place once sorting is enabled again
+static void sortSymbols(SymbolNode &node, Qt::SortOrder order)
+{
+    node.children.sort([order](const SymbolNode &l, const SymbolNode &r) {
+        return order == Qt::AscendingOrder ? l.text < r.text : r.text < l.text;
+    });
+    for (auto &child : node.children) {
+        sortSymbols(child, order);
+    }
+}
+
 K_PLUGIN_FACTORY_WITH_JSON(KatePluginSymbolViewerFactory, "katesymbolviewerplugin.json", registerPlugin<KatePluginSymbolViewer>();)
 
 KatePluginSymbolViewerView::KatePluginSymbolViewerView(KatePluginSymbolViewer *plugin, KTextEditor::MainWindow *mw)
@@ -159,6 +176,9 @@ KatePluginSymbolViewerView::KatePluginSymbolViewerView(KatePluginSymbolViewer *p
 
 KatePluginSymbolViewerView::~KatePluginSymbolViewerView()
 {
+    // the parser task uses our members
+    KateTaskScheduler::self()->cancelAndWait(this);
+
     // un-register view
     m_plugin->m_views.remove(this);
 
@@ -307,17 +327,18 @@ void KatePluginSymbolViewerView::parseSymbols()
         return;
     }
 
-    m_symbols->clear();
-    // Qt docu recommends to populate view with disabled sorting
-    // https://doc.qt.io/qt-5/qtreeview.html#sortingEnabled-prop
-    m_symbols->setSortingEnabled(false);
-    Qt::SortOrder sortOrder = m_symbols->header()->sortIndicatorOrder();
+    KTextEditor::Document *doc = m_mainWindow->activeView() ? m_mainWindow->activeView()->document() : nullptr;
 
-    if (!m_mainWindow->activeView()) {
-        return;
+    // the symbols of another document are of no use
+    if (doc != m_resultDocument) {
+        m_symbols->clear();
+        m_lastResult.reset();
+        m_resultDocument = doc;
     }
 
-    KTextEditor::Document *doc = m_mainWindow->activeView()->document();
+    // results still underway are outdated now
+    const quint64 generation = ++m_parseGeneration;
+    KateTaskScheduler::self()->cancel(m_parseTask);
 
     // be sure we have some document around !
     if (!doc) {
@@ -327,35 +348,11 @@ void KatePluginSymbolViewerView::parseSymbols()
     /** Get the current highlighting mode */
     QString hlModeName = doc->mode();
 
-    if (hlModeName.contains(QLatin1String("C++")) || hlModeName == QLatin1Char('C') || hlModeName == QLatin1String("ANSI C89")) {
-        parseCppSymbols();
-    } else if (hlModeName == QLatin1String("PHP (HTML)")) {
-        parsePhpSymbols();
-    } else if (hlModeName == QLatin1String("Tcl/Tk")) {
-        parseTclSymbols();
-    } else if (hlModeName.contains(QLatin1String("Fortran"))) {
-        parseFortranSymbols();
-    } else if (hlModeName == QLatin1String("Perl")) {
-        parsePerlSymbols();
-    } else if (hlModeName == QLatin1String("Python")) {
-        parsePythonSymbols();
-    } else if (hlModeName == QLatin1String("Ruby")) {
-        parseRubySymbols();
-    } else if (hlModeName == QLatin1String("Java")) {
-        parseCppSymbols();
-    } else if (hlModeName == QLatin1String("Groovy")) {
-        parseCppSymbols();
-    } else if (hlModeName == QLatin1String("xslt")) {
-        parseXsltSymbols();
-    } else if (hlModeName == QLatin1String("XML") || hlModeName == QLatin1String("HTML")) {
-        parseXMLSymbols();
-    } else if (hlModeName == QLatin1String("Bash")) {
-        parseBashSymbols();
-    } else if (hlModeName == QLatin1String("ActionScript 2.0") || hlModeName == QLatin1String("JavaScript") || hlModeName == QLatin1String("QML")) {
-        parseEcmaSymbols();
-    } else if (hlModeName == QLatin1String("Julia")) {
-        parseJuliaSymbols();
-    } else {
+    const SymbolParser::Language language = SymbolParser::language(hlModeName);
+    if (language == SymbolParser::Language::Unsupported) {
+        m_symbols->clear();
+        m_lastResult.reset();
+
         QTreeWidgetItem *node = new QTreeWidgetItem(m_symbols);
         node->setText(0, i18n("Sorry, not supported yet!"));
         // Setting invalid line number avoid jump to top of document when clicked
@@ -363,6 +360,80 @@ void KatePluginSymbolViewerView::parseSymbols()
         node = new QTreeWidgetItem(m_symbols);
         node->setText(0, i18n("File type: %1", hlModeName));
         node->setText(1, QStringLiteral("-1"));
+
+        slotFilterChange(m_filter->text());
+        return;
+    }
+
+    SymbolParser::Options options;
+    options.tree = m_treeOn->isChecked();
+    options.expand = m_expandOn->isChecked();
+    options.types = m_typesOn->isChecked();
+    options.macros = m_macro->isChecked();
+    options.structures = m_struct->isChecked();
+    options.functions = m_func->isChecked();
+
+    // the parser works on a copy, the document may change while it runs
+    QStringList lines;
+    lines.reserve(doc->lines());
+    for (int i = 0; i < doc->lines(); ++i) {
+        lines.push_back(doc->line(i));
+    }
+
+    m_parseTask = KateTaskScheduler::self()->schedule(
+        KateTaskScheduler::Visible,
+        i18n("Parsing symbols"),
+        [this, generation, doc = QPointer<KTextEditor::Document>(doc), language, options, lines, previous = m_lastResult](KateTaskScheduler::Token &token) {
+            auto result = SymbolParser::parse(language, options, lines, previous, [&token]() {
+                return token.checkpoint();
+            });
+            if (!result) {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, doc, result]() {
+                    showSymbols(generation, doc, result);
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+void KatePluginSymbolViewerView::showSymbols(quint64 generation, KTextEditor::Document *doc, const std::shared_ptr<const SymbolParser::Result> &result)
+{
+    if (generation != m_parseGeneration || !doc || doc != m_resultDocument) {
+        return;
+    }
+
+    // shown another way the items are of no use
+    if (!m_lastResult || m_lastResult->language != result->language || !(m_lastResult->options == result->options)) {
+        m_symbols->clear();
+    }
+    m_lastResult = result;
+
+    if (!result->macroText.isEmpty()) {
+        m_macro->setText(result->macroText);
+    }
+    if (!result->structText.isEmpty()) {
+        m_struct->setText(result->structText);
+    }
+    if (!result->functionText.isEmpty()) {
+        m_func->setText(result->functionText);
+    }
+
+    // Qt docu recommends to populate view with disabled sorting
+    // https://doc.qt.io/qt-5/qtreeview.html#sortingEnabled-prop
+    m_symbols->setSortingEnabled(false);
+    Qt::SortOrder sortOrder = m_symbols->header()->sortIndicatorOrder();
+    m_symbols->setRootIsDecorated(result->rootIsDecorated);
+
+    if (m_sort->isChecked()) {
+        SymbolNode sorted = result->root;
+        sortSymbols(sorted, sortOrder);
+        updateItems(m_symbols->invisibleRootItem(), sorted);
+    } else {
+        updateItems(m_symbols->invisibleRootItem(), result->root);
     }
 
     m_oldCursorLine = -1;
@@ -375,6 +446,76 @@ void KatePluginSymbolViewerView::parseSymbols()
     slotFilterChange(m_filter->text());
 }
 
+void KatePluginSymbolViewerView::updateItems(QTreeWidgetItem *parent, const SymbolNode &node)
+{
+    // the items are matched in order, so only the symbols that changed are touched
+    int row = 0;
+    for (const auto &symbol : node.children) {
+        int match = -1;
+        const int end = std::min(parent->childCount(), row + LookAhead);
+        for (int i = row; i < end; ++i) {
+            const QTreeWidgetItem *item = parent->child(i);
+            if (item->text(0) == symbol.text && item->data(0, Qt::UserRole).toInt() == symbol.icon) {
+                match = i;
+                break;
+            }
+        }
+
+        QTreeWidgetItem *item = nullptr;
+        if (match < 0) {
+            item = new QTreeWidgetItem();
+            item->setText(0, symbol.text);
+            item->setIcon(0, symbolIcon(symbol.icon));
+            item->setData(0, Qt::UserRole, int(symbol.icon));
+            parent->insertChild(row, item);
+            if (symbol.expanded) {
+                item->setExpanded(true);
+            }
+        } else {
+            for (int i = row; i < match; ++i) {
+                delete parent->takeChild(row);
+            }
+            item = parent->child(row);
+        }
+
+        const QString line = symbol.line < 0 ? QString() : QString::number(symbol.line, 10);
+        if (item->text(1) != line) {
+            item->setText(1, line);
+        }
+        if (item->toolTip(0) != symbol.toolTip) {
+            item->setToolTip(0, symbol.toolTip);
+        }
+
+        updateItems(item, symbol);
+        ++row;
+    }
+
+    while (parent->childCount() > row) {
+        delete parent->takeChild(row);
+    }
+}
+
+QIcon KatePluginSymbolViewerView::symbolIcon(SymbolNode::Icon icon) const
+{
+    switch (icon) {
+    case SymbolNode::Block:
+        return m_icon_block;
+    case SymbolNode::Class:
+        return m_icon_class;
+    case SymbolNode::Context:
+        return m_icon_context;
+    case SymbolNode::Function:
+        return m_icon_function;
+    case SymbolNode::Typedef:
+        return m_icon_typedef;
+    case SymbolNode::Variable:
+        return m_icon_variable;
+    case SymbolNode::NoIcon:
+        break;
+    }
+    return QIcon();
+}
+
 void KatePluginSymbolViewerView::goToSymbol(QTreeWidgetItem *it)
 {
     KTextEditor::View *kv = m_mainWindow->activeView();
@@ -526,20 +667,5 @@ void KatePluginSymbolViewerConfigPage::apply()
 }
 // END KatePluginSymbolViewerConfigPage
 
-// BEGIN parsers
-#include "bash_parser.cpp"
-#include "cpp_parser.cpp"
-#include "ecma_parser.cpp"
-#include "fortran_parser.cpp"
-#include "julia_parser.cpp"
-#include "perl_parser.cpp"
-#include "php_parser.cpp"
-#include "python_parser.cpp"
-#include "ruby_parser.cpp"
-#include "tcl_parser.cpp"
-#include "xml_parser.cpp"
-#include "xslt_parser.cpp"
-// END parsers
-
 #include "moc_plugin_katesymbolviewer.cpp"
 #include "plugin_katesymbolviewer.moc"
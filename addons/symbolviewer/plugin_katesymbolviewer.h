@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include "symbolparser.h"
+
 #include <KTextEditor/ConfigPage>
+#include <KTextEditor/Document>
 #include <KTextEditor/MainWindow>
 #include <KTextEditor/Plugin>
 #include <KTextEditor/View>
@@ -23,13 +26,14 @@
 #include <QMenu>
 
 #include <QList>
+#include <QPointer>
 #include <QSet>
 #include <QTimer>
 #include <QTreeWidget>
 
 #include <KLocalizedString>
 
-enum class Symbol { Function, Class, Method };
+#include <memory>
 
 class KLineEdit;
 
@@ -135,22 +139,19 @@ private:
     QTimer m_currItemTimer;
     int m_oldCursorLine = 0;
 
+    // the symbols on display and the document they are from, the next parse continues from them
+    std::shared_ptr<const SymbolParser::Result> m_lastResult;
+    QPointer<KTextEditor::Document> m_resultDocument;
+    quint64 m_parseTask = 0;
+    quint64 m_parseGeneration = 0;
+
     void updatePixmapScroll();
 
     bool filterSymbols(QTreeWidgetItem *, const QString &);
 
-    void parseCppSymbols(void);
-    void parseTclSymbols(void);
-    void parseFortranSymbols(void);
-    void parsePerlSymbols(void);
-    void parsePythonSymbols(void);
-    void parseRubySymbols(void);
-    void parseXsltSymbols(void);
-    void parseXMLSymbols(void);
-    void parsePhpSymbols(void);
-    void parseBashSymbols(void);
-    void parseEcmaSymbols(void);
-    void parseJuliaSymbols(void);
+    void showSymbols(quint64 generation, KTextEditor::Document *doc, const std::shared_ptr<const SymbolParser::Result> &result);
+    void updateItems(QTreeWidgetItem *parent, const SymbolNode &node);
+    QIcon symbolIcon(SymbolNode::Icon icon) const;
 };
 
 class KatePluginSymbolViewer : public KTextEditor::Plugin
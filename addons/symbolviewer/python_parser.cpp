@@ -14,19 +14,28 @@
  *   SPDX-License-Identifier: GPL-2.0-or-later
  *                                                                         *
  ***************************************************************************/
-#include "plugin_katesymbolviewer.h"
-
-void KatePluginSymbolViewerView::parsePythonSymbols(void)
+#include "symbolparser.h"
+
+enum class Symbol { Function, Class, Method };
+
+// docstrings are block comments for us, default values of parameters become empty strings
+static const SymbolLexer::Rules PythonRules = {
+    .lineComment = QLatin1String("#"),
+    .blockCommentStart = QLatin1String("\"\"\""),
+    .blockCommentEnd = QLatin1String("\"\"\""),
+    .otherBlockCommentStart = QLatin1String("'''"),
+    .otherBlockCommentEnd = QLatin1String("'''"),
+    .quotes = QLatin1String("'\""),
+    .keepQuotes = true,
+};
+
+void SymbolParser::parsePythonSymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
-    m_macro->setText(i18n("Show Functions"));
-    m_struct->setText(i18n("Show Methods"));
-    m_func->setText(i18n("Show Classes"));
+    m_result.macroText = i18n("Show Functions");
+    m_result.structText = i18n("Show Methods");
+    m_result.functionText = i18n("Show Classes");
 
-    bool commentLine = false;
+    SymbolLexer lexer(PythonRules);
 
     QString name;
     QString params;
@@ -34,38 +43,25 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
     QString endcolon;
     QString current_class_name;
 
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *functionNode = nullptr, *mtdNode = nullptr, *clsNode = nullptr;
-    QTreeWidgetItem *lastMcrNode = nullptr, *lastMtdNode = nullptr, *lastClsNode = nullptr;
+    SymbolNode *node = nullptr;
+    SymbolNode *functionNode = nullptr, *mtdNode = nullptr, *clsNode = nullptr;
 
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
+    if (m_options.tree) {
+        clsNode = m_root->addChild(i18n("Classes"));
+        functionNode = m_root->addChild(i18n("Functions"));
+        functionNode->icon = SymbolNode::Function;
+        clsNode->icon = SymbolNode::Class;
 
-    if (m_treeOn->isChecked()) {
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Classes")));
-        functionNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        functionNode->setIcon(0, m_icon_function);
-        clsNode->setIcon(0, m_icon_class);
-
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(functionNode);
-            m_symbols->expandItem(clsNode);
+        if (m_options.expand) {
+            functionNode->expanded = true;
+            clsNode->expanded = true;
         }
-        lastClsNode = clsNode;
-        lastMcrNode = functionNode;
         mtdNode = clsNode;
-        lastMtdNode = clsNode;
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
     // static const QString contStr(0x21b5);
     static const QString contStr(QChar(0x21b5));
 
-    static const QRegularExpression comment_regexp(QLatin1String("^[#]"), QRegularExpression::UseUnicodePropertiesOption);
-    static const QRegularExpression ml_docsctring_regexp(QLatin1String("\"\"\""), QRegularExpression::UseUnicodePropertiesOption);
-    static const QRegularExpression sl_docstring_regexp(QLatin1String("\"\"\"(.*)?\"\"\""), QRegularExpression::UseUnicodePropertiesOption);
-
     static const QRegularExpression class_regexp(QLatin1String("^class ([\\w]+)\\s*(\\([\\w.,\\s]*\\)?)?\\s*(:$)?"),
                                                  QRegularExpression::UseUnicodePropertiesOption);
 
@@ -75,9 +71,12 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
 
     QRegularExpressionMatch match;
 
-    for (int i = 0; i < kv->lines(); i++) {
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!lexer.inBlockComment() && current_class_name.isEmpty() && !checkpoint(i)) {
+            break;
+        }
         int line = i;
-        QString cl = kv->line(i);
+        QString cl = m_lines.at(i);
         if (cl.isEmpty()) {
             continue;
         }
@@ -85,8 +84,8 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
         while (cl[cl.length() - 1] == QLatin1Char('\\')) {
             cl = cl.left(cl.length() - 1);
             i++;
-            if (i < kv->lines()) {
-                cl += kv->line(i);
+            if (i < lineCount()) {
+                cl += m_lines.at(i);
             } else {
                 break;
             }
@@ -95,27 +94,14 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
             }
         }
 
-        match = ml_docsctring_regexp.match(cl);
-
-        if (match.hasMatch()) {
-            match = sl_docstring_regexp.match(cl);
-            if (match.hasMatch()) {
-                commentLine = false;
-                continue;
-
-            } else {
-                commentLine = !commentLine;
-                continue;
-            }
-        } else {
-            match = sl_docstring_regexp.match(cl);
-            if (match.hasMatch()) {
-                commentLine = false;
-                continue;
-            }
+        // without docstrings and comments, “def a(b):  # c” still ends in its colon
+        cl = lexer.strip(cl);
+        qsizetype end = cl.size();
+        while (end > 0 && cl.at(end - 1).isSpace()) {
+            --end;
         }
-
-        if (commentLine) {
+        cl.truncate(end);
+        if (cl.isEmpty()) {
             continue;
         }
 
@@ -150,7 +136,6 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
                 params += QLatin1Char(' ');
                 params += contStr;
             }
-
         } else {
             name = match.captured(2);
             params = match.captured(3);
@@ -167,52 +152,48 @@ void KatePluginSymbolViewerView::parsePythonSymbols(void)
                 params += contStr;
             }
         }
-        if (m_typesOn->isChecked()) {
+        if (m_options.types) {
             name += params;
         }
 
-        if (m_func->isChecked() && type == Symbol::Class) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(clsNode, lastClsNode);
-                if (m_expandOn->isChecked()) {
-                    m_symbols->expandItem(node);
+        if (m_options.functions && type == Symbol::Class) {
+            if (m_options.tree) {
+                node = clsNode->addChild();
+                if (m_options.expand) {
+                    node->expanded = true;
                 }
-                lastClsNode = node;
-                mtdNode = lastClsNode;
-                lastMtdNode = lastClsNode;
+                mtdNode = node;
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
-            node->setText(0, name);
-            node->setIcon(0, m_icon_class);
-            node->setText(1, QString::number(line, 10));
+            node->text = name;
+            node->icon = SymbolNode::Class;
+            node->line = line;
         }
 
-        if (m_struct->isChecked() && type == Symbol::Method) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(mtdNode, lastMtdNode);
-                lastMtdNode = node;
+        if (m_options.structures && type == Symbol::Method) {
+            if (m_options.tree) {
+                node = mtdNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
-            node->setText(0, name);
-            node->setIcon(0, m_icon_function);
-            node->setText(1, QString::number(line, 10));
+            node->text = name;
+            node->icon = SymbolNode::Function;
+            node->line = line;
         }
 
-        if (m_macro->isChecked() && type == Symbol::Function) {
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(functionNode, lastMcrNode);
-                lastMcrNode = node;
+        if (m_options.macros && type == Symbol::Function) {
+            if (m_options.tree) {
+                node = functionNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
 
-            node->setText(0, name);
-            node->setIcon(0, m_icon_function);
-            node->setText(1, QString::number(line, 10));
+            node->text = name;
+            node->icon = SymbolNode::Function;
+            node->line = line;
         }
 
         name.clear();
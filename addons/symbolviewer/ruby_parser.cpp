@@ -10,95 +10,85 @@
  *   SPDX-License-Identifier: GPL-2.0-or-later
  *                                                                         *
  ***************************************************************************/
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseRubySymbols(void)
+void SymbolParser::parseRubySymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
-    m_macro->setText(i18n("Show Functions"));
-    m_struct->setText(i18n("Show Methods"));
-    m_func->setText(i18n("Show Classes"));
-
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *mtdNode = nullptr, *clsNode = nullptr, *functionNode = nullptr;
-    QTreeWidgetItem *lastMtdNode = nullptr, *lastClsNode = nullptr;
+    m_result.macroText = i18n("Show Functions");
+    m_result.structText = i18n("Show Methods");
+    m_result.functionText = i18n("Show Classes");
 
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
+    SymbolNode *node = nullptr;
+    SymbolNode *mtdNode = nullptr, *clsNode = nullptr, *functionNode = nullptr;
 
-    if (m_treeOn->isChecked()) {
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Classes")));
-        functionNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        clsNode->setIcon(0, m_icon_class);
-        functionNode->setIcon(0, m_icon_function);
+    if (m_options.tree) {
+        clsNode = m_root->addChild(i18n("Classes"));
+        functionNode = m_root->addChild(i18n("Functions"));
+        clsNode->icon = SymbolNode::Class;
+        functionNode->icon = SymbolNode::Function;
 
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(clsNode);
-            m_symbols->expandItem(functionNode);
+        if (m_options.expand) {
+            clsNode->expanded = true;
+            functionNode->expanded = true;
         }
-        lastClsNode = clsNode;
         mtdNode = clsNode;
-        lastMtdNode = clsNode;
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
     static const QRegularExpression function_regexp(QLatin1String("^(\\s*)def\\s+([self\\.]*[a-zA-Z0-9_]+)\\s*(\\(*.*\\)*)"));
     static const QRegularExpression class_regexp(QLatin1String("^\\s*class\\s+([a-zA-Z0-9]+)"));
     QRegularExpressionMatch match;
 
-    for (int i = 0; i < kv->lines(); i++) {
-        QString cl = kv->line(i);
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (mtdNode == clsNode && !checkpoint(i)) {
+            break;
+        }
+        QString cl = m_lines.at(i);
 
         match = class_regexp.match(cl);
         if (match.hasMatch()) {
-            if (m_func->isChecked()) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(clsNode, lastClsNode);
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(node);
+            if (m_options.functions) {
+                if (m_options.tree) {
+                    node = clsNode->addChild();
+                    if (m_options.expand) {
+                        node->expanded = true;
                     }
-                    lastClsNode = node;
-                    mtdNode = lastClsNode;
-                    lastMtdNode = lastClsNode;
+                    mtdNode = node;
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
-                node->setText(0, match.captured(1));
-                node->setIcon(0, m_icon_class);
-                node->setText(1, QString::number(i, 10));
+                node->text = match.captured(1);
+                node->icon = SymbolNode::Class;
+                node->line = i;
             }
             continue;
         }
 
         match = function_regexp.match(cl);
         if (match.hasMatch()) {
-            if (m_struct->isChecked() && match.captured(1).isEmpty()) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(functionNode);
+            if (m_options.structures && match.captured(1).isEmpty()) {
+                if (m_options.tree) {
+                    node = functionNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
-            } else if (m_macro->isChecked()) {
-                if (m_treeOn->isChecked()) {
-                    node = new QTreeWidgetItem(mtdNode, lastMtdNode);
-                    lastMtdNode = node;
+            } else if (m_options.macros) {
+                if (m_options.tree) {
+                    node = mtdNode->addChild();
                 } else {
-                    node = new QTreeWidgetItem(m_symbols);
+                    node = m_root->addChild();
                 }
+            } else {
+                continue;
             }
 
-            node->setToolTip(0, match.captured(2));
-            if (m_typesOn->isChecked()) {
-                node->setText(0, match.captured(2) + match.captured(3));
+            node->toolTip = match.captured(2);
+            if (m_options.types) {
+                node->text = match.captured(2) + match.captured(3);
             } else {
-                node->setText(0, match.captured(2));
+                node->text = match.captured(2);
             }
-            node->setIcon(0, m_icon_function);
-            node->setText(1, QString::number(i, 10));
+            node->icon = SymbolNode::Function;
+            node->line = i;
         }
     }
 }
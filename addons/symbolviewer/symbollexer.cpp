@@ -0,0 +1,119 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "symbollexer.h"
+
+#include <algorithm>
+
+SymbolLexer::SymbolLexer(const Rules &rules)
+    : m_rules(rules)
+{
+    const auto addStart = [this](QChar c) {
+        if (!m_starts.contains(c)) {
+            m_starts.append(c);
+        }
+    };
+    for (const QLatin1String delimiter : {m_rules.lineComment, m_rules.otherLineComment, m_rules.blockCommentStart, m_rules.otherBlockCommentStart}) {
+        if (!delimiter.isEmpty()) {
+            addStart(delimiter.front());
+        }
+    }
+    for (const QLatin1Char quote : m_rules.quotes) {
+        addStart(quote);
+    }
+}
+
+QString SymbolLexer::strip(QStringView line)
+{
+    QString code;
+    code.reserve(line.size());
+
+    // where each start character is found next, searched for again only once passed
+    QVarLengthArray<qsizetype, 8> found(m_starts.size(), -1);
+
+    const auto isAt = [](QStringView rest, QLatin1String delimiter) {
+        return !delimiter.isEmpty() && rest.startsWith(delimiter);
+    };
+
+    qsizetype pos = 0;
+    while (pos < line.size()) {
+        // the rest of a comment has no delimiters of interest but its end
+        if (inBlockComment()) {
+            const qsizetype end = line.indexOf(m_blockCommentEnd, pos);
+            if (end < 0) {
+                break;
+            }
+            pos = end + m_blockCommentEnd.size();
+            m_blockCommentEnd = QLatin1String();
+            continue;
+        }
+
+        // the code up to the next possible delimiter is copied in one go, Qt finds them with SIMD
+        qsizetype next = line.size();
+        for (qsizetype i = 0; i < m_starts.size(); ++i) {
+            if (found[i] < pos && found[i] != line.size()) {
+                const qsizetype index = line.indexOf(m_starts[i], pos);
+                found[i] = index < 0 ? line.size() : index;
+            }
+            next = std::min(next, found[i]);
+        }
+        code.append(line.sliced(pos, next - pos));
+        if (next == line.size()) {
+            break;
+        }
+
+        pos = next;
+        const QStringView rest = line.sliced(pos);
+        if (isAt(rest, m_rules.blockCommentStart)) {
+            m_blockCommentEnd = m_rules.blockCommentEnd;
+            pos += m_rules.blockCommentStart.size();
+            continue;
+        }
+        if (isAt(rest, m_rules.otherBlockCommentStart)) {
+            m_blockCommentEnd = m_rules.otherBlockCommentEnd;
+            pos += m_rules.otherBlockCommentStart.size();
+            continue;
+        }
+        if (isAt(rest, m_rules.lineComment) || isAt(rest, m_rules.otherLineComment)) {
+            break;
+        }
+
+        const QChar c = line[pos];
+        if (m_rules.quotes.contains(c)) {
+            const qsizetype end = stringEnd(line, pos);
+            if (m_rules.keepQuotes) {
+                code.append(c);
+                if (end < line.size()) {
+                    code.append(c);
+                }
+            }
+            pos = end + 1;
+            continue;
+        }
+
+        // just the start of something, like a single /
+        code.append(c);
+        ++pos;
+    }
+
+    return code;
+}
+
+qsizetype SymbolLexer::stringEnd(QStringView line, qsizetype start) const
+{
+    const QChar quote = line[start];
+    qsizetype end = start;
+    while ((end = line.indexOf(quote, end + 1)) >= 0) {
+        // the quote is escaped by an odd number of escapes before it
+        qsizetype escapes = 0;
+        while (!m_rules.escape.isNull() && end - escapes - 1 > start && line[end - escapes - 1] == m_rules.escape) {
+            ++escapes;
+        }
+        if (escapes % 2 == 0) {
+            return end;
+        }
+    }
+    return line.size();
+}
@@ -0,0 +1,64 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <QVarLengthArray>
+
+/**
+ * Removes the comments and the contents of the strings from lines of code, for the symbol parsers.
+ *
+ * What starts a comment or a string is defined by a small rule table per language. Block comments
+ * may span lines, the lexer remembers whether the last line ended in one. Block comments are looked
+ * for before line comments and strings, so #= can start a block comment and # a line comment.
+ */
+class SymbolLexer
+{
+public:
+    struct Rules {
+        // up to two kinds of comments to the end of the line, like // and #
+        QLatin1String lineComment;
+        QLatin1String otherLineComment;
+        QLatin1String blockCommentStart;
+        QLatin1String blockCommentEnd;
+        // a second kind of block comments, like the ''' docstrings next to """ ones
+        QLatin1String otherBlockCommentStart;
+        QLatin1String otherBlockCommentEnd;
+        // each of them starts a string it also ends, strings end at the end of the line
+        QLatin1String quotes;
+        // a null character if quotes are doubled instead, like in Fortran
+        QChar escape = QLatin1Char('\\');
+        // "text" becomes "" instead of nothing
+        bool keepQuotes = false;
+    };
+
+    explicit SymbolLexer(const Rules &rules);
+
+    /**
+     * The code of @p line, continuing the block comment of the previous line if any.
+     */
+    QString strip(QStringView line);
+
+    /**
+     * The last line ended in a block comment.
+     */
+    bool inBlockComment() const
+    {
+        return !m_blockCommentEnd.isEmpty();
+    }
+
+private:
+    // the end of the string starting at @p start, or the end of the line
+    qsizetype stringEnd(QStringView line, qsizetype start) const;
+
+private:
+    const Rules m_rules;
+    // the characters any comment or string starts with
+    QVarLengthArray<QChar, 8> m_starts;
+    // the end of the block comment the last line ended in
+    QLatin1String m_blockCommentEnd;
+};
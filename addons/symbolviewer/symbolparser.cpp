@@ -0,0 +1,256 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "symbolparser.h"
+#include "symbollexer.h"
+
+#include <KLocalizedString>
+
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <limits>
+
+// how often the parsers are asked whether to go on, in lines
+static constexpr int CheckInterval = 256;
+
+// copy the symbols of the lines [begin, end) moved by shift lines, groups are kept even if empty
+static void copySymbols(const SymbolNode &from, SymbolNode &to, int begin, int end, int shift)
+{
+    for (const auto &child : from.children) {
+        if (child.line < 0) {
+            auto &group = to.children.emplace_back();
+            group.text = child.text;
+            group.toolTip = child.toolTip;
+            group.icon = child.icon;
+            group.expanded = child.expanded;
+            copySymbols(child, group, begin, end, shift);
+        } else if (child.line >= begin && child.line < end) {
+            auto &copy = to.children.emplace_back(child);
+            if (shift != 0) {
+                const auto move = [shift](SymbolNode &node, const auto &move) -> void {
+                    node.line += node.line >= 0 ? shift : 0;
+                    for (auto &c : node.children) {
+                        move(c, move);
+                    }
+                };
+                move(copy, move);
+            }
+        }
+    }
+}
+
+// append the symbols of from, the symbols of groups with the same name are joined
+static void mergeSymbols(SymbolNode &to, SymbolNode &&from)
+{
+    for (auto &child : from.children) {
+        if (child.line < 0) {
+            auto group = std::find_if(to.children.begin(), to.children.end(), [&child](const SymbolNode &node) {
+                return node.line < 0 && node.text == child.text;
+            });
+            if (group != to.children.end()) {
+                mergeSymbols(*group, std::move(child));
+                continue;
+            }
+        }
+        to.children.push_back(std::move(child));
+    }
+}
+
+SymbolParser::Language SymbolParser::language(const QString &mode)
+{
+    if (mode.contains(QLatin1String("C++")) || mode == QLatin1Char('C') || mode == QLatin1String("ANSI C89")) {
+        return Language::Cpp;
+    } else if (mode == QLatin1String("PHP (HTML)")) {
+        return Language::Php;
+    } else if (mode == QLatin1String("Tcl/Tk")) {
+        return Language::Tcl;
+    } else if (mode.contains(QLatin1String("Fortran"))) {
+        return Language::Fortran;
+    } else if (mode == QLatin1String("Perl")) {
+        return Language::Perl;
+    } else if (mode == QLatin1String("Python")) {
+        return Language::Python;
+    } else if (mode == QLatin1String("Ruby")) {
+        return Language::Ruby;
+    } else if (mode == QLatin1String("Java") || mode == QLatin1String("Groovy")) {
+        return Language::Cpp;
+    } else if (mode == QLatin1String("xslt")) {
+        return Language::Xslt;
+    } else if (mode == QLatin1String("XML") || mode == QLatin1String("HTML")) {
+        return Language::Xml;
+    } else if (mode == QLatin1String("Bash")) {
+        return Language::Bash;
+    } else if (mode == QLatin1String("ActionScript 2.0") || mode == QLatin1String("JavaScript") || mode == QLatin1String("QML")) {
+        return Language::Ecma;
+    } else if (mode == QLatin1String("Julia")) {
+        return Language::Julia;
+    }
+    return Language::Unsupported;
+}
+
+std::shared_ptr<const SymbolParser::Result> SymbolParser::parse(Language language,
+                                                                const Options &options,
+                                                                const QStringList &lines,
+                                                                const std::shared_ptr<const Result> &previous,
+                                                                const std::function<bool()> &keepGoing)
+{
+    const bool incremental = previous && previous->language == language && previous->options == options;
+    if (incremental && previous->lines == lines) {
+        return previous;
+    }
+
+    auto result = std::make_shared<Result>();
+    result->language = language;
+    result->options = options;
+    result->lines = lines;
+    result->rootIsDecorated = options.tree;
+
+    if (!incremental) {
+        SymbolParser parser(*result, &result->root, keepGoing);
+        parser.run();
+        return parser.m_canceled ? nullptr : result;
+    }
+
+    // the lines that changed
+    const int newCount = lines.size();
+    const int oldCount = previous->lines.size();
+    const int common = std::min(newCount, oldCount);
+    int first = 0;
+    while (first < common && lines.at(first) == previous->lines.at(first)) {
+        ++first;
+    }
+    int unchangedEnd = 0;
+    while (unchangedEnd < common - first && lines.at(newCount - 1 - unchangedEnd) == previous->lines.at(oldCount - 1 - unchangedEnd)) {
+        ++unchangedEnd;
+    }
+
+    SymbolNode changed;
+    SymbolParser parser(*result, &changed, keepGoing);
+    parser.m_previous = previous.get();
+    parser.m_changeEnd = newCount - unchangedEnd;
+    parser.m_lineDelta = newCount - oldCount;
+
+    // start at the last line before the change at which the previous run was in its initial state
+    const auto &checkpoints = previous->checkpoints;
+    auto start = std::upper_bound(checkpoints.begin(), checkpoints.end(), first);
+    if (start != checkpoints.begin()) {
+        parser.m_startLine = *std::prev(start);
+        result->checkpoints.assign(checkpoints.begin(), std::prev(start));
+    }
+
+    parser.run();
+    if (parser.m_canceled) {
+        return nullptr;
+    }
+
+    if (parser.m_startLine > 0) {
+        copySymbols(previous->root, result->root, 0, parser.m_startLine, 0);
+    }
+    mergeSymbols(result->root, std::move(changed));
+
+    // the rest is what the previous run found, just moved
+    if (parser.m_stopLine >= 0) {
+        const int oldStop = parser.m_stopLine - parser.m_lineDelta;
+        SymbolNode rest;
+        copySymbols(previous->root, rest, oldStop, std::numeric_limits<int>::max(), parser.m_lineDelta);
+        mergeSymbols(result->root, std::move(rest));
+
+        for (auto it = std::lower_bound(checkpoints.begin(), checkpoints.end(), oldStop); it != checkpoints.end(); ++it) {
+            result->checkpoints.push_back(*it + parser.m_lineDelta);
+        }
+    }
+
+    return result;
+}
+
+SymbolParser::SymbolParser(Result &result, SymbolNode *root, const std::function<bool()> &keepGoing)
+    : m_result(result)
+    , m_lines(result.lines)
+    , m_options(result.options)
+    , m_root(root)
+    , m_keepGoing(keepGoing)
+{
+}
+
+void SymbolParser::run()
+{
+    switch (m_result.language) {
+    case Language::Cpp:
+        parseCppSymbols();
+        break;
+    case Language::Php:
+        parsePhpSymbols();
+        break;
+    case Language::Tcl:
+        parseTclSymbols();
+        break;
+    case Language::Fortran:
+        parseFortranSymbols();
+        break;
+    case Language::Perl:
+        parsePerlSymbols();
+        break;
+    case Language::Python:
+        parsePythonSymbols();
+        break;
+    case Language::Ruby:
+        parseRubySymbols();
+        break;
+    case Language::Xslt:
+        parseXsltSymbols();
+        break;
+    case Language::Xml:
+        parseXMLSymbols();
+        break;
+    case Language::Bash:
+        parseBashSymbols();
+        break;
+    case Language::Ecma:
+        parseEcmaSymbols();
+        break;
+    case Language::Julia:
+        parseJuliaSymbols();
+        break;
+    case Language::Unsupported:
+        break;
+    }
+}
+
+int SymbolParser::lineCount()
+{
+    if (!m_canceled && m_keepGoing && ++m_calls % CheckInterval == 0 && !m_keepGoing()) {
+        m_canceled = true;
+    }
+    return m_canceled ? 0 : m_lines.size();
+}
+
+bool SymbolParser::checkpoint(int line)
+{
+    // past the change the previous run went on the same way from here
+    if (m_previous && line >= m_changeEnd
+        && std::binary_search(m_previous->checkpoints.begin(), m_previous->checkpoints.end(), line - m_lineDelta)) {
+        m_stopLine = line;
+        return false;
+    }
+
+    m_result.checkpoints.push_back(line);
+    return true;
+}
+
+// BEGIN parsers
+#include "bash_parser.cpp"
+#include "cpp_parser.cpp"
+#include "ecma_parser.cpp"
+#include "fortran_parser.cpp"
+#include "julia_parser.cpp"
+#include "perl_parser.cpp"
+#include "php_parser.cpp"
+#include "python_parser.cpp"
+#include "ruby_parser.cpp"
+#include "tcl_parser.cpp"
+#include "xml_parser.cpp"
+#include "xslt_parser.cpp"
+// END parsers
@@ -0,0 +1,138 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+/**
+ * One entry of the symbol list, groups like "Functions" have no line.
+ */
+struct SymbolNode {
+    enum Icon : quint8 { NoIcon, Block, Class, Context, Function, Typedef, Variable };
+
+    QString text;
+    QString toolTip;
+    int line = -1;
+    Icon icon = NoIcon;
+    bool expanded = false;
+    // a list keeps the nodes in place while the parsers add to them
+    std::list<SymbolNode> children;
+
+    SymbolNode *addChild(const QString &childText = QString())
+    {
+        auto &child = children.emplace_back();
+        child.text = childText;
+        return &child;
+    }
+};
+
+/**
+ * Finds the symbols of a document for the symbol viewer.
+ *
+ * The parsers work on a copy of the text, they can run in a worker thread. They report the lines at
+ * which they are in their initial state. After an edit parsing starts again at the last such line
+ * before the change and stops at the first one after it that the previous run saw as well, the
+ * symbols before and after that are taken over from the previous run.
+ */
+class SymbolParser
+{
+public:
+    enum class Language { Unsupported, Cpp, Php, Tcl, Fortran, Perl, Python, Ruby, Xslt, Xml, Bash, Ecma, Julia };
+
+    struct Options {
+        bool tree = false;
+        bool expand = false;
+        bool types = false;
+        bool macros = true;
+        bool structures = true;
+        bool functions = true;
+
+        bool operator==(const Options &other) const = default;
+    };
+
+    struct Result {
+        Language language = Language::Unsupported;
+        Options options;
+        QStringList lines;
+        SymbolNode root;
+        bool rootIsDecorated = false;
+
+        // the texts of the show actions depend on the language, empty ones stay as they are
+        QString macroText;
+        QString structText;
+        QString functionText;
+
+        // lines at which the parser was in its initial state, sorted
+        std::vector<int> checkpoints;
+    };
+
+    /**
+     * The parser for a highlighting mode.
+     */
+    static Language language(const QString &mode);
+
+    /**
+     * Find the symbols in @p lines, reusing @p previous if it was parsed the same way.
+     * Returns nullptr once @p keepGoing returns false.
+     */
+    static std::shared_ptr<const Result> parse(Language language,
+                                               const Options &options,
+                                               const QStringList &lines,
+                                               const std::shared_ptr<const Result> &previous,
+                                               const std::function<bool()> &keepGoing = {});
+
+private:
+    SymbolParser(Result &result, SymbolNode *root, const std::function<bool()> &keepGoing);
+
+    void run();
+
+    /**
+     * The parsers loop while this is larger than their current line, for canceled runs it is 0.
+     */
+    int lineCount();
+
+    /**
+     * The parser is in its initial state at the start of @p line.
+     * Returns false if it should stop, the previous run continues from there.
+     */
+    bool checkpoint(int line);
+
+    void parseCppSymbols();
+    void parseTclSymbols();
+    void parseFortranSymbols();
+    void parsePerlSymbols();
+    void parsePythonSymbols();
+    void parseRubySymbols();
+    void parseXsltSymbols();
+    void parseXMLSymbols();
+    void parsePhpSymbols();
+    void parseBashSymbols();
+    void parseEcmaSymbols();
+    void parseJuliaSymbols();
+
+private:
+    Result &m_result;
+    const QStringList &m_lines;
+    const Options &m_options;
+    SymbolNode *m_root;
+    const std::function<bool()> &m_keepGoing;
+
+    int m_startLine = 0;
+    int m_calls = 0;
+    bool m_canceled = false;
+
+    // what we know from the previous run
+    const Result *m_previous = nullptr;
+    int m_changeEnd = 0;
+    int m_lineDelta = 0;
+    int m_stopLine = -1;
+};
@@ -11,14 +11,10 @@
  *                                                                         *
  ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseTclSymbols(void)
+void SymbolParser::parseTclSymbols()
 {
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
     QString prevline;
     bool prevComment = false;
     QString varStr(QStringLiteral("set "));
@@ -27,35 +23,29 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
     int args_par = 0, graph = 0;
     char block = 0, parse_func = 0;
 
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *mcrNode = nullptr, *clsNode = nullptr;
-    QTreeWidgetItem *lastMcrNode = nullptr, *lastClsNode = nullptr;
-
-    if (m_treeOn->isChecked()) {
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Functions")));
-        mcrNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Globals")));
-        clsNode->setIcon(0, m_icon_function);
-        mcrNode->setIcon(0, m_icon_variable);
+    SymbolNode *node = nullptr;
+    SymbolNode *mcrNode = nullptr, *clsNode = nullptr;
 
-        lastMcrNode = mcrNode;
-        lastClsNode = clsNode;
+    if (m_options.tree) {
+        clsNode = m_root->addChild(i18n("Functions"));
+        mcrNode = m_root->addChild(i18n("Globals"));
+        clsNode->icon = SymbolNode::Function;
+        mcrNode->icon = SymbolNode::Variable;
 
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(clsNode);
-            m_symbols->expandItem(mcrNode);
+        if (m_options.expand) {
+            clsNode->expanded = true;
+            mcrNode->expanded = true;
         }
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
-    KTextEditor::Document *kDoc = m_mainWindow->activeView()->document();
-
     // positions.resize(kDoc->numLines() + 3); // Maximum m_symbols number o.O
     // positions.fill(0);
 
-    for (int i = 0; i < kDoc->lines(); i++) {
-        QString currline = kDoc->line(i);
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (block == 0 && parse_func == 0 && args_par == 0 && graph == 0 && stripped.isEmpty() && !prevComment && !checkpoint(i)) {
+            break;
+        }
+        QString currline = m_lines.at(i);
         currline = currline.trimmed();
         bool comment = false;
         // qDebug(13000)<<currline;
@@ -67,7 +57,7 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
         }
 
         if (i > 0) {
-            prevline = kDoc->line(i - 1);
+            prevline = m_lines.at(i - 1);
             if (prevline.endsWith(QLatin1String("\\")) && prevComment) {
                 comment = true;
             }
@@ -76,7 +66,7 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
 
         if (!comment) {
             if (currline.startsWith(varStr) && block == 0) {
-                if (m_macro->isChecked()) // not really a macro, but a variable
+                if (m_options.macros) // not really a macro, but a variable
                 {
                     stripped = currline.right(currline.length() - 3);
                     stripped = stripped.simplified();
@@ -86,15 +76,14 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
                         stripped = stripped.left(fnd);
                     }
 
-                    if (m_treeOn->isChecked()) {
-                        node = new QTreeWidgetItem(mcrNode, lastMcrNode);
-                        lastMcrNode = node;
+                    if (m_options.tree) {
+                        node = mcrNode->addChild();
                     } else {
-                        node = new QTreeWidgetItem(m_symbols);
+                        node = m_root->addChild();
                     }
-                    node->setText(0, stripped);
-                    node->setIcon(0, m_icon_function);
-                    node->setText(1, QString::number(i, 10));
+                    node->text = stripped;
+                    node->icon = SymbolNode::Function;
+                    node->line = i;
                     stripped.clear();
                 } // macro
             } // starts with "set"
@@ -127,16 +116,15 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
                             args_par--;
                             if (args_par == 0) {
                                 // stripped = stripped.simplified();
-                                if (m_func->isChecked()) {
-                                    if (m_treeOn->isChecked()) {
-                                        node = new QTreeWidgetItem(clsNode, lastClsNode);
-                                        lastClsNode = node;
+                                if (m_options.functions) {
+                                    if (m_options.tree) {
+                                        node = clsNode->addChild();
                                     } else {
-                                        node = new QTreeWidgetItem(m_symbols);
+                                        node = m_root->addChild();
                                     }
-                                    node->setText(0, stripped);
-                                    node->setIcon(0, m_icon_variable);
-                                    node->setText(1, QString::number(i, 10));
+                                    node->text = stripped;
+                                    node->icon = SymbolNode::Variable;
+                                    node->line = i;
                                 }
                                 stripped.clear();
                                 block = 1;
@@ -144,7 +132,7 @@ void KatePluginSymbolViewerView::parseTclSymbols(void)
                         }
                     } // block = 0
                 } // for j loop
-            } // m_func->isChecked()
+            } // m_options.functions
         } // not a comment
     } // for i loop
 
@@ -14,41 +14,33 @@
  *
  ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseXMLSymbols(void)
-{
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
-
-    m_struct->setText(i18n("Show Tags"));
-
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *topNode = nullptr;
-
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
+// attribute values are kept, they are the names we show
+static const SymbolLexer::Rules XmlRules = {
+    .blockCommentStart = QLatin1String("<!--"),
+    .blockCommentEnd = QLatin1String("-->"),
+};
 
-    m_symbols->setRootIsDecorated(0);
+void SymbolParser::parseXMLSymbols()
+{
+    m_result.structText = i18n("Show Tags");
 
-    bool is_comment = false;
-    for (int i = 0; i < kv->lines(); i++) {
-        QString cl = kv->line(i);
-        cl = cl.trimmed();
+    SymbolNode *node = nullptr;
+    SymbolNode *topNode = nullptr;
 
-        if (cl.indexOf(QLatin1String("<!--")) >= 0) {
-            is_comment = true;
-        }
-        if (cl.indexOf(QLatin1String("-->")) >= 0) {
-            is_comment = false;
-            continue;
-        }
+    m_result.rootIsDecorated = false;
 
-        if (is_comment) {
-            continue;
+    SymbolLexer lexer(XmlRules);
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!m_options.tree && !lexer.inBlockComment() && !checkpoint(i)) {
+            break;
         }
+        // a tag after a comment on the same line counts, too
+        QString cl = lexer.strip(m_lines.at(i));
+        cl = cl.trimmed();
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^<[a-zA-Z_]+[a-zA-Z0-9_\\.\\-]*"))) == 0 && m_struct->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^<[a-zA-Z_]+[a-zA-Z0-9_\\.\\-]*"))) == 0 && m_options.structures) {
             /* Get the tag type */
             QString type;
             QRegularExpressionMatch match;
@@ -62,26 +54,27 @@ void KatePluginSymbolViewerView::parseXMLSymbols(void)
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^<[a-zA-Z_]+[a-zA-Z0-9_\\.\\-]* *")));
             stripped.remove(QRegularExpression(QLatin1String(" */*>.*")));
 
-            if (m_treeOn->isChecked()) {
+            if (m_options.tree) {
                 /* See if group already exists */
-                QList<QTreeWidgetItem *> reslist = m_symbols->findItems(type, Qt::MatchExactly);
-                if (reslist.isEmpty()) {
-                    topNode = new QTreeWidgetItem(m_symbols, QStringList(type));
-                    topNode->setIcon(0, m_icon_class);
-                    if (m_expandOn->isChecked()) {
-                        m_symbols->expandItem(topNode);
+                auto group = std::find_if(m_root->children.begin(), m_root->children.end(), [&type](const SymbolNode &child) {
+                    return child.line < 0 && child.text == type;
+                });
+                if (group == m_root->children.end()) {
+                    topNode = m_root->addChild(type);
+                    topNode->icon = SymbolNode::Class;
+                    if (m_options.expand) {
+                        topNode->expanded = true;
                     }
                 } else {
-                    topNode = reslist[0];
+                    topNode = &*group;
                 }
-                node = new QTreeWidgetItem(topNode);
-                topNode->addChild(node);
+                node = topNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setIcon(0, m_icon_variable);
-            node->setText(0, stripped);
-            node->setText(1, QString::number(i, 10));
+            node->icon = SymbolNode::Variable;
+            node->text = stripped;
+            node->line = i;
         }
     }
 }
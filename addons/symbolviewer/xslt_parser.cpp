@@ -11,128 +11,113 @@
  *                                                                         *
  ***************************************************************************/
 
-#include "plugin_katesymbolviewer.h"
+#include "symbolparser.h"
 
-void KatePluginSymbolViewerView::parseXsltSymbols(void)
-{
-    if (!m_mainWindow->activeView()) {
-        return;
-    }
+// attribute values are kept, they are the names we show
+static const SymbolLexer::Rules XsltRules = {
+    .blockCommentStart = QLatin1String("<!--"),
+    .blockCommentEnd = QLatin1String("-->"),
+};
 
-    m_macro->setText(i18n("Show Params"));
-    m_struct->setText(i18n("Show Variables"));
-    m_func->setText(i18n("Show Templates"));
+void SymbolParser::parseXsltSymbols()
+{
+    m_result.macroText = i18n("Show Params");
+    m_result.structText = i18n("Show Variables");
+    m_result.functionText = i18n("Show Templates");
 
-    QTreeWidgetItem *node = nullptr;
-    QTreeWidgetItem *mcrNode = nullptr, *sctNode = nullptr, *clsNode = nullptr;
-    QTreeWidgetItem *lastMcrNode = nullptr, *lastSctNode = nullptr, *lastClsNode = nullptr;
+    SymbolNode *node = nullptr;
+    SymbolNode *mcrNode = nullptr, *sctNode = nullptr, *clsNode = nullptr;
 
-    KTextEditor::Document *kv = m_mainWindow->activeView()->document();
     // kdDebug(13000)<<"Lines counted :"<<kv->numLines()<<endl;
 
-    if (m_treeOn->isChecked()) {
-        mcrNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Params")));
-        sctNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Variables")));
-        clsNode = new QTreeWidgetItem(m_symbols, QStringList(i18n("Templates")));
-        mcrNode->setIcon(0, m_icon_typedef);
-        sctNode->setIcon(0, m_icon_variable);
-        clsNode->setIcon(0, m_icon_class);
-
-        if (m_expandOn->isChecked()) {
-            m_symbols->expandItem(mcrNode);
-            m_symbols->expandItem(sctNode);
-            m_symbols->expandItem(clsNode);
+    if (m_options.tree) {
+        mcrNode = m_root->addChild(i18n("Params"));
+        sctNode = m_root->addChild(i18n("Variables"));
+        clsNode = m_root->addChild(i18n("Templates"));
+        mcrNode->icon = SymbolNode::Typedef;
+        sctNode->icon = SymbolNode::Variable;
+        clsNode->icon = SymbolNode::Class;
+
+        if (m_options.expand) {
+            mcrNode->expanded = true;
+            sctNode->expanded = true;
+            clsNode->expanded = true;
         }
-
-        lastMcrNode = mcrNode;
-        lastSctNode = sctNode;
-        lastClsNode = clsNode;
-
-        m_symbols->setRootIsDecorated(1);
-    } else {
-        m_symbols->setRootIsDecorated(0);
     }
 
-    bool is_comment = false, is_template = false;
-    for (int i = 0; i < kv->lines(); i++) {
-        QString cl = kv->line(i);
-        cl = cl.trimmed();
-
-        if (cl.indexOf(QLatin1String("<!--")) >= 0) {
-            is_comment = true;
-        }
-        if (cl.indexOf(QLatin1String("-->")) >= 0) {
-            is_comment = false;
-            continue;
+    SymbolLexer lexer(XsltRules);
+    bool is_template = false;
+    for (int i = m_startLine; i < lineCount(); i++) {
+        if (!lexer.inBlockComment() && !is_template && !checkpoint(i)) {
+            break;
         }
+        // a tag after a comment on the same line counts, too
+        QString cl = lexer.strip(m_lines.at(i));
+        cl = cl.trimmed();
 
         if (cl.indexOf(QRegularExpression(QLatin1String("^</xsl:template>"))) >= 0) {
             is_template = false;
             continue;
         }
 
-        if (is_comment || is_template) {
+        if (is_template) {
             continue;
         }
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:param "))) == 0 && m_macro->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:param "))) == 0 && m_options.macros) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^<xsl:param +name=\"")));
             stripped.remove(QRegularExpression(QLatin1String("\".*")));
 
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(mcrNode, lastMcrNode);
-                lastMcrNode = node;
+            if (m_options.tree) {
+                node = mcrNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_typedef);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Typedef;
+            node->line = i;
         }
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:variable "))) == 0 && m_struct->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:variable "))) == 0 && m_options.structures) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^<xsl:variable +name=\"")));
             stripped.remove(QRegularExpression(QLatin1String("\".*")));
 
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(sctNode, lastSctNode);
-                lastSctNode = node;
+            if (m_options.tree) {
+                node = sctNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_variable);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Variable;
+            node->line = i;
         }
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:template +match="))) == 0 && m_func->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:template +match="))) == 0 && m_options.functions) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^<xsl:template +match=\"")));
             stripped.remove(QRegularExpression(QLatin1String("\".*")));
 
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(clsNode, lastClsNode);
-                lastClsNode = node;
+            if (m_options.tree) {
+                node = clsNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_context);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Context;
+            node->line = i;
         }
 
-        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:template +name="))) == 0 && m_func->isChecked()) {
+        if (cl.indexOf(QRegularExpression(QLatin1String("^<xsl:template +name="))) == 0 && m_options.functions) {
             QString stripped = cl.remove(QRegularExpression(QLatin1String("^<xsl:template +name=\"")));
             stripped.remove(QRegularExpression(QLatin1String("\".*")));
 
-            if (m_treeOn->isChecked()) {
-                node = new QTreeWidgetItem(clsNode, lastClsNode);
-                lastClsNode = node;
+            if (m_options.tree) {
+                node = clsNode->addChild();
             } else {
-                node = new QTreeWidgetItem(m_symbols);
+                node = m_root->addChild();
             }
-            node->setText(0, stripped);
-            node->setIcon(0, m_icon_class);
-            node->setText(1, QString::number(i, 10));
+            node->text = stripped;
+            node->icon = SymbolNode::Class;
+            node->line = i;
         }
 
         if (cl.indexOf(QLatin1String("<xsl:template")) >= 0) {
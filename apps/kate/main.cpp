@@ -7,6 +7,7 @@
  */
 
 #include "kateapp.h"
+#include "katetrace.h"
 
 #include <KAboutData>
 #include <KLocalizedString>
@@ -42,11 +43,13 @@
 #endif
 
 #ifdef WITH_DBUS
+#include "kateopenserver.h"
 #include "katerunninginstanceinfo.h"
 #include "katewaiter.h"
 #include <KDBusService>
 #include <QDBusMessage>
 #include <QDBusReply>
+#include <QLocalSocket>
 #else
 #include "SingleApplication/SingleApplication"
 #endif
@@ -201,6 +204,12 @@ int main(int argc, char **argv)
                                             i18n("The files/URLs opened by the application will be deleted after use"));
     parser.addOption(tempfileOption);
 
+    // --trace option
+    const QCommandLineOption traceOption(QStringList() << QStringLiteral("trace"),
+                                         i18n("Record the startup and other time critical operations to the given file, in Chrome trace format."),
+                                         i18n("file"));
+    parser.addOption(traceOption);
+
     // urls to open
     parser.addPositionalArgument(QStringLiteral("urls"), i18n("Documents to open."), i18n("[urls...]"));
 
@@ -214,6 +223,10 @@ int main(int argc, char **argv)
      */
     aboutData.processCommandLine(&parser);
 
+    if (parser.isSet(traceOption)) {
+        KateTrace::enable(parser.value(traceOption));
+    }
+
     /**
      * remember the urls we shall open
      */
@@ -311,82 +324,23 @@ int main(int argc, char **argv)
         }
 
         if (foundRunningService) {
-            // open given session
-            if (parser.isSet(startSessionOption) && (!session_already_opened)) {
-                QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
-                                                                QStringLiteral("/MainApplication"),
-                                                                QStringLiteral("org.kde.Kate.Application"),
-                                                                QStringLiteral("activateSession"));
-
-                QVariantList dbusargs;
-                dbusargs.append(parser.value(startSessionOption));
-                m.setArguments(dbusargs);
-
-                QDBusConnection::sessionBus().call(m);
-            }
-
             QString enc = parser.isSet(useEncodingOption) ? parser.value(useEncodingOption) : QString();
 
             bool tempfileSet = parser.isSet(tempfileOption);
 
-            QStringList tokens;
-
-            // open given files...
-            for (int i = 0; i < urls.size(); ++i) {
-                const QString &url = urls[i];
-                QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
-                                                                QStringLiteral("/MainApplication"),
-                                                                QStringLiteral("org.kde.Kate.Application"),
-                                                                QStringLiteral("tokenOpenUrlAt"));
-
-                UrlInfo info(url);
-                QVariantList dbusargs;
-
-                // convert to an url
-                dbusargs.append(info.url.toString());
-                dbusargs.append(info.cursor.line());
-                dbusargs.append(info.cursor.column());
-                dbusargs.append(enc);
-                dbusargs.append(tempfileSet);
-                m.setArguments(dbusargs);
-
-                QDBusMessage res = QDBusConnection::sessionBus().call(m);
-                if (res.type() == QDBusMessage::ReplyMessage) {
-                    if (res.arguments().count() == 1) {
-                        QVariant v = res.arguments().constFirst();
-                        if (v.isValid()) {
-                            QString s = v.toString();
-                            if ((!s.isEmpty()) && (s != QLatin1String("ERROR"))) {
-                                tokens << s;
-                            }
-                        }
-                    }
-                }
-            }
-
+            std::optional<QString> input;
             if (parser.isSet(readStdInOption)) {
                 // set chosen codec
                 const QString codec_name = parser.isSet(QStringLiteral("encoding")) ? parser.value(QStringLiteral("encoding")) : QString();
 
-                QFile input;
-                input.open(stdin, QIODevice::ReadOnly);
+                QFile inputFile;
+                inputFile.open(stdin, QIODevice::ReadOnly);
                 auto decoder = QStringDecoder(codec_name.toUtf8().constData());
-                QString text = decoder.isValid() ? decoder.decode(input.readAll()) : QString::fromLocal8Bit(input.readAll());
+                QString text = decoder.isValid() ? decoder.decode(inputFile.readAll()) : QString::fromLocal8Bit(inputFile.readAll());
 
                 // normalize line endings, to e.g. catch issues with \r\n on Windows
                 text.replace(QRegularExpression(QStringLiteral("\r\n?")), QStringLiteral("\n"));
-
-                QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
-                                                                QStringLiteral("/MainApplication"),
-                                                                QStringLiteral("org.kde.Kate.Application"),
-                                                                QStringLiteral("openInput"));
-
-                QVariantList dbusargs;
-                dbusargs.append(text);
-                dbusargs.append(codec_name);
-                m.setArguments(dbusargs);
-
-                QDBusConnection::sessionBus().call(m);
+                input = text;
             }
 
             int line = 0;
@@ -403,49 +357,151 @@ int main(int argc, char **argv)
                 nav = true;
             }
 
-            if (nav) {
-                QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
-                                                                QStringLiteral("/MainApplication"),
-                                                                QStringLiteral("org.kde.Kate.Application"),
-                                                                QStringLiteral("setCursor"));
-
-                QVariantList args;
-                args.append(line);
-                args.append(column);
-                m.setArguments(args);
-
-                QDBusConnection::sessionBus().call(m);
-            }
-
-            // activate the used instance
-            QDBusMessage activateMsg = QDBusMessage::createMethodCall(serviceName,
-                                                                      QStringLiteral("/MainApplication"),
-                                                                      QStringLiteral("org.kde.Kate.Application"),
-                                                                      QStringLiteral("activate"));
+            QString activationToken;
             if (KWindowSystem::isPlatformWayland()) {
-                activateMsg.setArguments({qEnvironmentVariable("XDG_ACTIVATION_TOKEN")});
+                activationToken = qEnvironmentVariable("XDG_ACTIVATION_TOKEN");
             } else if (KWindowSystem::isPlatformX11()) {
 #if HAVE_X11
-                activateMsg.setArguments({QString::fromUtf8(QX11Info::nextStartupId())});
+                activationToken = QString::fromUtf8(QX11Info::nextStartupId());
 #endif
             }
-            QDBusConnection::sessionBus().call(activateMsg);
 
-            // connect dbus signal
-            if (needToBlock) {
-                KateWaiter *waiter = new KateWaiter(serviceName, tokens);
-                QDBusConnection::sessionBus().connect(serviceName,
-                                                      QStringLiteral("/MainApplication"),
-                                                      QStringLiteral("org.kde.Kate.Application"),
-                                                      QStringLiteral("exiting"),
-                                                      waiter,
-                                                      SLOT(exiting()));
-                QDBusConnection::sessionBus().connect(serviceName,
-                                                      QStringLiteral("/MainApplication"),
-                                                      QStringLiteral("org.kde.Kate.Application"),
-                                                      QStringLiteral("documentClosed"),
-                                                      waiter,
-                                                      SLOT(documentClosed(QString)));
+            // fast path: hand over everything in one message via the local socket of the instance
+            // we only wait until it got the message, not until all files are loaded
+            const qint64 pid = QStringView(serviceName).mid(QStringLiteral("org.kde.kate-").size()).toLongLong();
+            bool waitForInstance = needToBlock;
+            std::unique_ptr<QLocalSocket> openSocket = KateOpenServer::connectToInstance(pid);
+            if (openSocket) {
+                KateOpenRequest request;
+                request.files.reserve(urls.size());
+                for (const QString &url : urls) {
+                    UrlInfo info(url);
+                    request.files.push_back({.url = info.url, .cursor = info.cursor});
+                }
+                request.encoding = enc;
+                request.isTempFile = tempfileSet;
+                request.block = needToBlock;
+                if (parser.isSet(startSessionOption) && (!session_already_opened)) {
+                    request.session = parser.value(startSessionOption);
+                }
+                request.input = input;
+                if (nav) {
+                    request.cursor = KTextEditor::Cursor(line, column);
+                }
+                request.activationToken = activationToken;
+
+                if (!KateOpenServer::sendRequest(*openSocket, request)) {
+                    fprintf(stderr, "%s\n", qPrintable(i18n("Failed to pass the files to the running Kate instance.")));
+                    return 1;
+                }
+
+                // the instance closes the connection once all our documents are closed
+                waitForInstance = needToBlock && openSocket->state() == QLocalSocket::ConnectedState;
+                if (waitForInstance) {
+                    QObject::connect(openSocket.get(), &QLocalSocket::disconnected, &app, &QCoreApplication::quit);
+                }
+            } else {
+                // open given session
+                if (parser.isSet(startSessionOption) && (!session_already_opened)) {
+                    QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
+                                                                    QStringLiteral("/MainApplication"),
+                                                                    QStringLiteral("org.kde.Kate.Application"),
+                                                                    QStringLiteral("activateSession"));
+
+                    QVariantList dbusargs;
+                    dbusargs.append(parser.value(startSessionOption));
+                    m.setArguments(dbusargs);
+
+                    QDBusConnection::sessionBus().call(m);
+                }
+
+                QStringList tokens;
+
+                // open given files...
+                for (int i = 0; i < urls.size(); ++i) {
+                    const QString &url = urls[i];
+                    QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
+                                                                    QStringLiteral("/MainApplication"),
+                                                                    QStringLiteral("org.kde.Kate.Application"),
+                                                                    QStringLiteral("tokenOpenUrlAt"));
+
+                    UrlInfo info(url);
+                    QVariantList dbusargs;
+
+                    // convert to an url
+                    dbusargs.append(info.url.toString());
+                    dbusargs.append(info.cursor.line());
+                    dbusargs.append(info.cursor.column());
+                    dbusargs.append(enc);
+                    dbusargs.append(tempfileSet);
+                    m.setArguments(dbusargs);
+
+                    QDBusMessage res = QDBusConnection::sessionBus().call(m);
+                    if (res.type() == QDBusMessage::ReplyMessage) {
+                        if (res.arguments().count() == 1) {
+                            QVariant v = res.arguments().constFirst();
+                            if (v.isValid()) {
+                                QString s = v.toString();
+                                if ((!s.isEmpty()) && (s != QLatin1String("ERROR"))) {
+                                    tokens << s;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                if (input) {
+                    QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
+                                                                    QStringLiteral("/MainApplication"),
+                                                                    QStringLiteral("org.kde.Kate.Application"),
+                                                                    QStringLiteral("openInput"));
+
+                    QVariantList dbusargs;
+                    dbusargs.append(*input);
+                    dbusargs.append(enc);
+                    m.setArguments(dbusargs);
+
+                    QDBusConnection::sessionBus().call(m);
+                }
+
+                if (nav) {
+                    QDBusMessage m = QDBusMessage::createMethodCall(serviceName,
+                                                                    QStringLiteral("/MainApplication"),
+                                                                    QStringLiteral("org.kde.Kate.Application"),
+                                                                    QStringLiteral("setCursor"));
+
+                    QVariantList args;
+                    args.append(line);
+                    args.append(column);
+                    m.setArguments(args);
+
+                    QDBusConnection::sessionBus().call(m);
+                }
+
+                // activate the used instance
+                QDBusMessage activateMsg = QDBusMessage::createMethodCall(serviceName,
+                                                                          QStringLiteral("/MainApplication"),
+                                                                          QStringLiteral("org.kde.Kate.Application"),
+                                                                          QStringLiteral("activate"));
+                activateMsg.setArguments({activationToken});
+                QDBusConnection::sessionBus().call(activateMsg);
+
+                // connect dbus signal
+                if (needToBlock) {
+                    KateWaiter *waiter = new KateWaiter(serviceName, tokens);
+                    QDBusConnection::sessionBus().connect(serviceName,
+                                                          QStringLiteral("/MainApplication"),
+                                                          QStringLiteral("org.kde.Kate.Application"),
+                                                          QStringLiteral("exiting"),
+                                                          waiter,
+                                                          SLOT(exiting()));
+                    QDBusConnection::sessionBus().connect(serviceName,
+                                                          QStringLiteral("/MainApplication"),
+                                                          QStringLiteral("org.kde.Kate.Application"),
+                                                          QStringLiteral("documentClosed"),
+                                                          waiter,
+                                                          SLOT(documentClosed(QString)));
+                }
             }
 
             // KToolInvocation (and KRun) will wait until we register on dbus
@@ -470,8 +526,8 @@ int main(int argc, char **argv)
                     Qt::DirectConnection);
             }
 
-            // this will wait until exiting is emitted by the used instance, if wanted...
-            return needToBlock ? app.exec() : 0;
+            // this will wait until exiting is emitted by the used instance or our connection is closed, if wanted...
+            return waitForInstance ? app.exec() : 0;
         }
     }
 #else
@@ -7,6 +7,7 @@
 */
 
 #include "kateapp.h"
+#include "katetrace.h"
 
 #include <KAboutData>
 #include <KLocalizedString>
@@ -118,6 +119,12 @@ int main(int argc, char **argv)
     const QCommandLineOption tempfile(QStringList() << QStringLiteral("tempfile"), i18n("The files/URLs opened by the application will be deleted after use"));
     parser.addOption(tempfile);
 
+    // --trace option
+    const QCommandLineOption trace(QStringList() << QStringLiteral("trace"),
+                                   i18n("Record the startup and other time critical operations to the given file, in Chrome trace format."),
+                                   i18n("file"));
+    parser.addOption(trace);
+
     // urls to open
     parser.addPositionalArgument(QStringLiteral("urls"), i18n("Documents to open."), i18n("[urls...]"));
 
@@ -131,6 +138,10 @@ int main(int argc, char **argv)
      */
     aboutData.processCommandLine(&parser);
 
+    if (parser.isSet(trace)) {
+        KateTrace::enable(parser.value(trace));
+    }
+
     /**
      * construct the real kate app object ;)
      * behaves like a singleton, one unique instance
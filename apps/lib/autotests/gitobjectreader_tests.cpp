@@ -0,0 +1,188 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "gitobjectreader_tests.h"
+#include "gitobjectreader.h"
+
+#include <algorithm>
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTest>
+
+QTEST_MAIN(GitObjectReaderTests)
+
+bool GitObjectReaderTests::git(const QStringList &args)
+{
+    QProcess p;
+    p.setWorkingDirectory(m_repo.path());
+    p.start(QStringLiteral("git"), args);
+    return p.waitForFinished() && p.exitStatus() == QProcess::NormalExit && p.exitCode() == 0;
+}
+
+void GitObjectReaderTests::initTestCase()
+{
+    m_haveGit = !QStandardPaths::findExecutable(QStringLiteral("git")).isEmpty() && m_repo.isValid();
+    if (!m_haveGit) {
+        return;
+    }
+
+    QFile f(m_repo.filePath(QStringLiteral("a.txt")));
+    QVERIFY(f.open(QFile::WriteOnly));
+    f.write("hello\nworld\n");
+    f.close();
+    QVERIFY(QDir(m_repo.path()).mkpath(QStringLiteral("dir")));
+    QFile f2(m_repo.filePath(QStringLiteral("dir/b b.txt")));
+    QVERIFY(f2.open(QFile::WriteOnly));
+    f2.write("second");
+    f2.close();
+
+    QVERIFY(git({QStringLiteral("init"), QStringLiteral("-q")}));
+    QVERIFY(git({QStringLiteral("add"), QStringLiteral(".")}));
+    QVERIFY(git({QStringLiteral("-c"),
+                 QStringLiteral("user.name=Kate"),
+                 QStringLiteral("-c"),
+                 QStringLiteral("user.email=kate@kde.org"),
+                 QStringLiteral("commit"),
+                 QStringLiteral("-q"),
+                 QStringLiteral("-m"),
+                 QStringLiteral("initial")}));
+}
+
+void GitObjectReaderTests::testParseTree()
+{
+    // "<mode> <name>\0<20 byte id>" twice
+    QByteArray raw("100644 a.txt");
+    raw.append('\0');
+    raw.append(QByteArray(20, '\x11'));
+    raw.append("40000 dir");
+    raw.append('\0');
+    raw.append(QByteArray(20, '\x22'));
+
+    const auto entries = GitObjectReader::parseTree(raw, 20);
+    QCOMPARE(int(entries.size()), 2);
+    QCOMPARE(entries[0].mode, QByteArray("100644"));
+    QCOMPARE(entries[0].name, QStringLiteral("a.txt"));
+    QCOMPARE(entries[0].id, QByteArray(20, '\x11').toHex());
+    QVERIFY(!entries[0].isTree());
+    QCOMPARE(entries[1].name, QStringLiteral("dir"));
+    QVERIFY(entries[1].isTree());
+
+    // truncated data must not crash
+    QCOMPARE(int(GitObjectReader::parseTree(raw.left(raw.size() - 1), 20).size()), 1);
+}
+
+void GitObjectReaderTests::testReadBlob()
+{
+    if (!m_haveGit) {
+        QSKIP("git not available");
+    }
+
+    auto reader = GitObjectReader::instance(m_repo.path());
+    QCOMPARE(GitObjectReader::instance(m_repo.path() + QStringLiteral("/")), reader);
+
+    std::vector<GitObject> results;
+    reader->readObject(QStringLiteral("HEAD:a.txt"), this, [&results](const GitObject &o) {
+        results.push_back(o);
+    });
+    reader->readObject(QStringLiteral(":dir/b b.txt"), this, [&results](const GitObject &o) {
+        results.push_back(o);
+    });
+    QTRY_COMPARE(int(results.size()), 2);
+
+    QCOMPARE(results[0].type, GitObject::Blob);
+    QCOMPARE(results[0].data, QByteArray("hello\nworld\n"));
+    QCOMPARE(results[0].size, qint64(12));
+    QCOMPARE(results[1].type, GitObject::Blob);
+    QCOMPARE(results[1].data, QByteArray("second"));
+
+    // one process serves all reads
+    QCOMPARE(reader->statistics().spawnCount, 1);
+    QCOMPARE(reader->statistics().requestCount, qint64(2));
+}
+
+void GitObjectReaderTests::testReadInfoAndMissing()
+{
+    if (!m_haveGit) {
+        QSKIP("git not available");
+    }
+
+    auto reader = GitObjectReader::instance(m_repo.path());
+    std::vector<GitObject> results;
+    reader->readObjectInfo(QStringLiteral("HEAD"), this, [&results](const GitObject &o) {
+        results.push_back(o);
+    });
+    reader->readObject(QStringLiteral("HEAD:does not exist"), this, [&results](const GitObject &o) {
+        results.push_back(o);
+    });
+    reader->readObject(QStringLiteral("HEAD:a.txt"), this, [&results](const GitObject &o) {
+        results.push_back(o);
+    });
+    QTRY_COMPARE(int(results.size()), 3);
+
+    // info requests carry no data
+    const auto commit = std::find_if(results.begin(), results.end(), [](const GitObject &o) {
+        return o.type == GitObject::Commit;
+    });
+    QVERIFY(commit != results.end());
+    QVERIFY(commit->data.isEmpty());
+    QVERIFY(commit->size > 0);
+
+    // the missing object doesn't break the following read
+    QCOMPARE(int(std::count_if(results.begin(),
+                           results.end(),
+                           [](const GitObject &o) {
+                               return !o.isValid();
+                           })),
+             1);
+    QCOMPARE(results.back().data, QByteArray("hello\nworld\n"));
+}
+
+void GitObjectReaderTests::testReadTree()
+{
+    if (!m_haveGit) {
+        QSKIP("git not available");
+    }
+
+    auto reader = GitObjectReader::instance(m_repo.path());
+    std::vector<GitTreeEntry> entries;
+    bool done = false;
+    reader->readTree(QStringLiteral("HEAD"), this, [&](const std::vector<GitTreeEntry> &e) {
+        entries = e;
+        done = true;
+    });
+    QTRY_VERIFY(done);
+
+    QCOMPARE(int(entries.size()), 2);
+    QCOMPARE(entries[0].name, QStringLiteral("a.txt"));
+    QCOMPARE(entries[1].name, QStringLiteral("dir"));
+    QVERIFY(entries[1].isTree());
+}
+
+void GitObjectReaderTests::testContextDestroyed()
+{
+    if (!m_haveGit) {
+        QSKIP("git not available");
+    }
+
+    auto reader = GitObjectReader::instance(m_repo.path());
+    bool called = false;
+    bool calledAfter = false;
+    auto context = new QObject;
+    reader->readObject(QStringLiteral("HEAD:a.txt"), context, [&called](const GitObject &) {
+        called = true;
+    });
+    delete context;
+    reader->readObject(QStringLiteral("HEAD:a.txt"), this, [&calledAfter](const GitObject &) {
+        calledAfter = true;
+    });
+    QTRY_VERIFY(calledAfter);
+    QVERIFY(!called);
+}
+
+#include "moc_gitobjectreader_tests.cpp"
@@ -0,0 +1,29 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class GitObjectReaderTests : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testParseTree();
+    void testReadBlob();
+    void testReadInfoAndMissing();
+    void testReadTree();
+    void testContextDestroyed();
+
+private:
+    bool git(const QStringList &args);
+
+    QTemporaryDir m_repo;
+    bool m_haveGit = false;
+};
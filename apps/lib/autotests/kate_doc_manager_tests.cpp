@@ -2,10 +2,14 @@
 #include "kate_doc_manager_tests.h"
 #include "katedocmanager.h"
 
+#include <KConfigGroup>
 #include <KLocalizedString>
+#include <KSharedConfig>
 
 #include <QCommandLineParser>
+#include <QFile>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 
 QTEST_MAIN(KateDocManagerTests)
@@ -129,4 +133,81 @@ void KateDocManagerTests::closedDocumentsWithEmptyUrlsAreNotRestorable()
     Q_ASSERT(recentlyClosedUrls.isEmpty());
 }
 
+void KateDocManagerTests::lazySessionRestore()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("lazy.txt"));
+    QFile f(path);
+    QVERIFY(f.open(QFile::WriteOnly));
+    f.write("lazy content");
+    f.close();
+    const QUrl url = QUrl::fromLocalFile(path);
+
+    KConfigGroup(KSharedConfig::openConfig(), QStringLiteral("General")).writeEntry("Lazy Session Restore", true);
+
+    KConfig session(QString(), KConfig::SimpleConfig);
+    KConfigGroup(&session, QStringLiteral("Open Documents")).writeEntry("Count", 1);
+    KConfigGroup(&session, QStringLiteral("Document 0")).writeEntry("URL", url.toString());
+
+    auto documentManager = app->documentManager();
+    documentManager->restoreDocumentList(&session);
+    QCOMPARE(documentManager->documentList().size(), 1);
+
+    // only a placeholder, but already known by url
+    auto doc = documentManager->documentList().constFirst();
+    QVERIFY(documentManager->isPendingRestore(doc));
+    QVERIFY(doc->isEmpty());
+    QCOMPARE(documentManager->findDocument(url), doc);
+
+    // saving the session keeps the placeholder intact
+    KConfig saved(QString(), KConfig::SimpleConfig);
+    documentManager->saveDocumentList(&saved);
+    QCOMPARE(KConfigGroup(&saved, QStringLiteral("Document 0")).readEntry("URL"), url.toString());
+
+    // explicitly opening the url loads the document
+    QCOMPARE(documentManager->openUrl(url), doc);
+    QVERIFY(!documentManager->isPendingRestore(doc));
+    QCOMPARE(doc->text(), QStringLiteral("lazy content"));
+
+    KConfigGroup(KSharedConfig::openConfig(), QStringLiteral("General")).deleteEntry("Lazy Session Restore");
+}
+
+void KateDocManagerTests::hibernateDocument()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("hibernate.txt"));
+    QFile f(path);
+    QVERIFY(f.open(QFile::WriteOnly));
+    f.write("hibernated content");
+    f.close();
+    const QUrl url = QUrl::fromLocalFile(path);
+
+    auto documentManager = app->documentManager();
+    auto doc = documentManager->openUrl(url);
+    QVERIFY(doc);
+    QCOMPARE(doc->text(), QStringLiteral("hibernated content"));
+
+    // modified documents stay if not enabled
+    doc->setText(QStringLiteral("changed"));
+    QVERIFY(!documentManager->hibernateDocument(doc));
+    doc->setText(QStringLiteral("hibernated content"));
+    doc->setModified(false);
+
+    // the content is gone, the url is still known
+    QVERIFY(documentManager->hibernateDocument(doc));
+    QVERIFY(documentManager->isPendingRestore(doc));
+    QVERIFY(doc->isEmpty());
+    QCOMPARE(documentManager->documentUrl(doc), url);
+    QCOMPARE(documentManager->documentName(doc), QStringLiteral("hibernate.txt"));
+    QCOMPARE(documentManager->findDocument(url), doc);
+
+    // accessing it loads it again
+    QCOMPARE(documentManager->openUrl(url), doc);
+    QVERIFY(!documentManager->isPendingRestore(doc));
+    QCOMPARE(doc->text(), QStringLiteral("hibernated content"));
+    QCOMPARE(doc->url(), url);
+}
+
 #include "moc_kate_doc_manager_tests.cpp"
@@ -19,6 +19,8 @@ private Q_SLOTS:
     void popRecentlyClosedUrlsReturnsNoneIfNoTabsClosedDuringSession();
     void popRecentlyClosedUrlsReturnsUrlIfTabClosedDuringSession();
     void closedDocumentsWithEmptyUrlsAreNotRestorable();
+    void lazySessionRestore();
+    void hibernateDocument();
 
 private:
     std::unique_ptr<KateApp> app;
@@ -701,4 +701,39 @@ void KateViewManagementTests::testViewspaceWithWidgetDoesntCrashOnClose()
     QVERIFY(spy.count() == 1);
 }
 
+void KateViewManagementTests::testViewLimitRecyclesBackgroundViews()
+{
+    app->sessionManager()->sessionNew();
+    KateMainWindow *mw = app->activeKateMainWindow();
+    auto vm = mw->viewManager();
+    clearAllDocs(mw);
+    vm->m_viewLimit = 2;
+
+    QPointer<KTextEditor::View> v1 = vm->createView();
+    auto doc1 = v1->document();
+    doc1->setText(QStringLiteral("Line1\nLine2\nLine3"));
+    v1->setCursorPosition({2, 2});
+    vm->createView();
+    vm->createView();
+
+    // the least recently used view is gone, its tab stays
+    auto vs = vm->activeViewSpace();
+    QVERIFY(!v1);
+    QCOMPARE(vm->m_views.size(), 2);
+    QVERIFY(vs->hasDocument(doc1));
+    QVERIFY(!vs->findViewForDocument(doc1));
+
+    // activating the tab brings back the view with its state
+    vm->activateView(doc1);
+    auto v = vs->findViewForDocument(doc1);
+    QVERIFY(v);
+    QCOMPARE(vm->activeView(), v);
+    QCOMPARE(v->cursorPosition(), KTextEditor::Cursor(2, 2));
+    QCOMPARE(vm->m_views.size(), 2);
+
+    vm->m_viewLimit = 0;
+    doc1->setModified(false);
+    clearAllDocs(mw);
+}
+
 #include "moc_kate_view_mgmt_tests.cpp"
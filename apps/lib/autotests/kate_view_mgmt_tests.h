@@ -61,6 +61,7 @@ private Q_SLOTS:
     void testNewViewCreatedIfViewNotinViewspace();
     void testNewSessionClearsWindowWidgets();
     void testViewspaceWithWidgetDoesntCrashOnClose();
+    void testViewLimitRecyclesBackgroundViews();
 
 private:
     class QTemporaryDir *m_tempdir;
@@ -0,0 +1,212 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katefilewatcher_test.h"
+#include "katefilewatcher.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_MAIN(KateFileWatcherTest)
+
+static void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
+// all paths the watch reported so far
+static QStringList reportedPaths(const QSignalSpy &spy)
+{
+    QStringList paths;
+    for (const auto &arguments : spy) {
+        paths += arguments.at(0).toStringList();
+    }
+    return paths;
+}
+
+void KateFileWatcherTest::testFile()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("file.txt"));
+    writeFile(file, "a");
+
+    QObject owner;
+    auto watch = KateFileWatcher::self()->watch(file, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+
+    // many writes in a row are reported once
+    for (int i = 0; i < 10; ++i) {
+        writeFile(file, QByteArray::number(i));
+    }
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(spy.at(0).at(0).toStringList(), QStringList{file});
+    QTest::qWait(300);
+    QCOMPARE(spy.size(), 1);
+}
+
+void KateFileWatcherTest::testAtomicReplace()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("index"));
+    writeFile(file, "a");
+
+    KateFileWatcher::self()->setPollInterval(50);
+    QObject owner;
+    auto watch = KateFileWatcher::self()->watch(file, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+
+    // like git updates its index
+    const QString temp = dir.filePath(QStringLiteral("index.lock"));
+    writeFile(temp, "b");
+    QVERIFY(QFile::remove(file));
+    QVERIFY(QFile::rename(temp, file));
+    QTRY_VERIFY(spy.size() >= 1);
+
+    // still watched after the replacement
+    QTest::qWait(300);
+    spy.clear();
+    writeFile(file, "c");
+    QTRY_COMPARE(spy.size(), 1);
+}
+
+void KateFileWatcherTest::testRecursive()
+{
+    QTemporaryDir dir;
+    QVERIFY(QDir(dir.path()).mkpath(QStringLiteral("a/b")));
+
+    QObject owner;
+    KateFileWatcher::Options options;
+    options.recursive = true;
+    auto watch = KateFileWatcher::self()->watch(dir.path(), options, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+
+    // the tree is listed in the background
+    QVERIFY(!watch->isReady());
+    QTRY_VERIFY(watch->isReady());
+
+    const QString deep = dir.filePath(QStringLiteral("a/b/deep.txt"));
+    writeFile(deep, "a");
+    QTRY_VERIFY(reportedPaths(spy).contains(deep));
+
+    // new directories are picked up, with everything created before we got to watch them
+    QVERIFY(QDir(dir.path()).mkpath(QStringLiteral("c/d")));
+    const QString early = dir.filePath(QStringLiteral("c/d/early.txt"));
+    writeFile(early, "a");
+    QTRY_VERIFY(reportedPaths(spy).contains(early));
+
+    spy.clear();
+    const QString late = dir.filePath(QStringLiteral("c/d/late.txt"));
+    writeFile(late, "a");
+    QTRY_VERIFY(reportedPaths(spy).contains(late));
+
+    // removed directories are no longer watched
+    const int watched = KateFileWatcher::self()->watchedDirectoryCount();
+    QVERIFY(QDir(dir.filePath(QStringLiteral("c"))).removeRecursively());
+    QTRY_COMPARE(KateFileWatcher::self()->watchedDirectoryCount(), watched - 2);
+}
+
+void KateFileWatcherTest::testIgnore()
+{
+    QTemporaryDir dir;
+    QVERIFY(QDir(dir.path()).mkpath(QStringLiteral(".git/objects")));
+
+    const int before = KateFileWatcher::self()->watchedDirectoryCount();
+    QObject owner;
+    KateFileWatcher::Options options;
+    options.recursive = true;
+    options.ignore = {QStringLiteral(".git"), QStringLiteral("*.o")};
+    auto watch = KateFileWatcher::self()->watch(dir.path(), options, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+    QTRY_VERIFY(watch->isReady());
+
+    // ignored directories are not even watched
+    QCOMPARE(KateFileWatcher::self()->watchedDirectoryCount(), before + 1);
+
+    writeFile(dir.filePath(QStringLiteral(".git/objects/x")), "a");
+    writeFile(dir.filePath(QStringLiteral("main.o")), "a");
+    writeFile(dir.filePath(QStringLiteral("main.cpp")), "a");
+    QTRY_VERIFY(spy.size() >= 1);
+    QTest::qWait(300);
+    QCOMPARE(reportedPaths(spy), QStringList{dir.filePath(QStringLiteral("main.cpp"))});
+}
+
+void KateFileWatcherTest::testModifications()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("main.cpp"));
+    writeFile(file, "a");
+    QTest::qWait(50);
+
+    QObject owner;
+    KateFileWatcher::Options options;
+    options.recursive = true;
+    options.modifications = true;
+    auto watch = KateFileWatcher::self()->watch(dir.path(), options, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+    QTRY_VERIFY(watch->isReady());
+
+    // saved atomically, the directory listing stays the same
+    QSaveFile save(file);
+    QVERIFY(save.open(QIODevice::WriteOnly));
+    save.write("b");
+    QVERIFY(save.commit());
+    QTRY_VERIFY(reportedPaths(spy).contains(file));
+}
+
+void KateFileWatcherTest::testShared()
+{
+    QTemporaryDir dir;
+
+    const int before = KateFileWatcher::self()->watchedDirectoryCount();
+    QObject owner;
+    auto first = KateFileWatcher::self()->watch(dir.path(), &owner);
+    auto second = KateFileWatcher::self()->watch(dir.path(), &owner);
+    QTRY_VERIFY(first->isReady() && second->isReady());
+    QCOMPARE(KateFileWatcher::self()->watchedDirectoryCount(), before + 1);
+
+    // dropping one subscription must not stop the other
+    QSignalSpy spy(second, &KateFileWatch::changed);
+    delete first;
+    QCOMPARE(KateFileWatcher::self()->watchedDirectoryCount(), before + 1);
+
+    writeFile(dir.filePath(QStringLiteral("new.txt")), "a");
+    QTRY_COMPARE(spy.size(), 1);
+
+    delete second;
+    QCOMPARE(KateFileWatcher::self()->watchedDirectoryCount(), before);
+}
+
+void KateFileWatcherTest::testPollingFallback()
+{
+    QTemporaryDir dir;
+    QVERIFY(QDir(dir.path()).mkpath(QStringLiteral("a/b")));
+
+    // pretend we are out of native watches
+    auto watcher = KateFileWatcher::self();
+    watcher->setMaxWatchedDirectories(watcher->watchedDirectoryCount() + 1);
+    watcher->setPollInterval(50);
+
+    QObject owner;
+    KateFileWatcher::Options options;
+    options.recursive = true;
+    auto watch = watcher->watch(dir.path(), options, &owner);
+    QSignalSpy spy(watch, &KateFileWatch::changed);
+    QTRY_VERIFY(watch->isReady());
+
+    const QString deep = dir.filePath(QStringLiteral("a/b/deep.txt"));
+    writeFile(deep, "a");
+    QTRY_VERIFY(reportedPaths(spy).contains(deep));
+
+    watcher->setMaxWatchedDirectories(8192);
+}
+
+#include "moc_katefilewatcher_test.cpp"
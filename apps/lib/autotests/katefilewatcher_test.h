@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class KateFileWatcherTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testFile();
+    void testAtomicReplace();
+    void testRecursive();
+    void testIgnore();
+    void testModifications();
+    void testShared();
+    void testPollingFallback();
+};
@@ -0,0 +1,142 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katemetainfostore_test.h"
+#include "katemetainfostore.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_MAIN(KateMetaInfoStoreTest)
+
+static KateMetaInfoStore::Entry entry(const QByteArray &checksum, int line)
+{
+    KateMetaInfoStore::Entry e;
+    e.checksum = checksum;
+    e.time = QDateTime::currentDateTimeUtc();
+    e.config.insert(QStringLiteral("Bookmarks"), QStringLiteral("1,5,%1").arg(line));
+    e.config.insert(QStringLiteral("Folding"), QStringLiteral("a\\,b"));
+    return e;
+}
+
+void KateMetaInfoStoreTest::testInsertAndLookup()
+{
+    QTemporaryDir dir;
+    KateMetaInfoStore store(dir.filePath(QStringLiteral("metainfos")));
+    QCOMPARE(store.size(), 0);
+    QVERIFY(!store.value(QStringLiteral("file:///a")));
+
+    store.insert(QStringLiteral("file:///a"), entry("aaaa", 1));
+    store.insert(QStringLiteral("file:///b"), entry("bbbb", 2));
+    store.insert(QStringLiteral("file:///a"), entry("cccc", 3));
+    QCOMPARE(store.size(), 2);
+
+    // works before and after the writer is done
+    for (int i = 0; i < 2; ++i) {
+        const auto a = store.value(QStringLiteral("file:///a"));
+        QVERIFY(a);
+        QCOMPARE(a->checksum, QByteArray("cccc"));
+        QCOMPARE(a->config, entry("cccc", 3).config);
+        store.flush();
+    }
+
+    store.remove(QStringLiteral("file:///b"));
+    QVERIFY(!store.contains(QStringLiteral("file:///b")));
+    QCOMPARE(store.size(), 1);
+}
+
+void KateMetaInfoStoreTest::testPersistence()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("metainfos"));
+    {
+        KateMetaInfoStore store(file);
+        store.insert(QStringLiteral("file:///a"), entry("aaaa", 1));
+        store.insert(QStringLiteral("file:///b"), entry("bbbb", 2));
+        store.insert(QStringLiteral("file:///c"), entry("cccc", 3));
+        store.remove(QStringLiteral("file:///b"));
+        store.insert(QStringLiteral("file:///c"), entry("dddd", 4));
+    }
+
+    KateMetaInfoStore store(file);
+    QCOMPARE(store.size(), 2);
+    QCOMPARE(store.value(QStringLiteral("file:///a"))->checksum, QByteArray("aaaa"));
+    QVERIFY(!store.contains(QStringLiteral("file:///b")));
+    QCOMPARE(store.value(QStringLiteral("file:///c"))->config, entry("dddd", 4).config);
+}
+
+void KateMetaInfoStoreTest::testEviction()
+{
+    QTemporaryDir dir;
+    KateMetaInfoStore store(dir.filePath(QStringLiteral("metainfos")));
+    store.setMaxEntries(20);
+
+    for (int i = 0; i < 20; ++i) {
+        store.insert(QStringLiteral("file:///%1").arg(i), entry("sum", i));
+    }
+    QCOMPARE(store.size(), 20);
+
+    // make sure the first one is the most recently used one
+    QTest::qWait(2);
+    QVERIFY(store.value(QStringLiteral("file:///0")));
+
+    // going over the limit evicts a batch of the least recently used entries
+    store.insert(QStringLiteral("file:///new"), entry("sum", 100));
+    QCOMPARE(store.size(), 18);
+    QVERIFY(store.contains(QStringLiteral("file:///0")));
+    QVERIFY(store.contains(QStringLiteral("file:///new")));
+}
+
+void KateMetaInfoStoreTest::testTornRecord()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("metainfos"));
+    {
+        KateMetaInfoStore store(file);
+        store.insert(QStringLiteral("file:///a"), entry("aaaa", 1));
+        store.insert(QStringLiteral("file:///b"), entry("bbbb", 2));
+    }
+
+    // cut the last record in half
+    QFile f(file);
+    QVERIFY(f.open(QIODevice::ReadWrite));
+    QVERIFY(f.resize(f.size() - 10));
+    f.close();
+
+    {
+        KateMetaInfoStore store(file);
+        QCOMPARE(store.size(), 1);
+        QVERIFY(store.value(QStringLiteral("file:///a")));
+        store.insert(QStringLiteral("file:///c"), entry("cccc", 3));
+    }
+
+    // appending after the recovery works
+    KateMetaInfoStore store(file);
+    QCOMPARE(store.size(), 2);
+    QCOMPARE(store.value(QStringLiteral("file:///c"))->checksum, QByteArray("cccc"));
+}
+
+void KateMetaInfoStoreTest::testCompaction()
+{
+    QTemporaryDir dir;
+    const QString file = dir.filePath(QStringLiteral("metainfos"));
+    {
+        KateMetaInfoStore store(file);
+        for (int i = 0; i < 2000; ++i) {
+            store.insert(QStringLiteral("file:///%1").arg(i % 10), entry("sum", i));
+        }
+    }
+    const qint64 sizeBefore = QFileInfo(file).size();
+
+    KateMetaInfoStore store(file);
+    QCOMPARE(store.size(), 10);
+    QVERIFY(QFileInfo(file).size() < sizeBefore / 10);
+    QCOMPARE(store.value(QStringLiteral("file:///9"))->config, entry("sum", 1999).config);
+}
+
+#include "moc_katemetainfostore_test.cpp"
@@ -0,0 +1,21 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class KateMetaInfoStoreTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testInsertAndLookup();
+    void testPersistence();
+    void testEviction();
+    void testTornRecord();
+    void testCompaction();
+};
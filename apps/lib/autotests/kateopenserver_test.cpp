@@ -0,0 +1,136 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kateopenserver_test.h"
+#include "kateopenserver.h"
+
+#include <QCoreApplication>
+#include <QLocalSocket>
+#include <QTest>
+#include <QThread>
+
+#include <atomic>
+
+QTEST_MAIN(KateOpenServerTest)
+
+static KateOpenRequest testRequest()
+{
+    KateOpenRequest request;
+    request.files.push_back({.url = QUrl::fromLocalFile(QStringLiteral("/tmp/a.cpp")), .cursor = KTextEditor::Cursor(3, 4)});
+    request.files.push_back({.url = QUrl(QStringLiteral("sftp://host/b.txt")), .cursor = KTextEditor::Cursor::invalid()});
+    request.encoding = QStringLiteral("ISO-8859-15");
+    request.isTempFile = true;
+    request.session = QStringLiteral("work");
+    request.input = QStringLiteral("from stdin\n");
+    request.cursor = KTextEditor::Cursor(10, 0);
+    request.activationToken = QStringLiteral("token");
+    return request;
+}
+
+void KateOpenServerTest::testSerialize()
+{
+    const auto request = testRequest();
+    const auto result = KateOpenRequest::deserialize(request.serialize());
+    QVERIFY(result);
+    QCOMPARE(result->files.size(), size_t(2));
+    QCOMPARE(result->files[0].url, request.files[0].url);
+    QCOMPARE(result->files[0].cursor, request.files[0].cursor);
+    QCOMPARE(result->files[1].url, request.files[1].url);
+    QVERIFY(!result->files[1].cursor.isValid());
+    QCOMPARE(result->encoding, request.encoding);
+    QVERIFY(result->isTempFile);
+    QVERIFY(!result->block);
+    QCOMPARE(result->session, request.session);
+    QCOMPARE(result->input, request.input);
+    QCOMPARE(result->cursor, request.cursor);
+    QCOMPARE(result->activationToken, request.activationToken);
+
+    // no input is not the same as empty input
+    KateOpenRequest empty;
+    const auto emptyResult = KateOpenRequest::deserialize(empty.serialize());
+    QVERIFY(emptyResult);
+    QVERIFY(emptyResult->files.empty());
+    QVERIFY(!emptyResult->input);
+    QVERIFY(!emptyResult->cursor.isValid());
+}
+
+void KateOpenServerTest::testInvalidData()
+{
+    QVERIFY(!KateOpenRequest::deserialize(QByteArray()));
+    QVERIFY(!KateOpenRequest::deserialize(QByteArray("garbage")));
+
+    // truncated
+    const auto data = testRequest().serialize();
+    QVERIFY(!KateOpenRequest::deserialize(data.left(data.size() - 4)));
+}
+
+void KateOpenServerTest::testRequest()
+{
+    int handled = 0;
+    KateOpenRequest received;
+    KateOpenServer server([&](const KateOpenRequest &request) {
+        ++handled;
+        received = request;
+        return std::vector<QObject *>();
+    });
+    const qint64 pid = QCoreApplication::applicationPid();
+    QVERIFY(server.listen(pid));
+
+    // the client blocks while waiting, we need to run the server event loop meanwhile
+    std::atomic<bool> sent = false;
+    std::unique_ptr<QThread> client(QThread::create([pid, &sent]() {
+        auto socket = KateOpenServer::connectToInstance(pid);
+        sent = socket && KateOpenServer::sendRequest(*socket, testRequest());
+    }));
+    client->start();
+
+    QTRY_VERIFY(client->isFinished());
+    QVERIFY(sent);
+    QTRY_COMPARE(handled, 1);
+    QCOMPARE(received.files.size(), size_t(2));
+    QCOMPARE(received.session, QStringLiteral("work"));
+}
+
+void KateOpenServerTest::testBlockingRequest()
+{
+    auto doc1 = std::make_unique<QObject>();
+    auto doc2 = std::make_unique<QObject>();
+    int handled = 0;
+    KateOpenServer server([&](const KateOpenRequest &) {
+        ++handled;
+        // duplicates must not confuse the counting
+        return std::vector<QObject *>{doc1.get(), doc2.get(), doc1.get()};
+    });
+    const qint64 pid = QCoreApplication::applicationPid();
+    QVERIFY(server.listen(pid));
+
+    std::atomic<bool> sent = false;
+    std::atomic<bool> disconnected = false;
+    std::unique_ptr<QThread> client(QThread::create([pid, &sent, &disconnected]() {
+        auto socket = KateOpenServer::connectToInstance(pid);
+        auto request = testRequest();
+        request.block = true;
+        sent = socket && KateOpenServer::sendRequest(*socket, request);
+        if (sent) {
+            disconnected = socket->state() == QLocalSocket::UnconnectedState || socket->waitForDisconnected(10000);
+        }
+    }));
+    client->start();
+
+    QTRY_VERIFY(sent);
+    QTRY_COMPARE(handled, 1);
+
+    // still blocked as long as one document is alive
+    doc1.reset();
+    QTest::qWait(100);
+    QVERIFY(!client->isFinished());
+
+    doc2.reset();
+    QTRY_VERIFY(client->isFinished());
+    QVERIFY(disconnected);
+}
+
+#include "moc_kateopenserver_test.cpp"
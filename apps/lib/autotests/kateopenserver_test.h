@@ -0,0 +1,20 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class KateOpenServerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSerialize();
+    void testInvalidData();
+    void testRequest();
+    void testBlockingRequest();
+};
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katepluginactivation_test.h"
+#include "katepluginmanager.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+QTEST_MAIN(KatePluginActivationTest)
+
+static KPluginMetaData metaData(const char *json)
+{
+    return KPluginMetaData(QJsonDocument::fromJson(json).object(), QStringLiteral("testplugin"));
+}
+
+void KatePluginActivationTest::testNoActivation()
+{
+    const auto activation = KatePluginActivation::fromMetaData(metaData(R"({"KPlugin": {"Name": "Test"}})"));
+    QVERIFY(activation.isEmpty());
+}
+
+void KatePluginActivationTest::testParseTriggers()
+{
+    const auto activation = KatePluginActivation::fromMetaData(metaData(R"({
+        "KPlugin": {"Name": "Test"},
+        "X-Kate-Activation": {
+            "MimeTypes": ["text/x-csrc", "application/sql"],
+            "ProjectFiles": [".kateproject"],
+            "HighlightingModes": ["^(C|ANSI C89)$"],
+            "ConfigFiles": ["test/settings.json"],
+            "ConfigEntries": ["test/ServerConfiguration"],
+            "ToolViews": [
+                {"Identifier": "test_output", "Position": "Bottom", "Icon": "server-database", "Text": "Output"},
+                {"Identifier": "test_browser", "Icon": "folder", "Text": "Browser"}
+            ],
+            "Actions": [
+                {"Name": "test_run", "Icon": "quickopen", "Text": "Run", "Shortcut": "Ctrl+E"}
+            ]
+        }
+    })"));
+
+    QVERIFY(!activation.isEmpty());
+    QCOMPARE(activation.mimeTypes, QStringList({QStringLiteral("text/x-csrc"), QStringLiteral("application/sql")}));
+    QCOMPARE(activation.projectFiles, QStringList({QStringLiteral(".kateproject")}));
+    QCOMPARE(activation.highlightingModes.size(), 1);
+    QVERIFY(activation.highlightingModes[0].match(QStringLiteral("ANSI C89")).hasMatch());
+    QVERIFY(!activation.highlightingModes[0].match(QStringLiteral("C++")).hasMatch());
+    QCOMPARE(activation.configFiles, QStringList({QStringLiteral("test/settings.json")}));
+    QCOMPARE(activation.configEntries, QStringList({QStringLiteral("test/ServerConfiguration")}));
+
+    QCOMPARE(activation.toolViews.size(), size_t(2));
+    QCOMPARE(activation.toolViews[0].identifier, QStringLiteral("test_output"));
+    QCOMPARE(activation.toolViews[0].position, KTextEditor::MainWindow::Bottom);
+    QCOMPARE(activation.toolViews[0].icon, QStringLiteral("server-database"));
+    QCOMPARE(activation.toolViews[0].text, QStringLiteral("Output"));
+    // left is the default position
+    QCOMPARE(activation.toolViews[1].position, KTextEditor::MainWindow::Left);
+
+    QCOMPARE(activation.actions.size(), size_t(1));
+    QCOMPARE(activation.actions[0].name, QStringLiteral("test_run"));
+    QCOMPARE(activation.actions[0].text, QStringLiteral("Run"));
+    QCOMPARE(activation.actions[0].shortcut, QStringLiteral("Ctrl+E"));
+}
+
+void KatePluginActivationTest::testSkipIncompleteEntries()
+{
+    // tool views and actions need a name to be matched with the real ones
+    const auto activation = KatePluginActivation::fromMetaData(metaData(R"({
+        "KPlugin": {"Name": "Test"},
+        "X-Kate-Activation": {
+            "ToolViews": [{"Text": "No Identifier"}],
+            "Actions": [{"Text": "No Name"}]
+        }
+    })"));
+
+    QVERIFY(activation.isEmpty());
+}
+
+#include "moc_katepluginactivation_test.cpp"
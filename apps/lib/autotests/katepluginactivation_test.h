@@ -0,0 +1,19 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class KatePluginActivationTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testNoActivation();
+    void testParseTriggers();
+    void testSkipIncompleteEntries();
+};
@@ -0,0 +1,85 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kateresourceusage_test.h"
+#include "kateresourceusage.h"
+
+#include <QTest>
+
+QTEST_MAIN(KateResourceUsageTest)
+
+static const KateResourceUsage::Entry *findEntry(const std::vector<KateResourceUsage::Entry> &entries, const QString &subsystem, const QString &name)
+{
+    for (const auto &entry : entries) {
+        if (entry.subsystem == subsystem && entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void KateResourceUsageTest::testReporters()
+{
+    QObject context;
+    const QString subsystem = QStringLiteral("Reporters");
+
+    // like one reporter per main window
+    for (int i = 0; i < 2; ++i) {
+        KateResourceUsage::self()->addReporter(subsystem, &context, [](KateResourceUsage::Report &report) {
+            report.add(QStringLiteral("Items"), 3, 100);
+            report.add(QStringLiteral("Unknown size"), 1);
+        });
+    }
+
+    const auto entries = KateResourceUsage::self()->snapshot();
+    auto items = findEntry(entries, subsystem, QStringLiteral("Items"));
+    QVERIFY(items);
+    QCOMPARE(items->count, qint64(6));
+    QCOMPARE(items->bytes, qint64(200));
+
+    auto unknown = findEntry(entries, subsystem, QStringLiteral("Unknown size"));
+    QVERIFY(unknown);
+    QCOMPARE(unknown->count, qint64(2));
+    QCOMPARE(unknown->bytes, qint64(-1));
+
+    QVERIFY(KateResourceUsage::self()->dump().contains(QStringLiteral("Reporters / Items: 6")));
+}
+
+void KateResourceUsageTest::testContextDestroyed()
+{
+    const QString subsystem = QStringLiteral("Destroyed");
+    {
+        QObject context;
+        KateResourceUsage::self()->addReporter(subsystem, &context, [](KateResourceUsage::Report &report) {
+            report.add(QStringLiteral("Items"), 1);
+        });
+        QVERIFY(findEntry(KateResourceUsage::self()->snapshot(), subsystem, QStringLiteral("Items")));
+    }
+
+    // the reporter must not be called once its subsystem is gone
+    QVERIFY(!findEntry(KateResourceUsage::self()->snapshot(), subsystem, QStringLiteral("Items")));
+}
+
+void KateResourceUsageTest::testCpuScope()
+{
+    const QString subsystem = QStringLiteral("Busy");
+    QVERIFY(!KateResourceUsage::cpuTime().contains(subsystem));
+
+    {
+        KateResourceUsage::CpuScope cpu("Busy");
+        const qint64 start = KateResourceUsage::threadCpuTime();
+        volatile quint64 sum = 0;
+        while (KateResourceUsage::threadCpuTime() - start < 20000000) {
+            sum = sum + 1;
+        }
+    }
+
+    const auto times = KateResourceUsage::cpuTime();
+    QVERIFY(times.value(subsystem) >= 20000000);
+    QVERIFY(times.contains(QStringLiteral("Process")));
+}
+
+#include "moc_kateresourceusage_test.cpp"
@@ -0,0 +1,214 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katetaskscheduler_test.h"
+#include "katetaskscheduler.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QTest>
+#include <QThread>
+
+#include <atomic>
+
+QTEST_MAIN(KateTaskSchedulerTest)
+
+using Scheduler = KateTaskScheduler;
+
+// order in which the tasks started and ended
+class Log
+{
+public:
+    void add(const QString &entry)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.push_back(entry);
+    }
+
+    qsizetype indexOf(const QString &entry)
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_entries.indexOf(entry);
+    }
+
+private:
+    QMutex m_mutex;
+    QStringList m_entries;
+};
+
+static void waitFor(const std::atomic<bool> &flag)
+{
+    while (!flag) {
+        QThread::msleep(1);
+    }
+}
+
+void KateTaskSchedulerTest::cleanup()
+{
+    QTRY_COMPARE(Scheduler::self()->runningCount(), 0);
+    QCOMPARE(Scheduler::self()->pendingCount(), 0);
+    Scheduler::self()->setCoreLimit(Scheduler::Visible, QThread::idealThreadCount());
+    Scheduler::self()->setCpuBudget(Scheduler::Background, 50);
+}
+
+void KateTaskSchedulerTest::testPriorityOrder()
+{
+    auto scheduler = Scheduler::self();
+    scheduler->setCoreLimit(Scheduler::Visible, 1);
+
+    Log log;
+    std::atomic<bool> release = false;
+    auto logged = [&log](const QString &name) {
+        return [&log, name](Scheduler::Token &) {
+            log.add(name + QStringLiteral(" start"));
+            QThread::msleep(20);
+            log.add(name + QStringLiteral(" end"));
+        };
+    };
+
+    scheduler->schedule(Scheduler::Visible, QStringLiteral("blocker"), [&](Scheduler::Token &) {
+        log.add(QStringLiteral("blocker start"));
+        waitFor(release);
+        log.add(QStringLiteral("blocker end"));
+    });
+    scheduler->schedule(Scheduler::Visible, QStringLiteral("visible"), logged(QStringLiteral("visible")));
+    scheduler->schedule(Scheduler::Background, QStringLiteral("background"), logged(QStringLiteral("background")));
+    scheduler->schedule(Scheduler::Idle, QStringLiteral("idle"), logged(QStringLiteral("idle")));
+
+    // the visible task waits for the blocker, the background one as long as the visible one waits,
+    // the idle one until nothing else runs
+    QTRY_VERIFY(log.indexOf(QStringLiteral("blocker start")) >= 0);
+    QCOMPARE(scheduler->runningTaskNames(), QStringList{QStringLiteral("blocker")});
+    QCOMPARE(scheduler->pendingCount(), 3);
+
+    release = true;
+    QTRY_VERIFY(log.indexOf(QStringLiteral("idle end")) >= 0);
+    QVERIFY(log.indexOf(QStringLiteral("visible start")) > log.indexOf(QStringLiteral("blocker end")));
+    QVERIFY(log.indexOf(QStringLiteral("background start")) > log.indexOf(QStringLiteral("blocker end")));
+    QVERIFY(log.indexOf(QStringLiteral("idle start")) > log.indexOf(QStringLiteral("visible end")));
+    QVERIFY(log.indexOf(QStringLiteral("idle start")) > log.indexOf(QStringLiteral("background end")));
+}
+
+void KateTaskSchedulerTest::testCancelPending()
+{
+    auto scheduler = Scheduler::self();
+    scheduler->setCoreLimit(Scheduler::Visible, 1);
+
+    std::atomic<bool> release = false;
+    std::atomic<bool> ran = false;
+    scheduler->schedule(Scheduler::Visible, QStringLiteral("blocker"), [&](Scheduler::Token &) {
+        waitFor(release);
+    });
+    const auto id = scheduler->schedule(Scheduler::Visible, QStringLiteral("canceled"), [&](Scheduler::Token &) {
+        ran = true;
+    });
+    QCOMPARE(scheduler->pendingCount(), 1);
+
+    scheduler->cancel(id);
+    QCOMPARE(scheduler->pendingCount(), 0);
+
+    release = true;
+    QTRY_COMPARE(scheduler->runningCount(), 0);
+    QVERIFY(!ran);
+}
+
+void KateTaskSchedulerTest::testCancelRunning()
+{
+    auto scheduler = Scheduler::self();
+
+    std::atomic<bool> started = false;
+    const auto id = scheduler->schedule(Scheduler::Background, QStringLiteral("endless"), [&](Scheduler::Token &token) {
+        started = true;
+        while (token.checkpoint()) {
+            QThread::msleep(1);
+        }
+    });
+    QTRY_VERIFY(started);
+
+    scheduler->cancel(id);
+    QTRY_COMPARE(scheduler->runningCount(), 0);
+}
+
+void KateTaskSchedulerTest::testContextDestroyed()
+{
+    auto scheduler = Scheduler::self();
+    auto context = new QObject;
+
+    std::atomic<bool> started = false;
+    std::atomic<bool> done = false;
+    scheduler->schedule(
+        Scheduler::Visible,
+        QStringLiteral("endless"),
+        [&](Scheduler::Token &token) {
+            started = true;
+            while (!token.isCanceled()) {
+                QThread::msleep(1);
+            }
+            done = true;
+        },
+        context);
+    QTRY_VERIFY(started);
+
+    // the task is finished once the context is gone, like for an unloaded plugin
+    delete context;
+    QVERIFY(done);
+}
+
+void KateTaskSchedulerTest::testCancelThrottled()
+{
+    auto scheduler = Scheduler::self();
+    scheduler->setCpuBudget(Scheduler::Background, 1);
+    QObject context;
+
+    std::atomic<bool> pausing = false;
+    scheduler->schedule(
+        Scheduler::Background,
+        QStringLiteral("throttled"),
+        [&](Scheduler::Token &token) {
+            // one busy slice earns a pause of several seconds
+            QElapsedTimer busy;
+            busy.start();
+            while (busy.elapsed() < 100) {
+            }
+            pausing = true;
+            token.checkpoint();
+        },
+        &context);
+    QTRY_VERIFY(pausing);
+    QThread::msleep(20);
+
+    // we must not sit out the pause, cancelAndWait() blocks the GUI thread
+    QElapsedTimer wait;
+    wait.start();
+    scheduler->cancelAndWait(&context);
+    QVERIFY(wait.elapsed() < 1000);
+}
+
+void KateTaskSchedulerTest::testUserInput()
+{
+    auto scheduler = Scheduler::self();
+
+    std::atomic<bool> background = false;
+    std::atomic<bool> interactive = false;
+    scheduler->notifyUserInput();
+    QVERIFY(scheduler->isUserActive(Scheduler::Background));
+    QVERIFY(!scheduler->isUserActive(Scheduler::Interactive));
+
+    scheduler->schedule(Scheduler::Background, QStringLiteral("background"), [&](Scheduler::Token &) {
+        background = true;
+    });
+    scheduler->schedule(Scheduler::Interactive, QStringLiteral("interactive"), [&](Scheduler::Token &) {
+        interactive = true;
+    });
+
+    // interactive work doesn't care, background work waits until the user is quiet
+    QTRY_VERIFY(interactive);
+    QVERIFY(!background);
+    QTRY_VERIFY(background);
+    QVERIFY(!scheduler->isUserActive(Scheduler::Background));
+}
+
+#include "moc_katetaskscheduler_test.cpp"
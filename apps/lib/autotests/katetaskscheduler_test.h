@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class KateTaskSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup();
+
+    void testPriorityOrder();
+    void testCancelPending();
+    void testCancelRunning();
+    void testContextDestroyed();
+    void testCancelThrottled();
+    void testUserInput();
+};
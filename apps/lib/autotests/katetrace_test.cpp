@@ -0,0 +1,91 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katetrace_test.h"
+#include "katetrace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+QTEST_MAIN(KateTraceTest)
+
+void KateTraceTest::testDisabled()
+{
+    QVERIFY(!KateTrace::isEnabled());
+
+    KateTrace::Zone zone("test", "disabled");
+    QVERIFY(!zone.isActive());
+}
+
+void KateTraceTest::testWriteTrace()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("trace.json"));
+
+    KateTrace::enable(fileName);
+    QVERIFY(KateTrace::isEnabled());
+
+    {
+        KateTrace::Zone zone("test", "outer");
+        QVERIFY(zone.isActive());
+        zone.setDetail(QStringLiteral("some detail"));
+        KATE_TRACE_ZONE("test", "inner");
+    }
+
+    // events of other threads end up in their own track
+    std::unique_ptr<QThread> thread(QThread::create([]() {
+        KATE_TRACE_ZONE("test", "worker");
+    }));
+    thread->setObjectName(QStringLiteral("TraceWorker"));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    KateTrace::flush();
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QHash<QString, QJsonObject> events;
+    QHash<qint64, QString> threadNames;
+    const auto traceEvents = doc.object().value(QStringLiteral("traceEvents")).toArray();
+    for (const auto &value : traceEvents) {
+        const auto event = value.toObject();
+        if (event.value(QStringLiteral("ph")).toString() == QLatin1String("M")) {
+            threadNames.insert(event.value(QStringLiteral("tid")).toInteger(), event.value(QStringLiteral("args")).toObject().value(QStringLiteral("name")).toString());
+        } else {
+            QCOMPARE(event.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+            QCOMPARE(event.value(QStringLiteral("cat")).toString(), QStringLiteral("test"));
+            events.insert(event.value(QStringLiteral("name")).toString(), event);
+        }
+    }
+
+    QCOMPARE(events.size(), 3);
+    const auto outer = events.value(QStringLiteral("outer"));
+    const auto inner = events.value(QStringLiteral("inner"));
+    const auto worker = events.value(QStringLiteral("worker"));
+    QCOMPARE(outer.value(QStringLiteral("args")).toObject().value(QStringLiteral("detail")).toString(), QStringLiteral("some detail"));
+    QVERIFY(!inner.contains(QStringLiteral("args")));
+
+    // inner is nested in outer
+    const double outerStart = outer.value(QStringLiteral("ts")).toDouble();
+    const double innerStart = inner.value(QStringLiteral("ts")).toDouble();
+    QVERIFY(innerStart >= outerStart);
+    QVERIFY(innerStart + inner.value(QStringLiteral("dur")).toDouble() <= outerStart + outer.value(QStringLiteral("dur")).toDouble());
+
+    QCOMPARE(threadNames.value(outer.value(QStringLiteral("tid")).toInteger()), QStringLiteral("main"));
+    QCOMPARE(threadNames.value(worker.value(QStringLiteral("tid")).toInteger()), QStringLiteral("TraceWorker"));
+}
+
+#include "moc_katetrace_test.cpp"
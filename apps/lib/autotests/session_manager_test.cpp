@@ -9,7 +9,9 @@
 #include "katesessionmanager.h"
 
 #include <KConfig>
+#include <KConfigGroup>
 #include <KLocalizedString>
+#include <KTextEditor/Document>
 
 #include <QCommandLineParser>
 #include <QTemporaryDir>
@@ -113,4 +115,62 @@ void KateSessionManagerTest::renameSession()
     QCOMPARE(m_manager->sessionList().size(), 0);
 }
 
+void KateSessionManagerTest::stashOnlyChangedDocuments()
+{
+    // don't touch the real stash location
+    QStandardPaths::setTestModeEnabled(true);
+
+    m_manager->activateSession(QStringLiteral("stash"), false, false);
+    KateSession::Ptr s = m_manager->activeSession();
+    m_app->stashManager()->setStashNewUnsavedFiles(true);
+
+    auto doc = m_app->documentManager()->createDoc();
+    doc->setText(QStringLiteral("hello"));
+    const QString group = QStringLiteral("Document %1").arg(m_app->documentManager()->documentList().indexOf(doc));
+
+    auto save = [this]() {
+        QVERIFY(m_manager->saveActiveSession());
+        m_app->stashManager()->waitForStashWrites();
+        m_manager->waitForSessionWrites();
+    };
+    auto readFile = [](const QString &fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    // the session file on disk references the stash
+    save();
+    const QString stashedFile = KConfig(s->file(), KConfig::SimpleConfig).group(group).readEntry("stashedFile");
+    QVERIFY(!stashedFile.isEmpty());
+    QCOMPARE(readFile(stashedFile), QByteArray("hello"));
+
+    // unchanged documents are not written again
+    {
+        QFile file(stashedFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("untouched");
+    }
+    save();
+    QCOMPARE(readFile(stashedFile), QByteArray("untouched"));
+
+    // changed ones are written to the same file
+    doc->setText(QStringLiteral("world"));
+    save();
+    QCOMPARE(KConfig(s->file(), KConfig::SimpleConfig).group(group).readEntry("stashedFile"), stashedFile);
+    QCOMPARE(readFile(stashedFile), QByteArray("world"));
+
+    // without changes to stash, the entry and the file are gone
+    doc->clear();
+    save();
+    QVERIFY(!KConfig(s->file(), KConfig::SimpleConfig).group(group).hasKey("stashedFile"));
+    QVERIFY(!QFile::exists(stashedFile));
+
+    // cleanup again for next test
+    doc->setModified(false);
+    m_app->documentManager()->closeDocument(doc, false);
+    QVERIFY(m_manager->activateAnonymousSession());
+    QVERIFY(m_manager->deleteSession(s));
+    m_app->stashManager()->clearStashForSession(s);
+}
+
 #include "moc_session_manager_test.cpp"
@@ -8,6 +8,8 @@
 #include "diagnosticitem.h"
 #include "drawing_utils.h"
 #include "kateapp.h"
+#include "kateresourceusage.h"
+#include "katetrace.h"
 #include "kateviewmanager.h"
 #include "session_diagnostic_suppression.h"
 #include "texthint/KateTextHintManager.h"
@@ -421,6 +423,21 @@ DiagnosticsView::DiagnosticsView(QWidget *parent, KTextEditor::MainWindow *mainW
     };
     connect(KateApp::self(), &KateApp::configurationChanged, this, readConfig);
     readConfig();
+
+    KateResourceUsage::self()->addReporter(QStringLiteral("Diagnostics"), this, [this](KateResourceUsage::Report &report) {
+        qint64 diagnostics = 0;
+        for (int i = 0; i < m_model.rowCount(); ++i) {
+            diagnostics += m_model.item(i)->rowCount();
+        }
+        report.add(QStringLiteral("Files"), m_model.rowCount());
+        report.add(QStringLiteral("Diagnostics"), diagnostics);
+
+        qint64 ranges = 0;
+        for (const auto &documentRanges : std::as_const(m_diagnosticsRanges)) {
+            ranges += documentRanges.size();
+        }
+        report.add(QStringLiteral("Moving ranges"), ranges);
+    });
 }
 
 DiagnosticsView *DiagnosticsView::instance(KTextEditor::MainWindow *mainWindow)
@@ -816,6 +833,12 @@ void DiagnosticsView::onDoubleClicked(const QModelIndex &index, bool quickFix)
 
 void DiagnosticsView::onDiagnosticsAdded(const FileDiagnostics &diagnostics)
 {
+    KateTrace::Zone zone("diagnostics", "DiagnosticsView::onDiagnosticsAdded");
+    if (zone.isActive()) {
+        zone.setDetail(diagnostics.uri.toString());
+    }
+    KateResourceUsage::CpuScope cpu("Diagnostics");
+
     auto view = m_mainWindow->activeView();
     auto doc = view ? view->document() : nullptr;
     // We allow diagnostics for the active document always because it might be that diagnostic limit is reached
@@ -0,0 +1,340 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "gitobjectreader.h"
+#include "gitprocess.h"
+#include "hostprocess.h"
+#include "kate_timings_debug.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QProcess>
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+
+// stop the cat-file processes if nobody asked for anything for this long
+static constexpr int IdleTimeoutMs = 60 * 1000;
+
+// spawn counter over all readers
+static int s_totalSpawnCount = 0;
+
+struct GitObjectReader::Request {
+    QPointer<QObject> context;
+    bool hasContext = false;
+    Callback callback;
+    QElapsedTimer timer;
+};
+
+struct GitObjectReader::Channel {
+    explicit Channel(bool contents)
+        : withContents(contents)
+    {
+    }
+
+    // "--batch" or "--batch-check"
+    const bool withContents;
+    std::unique_ptr<QProcess> process;
+    std::deque<Request> pending;
+    QByteArray buffer;
+    // header of the object we are currently reading the contents for
+    std::optional<GitObject> current;
+};
+
+static GitObject::Type objectType(QByteArrayView type)
+{
+    if (type == QByteArrayView("blob")) {
+        return GitObject::Blob;
+    } else if (type == QByteArrayView("tree")) {
+        return GitObject::Tree;
+    } else if (type == QByteArrayView("commit")) {
+        return GitObject::Commit;
+    } else if (type == QByteArrayView("tag")) {
+        return GitObject::Tag;
+    }
+    return GitObject::Missing;
+}
+
+/**
+ * Parses "<id> <type> <size>" or "<rev> missing" / "<rev> ambiguous".
+ * The rev might contain spaces, therefore we work from the end of the line.
+ */
+static GitObject parseHeader(QByteArrayView line)
+{
+    GitObject object;
+    const qsizetype sizeStart = line.lastIndexOf(' ');
+    if (sizeStart <= 0) {
+        return object;
+    }
+
+    const qsizetype typeStart = line.lastIndexOf(' ', sizeStart - 1);
+    if (typeStart <= 0) {
+        return object;
+    }
+
+    bool ok = false;
+    const qint64 size = line.mid(sizeStart + 1).toLongLong(&ok);
+    const auto type = objectType(line.mid(typeStart + 1, sizeStart - typeStart - 1));
+    if (!ok || type == GitObject::Missing) {
+        return object;
+    }
+
+    object.id = line.left(typeStart).toByteArray();
+    object.type = type;
+    object.size = size;
+    return object;
+}
+
+GitObjectReader *GitObjectReader::instance(const QString &repoBasePath)
+{
+    static QHash<QString, QPointer<GitObjectReader>> s_readers;
+
+    const QString repo = QDir::cleanPath(repoBasePath);
+    auto &reader = s_readers[repo];
+    if (!reader) {
+        reader = new GitObjectReader(repo, QCoreApplication::instance());
+    }
+    return reader;
+}
+
+int GitObjectReader::totalSpawnCount()
+{
+    return s_totalSpawnCount;
+}
+
+GitObjectReader::GitObjectReader(const QString &repo, QObject *parent)
+    : QObject(parent)
+    , m_repo(repo)
+    , m_batch(std::make_unique<Channel>(true))
+    , m_check(std::make_unique<Channel>(false))
+{
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(IdleTimeoutMs);
+    connect(&m_idleTimer, &QTimer::timeout, this, &GitObjectReader::stopIdleProcesses);
+}
+
+GitObjectReader::~GitObjectReader()
+{
+    // let git terminate on its own, EOF on stdin ends cat-file
+    for (auto *channel : {m_batch.get(), m_check.get()}) {
+        if (channel->process) {
+            channel->process->disconnect(this);
+            channel->process->closeWriteChannel();
+            if (!channel->process->waitForFinished(500)) {
+                channel->process->kill();
+                channel->process->waitForFinished();
+            }
+        }
+    }
+
+    if (m_stats.requestCount > 0) {
+        qCDebug(LibKateTime,
+                "GitObjectReader for %s: %d spawns, %lld requests, avg latency %lld us, max latency %lld us",
+                qPrintable(m_repo),
+                m_stats.spawnCount,
+                m_stats.requestCount,
+                m_stats.totalLatencyUs / m_stats.requestCount,
+                m_stats.maxLatencyUs);
+    }
+}
+
+void GitObjectReader::readObject(const QString &rev, QObject *context, Callback callback)
+{
+    enqueue(*m_batch, rev, context, std::move(callback));
+}
+
+void GitObjectReader::readObjectInfo(const QString &rev, QObject *context, Callback callback)
+{
+    enqueue(*m_check, rev, context, std::move(callback));
+}
+
+void GitObjectReader::readTree(const QString &rev, QObject *context, TreeCallback callback)
+{
+    readObject(rev + QStringLiteral("^{tree}"), context, [callback = std::move(callback)](const GitObject &object) {
+        if (object.type != GitObject::Tree) {
+            callback({});
+            return;
+        }
+        callback(parseTree(object.data, object.id.size() / 2));
+    });
+}
+
+std::vector<GitTreeEntry> GitObjectReader::parseTree(const QByteArray &data, int idSize)
+{
+    // each entry is "<mode> <name>\0<binary id>"
+    std::vector<GitTreeEntry> entries;
+    qsizetype pos = 0;
+    while (pos < data.size()) {
+        const qsizetype space = data.indexOf(' ', pos);
+        if (space == -1) {
+            break;
+        }
+        const qsizetype nul = data.indexOf('\0', space + 1);
+        if (nul == -1 || nul + 1 + idSize > data.size()) {
+            break;
+        }
+
+        GitTreeEntry entry;
+        entry.mode = data.mid(pos, space - pos);
+        entry.name = QString::fromUtf8(data.constData() + space + 1, nul - space - 1);
+        entry.id = data.mid(nul + 1, idSize).toHex();
+        entries.push_back(std::move(entry));
+        pos = nul + 1 + idSize;
+    }
+    return entries;
+}
+
+void GitObjectReader::enqueue(Channel &channel, const QString &rev, QObject *context, Callback callback)
+{
+    Request request;
+    request.context = context;
+    request.hasContext = context != nullptr;
+    request.callback = std::move(callback);
+    request.timer.start();
+
+    // cat-file reads one name per line, anything else would confuse the protocol
+    if (rev.isEmpty() || rev.contains(QLatin1Char('\n')) || !ensureStarted(channel)) {
+        QMetaObject::invokeMethod(
+            this,
+            [request = std::move(request)]() {
+                if (!request.hasContext || request.context) {
+                    request.callback(GitObject{});
+                }
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+
+    m_idleTimer.stop();
+    channel.pending.push_back(std::move(request));
+    channel.process->write(rev.toUtf8() + '\n');
+}
+
+bool GitObjectReader::ensureStarted(Channel &channel)
+{
+    if (channel.process) {
+        return true;
+    }
+
+    auto process = std::make_unique<QProcess>();
+    if (!setupGitProcess(*process, m_repo, {QStringLiteral("cat-file"), channel.withContents ? QStringLiteral("--batch") : QStringLiteral("--batch-check")})) {
+        return false;
+    }
+
+    connect(process.get(), &QProcess::readyReadStandardOutput, this, [this, &channel]() {
+        onReadyRead(channel);
+    });
+    connect(process.get(), &QProcess::finished, this, [this, &channel]() {
+        failPending(channel);
+    });
+    connect(process.get(), &QProcess::errorOccurred, this, [this, &channel](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart || error == QProcess::Crashed) {
+            failPending(channel);
+        }
+    });
+
+    channel.process = std::move(process);
+    channel.buffer.clear();
+    channel.current.reset();
+
+    startHostProcess(*channel.process, QProcess::ReadWrite);
+    ++m_stats.spawnCount;
+    ++s_totalSpawnCount;
+    return true;
+}
+
+void GitObjectReader::onReadyRead(Channel &channel)
+{
+    channel.buffer += channel.process->readAllStandardOutput();
+
+    qsizetype pos = 0;
+    while (!channel.pending.empty()) {
+        if (!channel.current) {
+            const qsizetype lineEnd = channel.buffer.indexOf('\n', pos);
+            if (lineEnd == -1) {
+                break;
+            }
+
+            GitObject object = parseHeader(QByteArrayView(channel.buffer).mid(pos, lineEnd - pos));
+            pos = lineEnd + 1;
+            if (!channel.withContents || !object.isValid()) {
+                finishRequest(channel, object);
+                continue;
+            }
+            channel.current = std::move(object);
+        }
+
+        // contents are followed by a newline
+        if (channel.buffer.size() - pos < channel.current->size + 1) {
+            break;
+        }
+
+        channel.current->data = channel.buffer.mid(pos, channel.current->size);
+        pos += channel.current->size + 1;
+        GitObject object = std::move(*channel.current);
+        channel.current.reset();
+        finishRequest(channel, object);
+    }
+
+    channel.buffer.remove(0, pos);
+}
+
+void GitObjectReader::finishRequest(Channel &channel, const GitObject &object)
+{
+    Request request = std::move(channel.pending.front());
+    channel.pending.pop_front();
+
+    const qint64 latency = request.timer.nsecsElapsed() / 1000;
+    ++m_stats.requestCount;
+    m_stats.totalLatencyUs += latency;
+    m_stats.maxLatencyUs = std::max(m_stats.maxLatencyUs, latency);
+
+    if (m_batch->pending.empty() && m_check->pending.empty()) {
+        m_idleTimer.start();
+    }
+
+    if (request.hasContext && !request.context) {
+        return;
+    }
+    request.callback(object);
+}
+
+void GitObjectReader::failPending(Channel &channel)
+{
+    // the process is gone, answer everything still waiting with a missing object
+    if (channel.process) {
+        channel.process->disconnect(this);
+        channel.process.release()->deleteLater();
+    }
+    channel.buffer.clear();
+    channel.current.reset();
+
+    while (!channel.pending.empty()) {
+        finishRequest(channel, GitObject{});
+    }
+}
+
+void GitObjectReader::stopIdleProcesses()
+{
+    for (auto *channel : {m_batch.get(), m_check.get()}) {
+        if (!channel->process || !channel->pending.empty()) {
+            continue;
+        }
+
+        // closing stdin makes cat-file exit, delete the process once it is done
+        QProcess *process = channel->process.release();
+        process->disconnect(this);
+        process->setParent(this);
+        connect(process, &QProcess::finished, process, &QObject::deleteLater);
+        process->closeWriteChannel();
+    }
+}
+
+#include "moc_gitobjectreader.cpp"
@@ -0,0 +1,162 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * A git object as delivered by GitObjectReader.
+ */
+struct GitObject {
+    enum Type {
+        Missing,
+        Blob,
+        Tree,
+        Commit,
+        Tag,
+    };
+
+    /// full hex object id, empty for missing objects
+    QByteArray id;
+    Type type = Missing;
+    qint64 size = 0;
+    /// raw object content, always empty for info requests
+    QByteArray data;
+
+    bool isValid() const
+    {
+        return type != Missing;
+    }
+};
+
+/**
+ * One entry of a git tree object.
+ */
+struct GitTreeEntry {
+    /// octal mode as printed by git, e.g. "100644" or "40000"
+    QByteArray mode;
+    /// full hex object id
+    QByteArray id;
+    QString name;
+
+    bool isTree() const
+    {
+        return mode == "40000";
+    }
+};
+
+/**
+ * Per repository service that keeps long-lived "git cat-file --batch"
+ * and "git cat-file --batch-check" processes around and multiplexes
+ * object requests of all users onto them.
+ *
+ * Spawning git is expensive, even more so if we need to go through
+ * flatpak-spawn, therefore everything that just needs to read objects
+ * (file contents at some revision, trees, raw commits) should use this
+ * instead of starting a new process for each read.
+ *
+ * Blame, diffs (working tree, commit views, branch comparison, stashes)
+ * and file history still run their own git commands: cat-file can only
+ * hand out stored objects, it can neither compute diffs and numstats nor
+ * walk history or follow renames. Porting them would mean reimplementing
+ * that in Kate, which is not worth it for commands run on user request.
+ *
+ * All requests are asynchronous, callbacks are invoked in request order.
+ * If a context object is given and destroyed before the answer arrives,
+ * the callback is not invoked.
+ * The processes are stopped after some idle time and respawned on demand.
+ */
+class KATE_PRIVATE_EXPORT GitObjectReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const GitObject &)>;
+    using TreeCallback = std::function<void(const std::vector<GitTreeEntry> &)>;
+
+    struct Statistics {
+        /// number of git processes spawned by this reader
+        int spawnCount = 0;
+        /// number of answered requests
+        qint64 requestCount = 0;
+        /// sum and maximum of request latencies, in microseconds
+        qint64 totalLatencyUs = 0;
+        qint64 maxLatencyUs = 0;
+    };
+
+    /**
+     * Get the shared reader for the given repository.
+     * @param repoBasePath top-level dir of the repository, e.g. as returned by getRepoBasePath()
+     */
+    static GitObjectReader *instance(const QString &repoBasePath);
+
+    ~GitObjectReader() override;
+
+    /**
+     * Read the object named by @p rev including its contents.
+     * @p rev can be anything git rev-parse understands, e.g. "HEAD:path/to/file" or ":file" for the index.
+     */
+    void readObject(const QString &rev, QObject *context, Callback callback);
+
+    /**
+     * Read only id, type and size of the object named by @p rev, the data will be empty.
+     */
+    void readObjectInfo(const QString &rev, QObject *context, Callback callback);
+
+    /**
+     * Read the tree named by @p rev, commits are peeled to their tree.
+     * For a missing tree, the callback gets an empty list.
+     */
+    void readTree(const QString &rev, QObject *context, TreeCallback callback);
+
+    /**
+     * Parse raw tree object @p data, @p idSize is the binary size of an object id (20 for sha1, 32 for sha256).
+     */
+    static std::vector<GitTreeEntry> parseTree(const QByteArray &data, int idSize);
+
+    const QString &repository() const
+    {
+        return m_repo;
+    }
+
+    Statistics statistics() const
+    {
+        return m_stats;
+    }
+
+    /// number of git processes spawned by all readers of this application
+    static int totalSpawnCount();
+
+private:
+    GitObjectReader(const QString &repo, QObject *parent);
+
+    struct Request;
+    struct Channel;
+
+    void enqueue(Channel &channel, const QString &rev, QObject *context, Callback callback);
+    bool ensureStarted(Channel &channel);
+    void onReadyRead(Channel &channel);
+    void finishRequest(Channel &channel, const GitObject &object);
+    void failPending(Channel &channel);
+    void stopIdleProcesses();
+
+private:
+    const QString m_repo;
+    std::unique_ptr<Channel> m_batch;
+    std::unique_ptr<Channel> m_check;
+    QTimer m_idleTimer;
+    Statistics m_stats;
+};
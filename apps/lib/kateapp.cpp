@@ -10,6 +10,7 @@
 #include "doc_or_widget.h"
 #include "kate_timings_debug.h"
 #include "katemainwindow.h"
+#include "katetrace.h"
 #include "kateviewmanager.h"
 
 #include <KAboutData>
@@ -21,6 +22,7 @@
 #include <KMessageBox>
 #include <KNetworkMounts>
 #include <KSharedConfig>
+#include <KTextEditor/Document>
 #include <KTextEditor/View>
 #include <KWindowSystem>
 #include <QLoggingCategory>
@@ -109,6 +111,9 @@ Q_LOGGING_CATEGORY(LOG_KATE, "kate", QtWarningMsg)
 
 void KateApp::initPreApplicationCreation(bool detach)
 {
+    // trace from the start if requested
+    KateTrace::enableFromEnvironment();
+
 #if !defined(Q_OS_WIN) && !defined(Q_OS_HAIKU)
     // Prohibit using sudo or kdesu (but allow using the root user directly)
     if (getuid() == 0) {
@@ -187,6 +192,9 @@ KateApp::KateApp(const QCommandLineParser &args, const ApplicationMode mode, con
 #endif
     , m_docManager(this)
     , m_sessionManager(this, sessionsDir)
+    , m_openServer([this](const KateOpenRequest &request) {
+        return handleOpenRequest(request);
+    })
     , m_lastActivationChange(QDateTime::currentMSecsSinceEpoch())
 {
 #if HAVE_STYLE_MANAGER
@@ -217,6 +225,18 @@ KateApp::KateApp(const QCommandLineParser &args, const ApplicationMode mode, con
     connect(&m_docManager, &KateDocManager::documentWillBeDeleted, &m_wrapper, &KTextEditor::Application::documentWillBeDeleted);
     connect(&m_docManager, &KateDocManager::documentDeleted, &m_wrapper, &KTextEditor::Application::documentDeleted);
 
+    /**
+     * the highlighting mode is only known once a document is loaded, plugins might wait for it
+     */
+    connect(&m_docManager, &KateDocManager::documentCreated, this, [this](KTextEditor::Document *document) {
+        connect(document, &KTextEditor::Document::highlightingModeChanged, this, [this](KTextEditor::Document *doc) {
+            auto win = activeKateMainWindow();
+            if (win && win->activeView() && win->activeView()->document() == doc) {
+                m_pluginManager.documentActivated(doc);
+            }
+        });
+    });
+
     /**
      * handle mac os x like file open request via event filter
      */
@@ -336,12 +356,16 @@ void KateApp::fillAuthorsAndCredits(KAboutData &aboutData)
 
 bool KateApp::init()
 {
+    KATE_TRACE_ZONE("startup", "KateApp::init");
+
     // we want no auto saving during application startup, we handle that explicitly
     KateSessionManager::AutoSaveBlocker blocker(sessionManager());
 
     // set KATE_PID for use in child processes
+    // other invocations of kate can send us the files to open via our local socket
     if (isKate()) {
         qputenv("KATE_PID", QStringLiteral("%1").arg(QCoreApplication::applicationPid()).toLatin1().constData());
+        m_openServer.listen(QCoreApplication::applicationPid());
     }
 
 #ifdef Q_OS_UNIX
@@ -375,6 +399,8 @@ bool KateApp::init()
 
 void KateApp::restoreKate()
 {
+    KATE_TRACE_ZONE("startup", "KateApp::restoreKate");
+
     // we want no auto saving during application startup, we handle that explicitly
     KateSessionManager::AutoSaveBlocker blocker(sessionManager());
 
@@ -403,6 +429,8 @@ void KateApp::restoreKate()
 
 bool KateApp::startupKate()
 {
+    KATE_TRACE_ZONE("startup", "KateApp::startupKate");
+
     // we want no auto saving during application startup, we handle that explicitly
     KateSessionManager::AutoSaveBlocker blocker(sessionManager());
 
@@ -442,6 +470,16 @@ bool KateApp::startupKate()
 
     const auto args = m_args.positionalArguments();
 
+    // read all files ahead in parallel, we open them one after the other below
+    if (args.size() > 1) {
+        std::vector<QUrl> urls;
+        urls.reserve(args.size());
+        for (const auto &positionalArgument : args) {
+            urls.push_back(UrlInfo(positionalArgument).url);
+        }
+        documentManager()->prefetchUrls(urls);
+    }
+
     for (const auto &positionalArgument : args) {
         UrlInfo info(positionalArgument);
 
@@ -459,7 +497,7 @@ bool KateApp::startupKate()
                 }
             }
             doc = openDocUrl(info.url, codec_name, tempfileSet, /*activateView=*/false, info.cursor);
-        } else if (!KateApp::self()->pluginManager()->plugin(QStringLiteral("kateprojectplugin"))) {
+        } else if (!KateApp::self()->pluginManager()->activatePlugin(QStringLiteral("kateprojectplugin"))) {
             KMessageBox::error(activeKateMainWindow(), i18n("Folders can only be opened when the projects plugin is enabled"));
         }
     }
@@ -491,8 +529,8 @@ void KateApp::shutdownKate(KateMainWindow *win)
         return;
     }
 
+    // this will stash unsaved changes, too
     sessionManager()->saveActiveSession(true);
-    stashManager()->stashDocuments(sessionManager()->activeSession()->config(), documentManager()->documentList());
 
     /**
      * all main windows will be cleaned up
@@ -824,6 +862,55 @@ void KateApp::remoteMessageReceived(quint32, QByteArray message)
     }
 }
 
+std::vector<QObject *> KateApp::handleOpenRequest(const KateOpenRequest &request)
+{
+    KateTrace::Zone zone("startup", "KateApp::handleOpenRequest");
+    if (zone.isActive()) {
+        zone.setDetail(QStringLiteral("%1 files").arg(request.files.size()));
+    }
+
+    // we want no auto saving while we open a lot of files
+    KateSessionManager::AutoSaveBlocker blocker(sessionManager());
+
+    if (!request.session.isEmpty()) {
+        sessionManager()->activateSession(request.session);
+    }
+
+    // read all files ahead in parallel, we open them one after the other below
+    if (request.files.size() > 1) {
+        std::vector<QUrl> urls;
+        urls.reserve(request.files.size());
+        for (const auto &file : request.files) {
+            urls.push_back(file.url);
+        }
+        documentManager()->prefetchUrls(urls);
+    }
+
+    // open all files without activating each one of them
+    std::vector<QObject *> documents;
+    documents.reserve(request.files.size());
+    KTextEditor::Document *doc = nullptr;
+    for (const auto &file : request.files) {
+        if (auto opened = openDocUrl(file.url, request.encoding, request.isTempFile, /*activateView=*/false, file.cursor)) {
+            doc = opened;
+            documents.push_back(doc);
+        }
+    }
+
+    if (request.input) {
+        openInput(*request.input, request.encoding);
+    } else if (doc && activeKateMainWindow()) {
+        activeKateMainWindow()->viewManager()->activateView(doc);
+    }
+
+    if (request.cursor.isValid()) {
+        setCursor(request.cursor.line(), request.cursor.column());
+    }
+
+    activate(request.activationToken);
+    return documents;
+}
+
 bool KateApp::documentVisibleInOtherWindows(KTextEditor::Document *doc, KateMainWindow *window) const
 {
     for (auto win : m_mainWindows) {
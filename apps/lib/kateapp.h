@@ -18,6 +18,7 @@
 #endif
 
 #include "katedocmanager.h"
+#include "kateopenserver.h"
 #include "katepluginmanager.h"
 #include "kateprivate_export.h"
 #include "katesessionmanager.h"
@@ -405,6 +406,13 @@ public Q_SLOTS:
      */
     void remoteMessageReceived(quint32 instanceId, QByteArray message);
 
+    /**
+     * Handle an open request of some command line invocation, received via our KateOpenServer.
+     * All files are opened in one go, only the last one is activated.
+     * @return the opened documents
+     */
+    std::vector<QObject *> handleOpenRequest(const KateOpenRequest &request);
+
     /**
      * activate this kate instance
      */
@@ -484,6 +492,12 @@ private:
 
     KateStashManager m_stashManager;
 
+    /**
+     * fast path to open files from the command line in this instance
+     * must be destroyed before the documents, blocking clients wait for their connection to close
+     */
+    KateOpenServer m_openServer;
+
 #ifdef WITH_KUSERFEEDBACK
     /**
      * user feedback provider
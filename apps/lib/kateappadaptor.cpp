@@ -8,6 +8,7 @@
 
 #include "kateapp.h"
 #include "katemainwindow.h"
+#include "kateresourceusage.h"
 #include "katesessionmanager.h"
 
 #include "katedebug.h"
@@ -93,6 +94,11 @@ qint64 KateAppAdaptor::lastActivationChange() const
     return m_app->lastActivationChange();
 }
 
+QString KateAppAdaptor::resourceUsage()
+{
+    return KateResourceUsage::self()->dump();
+}
+
 QString KateAppAdaptor::activeSession() const
 {
     return m_app->sessionManager()->activeSession()->name();
@@ -86,6 +86,11 @@ public Q_SLOTS:
      */
     void activate(const QString &token = QString());
 
+    /**
+     * memory and CPU time used by the different parts of this instance, as text
+     */
+    QString resourceUsage();
+
 Q_SIGNALS:
     /**
      * Notify the world that this kate instance is exiting.
@@ -276,6 +276,20 @@ void KateConfigDialog::addBehaviorPage()
     connect(m_openNewTabInFrontOfCurrent, &QCheckBox::toggled, this, &KateConfigDialog::slotChanged);
     vbox->addWidget(m_openNewTabInFrontOfCurrent);
 
+    // views of background tabs can be recycled to save memory, they get created again on activation
+    hlayout = new QHBoxLayout;
+    label = new QLabel(i18n("Limit number of &views kept in memory:"), buttonGroup);
+    hlayout->addWidget(label);
+    m_viewLimit = new QSpinBox(buttonGroup);
+    hlayout->addWidget(m_viewLimit);
+    label->setBuddy(m_viewLimit);
+    m_viewLimit->setRange(0, 1024);
+    m_viewLimit->setSpecialValueText(i18n("Unlimited"));
+    m_viewLimit->setValue(cgGeneral.readEntry("View Limit", 0));
+    m_viewLimit->setToolTip(i18n("Views of the least recently used tabs will be freed if there are more. They are recreated once the tab is activated."));
+    connect(m_viewLimit, &QSpinBox::valueChanged, this, &KateConfigDialog::slotChanged);
+    vbox->addLayout(hlayout);
+
     layout->addWidget(buttonGroup);
 
     buttonGroup = new QGroupBox(i18n("&Mouse"), generalFrame);
@@ -390,10 +404,25 @@ void KateConfigDialog::addSessionPage()
     sessionConfigUi.daysMetaInfos->setValue(KateApp::self()->documentManager()->getDaysMetaInfos());
     connect(sessionConfigUi.daysMetaInfos, &QSpinBox::valueChanged, this, &KateConfigDialog::slotChanged);
 
+    // hibernation of unused documents
+    sessionConfigUi.hibernateDocuments->setChecked(cgGeneral.readEntry("Hibernate Documents", false));
+    connect(sessionConfigUi.hibernateDocuments, &QGroupBox::toggled, this, &KateConfigDialog::slotChanged);
+    sessionConfigUi.hibernateMinutes->setRange(1, 24 * 60);
+    KLocalization::setupSpinBoxFormatString(sessionConfigUi.hibernateMinutes,
+                                            ki18ncp("The suffix of 'Hibernate documents not viewed for'", "%v minute", "%v minutes"));
+    sessionConfigUi.hibernateMinutes->setValue(cgGeneral.readEntry("Hibernate Documents After", 30));
+    connect(sessionConfigUi.hibernateMinutes, &QSpinBox::valueChanged, this, &KateConfigDialog::slotChanged);
+    sessionConfigUi.hibernateModified->setChecked(cgGeneral.readEntry("Hibernate Modified Documents", false));
+    connect(sessionConfigUi.hibernateModified, &QCheckBox::toggled, this, &KateConfigDialog::slotChanged);
+
     // restore view  config
     sessionConfigUi.restoreVC->setChecked(cgGeneral.readEntry("Restore Window Configuration", true));
     connect(sessionConfigUi.restoreVC, &QCheckBox::toggled, this, &KateConfigDialog::slotChanged);
 
+    // lazy loading of session documents
+    sessionConfigUi.lazyRestore->setChecked(cgGeneral.readEntry("Lazy Session Restore", false));
+    connect(sessionConfigUi.lazyRestore, &QCheckBox::toggled, this, &KateConfigDialog::slotChanged);
+
     sessionConfigUi.spinBoxRecentFilesCount->setValue(recentFilesMaxCount());
     connect(sessionConfigUi.spinBoxRecentFilesCount, &QSpinBox::valueChanged, this, &KateConfigDialog::slotChanged);
 
@@ -433,10 +462,12 @@ void KateConfigDialog::addSessionPage()
     if (KateApp::isKWrite()) {
         sessionConfigUi.gbAppStartup->hide();
         sessionConfigUi.restoreVC->hide();
+        sessionConfigUi.lazyRestore->hide();
         sessionConfigUi.label_4->hide();
         sessionConfigUi.stashNewUnsavedFiles->hide();
         sessionConfigUi.stashUnsavedFilesChanges->hide();
         sessionConfigUi.label->hide();
+        sessionConfigUi.hibernateModified->hide();
     }
 }
 
@@ -570,6 +601,8 @@ void KateConfigDialog::slotApply()
 
         cg.writeEntry("Restore Window Configuration", sessionConfigUi.restoreVC->isChecked());
 
+        cg.writeEntry("Lazy Session Restore", sessionConfigUi.lazyRestore->isChecked());
+
         cg.writeEntry("Recent File List Entry Count", sessionConfigUi.spinBoxRecentFilesCount->value());
 
         if (sessionConfigUi.startNewSessionRadioButton->isChecked()) {
@@ -586,6 +619,12 @@ void KateConfigDialog::slotApply()
         cg.writeEntry("Days Meta Infos", sessionConfigUi.daysMetaInfos->value());
         KateApp::self()->documentManager()->setDaysMetaInfos(sessionConfigUi.daysMetaInfos->value());
 
+        cg.writeEntry("Hibernate Documents", sessionConfigUi.hibernateDocuments->isChecked());
+        cg.writeEntry("Hibernate Documents After", sessionConfigUi.hibernateMinutes->value());
+        cg.writeEntry("Hibernate Modified Documents", sessionConfigUi.hibernateModified->isChecked());
+        KateApp::self()->documentManager()->setHibernation(sessionConfigUi.hibernateDocuments->isChecked() ? sessionConfigUi.hibernateMinutes->value() : 0,
+                                                           sessionConfigUi.hibernateModified->isChecked());
+
         cg.writeEntry("Show welcome view for new window", sessionConfigUi.showWelcomeViewForNewWindow->isChecked());
 
         cg.writeEntry("Close documents with window", sessionConfigUi.winClosesDocuments->isChecked());
@@ -610,6 +649,7 @@ void KateConfigDialog::slotApply()
         m_mainWindow->setModNotificationEnabled(m_modNotifications->isChecked());
 
         cg.writeEntry("Tabbar Tab Limit", m_tabLimit->value());
+        cg.writeEntry("View Limit", m_viewLimit->value());
 
         cg.writeEntry("Auto Hide Tabs", m_autoHideTabs->isChecked());
 
@@ -90,6 +90,7 @@ private:
     QSpinBox *m_leftRightSidebarsIconSize = nullptr;
     QComboBox *m_cmbQuickOpenListMode;
     QSpinBox *m_tabLimit;
+    QSpinBox *m_viewLimit = nullptr;
     QCheckBox *m_autoHideTabs;
     QCheckBox *m_showTabCloseButton;
     QCheckBox *m_expandTabs;
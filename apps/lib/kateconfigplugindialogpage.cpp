@@ -12,8 +12,11 @@
 #include "kateconfigdialog.h"
 #include "katepluginmanager.h"
 
+#include <KConfigGroup>
 #include <KLocalizedString>
+#include <KSharedConfig>
 
+#include <QCheckBox>
 #include <QLineEdit>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
@@ -79,11 +82,20 @@ KateConfigPluginPage::KateConfigPluginPage(QWidget *parent, KateConfigDialog *di
 
     KatePluginList &pluginList(KateApp::self()->pluginManager()->pluginList());
     auto pluginModel = new QStandardItemModel(this);
-    pluginModel->setHorizontalHeaderLabels({i18n("Name"), i18n("Description")});
+    pluginModel->setHorizontalHeaderLabels({i18n("Name"), i18n("Description"), i18n("Load Time")});
     for (auto &pluginInfo : pluginList) {
         auto item = new KatePluginListItem(pluginInfo.load, &pluginInfo);
         item->setText(pluginInfo.metaData.name());
-        pluginModel->appendRow({item, new QStandardItem(pluginInfo.metaData.description())});
+
+        // what this plugin did cost us in this session
+        QString loadTime;
+        if (pluginInfo.loadTime >= 0) {
+            loadTime = i18nc("time it took to load a plugin", "%1 ms", pluginInfo.loadTime);
+        } else if (pluginInfo.deferred) {
+            loadTime = i18nc("plugin waiting to be loaded once it is needed", "On demand");
+        }
+
+        pluginModel->appendRow({item, new QStandardItem(pluginInfo.metaData.description()), new QStandardItem(loadTime)});
         m_pluginItems.push_back(item);
     }
     connect(pluginModel, &QStandardItemModel::itemChanged, this, &KateConfigPluginPage::changed);
@@ -112,10 +124,20 @@ KateConfigPluginPage::KateConfigPluginPage(QWidget *parent, KateConfigDialog *di
     connect(filter, &QLineEdit::textChanged, sortModel, [sortModel](const QString &text) {
         sortModel->setFilterRegularExpression(QRegularExpression(text, QRegularExpression::CaseInsensitiveOption));
     });
+
+    // plugins that know when they are needed can be loaded only then
+    m_loadOnDemand = new QCheckBox(i18n("Load plugins only once they are needed"), this);
+    m_loadOnDemand->setToolTip(
+        i18n("Plugins like the SQL or LSP plugins are loaded once a tool view or action of them is used or a matching file is opened. Takes effect on the next start."));
+    m_loadOnDemand->setChecked(KConfigGroup(KSharedConfig::openConfig(), QStringLiteral("General")).readEntry("Load Plugins On Demand", true));
+    layout->addWidget(m_loadOnDemand);
+    connect(m_loadOnDemand, &QCheckBox::toggled, this, &KateConfigPluginPage::changed);
 }
 
 void KateConfigPluginPage::slotApply()
 {
+    KConfigGroup(KSharedConfig::openConfig(), QStringLiteral("General")).writeEntry("Load Plugins On Demand", m_loadOnDemand->isChecked());
+
     for (auto item : m_pluginItems) {
         if (item->checkState() == Qt::Checked) {
             loadPlugin(item);
@@ -11,6 +11,7 @@
 #include <QFrame>
 
 class KatePluginListItem;
+class QCheckBox;
 
 class KateConfigPluginPage : public QFrame
 {
@@ -34,4 +35,5 @@ private:
 
 private:
     std::vector<class KatePluginListItem *> m_pluginItems;
+    QCheckBox *m_loadOnDemand = nullptr;
 };
@@ -10,7 +10,9 @@
 
 #include "kateapp.h"
 #include "katemainwindow.h"
+#include "kateresourceusage.h"
 #include "katesavemodifieddialog.h"
+#include "katetrace.h"
 #include "kateviewmanager.h"
 #include "ktexteditor_utils.h"
 
@@ -22,21 +24,81 @@
 #include <KMessageBox>
 #include <KSharedConfig>
 
+#include <QFile>
 #include <QFileDialog>
 #include <QProgressDialog>
+#include <QSignalBlocker>
+#include <QStandardPaths>
+
+#include <optional>
+#include <utility>
 
 KateDocManager::KateDocManager(QObject *parent)
     : QObject(parent)
-    , m_metaInfos(KateApp::isKate() ? QStringLiteral("katemetainfos") : QStringLiteral("kwritemetainfos"), KConfig::NoGlobals)
+    , m_metaInfos(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/metainfos"))
     , m_saveMetaInfos(true)
     , m_daysMetaInfos(0)
+    , m_pendingRestoreConfig(QString(), KConfig::SimpleConfig)
 {
+    // load lazily restored documents one by one if we are idle
+    m_pendingRestoreTimer.setInterval(0);
+    connect(&m_pendingRestoreTimer, &QTimer::timeout, this, &KateDocManager::loadNextPendingDocument);
+
+    // look for documents to hibernate from time to time, see setHibernation
+    m_hibernationTimer.setInterval(60 * 1000);
+    connect(&m_hibernationTimer, &QTimer::timeout, this, &KateDocManager::hibernateUnusedDocuments);
+
+    // prefetching is bound by I/O, a few threads are enough to keep the disk busy
+    m_prefetchPool.setMaxThreadCount(4);
+
     // set our application wrapper
     KTextEditor::Editor::instance()->setApplication(KateApp::self()->wrapper());
+
+    // import the meta infos of the old KConfig based storage once
+    const QString oldMetaInfos =
+        QStandardPaths::locate(QStandardPaths::GenericConfigLocation, KateApp::isKate() ? QStringLiteral("katemetainfos") : QStringLiteral("kwritemetainfos"));
+    if (!oldMetaInfos.isEmpty() && m_metaInfos.size() == 0) {
+        const KConfig config(oldMetaInfos, KConfig::SimpleConfig);
+        const QStringList groups = config.groupList();
+        for (const auto &group : groups) {
+            const KConfigGroup urlGroup(&config, group);
+            KateMetaInfoStore::Entry entry;
+            entry.checksum = urlGroup.readEntry("Checksum").toLatin1();
+            entry.time = urlGroup.readEntry("Time", QDateTime::currentDateTimeUtc());
+            entry.config = urlGroup.entryMap();
+            entry.config.remove(QStringLiteral("URL"));
+            entry.config.remove(QStringLiteral("Checksum"));
+            entry.config.remove(QStringLiteral("Time"));
+            m_metaInfos.insert(urlGroup.readEntry("URL", group), entry);
+        }
+        m_metaInfos.flush();
+        QFile::remove(oldMetaInfos);
+    }
+
+    KateResourceUsage::self()->addReporter(QStringLiteral("Documents"), this, [this](KateResourceUsage::Report &report) {
+        qint64 loaded = 0;
+        qint64 characters = 0;
+        qint64 views = 0;
+        for (auto doc : std::as_const(m_docList)) {
+            if (!isPendingRestore(doc)) {
+                ++loaded;
+                characters += doc->totalCharacters();
+            }
+            views += doc->views().size();
+        }
+        report.add(QStringLiteral("Loaded documents"), loaded, characters * qint64(sizeof(QChar)));
+        report.add(QStringLiteral("Placeholder documents"), m_docList.size() - loaded);
+        report.add(QStringLiteral("Views"), views);
+        report.add(QStringLiteral("Meta info entries"), m_metaInfos.size());
+    });
 }
 
 KateDocManager::~KateDocManager()
 {
+    // no need to finish prefetching if we are going away
+    m_prefetchPool.clear();
+    m_prefetchPool.waitForDone();
+
     // write metainfos?
     if (m_saveMetaInfos) {
         // saving meta-infos when file is saved is not enough, we need to do it once more at the end
@@ -44,15 +106,7 @@ KateDocManager::~KateDocManager()
 
         // purge saved filesessions
         if (m_daysMetaInfos > 0) {
-            const QStringList groups = m_metaInfos.groupList();
-            QDateTime def(QDate(1970, 1, 1).startOfDay());
-
-            for (const auto &group : groups) {
-                QDateTime last = m_metaInfos.group(group).readEntry("Time", def);
-                if (last.daysTo(QDateTime::currentDateTimeUtc()) > m_daysMetaInfos) {
-                    m_metaInfos.deleteGroup(group);
-                }
-            }
+            m_metaInfos.removeOlderThan(m_daysMetaInfos);
         }
     }
 }
@@ -75,7 +129,7 @@ KTextEditor::Document *KateDocManager::createDoc(const KateDocumentInfo &docInfo
     doc->setModifiedOnDiskWarning(!ownModNotification);
 
     m_docList.push_back(doc);
-    m_docInfos.emplace(doc, docInfo);
+    m_docInfos.emplace(doc, docInfo).first->second.lastUsed = QDateTime::currentMSecsSinceEpoch();
 
     // connect internal signals...
     connect(doc, &KTextEditor::Document::modifiedChanged, this, &KateDocManager::slotModChanged1);
@@ -84,6 +138,9 @@ KTextEditor::Document *KateDocManager::createDoc(const KateDocumentInfo &docInfo
         slotUrlChanged(doc->url());
     });
     connect(doc, &KParts::ReadOnlyPart::urlChanged, this, &KateDocManager::slotUrlChanged);
+    connect(doc, &KTextEditor::Document::viewCreated, this, [this](KTextEditor::Document *doc) {
+        m_docInfos.at(doc).lastUsed = QDateTime::currentMSecsSinceEpoch();
+    });
 
     // we have a new document, show it the world
     Q_EMIT documentCreated(doc);
@@ -110,8 +167,37 @@ KTextEditor::Document *KateDocManager::findDocument(const QUrl &url) const
     return it == m_docInfos.end() ? nullptr : it->first;
 }
 
+void KateDocManager::prefetchUrls(std::span<const QUrl> urls)
+{
+    // huge files will trigger a question before they are opened anyway, skip them
+    constexpr qint64 MaxPrefetchSize = 64 * 1024 * 1024;
+
+    for (const QUrl &url : urls) {
+        if (!url.isLocalFile() || findDocument(url)) {
+            continue;
+        }
+
+        m_prefetchPool.start([path = url.toLocalFile()]() {
+            QFile file(path);
+            if (file.size() > MaxPrefetchSize || !file.open(QFile::ReadOnly)) {
+                return;
+            }
+
+            // we only want the data in the page cache, the document will read it again
+            QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+            while (file.read(buffer.data(), buffer.size()) > 0) {
+            }
+        });
+    }
+}
+
 std::vector<KTextEditor::Document *> KateDocManager::openUrls(std::span<const QUrl> urls, const QString &encoding, const KateDocumentInfo &docInfo)
 {
+    // read ahead the files we will load one after the other
+    if (urls.size() > 1) {
+        prefetchUrls(urls);
+    }
+
     std::vector<KTextEditor::Document *> docs;
     docs.reserve(urls.size());
     for (const QUrl &url : urls) {
@@ -122,12 +208,18 @@ std::vector<KTextEditor::Document *> KateDocManager::openUrls(std::span<const QU
 
 KTextEditor::Document *KateDocManager::openUrl(const QUrl &url, const QString &encoding, const KateDocumentInfo &docInfo)
 {
+    KateTrace::Zone zone("documents", "KateDocManager::openUrl");
+    if (zone.isActive()) {
+        zone.setDetail(url.toDisplayString(QUrl::PreferLocalFile));
+    }
+
     // We want to work on absolute urls
     const QUrl u(Utils::absoluteUrl(url));
 
     // try to find already open document
     if (!u.isEmpty()) {
         if (auto doc = findDocument(u)) {
+            loadPendingDocument(doc);
             return doc;
         }
     }
@@ -175,6 +267,11 @@ bool KateDocManager::closeDocuments(std::span<KTextEditor::Document *const> docu
     int last = 0;
     bool success = true;
     for (KTextEditor::Document *doc : documents) {
+        // hibernated documents with unsaved changes must ask like any other modified document
+        if (closeUrl && isPendingRestore(doc) && hasUnsavedChanges(doc)) {
+            loadPendingDocument(doc);
+        }
+
         if (closeUrl && !doc->closeUrl()) {
             success = false; // get out on first error
             break;
@@ -185,6 +282,14 @@ bool KateDocManager::closeDocuments(std::span<KTextEditor::Document *const> docu
 
         // really delete the document and its infos
         disconnect(doc, &KParts::ReadOnlyPart::urlChanged, this, &KateDocManager::slotUrlChanged);
+        if (const auto &group = m_docInfos[doc].pendingRestoreGroup; !group.isEmpty()) {
+            // a hibernated modified document has its content in the stash
+            if (const QString stashedFile = m_pendingRestoreConfig.group(group).readEntry("stashedFile"); !stashedFile.isEmpty()) {
+                KateApp::self()->stashManager()->waitForStashWrites();
+                QFile::remove(stashedFile);
+            }
+            m_pendingRestoreConfig.deleteGroup(group);
+        }
         m_docInfos.erase(doc);
         delete m_docList.takeAt(m_docList.indexOf(doc));
 
@@ -212,9 +317,13 @@ bool KateDocManager::closeDocumentList(std::span<KTextEditor::Document *const> d
 {
     std::vector<KTextEditor::Document *> modifiedDocuments;
     for (KTextEditor::Document *document : documents) {
-        if (document->isModified()) {
-            modifiedDocuments.push_back(document);
+        if (!hasUnsavedChanges(document)) {
+            continue;
         }
+
+        // the dialog saves or discards the content, a hibernated document has it in its stash only
+        loadPendingDocument(document);
+        modifiedDocuments.push_back(document);
     }
 
     if (!modifiedDocuments.empty() && !KateSaveModifiedDialog::queryClose(window, modifiedDocuments)) {
@@ -255,9 +364,18 @@ bool KateDocManager::closeOtherDocuments(KTextEditor::Document *doc)
 std::vector<KTextEditor::Document *> KateDocManager::modifiedDocumentList()
 {
     std::vector<KTextEditor::Document *> modified;
-    std::copy_if(m_docList.begin(), m_docList.end(), std::back_inserter(modified), [](KTextEditor::Document *doc) {
-        return doc->isModified();
-    });
+    for (KTextEditor::Document *doc : std::as_const(m_docList)) {
+        if (!hasUnsavedChanges(doc)) {
+            continue;
+        }
+
+        // without stashing the session can't keep the changes of a hibernated document,
+        // load it so it can be saved
+        if (isPendingRestore(doc) && !KateApp::self()->stashManager()->canStash()) {
+            loadPendingDocument(doc);
+        }
+        modified.push_back(doc);
+    }
     return modified;
 }
 
@@ -307,7 +425,8 @@ bool KateDocManager::queryCloseDocuments(KateMainWindow *w)
 void KateDocManager::saveAll()
 {
     for (KTextEditor::Document *doc : std::as_const(m_docList)) {
-        if (doc->isModified()) {
+        if (hasUnsavedChanges(doc)) {
+            loadPendingDocument(doc);
             doc->documentSave();
         }
     }
@@ -350,14 +469,22 @@ void KateDocManager::saveDocumentList(KConfig *config)
     for (KTextEditor::Document *doc : std::as_const(m_docList)) {
         const QString entryName = QStringLiteral("Document %1").arg(i);
         KConfigGroup cg(config, entryName);
-        doc->writeSessionConfig(cg);
-        m_docInfos[doc].sessionConfigId = i;
+        auto &info = m_docInfos[doc];
+        if (!info.pendingRestoreGroup.isEmpty()) {
+            // never loaded, keep what we restored from
+            m_pendingRestoreConfig.group(info.pendingRestoreGroup).copyTo(&cg);
+        } else {
+            doc->writeSessionConfig(cg);
+        }
+        info.sessionConfigId = i;
         i++;
     }
 }
 
 void KateDocManager::restoreDocumentList(KConfig *config)
 {
+    KATE_TRACE_ZONE("session", "KateDocManager::restoreDocumentList");
+
     KConfigGroup openDocGroup(config, QStringLiteral("Open Documents"));
     unsigned int count = openDocGroup.readEntry("Count", 0);
 
@@ -370,17 +497,46 @@ void KateDocManager::restoreDocumentList(KConfig *config)
         return;
     }
 
-    QProgressDialog progress;
-    progress.setWindowTitle(i18n("Starting Up"));
-    progress.setLabelText(i18n("Reopening files from the last session..."));
-    progress.setModal(true);
-    progress.setCancelButton(nullptr);
-    progress.setRange(0, count);
+    // in lazy mode, we only create placeholders for all documents with an url
+    // they get loaded once a view is created for them or in the background if we are idle
+    const KConfigGroup generalGroup(KSharedConfig::openConfig(), QStringLiteral("General"));
+    const bool lazy = generalGroup.readEntry("Lazy Session Restore", false);
+
+    std::optional<QProgressDialog> progress;
+    if (!lazy) {
+        progress.emplace();
+        progress->setWindowTitle(i18n("Starting Up"));
+        progress->setLabelText(i18n("Reopening files from the last session..."));
+        progress->setModal(true);
+        progress->setCancelButton(nullptr);
+        progress->setRange(0, count);
+    }
+
+    // all documents will be loaded now, read them ahead in parallel
+    if (!lazy) {
+        std::vector<QUrl> urls;
+        urls.reserve(count);
+        for (unsigned int i = 0; i < count; i++) {
+            urls.emplace_back(KConfigGroup(config, QStringLiteral("Document %1").arg(i)).readEntry("URL"));
+        }
+        prefetchUrls(urls);
+    }
 
     for (unsigned int i = 0; i < count; i++) {
         KConfigGroup cg(config, QStringLiteral("Document %1").arg(i));
         KTextEditor::Document *doc = createDoc();
-        m_docInfos[doc].sessionConfigId = i;
+        auto &info = m_docInfos[doc];
+        info.sessionConfigId = i;
+
+        // stashed or untitled documents are always loaded, they are not backed by the file we would load later
+        const QString url = cg.readEntry("URL");
+        if (lazy && !url.isEmpty() && !cg.hasKey("stashedFile")) {
+            info.pendingRestoreGroup = QString::number(reinterpret_cast<quintptr>(doc));
+            info.normalizedUrl = Utils::normalizeUrl(QUrl(url));
+            KConfigGroup pending(&m_pendingRestoreConfig, info.pendingRestoreGroup);
+            cg.copyTo(&pending);
+            continue;
+        }
 
         connect(doc, &KTextEditor::Document::completed, this, &KateDocManager::documentOpened);
         connect(doc, &KParts::ReadOnlyPart::canceled, this, &KateDocManager::documentOpened);
@@ -389,10 +545,157 @@ void KateDocManager::restoreDocumentList(KConfig *config)
 
         KateApp::self()->stashManager()->popDocument(doc, cg);
 
-        progress.setValue(i);
+        if (progress) {
+            progress->setValue(i);
+        }
+    }
+
+    if (lazy) {
+        m_pendingRestoreTimer.start();
     }
 }
 
+bool KateDocManager::isPendingRestore(KTextEditor::Document *doc) const
+{
+    auto it = m_docInfos.find(doc);
+    return it != m_docInfos.end() && !it->second.pendingRestoreGroup.isEmpty();
+}
+
+bool KateDocManager::hasUnsavedChanges(KTextEditor::Document *doc) const
+{
+    if (doc->isModified()) {
+        return true;
+    }
+
+    auto it = m_docInfos.find(doc);
+    return it != m_docInfos.end() && !it->second.pendingRestoreGroup.isEmpty()
+        && m_pendingRestoreConfig.group(it->second.pendingRestoreGroup).hasKey("stashedFile");
+}
+
+void KateDocManager::loadPendingDocument(KTextEditor::Document *doc)
+{
+    auto it = m_docInfos.find(doc);
+    if (it == m_docInfos.end() || it->second.pendingRestoreGroup.isEmpty()) {
+        return;
+    }
+
+    // clear the pending state first, loading might trigger view creation that would recurse into this
+    const QString group = std::exchange(it->second.pendingRestoreGroup, QString());
+
+    connect(doc, &KTextEditor::Document::completed, this, &KateDocManager::documentOpened);
+    connect(doc, &KParts::ReadOnlyPart::canceled, this, &KateDocManager::documentOpened);
+
+    const KConfigGroup cg = m_pendingRestoreConfig.group(group);
+    doc->readSessionConfig(cg);
+    KateApp::self()->stashManager()->popDocument(doc, cg);
+    m_pendingRestoreConfig.deleteGroup(group);
+    m_docInfos.at(doc).lastUsed = QDateTime::currentMSecsSinceEpoch();
+}
+
+void KateDocManager::loadNextPendingDocument()
+{
+    // one document per round, we want to stay responsive
+    for (KTextEditor::Document *doc : std::as_const(m_docList)) {
+        if (isPendingRestore(doc)) {
+            loadPendingDocument(doc);
+            return;
+        }
+    }
+
+    m_pendingRestoreTimer.stop();
+}
+
+bool KateDocManager::hibernateDocument(KTextEditor::Document *doc)
+{
+    auto it = m_docInfos.find(doc);
+    if (it == m_docInfos.end() || !it->second.pendingRestoreGroup.isEmpty() || !doc->views().isEmpty()) {
+        return false;
+    }
+
+    // we must be able to load it again without asking anything
+    if (!doc->url().isLocalFile() || it->second.modifiedOnDisc || !it->second.openSuccess || (doc->isModified() && !m_hibernateModified)) {
+        return false;
+    }
+
+    // remember everything to load the document again
+    const QString group = QString::number(reinterpret_cast<quintptr>(doc));
+    KConfigGroup cg(&m_pendingRestoreConfig, group);
+    doc->writeSessionConfig(cg);
+    if (doc->isModified()) {
+        if (!KateApp::self()->stashManager()->stashForHibernation(doc, cg)) {
+            m_pendingRestoreConfig.deleteGroup(group);
+            return false;
+        }
+    } else {
+        saveMetaInfos(std::span(&doc, 1));
+    }
+
+    // plugins drop their moving ranges and per document state on these, closeUrl() below
+    // would emit them, but it has to run with all signals of the document blocked
+    Q_EMIT doc->aboutToClose(doc);
+    Q_EMIT doc->aboutToInvalidateMovingInterfaceContent(doc);
+
+    // apart from that the outside world shall not notice, tabs, file tree and quick open keep the url
+    // and name, documentUrl() and documentName() provide them for new users
+    bool closed = false;
+    {
+        const QSignalBlocker blocker(doc);
+        const bool wasModified = doc->isModified();
+        doc->setModified(false);
+        closed = doc->closeUrl();
+        if (!closed) {
+            doc->setModified(wasModified);
+        }
+    }
+    if (!closed) {
+        m_pendingRestoreConfig.deleteGroup(group);
+        return false;
+    }
+
+    it->second.pendingRestoreGroup = group;
+    return true;
+}
+
+void KateDocManager::setHibernation(int minutes, bool modified)
+{
+    m_hibernationTimeoutMs = qint64(std::max(minutes, 0)) * 60 * 1000;
+    m_hibernateModified = modified;
+    if (m_hibernationTimeoutMs > 0) {
+        m_hibernationTimer.start();
+    } else {
+        m_hibernationTimer.stop();
+    }
+}
+
+void KateDocManager::hibernateUnusedDocuments()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (KTextEditor::Document *doc : std::as_const(m_docList)) {
+        auto &info = m_docInfos.at(doc);
+        if (!doc->views().isEmpty()) {
+            info.lastUsed = now;
+        } else if (now - info.lastUsed >= m_hibernationTimeoutMs) {
+            hibernateDocument(doc);
+        }
+    }
+}
+
+QUrl KateDocManager::documentUrl(KTextEditor::Document *doc) const
+{
+    if (isPendingRestore(doc)) {
+        return m_docInfos.at(doc).normalizedUrl;
+    }
+    return doc->url();
+}
+
+QString KateDocManager::documentName(KTextEditor::Document *doc) const
+{
+    if (isPendingRestore(doc)) {
+        return m_docInfos.at(doc).normalizedUrl.fileName();
+    }
+    return doc->documentName();
+}
+
 void KateDocManager::slotModifiedOnDisc(KTextEditor::Document *doc, bool b, KTextEditor::Document::ModifiedOnDiskReason reason)
 {
     auto it = m_docInfos.find(doc);
@@ -412,17 +715,23 @@ bool KateDocManager::loadMetaInfos(KTextEditor::Document *doc, const QUrl &url)
         return false;
     }
 
-    if (!m_metaInfos.hasGroup(url.toDisplayString())) {
+    const QString key = url.toString();
+    if (!m_metaInfos.contains(key)) {
         return false;
     }
 
     const QByteArray checksum = doc->checksum().toHex();
     bool ok = true;
     if (!checksum.isEmpty()) {
-        KConfigGroup urlGroup(&m_metaInfos, url.toDisplayString());
-        const QString old_checksum = urlGroup.readEntry("Checksum");
+        const auto entry = m_metaInfos.value(key);
+        if (entry && entry->checksum == checksum) {
+            // feed the stored entries to the document via a temporary in-memory config
+            KConfig config(QString(), KConfig::SimpleConfig);
+            KConfigGroup urlGroup(&config, QStringLiteral("Document"));
+            for (auto it = entry->config.cbegin(); it != entry->config.cend(); ++it) {
+                urlGroup.writeEntry(it.key(), it.value());
+            }
 
-        if (QString::fromLatin1(checksum) == old_checksum) {
             QSet<QString> flags;
             if (documentInfo(doc)->openedByUser) {
                 flags << QStringLiteral("SkipEncoding");
@@ -430,7 +739,7 @@ bool KateDocManager::loadMetaInfos(KTextEditor::Document *doc, const QUrl &url)
             flags << QStringLiteral("SkipUrl");
             doc->readSessionConfig(urlGroup, flags);
         } else {
-            urlGroup.deleteGroup();
+            m_metaInfos.remove(key);
             ok = false;
         }
     }
@@ -468,21 +777,20 @@ void KateDocManager::saveMetaInfos(std::span<KTextEditor::Document *const> docum
         const QByteArray checksum = doc->checksum().toHex();
         if (!checksum.isEmpty()) {
             /**
-             * write the group with checksum and time
+             * write document session config to a temporary in-memory config
              */
-            const QString url = doc->url().toString();
-            KConfigGroup urlGroup(&m_metaInfos, url);
+            KConfig config(QString(), KConfig::SimpleConfig);
+            KConfigGroup urlGroup(&config, QStringLiteral("Document"));
+            doc->writeSessionConfig(urlGroup, flags);
 
             /**
-             * write document session config
+             * store it together with checksum and time
              */
-            doc->writeSessionConfig(urlGroup, flags);
+            const QString url = doc->url().toString();
             if (!urlGroup.keyList().isEmpty()) {
-                urlGroup.writeEntry("URL", url);
-                urlGroup.writeEntry("Checksum", QString::fromLatin1(checksum));
-                urlGroup.writeEntry("Time", now);
+                m_metaInfos.insert(url, KateMetaInfoStore::Entry{.checksum = checksum, .time = now, .config = urlGroup.entryMap()});
             } else {
-                urlGroup.deleteGroup();
+                m_metaInfos.remove(url);
             }
         }
     }
@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include "katemetainfostore.h"
 #include "kateprivate_export.h"
 
 #include <KTextEditor/Document>
 
 #include <QList>
 #include <QObject>
+#include <QThreadPool>
+#include <QTimer>
 
 #include <KConfig>
 
@@ -42,6 +45,13 @@ public:
     // id of this document from the last session restore or as set by the last session save
     // -1 if not valid
     int sessionConfigId = -1;
+
+    // group in the pending restore config if this document was restored lazily and not loaded yet
+    // or if it got hibernated
+    QString pendingRestoreGroup;
+
+    // last time the document was seen with a view, in ms since epoch, used for hibernation
+    qint64 lastUsed = 0;
 };
 
 class KATE_PRIVATE_EXPORT KateDocManager : public QObject
@@ -76,6 +86,12 @@ public:
     std::vector<KTextEditor::Document *>
     openUrls(std::span<const QUrl>, const QString &encoding = QString(), const KateDocumentInfo &docInfo = KateDocumentInfo());
 
+    /**
+     * Read the given local files concurrently in the background, before we load them one after the other.
+     * The documents will then load from the page cache instead of waiting for the disk for each file.
+     */
+    void prefetchUrls(std::span<const QUrl> urls);
+
     QList<QUrl> popRecentlyClosedUrls();
 
     bool closeDocument(KTextEditor::Document *, bool closeUrl = true);
@@ -90,6 +106,51 @@ public:
     void saveDocumentList(KConfig *config);
     void restoreDocumentList(KConfig *config);
 
+    /**
+     * Is the given document only a placeholder from a lazy session restore or a hibernated document?
+     * Such documents have no content and no url, use documentUrl() to get the url they will load.
+     */
+    bool isPendingRestore(KTextEditor::Document *doc) const;
+
+    /**
+     * Is the given document modified? A hibernated document with unsaved changes reports
+     * isModified() == false, its changes are in a stash file until it is loaded again.
+     */
+    bool hasUnsavedChanges(KTextEditor::Document *doc) const;
+
+    /**
+     * Load the given document if it is a placeholder from a lazy session restore or hibernated.
+     * Views, openUrl and the background loader trigger this, plugins can call it
+     * to access the content of a document on demand.
+     */
+    void loadPendingDocument(KTextEditor::Document *doc);
+
+    /**
+     * Unload the content of the given document to free memory, it stays in the document list
+     * and is loaded again on access, like a placeholder of a lazy session restore.
+     * Only documents without views that can be reloaded from a local file are hibernated,
+     * modified documents only if hibernation of them is enabled and they can be stashed.
+     * @return true if the document got hibernated
+     */
+    bool hibernateDocument(KTextEditor::Document *doc);
+
+    /**
+     * Configure the automatic hibernation of documents without views.
+     * @param minutes hibernate documents not used for that long, 0 to disable
+     * @param modified hibernate modified documents, too, their content is stashed
+     */
+    void setHibernation(int minutes, bool modified);
+
+    /**
+     * The url of the document, for placeholders and hibernated documents the one they will load.
+     */
+    QUrl documentUrl(KTextEditor::Document *doc) const;
+
+    /**
+     * The name of the document, for placeholders and hibernated documents based on the url they will load.
+     */
+    QString documentName(KTextEditor::Document *doc) const;
+
     inline bool getSaveMetaInfos() const
     {
         return m_saveMetaInfos;
@@ -171,6 +232,8 @@ private:
     void slotModChanged1(KTextEditor::Document *doc);
     void slotUrlChanged(const QUrl &newUrl);
     void documentOpened();
+    void loadNextPendingDocument();
+    void hibernateUnusedDocuments();
 
 private:
     bool loadMetaInfos(KTextEditor::Document *doc, const QUrl &url);
@@ -179,9 +242,21 @@ private:
     QList<KTextEditor::Document *> m_docList;
     std::unordered_map<KTextEditor::Document *, KateDocumentInfo> m_docInfos;
 
-    KConfig m_metaInfos;
+    KateMetaInfoStore m_metaInfos;
     bool m_saveMetaInfos;
     int m_daysMetaInfos;
 
     QList<QUrl> m_recentlyClosedUrls;
+
+    // session config of lazily restored documents that are not loaded yet
+    KConfig m_pendingRestoreConfig;
+    QTimer m_pendingRestoreTimer;
+
+    // periodic check for documents to hibernate
+    QTimer m_hibernationTimer;
+    qint64 m_hibernationTimeoutMs = 0;
+    bool m_hibernateModified = false;
+
+    // threads used to prefetch files, see prefetchUrls
+    QThreadPool m_prefetchPool;
 };
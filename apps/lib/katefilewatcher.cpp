@@ -0,0 +1,552 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katefilewatcher.h"
+#include "katedebug.h"
+
+#include <KLocalizedString>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <utility>
+
+// rescan interval for everything the native watcher can't handle for us
+static constexpr int DefaultPollIntervalMs = 5000;
+
+static bool isIgnored(const std::vector<QRegularExpression> &ignore, const QString &name)
+{
+    return std::any_of(ignore.begin(), ignore.end(), [&name](const QRegularExpression &re) {
+        return re.match(name).hasMatch();
+    });
+}
+
+struct KateFileWatcher::Subscription {
+    // to find the subscription again once a listing is done, the watch might be gone by then
+    quint64 id = 0;
+    KateFileWatch *watch = nullptr;
+    QString path;
+    bool isDirectory = false;
+    bool recursive = false;
+    bool modifications = false;
+    std::vector<QRegularExpression> ignore;
+
+    // directories watched for this subscription, for recursive ones the whole tree
+    QSet<QString> directories;
+
+    // changes not yet emitted
+    QSet<QString> pending;
+    QTimer *debounce = nullptr;
+
+    bool isIgnored(const QString &name) const
+    {
+        return ::isIgnored(ignore, name);
+    }
+};
+
+static QString childPath(const QString &dir, const QString &name)
+{
+    return dir.endsWith(QLatin1Char('/')) ? dir + name : dir + QLatin1Char('/') + name;
+}
+
+// runs in a worker thread, files modified since @p modifiedSince are collected if it is valid
+static bool scanDirectory(const QString &dir, QSet<QString> &files, QSet<QString> &directories, const QDateTime &modifiedSince, QSet<QString> &modified)
+{
+    const auto entries = QDir(dir).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    for (const auto &entry : entries) {
+        // don't follow links to directories, they might form cycles
+        if (entry.isDir() && !entry.isSymLink()) {
+            directories.insert(entry.fileName());
+        } else {
+            files.insert(entry.fileName());
+            if (modifiedSince.isValid() && entry.lastModified() >= modifiedSince) {
+                modified.insert(entry.fileName());
+            }
+        }
+    }
+    return QFileInfo(dir).isDir();
+}
+
+KateFileWatch::KateFileWatch(KateFileWatcher *watcher, const QString &path, QObject *parent)
+    : QObject(parent)
+    , m_watcher(watcher)
+    , m_path(path)
+{
+}
+
+KateFileWatch::~KateFileWatch()
+{
+    if (m_watcher) {
+        m_watcher->unsubscribe(this);
+    }
+}
+
+KateFileWatcher *KateFileWatcher::self()
+{
+    static QPointer<KateFileWatcher> s_self;
+    if (!s_self) {
+        s_self = new KateFileWatcher(QCoreApplication::instance());
+    }
+    return s_self;
+}
+
+KateFileWatcher::KateFileWatcher(QObject *parent)
+    : QObject(parent)
+    , m_scheduler(KateTaskScheduler::self())
+{
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &KateFileWatcher::onDirectoryChanged);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &KateFileWatcher::onFileChanged);
+
+    m_pollTimer.setInterval(DefaultPollIntervalMs);
+    connect(&m_pollTimer, &QTimer::timeout, this, &KateFileWatcher::poll);
+}
+
+KateFileWatcher::~KateFileWatcher()
+{
+    // on shutdown the scheduler might be gone already, it waited for our scans then
+    if (m_scheduler) {
+        m_scheduler->cancelAndWait(this);
+    }
+}
+
+void KateFileWatcher::setPollInterval(int ms)
+{
+    m_pollTimer.setInterval(ms);
+}
+
+KateFileWatch *KateFileWatcher::watch(const QString &path, const Options &options, QObject *parent)
+{
+    const QString cleanPath = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    auto watch = new KateFileWatch(this, cleanPath, parent);
+
+    auto subscription = std::make_unique<Subscription>();
+    subscription->id = m_nextSubscriptionId++;
+    subscription->watch = watch;
+    subscription->path = cleanPath;
+    subscription->isDirectory = QFileInfo(cleanPath).isDir();
+    subscription->recursive = options.recursive;
+    subscription->modifications = options.modifications;
+    for (const auto &pattern : options.ignore) {
+        subscription->ignore.emplace_back(QRegularExpression::wildcardToRegularExpression(pattern));
+    }
+
+    subscription->debounce = new QTimer(this);
+    subscription->debounce->setSingleShot(true);
+    subscription->debounce->setInterval(options.debounceMs);
+    connect(subscription->debounce, &QTimer::timeout, this, [s = subscription.get()]() {
+        QStringList paths(s->pending.begin(), s->pending.end());
+        s->pending.clear();
+        std::sort(paths.begin(), paths.end());
+        // might delete the subscription, don't touch it afterwards
+        Q_EMIT s->watch->changed(paths);
+    });
+
+    if (subscription->isDirectory) {
+        addTree(*subscription, cleanPath, false);
+    } else {
+        addFile(cleanPath);
+        watch->m_ready = true;
+    }
+
+    m_subscriptions.push_back(std::move(subscription));
+    return watch;
+}
+
+void KateFileWatcher::unsubscribe(KateFileWatch *watch)
+{
+    auto it = std::find_if(m_subscriptions.begin(), m_subscriptions.end(), [watch](const auto &subscription) {
+        return subscription->watch == watch;
+    });
+    if (it == m_subscriptions.end()) {
+        return;
+    }
+
+    auto &subscription = **it;
+    const auto directories = subscription.directories;
+    for (const auto &dir : directories) {
+        removeDirectory(subscription, dir);
+    }
+    if (!subscription.isDirectory) {
+        removeFile(subscription.path);
+    }
+
+    // we might be inside the timeout of the debounce timer
+    subscription.debounce->stop();
+    subscription.debounce->deleteLater();
+    m_subscriptions.erase(it);
+}
+
+void KateFileWatcher::addTree(Subscription &subscription, const QString &root, bool reportContents)
+{
+    if (subscription.directories.contains(root)) {
+        return;
+    }
+
+    KateTaskScheduler::self()->schedule(
+        KateTaskScheduler::Visible,
+        i18n("Listing %1", root),
+        [this, id = subscription.id, root, recursive = subscription.recursive, ignore = subscription.ignore, reportContents](
+            KateTaskScheduler::Token &token) {
+            // parents are listed before their children, addListings relies on that
+            std::vector<Listing> listings;
+            QStringList todo{root};
+            while (!todo.isEmpty()) {
+                if (!token.checkpoint()) {
+                    return;
+                }
+
+                Listing listing;
+                listing.dir = todo.takeLast();
+                listing.scanned = QDateTime::currentDateTime();
+                listing.exists = scanDirectory(listing.dir, listing.files, listing.directories, QDateTime(), listing.modified);
+                if (recursive) {
+                    for (const auto &name : std::as_const(listing.directories)) {
+                        if (!isIgnored(ignore, name)) {
+                            todo.push_back(childPath(listing.dir, name));
+                        }
+                    }
+                }
+                listings.push_back(std::move(listing));
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [this, id, listings = std::move(listings), reportContents]() {
+                    addListings(id, listings, reportContents);
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+void KateFileWatcher::addListings(quint64 subscriptionId, const std::vector<Listing> &listings, bool reportContents)
+{
+    auto it = std::find_if(m_subscriptions.begin(), m_subscriptions.end(), [subscriptionId](const auto &subscription) {
+        return subscription->id == subscriptionId;
+    });
+    if (it == m_subscriptions.end()) {
+        return;
+    }
+
+    auto &subscription = **it;
+    for (const auto &listing : listings) {
+        const QString &dir = listing.dir;
+        if (subscription.directories.contains(dir)) {
+            continue;
+        }
+        subscription.directories.insert(dir);
+
+        // directories shared with other subscriptions keep their listing, they are up to date
+        auto &entry = m_directories[dir];
+        if (entry.refCount++ == 0) {
+            entry.scanned = listing.scanned;
+            entry.files = listing.files;
+            entry.directories = listing.directories;
+            entry.native = addNativeDirectory(dir);
+            if (!entry.native) {
+                schedulePoll();
+            }
+        }
+
+        // everything in a new directory is new, too
+        if (reportContents) {
+            for (const auto &name : listing.files) {
+                if (!subscription.isIgnored(name)) {
+                    report(subscription, childPath(dir, name));
+                }
+            }
+            for (const auto &name : listing.directories) {
+                if (!subscription.isIgnored(name)) {
+                    report(subscription, childPath(dir, name));
+                }
+            }
+        }
+    }
+
+    subscription.watch->m_ready = true;
+}
+
+void KateFileWatcher::removeDirectory(Subscription &subscription, const QString &dir)
+{
+    if (!subscription.directories.remove(dir)) {
+        return;
+    }
+
+    auto it = m_directories.find(dir);
+    if (it == m_directories.end() || --it->refCount > 0) {
+        return;
+    }
+
+    if (it->native) {
+        m_watcher.removePath(dir);
+        --m_nativeDirectoryCount;
+    }
+    m_directories.erase(it);
+}
+
+void KateFileWatcher::addFile(const QString &file)
+{
+    if (m_files[file]++ > 0) {
+        return;
+    }
+
+    if (!QFileInfo::exists(file) || !m_watcher.addPath(file)) {
+        m_missing.insert(file);
+        schedulePoll();
+    }
+}
+
+void KateFileWatcher::removeFile(const QString &file)
+{
+    auto it = m_files.find(file);
+    if (it == m_files.end() || --*it > 0) {
+        return;
+    }
+
+    m_files.erase(it);
+    if (!m_missing.remove(file)) {
+        m_watcher.removePath(file);
+    }
+}
+
+bool KateFileWatcher::addNativeDirectory(const QString &dir)
+{
+    if (m_nativeDirectoryCount >= m_maxNativeDirectories) {
+        return false;
+    }
+
+    if (!m_watcher.addPath(dir)) {
+        // out of watches, e.g. fs.inotify.max_user_watches reached, poll everything that's left
+        if (QFileInfo(dir).isReadable()) {
+            qCWarning(LOG_KATE) << "Failed to watch" << dir << "falling back to polling for" << m_nativeDirectoryCount << "watched directories";
+            m_maxNativeDirectories = m_nativeDirectoryCount;
+        }
+        return false;
+    }
+
+    ++m_nativeDirectoryCount;
+    return true;
+}
+
+void KateFileWatcher::schedulePoll()
+{
+    if (!m_pollTimer.isActive()) {
+        m_pollTimer.start();
+    }
+}
+
+void KateFileWatcher::rescan(const QStringList &dirs, KateTaskScheduler::Priority priority)
+{
+    struct Request {
+        QString dir;
+        QDateTime modifiedSince;
+    };
+    std::vector<Request> requests;
+
+    for (const auto &dir : dirs) {
+        auto it = m_directories.find(dir);
+        if (it == m_directories.end()) {
+            continue;
+        }
+
+        // listed again once the running scan is done
+        if (it->scanning) {
+            it->dirty = true;
+            continue;
+        }
+        it->scanning = true;
+
+        // replaced files keep their name, but got a new modification time
+        const bool wantsModifications = std::any_of(m_subscriptions.cbegin(), m_subscriptions.cend(), [&dir](const auto &subscription) {
+            return subscription->modifications && subscription->directories.contains(dir);
+        });
+        requests.push_back({dir, wantsModifications ? it->scanned : QDateTime()});
+    }
+
+    if (requests.empty()) {
+        return;
+    }
+
+    const QString name = requests.size() == 1 ? i18n("Listing %1", requests.front().dir) : i18n("Listing %1 directories", requests.size());
+    KateTaskScheduler::self()->schedule(
+        priority,
+        name,
+        [this, requests = std::move(requests)](KateTaskScheduler::Token &token) {
+            std::vector<Listing> listings;
+            listings.reserve(requests.size());
+            for (const auto &request : requests) {
+                if (!token.checkpoint()) {
+                    return;
+                }
+
+                Listing listing;
+                listing.dir = request.dir;
+                listing.scanned = QDateTime::currentDateTime();
+                listing.exists = scanDirectory(request.dir, listing.files, listing.directories, request.modifiedSince, listing.modified);
+                listings.push_back(std::move(listing));
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [this, listings = std::move(listings)]() {
+                    for (const auto &listing : listings) {
+                        updateDirectory(listing);
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        this);
+}
+
+void KateFileWatcher::updateDirectory(const Listing &listing)
+{
+    const QString &dir = listing.dir;
+    auto it = m_directories.find(dir);
+    if (it == m_directories.end()) {
+        return;
+    }
+    it->scanning = false;
+
+    if (it->native && !listing.exists) {
+        // the native watch is gone with the directory, poll until it is back
+        m_watcher.removePath(dir);
+        --m_nativeDirectoryCount;
+        it->native = false;
+        schedulePoll();
+    } else if (!it->native && listing.exists && addNativeDirectory(dir)) {
+        // polled so far, some native watches might have got free
+        it->native = true;
+    }
+
+    QSet<QString> changed = (listing.files - it->files) + (it->files - listing.files);
+    const QSet<QString> createdDirectories = listing.directories - it->directories;
+    const QSet<QString> removedDirectories = it->directories - listing.directories;
+    changed += createdDirectories;
+    changed += removedDirectories;
+    const QSet<QString> modified = listing.modified & it->files;
+
+    it->scanned = listing.scanned;
+    it->files = listing.files;
+    it->directories = listing.directories;
+
+    // changed again while we were listing
+    if (std::exchange(it->dirty, false)) {
+        rescan({dir}, KateTaskScheduler::Visible);
+    }
+
+    if (changed.isEmpty() && modified.isEmpty()) {
+        return;
+    }
+
+    for (const auto &subscription : m_subscriptions) {
+        if (!subscription->directories.contains(dir)) {
+            continue;
+        }
+
+        for (const auto &name : changed) {
+            if (!subscription->isIgnored(name)) {
+                report(*subscription, childPath(dir, name));
+            }
+        }
+        if (subscription->modifications) {
+            for (const auto &name : modified) {
+                if (!subscription->isIgnored(name)) {
+                    report(*subscription, childPath(dir, name));
+                }
+            }
+        }
+
+        if (!subscription->recursive) {
+            continue;
+        }
+
+        for (const auto &name : removedDirectories) {
+            const QString removed = childPath(dir, name);
+            const QString prefix = removed + QLatin1Char('/');
+            const auto watched = subscription->directories;
+            for (const auto &path : watched) {
+                if (path == removed || path.startsWith(prefix)) {
+                    removeDirectory(*subscription, path);
+                }
+            }
+        }
+
+        for (const auto &name : createdDirectories) {
+            if (!subscription->isIgnored(name)) {
+                addTree(*subscription, childPath(dir, name), true);
+            }
+        }
+    }
+}
+
+void KateFileWatcher::onDirectoryChanged(const QString &dir)
+{
+    rescan({dir}, KateTaskScheduler::Visible);
+}
+
+void KateFileWatcher::onFileChanged(const QString &file)
+{
+    if (!m_files.contains(file)) {
+        return;
+    }
+
+    // atomic replacement or removal drops the native watch
+    if (!QFileInfo::exists(file)) {
+        m_watcher.removePath(file);
+        m_missing.insert(file);
+        schedulePoll();
+    } else if (!m_missing.contains(file) && !m_watcher.files().contains(file) && !m_watcher.addPath(file)) {
+        m_missing.insert(file);
+        schedulePoll();
+    }
+
+    for (const auto &subscription : m_subscriptions) {
+        if (!subscription->isDirectory && subscription->path == file) {
+            report(*subscription, file);
+        }
+    }
+}
+
+void KateFileWatcher::poll()
+{
+    // deleted files that are back
+    const auto missing = m_missing;
+    for (const auto &file : missing) {
+        if (QFileInfo::exists(file) && m_watcher.addPath(file)) {
+            m_missing.remove(file);
+            onFileChanged(file);
+        }
+    }
+
+    // directories without native watch, listed in the background, skip the ones still busy from the last poll
+    QStringList polled;
+    for (auto it = m_directories.cbegin(); it != m_directories.cend(); ++it) {
+        if (!it->native && !it->scanning) {
+            polled.push_back(it.key());
+        }
+    }
+    rescan(polled, KateTaskScheduler::Background);
+
+    const bool needsPolling = !m_missing.isEmpty() || std::any_of(m_directories.cbegin(), m_directories.cend(), [](const Directory &directory) {
+                                  return !directory.native;
+                              });
+    if (!needsPolling) {
+        m_pollTimer.stop();
+    }
+}
+
+void KateFileWatcher::report(Subscription &subscription, const QString &path)
+{
+    subscription.pending.insert(path);
+    if (!subscription.debounce->isActive()) {
+        subscription.debounce->start();
+    }
+}
+
+#include "moc_katefilewatcher.cpp"
@@ -0,0 +1,197 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+#include "katetaskscheduler.h"
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+#include <memory>
+#include <vector>
+
+class KateFileWatcher;
+
+/**
+ * One subscription of the KateFileWatcher, delete it to stop watching.
+ */
+class KATE_PRIVATE_EXPORT KateFileWatch : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~KateFileWatch() override;
+
+    /**
+     * The watched file or directory.
+     */
+    const QString &path() const
+    {
+        return m_path;
+    }
+
+    /**
+     * Directories are listed in the background, changes before the listing is done are not reported.
+     */
+    bool isReady() const
+    {
+        return m_ready;
+    }
+
+Q_SIGNALS:
+    /**
+     * Emitted with all paths that changed since the last emission.
+     * For files that's the file itself, for directories the created, removed or renamed entries.
+     */
+    void changed(const QStringList &paths);
+
+private:
+    friend class KateFileWatcher;
+    KateFileWatch(KateFileWatcher *watcher, const QString &path, QObject *parent);
+
+private:
+    QPointer<KateFileWatcher> m_watcher;
+    const QString m_path;
+    bool m_ready = false;
+};
+
+/**
+ * Application wide file system watcher all plugins share.
+ *
+ * Every path is watched natively only once, no matter how many subscribers are interested.
+ * Changes are collected per subscription and emitted at most once per debounce interval,
+ * e.g. a git checkout touching hundreds of files results in one changed() signal.
+ *
+ * Recursive subscriptions watch all directories below the path, keep a listing of each
+ * and diff it on change to know which entries got created or removed; new directories
+ * are watched on the fly. If the native watcher runs out of watches, e.g. the inotify
+ * limit is reached, the affected subscriptions fall back to periodically rescanning.
+ * All listing is done in the KateTaskScheduler, only the diffing happens in the main thread.
+ *
+ * Files replaced atomically (written to a temporary file and renamed over the original,
+ * like git does for its index) are watched again automatically, deleted files once they
+ * reappear.
+ */
+class KATE_PRIVATE_EXPORT KateFileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        /// watch the whole directory tree below the path
+        bool recursive = false;
+        /// names of entries to ignore, wildcards allowed, e.g. ".git" or "*.o"
+        QStringList ignore;
+        /// collect changes this long before telling the subscriber
+        int debounceMs = 100;
+        /// report files in watched directories that got replaced, e.g. by an atomic save, too,
+        /// files written in place are only seen once something else changes in their directory
+        bool modifications = false;
+    };
+
+    static KateFileWatcher *self();
+
+    ~KateFileWatcher() override;
+
+    /**
+     * Watch the given file or directory, the subscription is owned by @p parent.
+     */
+    KateFileWatch *watch(const QString &path, const Options &options, QObject *parent);
+    KateFileWatch *watch(const QString &path, QObject *parent)
+    {
+        return watch(path, Options(), parent);
+    }
+
+    /**
+     * Number of natively watched directories, over all subscriptions.
+     */
+    int watchedDirectoryCount() const
+    {
+        return m_nativeDirectoryCount;
+    }
+
+    /**
+     * Maximal number of directories to watch natively, others are polled.
+     */
+    void setMaxWatchedDirectories(int max)
+    {
+        m_maxNativeDirectories = max;
+    }
+
+    /**
+     * Interval to rescan directories we can't watch natively and to look for deleted files.
+     */
+    void setPollInterval(int ms);
+
+private:
+    struct Subscription;
+    struct Directory {
+        int refCount = 0;
+        bool native = false;
+        QSet<QString> files;
+        QSet<QString> directories;
+        // to find the modified files
+        QDateTime scanned;
+        // a rescan is running, and whether the directory changed again meanwhile
+        bool scanning = false;
+        bool dirty = false;
+    };
+
+    // contents of one directory as seen by a worker
+    struct Listing {
+        QString dir;
+        bool exists = false;
+        QSet<QString> files;
+        QSet<QString> directories;
+        // files changed since the previous scan, if asked for
+        QSet<QString> modified;
+        QDateTime scanned;
+    };
+
+    explicit KateFileWatcher(QObject *parent);
+
+    friend class KateFileWatch;
+    void unsubscribe(KateFileWatch *watch);
+
+    void addTree(Subscription &subscription, const QString &root, bool reportContents);
+    void addListings(quint64 subscriptionId, const std::vector<Listing> &listings, bool reportContents);
+    void removeDirectory(Subscription &subscription, const QString &dir);
+    void addFile(const QString &file);
+    void removeFile(const QString &file);
+    bool addNativeDirectory(const QString &dir);
+    void schedulePoll();
+
+    void rescan(const QStringList &dirs, KateTaskScheduler::Priority priority);
+    void updateDirectory(const Listing &listing);
+
+    void onDirectoryChanged(const QString &dir);
+    void onFileChanged(const QString &file);
+    void poll();
+    void report(Subscription &subscription, const QString &path);
+
+private:
+    const QPointer<KateTaskScheduler> m_scheduler;
+    QFileSystemWatcher m_watcher;
+    std::vector<std::unique_ptr<Subscription>> m_subscriptions;
+    QHash<QString, Directory> m_directories;
+    QHash<QString, int> m_files;
+
+    // watched paths that are gone, we look for them on each poll
+    QSet<QString> m_missing;
+
+    QTimer m_pollTimer;
+    quint64 m_nextSubscriptionId = 1;
+    int m_nativeDirectoryCount = 0;
+    int m_maxNativeDirectories = 8192;
+};
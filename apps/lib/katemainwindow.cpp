@@ -21,11 +21,13 @@
 #include "katemwmodonhddialog.h"
 #include "kateoutputview.h"
 #include "katepluginmanager.h"
+#include "kateresourceusageview.h"
 #include "katequickopen.h"
 #include "katesavemodifieddialog.h"
 #include "katesessionmanager.h"
 #include "katesessionsaction.h"
 #include "katestashmanager.h"
+#include "katetrace.h"
 #include "kateupdatedisabler.h"
 #include "kateviewspace.h"
 #include "ktexteditor_utils.h"
@@ -115,6 +117,8 @@ KateMainWindow::KateMainWindow(KConfig *sconfig, const QString &sgroup, bool use
     : KateMDI::MainWindow(nullptr)
     , m_wrapper(new KTextEditor::MainWindow(this))
 {
+    KATE_TRACE_ZONE("gui", "KateMainWindow::KateMainWindow");
+
     /**
      * we don't want any flicker here
      */
@@ -127,14 +131,20 @@ KateMainWindow::KateMainWindow(KConfig *sconfig, const QString &sgroup, bool use
     setupImportantActions();
 
     // setup the most important widgets
-    setupMainWindow();
+    {
+        KATE_TRACE_ZONE("gui", "KateMainWindow::setupMainWindow");
+        setupMainWindow();
+    }
 
     // setup the actions
     setupActions();
 
     setStandardToolBarMenuEnabled(true);
     setXMLFile(QStringLiteral("kateui.rc"));
-    createShellGUI(true);
+    {
+        KATE_TRACE_ZONE("gui", "createShellGUI");
+        createShellGUI(true);
+    }
 
     // Has to be after the setXMLFile() call above, so that m_diagView's actions are
     // merged after the Tools menu has been populated with the default actions
@@ -163,6 +173,7 @@ KateMainWindow::KateMainWindow(KConfig *sconfig, const QString &sgroup, bool use
     readOptions();
 
     if (sconfig && !userTriggered) {
+        KATE_TRACE_ZONE("session", "KateViewManager::restoreViewConfiguration");
         m_viewManager->restoreViewConfiguration(KConfigGroup(sconfig, sgroup));
     }
 
@@ -601,6 +612,23 @@ void KateMainWindow::setupActions()
             }
         }
     });
+
+    a = actionCollection()->addAction(QStringLiteral("help_resource_usage"));
+    a->setIcon(QIcon::fromTheme(QStringLiteral("utilities-system-monitor")));
+    a->setText(i18n("Resource Usage"));
+    a->setWhatsThis(i18n("Show the memory and CPU time used by the documents, plugins and other parts of the application."));
+    connect(a, &QAction::triggered, this, [this] {
+        // debug view, only created on request
+        if (!m_toolViewResourceUsage) {
+            m_toolViewResourceUsage = createToolView(nullptr /* toolview has no plugin it belongs to */,
+                                                     QStringLiteral("resourceusage"),
+                                                     KTextEditor::MainWindow::Bottom,
+                                                     QIcon::fromTheme(QStringLiteral("utilities-system-monitor")),
+                                                     i18n("Resource Usage"));
+            new KateResourceUsageView(m_toolViewResourceUsage);
+        }
+        showToolView(m_toolViewResourceUsage);
+    });
 }
 
 void KateMainWindow::setupDiagnosticsView(KConfig *sconfig)
@@ -753,8 +781,6 @@ bool KateMainWindow::queryClose()
     // and save docs if we really close down !
     if (queryClose_internal()) {
         KateApp::self()->sessionManager()->saveActiveSession(true);
-        KateApp::self()->stashManager()->stashDocuments(KateApp::self()->sessionManager()->activeSession()->config(),
-                                                        KateApp::self()->documentManager()->documentList());
         return true;
     }
 
@@ -815,6 +841,8 @@ void KateMainWindow::readOptions()
     m_modCloseAfterLast = generalGroup.readEntry("Close After Last", KateApp::isKWrite());
     KateApp::self()->documentManager()->setSaveMetaInfos(generalGroup.readEntry("Save Meta Infos", true));
     KateApp::self()->documentManager()->setDaysMetaInfos(generalGroup.readEntry("Days Meta Infos", 30));
+    KateApp::self()->documentManager()->setHibernation(generalGroup.readEntry("Hibernate Documents", false) ? generalGroup.readEntry("Hibernate Documents After", 30) : 0,
+                                                       generalGroup.readEntry("Hibernate Modified Documents", false));
 
     KateApp::self()->stashManager()->setStashUnsavedChanges(generalGroup.readEntry("Stash unsaved file changes", false));
     KateApp::self()->stashManager()->setStashNewUnsavedFiles(generalGroup.readEntry("Stash new unsaved files", true));
@@ -987,6 +1015,7 @@ void KateMainWindow::slotWindowActivated()
 {
     if (auto v = m_viewManager->activeView()) {
         updateCaption(v->document());
+        KateApp::self()->pluginManager()->documentActivated(v->document());
     } else {
         updateCaption(nullptr);
     }
@@ -1279,6 +1308,9 @@ void KateMainWindow::saveProperties(KConfigGroup &config, bool includeViewConfig
                 KConfigGroup group(config.config(), QStringLiteral("Plugin:%1:MainWindow:%2").arg(item.saveName()).arg(id));
                 interface->writeSessionConfig(group);
             }
+        } else if (item.deferred) {
+            KConfigGroup group(config.config(), QStringLiteral("Plugin:%1:MainWindow:%2").arg(item.saveName()).arg(id));
+            KateApp::self()->pluginManager()->writeDeferredViewConfig(item, group);
         }
     }
 
@@ -719,6 +719,11 @@ private:
      */
     KateOutputView *m_outputView = nullptr;
 
+    /**
+     * resource usage tool view, created on demand
+     */
+    QWidget *m_toolViewResourceUsage = nullptr;
+
     /**
      * Diagnostics view at the bottom
      */
@@ -9,6 +9,7 @@
 
 #include "katemdi.h"
 #include "kateapp.h"
+#include "katetaskindicator.h"
 
 #include <KAcceleratorManager>
 #include <KActionCollection>
@@ -1586,6 +1587,8 @@ MainWindow::MainWindow(QWidget *parent)
     // m_bottomSidebarLayout->addWidget(m_branchLabel);
     // widget that hold statusbar of active kte-view
     m_bottomSidebarLayout->addWidget(m_statusBarStackedWidget);
+    // shows running background tasks
+    m_bottomSidebarLayout->addWidget(new KateTaskIndicator(this));
     m_bottomSidebarLayout->setStretch(0, 100);
     toplevelVBox->addLayout(m_bottomSidebarLayout);
 
@@ -0,0 +1,324 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katemetainfostore.h"
+#include "katedebug.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <vector>
+
+// file header: magic + format version
+static constexpr quint32 StoreMagic = 0x4b4d4931; // "KMI1"
+static constexpr qint64 HeaderSize = sizeof(quint32);
+
+// fixed stream format, independent of the Qt version we run with
+static constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_5;
+
+// record operations
+enum RecordType : quint8 {
+    Put = 1,
+    Remove = 2,
+};
+
+/**
+ * A record is [quint32 payload size][payload], the payload starts with
+ * the record type and the url, so the index can be built without reading values.
+ */
+static QByteArray serializeRecord(RecordType type, const QString &url, const KateMetaInfoStore::Entry *entry = nullptr)
+{
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(StreamVersion);
+        stream << quint8(type) << url;
+        if (entry) {
+            stream << entry->checksum << entry->time.toMSecsSinceEpoch() << entry->config;
+        }
+    }
+
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint32(payload.size());
+    record.append(payload);
+    return record;
+}
+
+static std::optional<KateMetaInfoStore::Entry> deserializeRecord(const QByteArray &record)
+{
+    QDataStream stream(record);
+    stream.setVersion(StreamVersion);
+    quint32 size = 0;
+    quint8 type = 0;
+    QString url;
+    stream >> size >> type >> url;
+    if (type != Put) {
+        return std::nullopt;
+    }
+
+    KateMetaInfoStore::Entry entry;
+    qint64 time = 0;
+    stream >> entry.checksum >> time >> entry.config;
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+    entry.time = QDateTime::fromMSecsSinceEpoch(time, QTimeZone::UTC);
+    return entry;
+}
+
+KateMetaInfoStore::KateMetaInfoStore(const QString &fileName)
+    : m_fileName(fileName)
+    , m_readFile(fileName)
+{
+    // appends must stay in order
+    m_writer.setMaxThreadCount(1);
+
+    load();
+}
+
+KateMetaInfoStore::~KateMetaInfoStore()
+{
+    flush();
+}
+
+void KateMetaInfoStore::load()
+{
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(LOG_KATE) << "Failed to open meta info store" << m_fileName << file.errorString();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+    quint32 magic = 0;
+    stream >> magic;
+    if (magic != StoreMagic) {
+        // new or unknown file, start from scratch
+        file.resize(0);
+        stream.resetStatus();
+        stream << StoreMagic;
+    }
+
+    // scan the record headers, the last record for an url wins
+    qint64 pos = HeaderSize;
+    const qint64 fileSize = file.size();
+    while (pos + qint64(sizeof(quint32)) <= fileSize) {
+        file.seek(pos);
+        quint32 size = 0;
+        quint8 type = 0;
+        QString url;
+        stream >> size >> type >> url;
+        const qint64 recordSize = qint64(sizeof(quint32)) + size;
+        if (stream.status() != QDataStream::Ok || pos + recordSize > fileSize) {
+            // torn write at the end, e.g. after a crash
+            break;
+        }
+
+        if (type == Put) {
+            if (auto it = m_index.find(url); it != m_index.end()) {
+                m_liveBytes -= it->size;
+            }
+            // the time follows the checksum, read it to initialize the usage order
+            QByteArray checksum;
+            qint64 time = 0;
+            stream >> checksum >> time;
+            m_index.insert(url, Slot{.offset = pos, .size = qint32(recordSize), .lastUse = time, .pending = {}});
+            m_liveBytes += recordSize;
+        } else if (auto it = m_index.find(url); it != m_index.end()) {
+            m_liveBytes -= it->size;
+            m_index.erase(it);
+        }
+        pos += recordSize;
+    }
+
+    // cut off any incomplete record
+    if (pos < fileSize) {
+        file.resize(pos);
+    }
+    m_fileEnd = pos;
+    file.close();
+
+    // get rid of overwritten and removed records if they make up most of the file
+    if (m_fileEnd - HeaderSize > 2 * m_liveBytes && m_fileEnd > 64 * 1024) {
+        compact();
+    }
+
+    m_flushedEnd = m_fileEnd;
+    m_writeFile = std::make_unique<QFile>(m_fileName);
+    if (!m_writeFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(LOG_KATE) << "Failed to open meta info store for writing" << m_fileName << m_writeFile->errorString();
+    }
+    // unbuffered, the writer appends behind our back
+    m_readFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void KateMetaInfoStore::compact()
+{
+    QFile in(m_fileName);
+    if (!in.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // keep the records in file order
+    std::vector<Slot *> sorted;
+    sorted.reserve(m_index.size());
+    for (auto &slot : m_index) {
+        sorted.push_back(&slot);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Slot *l, const Slot *r) {
+        return l->offset < r->offset;
+    });
+
+    QSaveFile out(m_fileName);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream(&out) << StoreMagic;
+
+    qint64 pos = HeaderSize;
+    std::vector<qint64> newOffsets;
+    newOffsets.reserve(sorted.size());
+    for (const Slot *slot : sorted) {
+        in.seek(slot->offset);
+        out.write(in.read(slot->size));
+        newOffsets.push_back(pos);
+        pos += slot->size;
+    }
+
+    in.close();
+    if (!out.commit()) {
+        qCWarning(LOG_KATE) << "Failed to compact meta info store" << m_fileName << out.errorString();
+        return;
+    }
+
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        sorted[i]->offset = newOffsets[i];
+    }
+    m_fileEnd = pos;
+}
+
+std::optional<KateMetaInfoStore::Entry> KateMetaInfoStore::value(const QString &url)
+{
+    auto it = m_index.find(url);
+    if (it == m_index.end()) {
+        return std::nullopt;
+    }
+
+    it->lastUse = QDateTime::currentMSecsSinceEpoch();
+    return readRecord(*it);
+}
+
+std::optional<KateMetaInfoStore::Entry> KateMetaInfoStore::readRecord(Slot &slot)
+{
+    // not yet on disk? use the in-memory copy
+    if (!slot.pending.isEmpty()) {
+        if (m_flushedEnd.load() < slot.offset + slot.size) {
+            return deserializeRecord(slot.pending);
+        }
+        slot.pending.clear();
+    }
+
+    if (!m_readFile.isOpen() || !m_readFile.seek(slot.offset)) {
+        return std::nullopt;
+    }
+    return deserializeRecord(m_readFile.read(slot.size));
+}
+
+void KateMetaInfoStore::insert(const QString &url, const Entry &entry)
+{
+    append(url, serializeRecord(Put, url, &entry), false);
+    if (m_index.size() > m_maxEntries) {
+        evict();
+    }
+}
+
+void KateMetaInfoStore::remove(const QString &url)
+{
+    if (m_index.contains(url)) {
+        append(url, serializeRecord(Remove, url), true);
+    }
+}
+
+void KateMetaInfoStore::append(const QString &url, const QByteArray &record, bool isRemoval)
+{
+    const qint64 offset = m_fileEnd;
+    m_fileEnd += record.size();
+
+    if (auto it = m_index.find(url); it != m_index.end()) {
+        m_liveBytes -= it->size;
+        if (isRemoval) {
+            m_index.erase(it);
+        }
+    }
+    if (!isRemoval) {
+        m_index.insert(url, Slot{.offset = offset, .size = qint32(record.size()), .lastUse = QDateTime::currentMSecsSinceEpoch(), .pending = record});
+        m_liveBytes += record.size();
+    }
+
+    // the actual write happens in the background, in order
+    m_writer.start([this, record, end = m_fileEnd]() {
+        if (m_writeFile && m_writeFile->isOpen()) {
+            m_writeFile->write(record);
+            m_writeFile->flush();
+        }
+        m_flushedEnd = end;
+    });
+}
+
+void KateMetaInfoStore::evict()
+{
+    // evict in batches, to not do this for each insert once we are at the limit
+    const int keep = m_maxEntries - std::max(1, m_maxEntries / 10);
+
+    std::vector<std::pair<qint64, QString>> byUse;
+    byUse.reserve(m_index.size());
+    for (auto it = m_index.cbegin(); it != m_index.cend(); ++it) {
+        byUse.emplace_back(it->lastUse, it.key());
+    }
+
+    const size_t toRemove = byUse.size() - size_t(std::max(0, keep));
+    std::nth_element(byUse.begin(), byUse.begin() + toRemove, byUse.end());
+    for (size_t i = 0; i < toRemove; ++i) {
+        remove(byUse[i].second);
+    }
+}
+
+void KateMetaInfoStore::removeOlderThan(int days)
+{
+    const qint64 limit = QDateTime::currentDateTimeUtc().addDays(-days).toMSecsSinceEpoch();
+    QStringList old;
+    for (auto it = m_index.cbegin(); it != m_index.cend(); ++it) {
+        if (it->lastUse < limit) {
+            old.push_back(it.key());
+        }
+    }
+
+    for (const auto &url : std::as_const(old)) {
+        remove(url);
+    }
+}
+
+void KateMetaInfoStore::setMaxEntries(int maxEntries)
+{
+    m_maxEntries = std::max(1, maxEntries);
+    if (m_index.size() > m_maxEntries) {
+        evict();
+    }
+}
+
+void KateMetaInfoStore::flush()
+{
+    m_writer.waitForDone();
+}
@@ -0,0 +1,120 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+/**
+ * Persistent store for the per url document meta information
+ * (cursor, bookmarks, folding, ...) we restore if a file is opened again.
+ *
+ * The data is kept in an append-only log file. On load only the record headers are
+ * scanned to build an url => file offset index, values are read on demand.
+ * Changes are serialized on the calling thread and appended to the log by a
+ * background writer. The number of entries is bounded, the least recently used ones
+ * are evicted. Garbage left in the log by overwritten entries is compacted away on load.
+ */
+class KATE_PRIVATE_EXPORT KateMetaInfoStore
+{
+public:
+    struct Entry {
+        /// checksum of the document, the meta info is only valid if it still matches
+        QByteArray checksum;
+        /// last time this entry was written
+        QDateTime time;
+        /// the document session config entries
+        QMap<QString, QString> config;
+    };
+
+    /**
+     * Open the store backed by the given log file, will be created if not existing.
+     */
+    explicit KateMetaInfoStore(const QString &fileName);
+
+    /**
+     * Waits for pending writes.
+     */
+    ~KateMetaInfoStore();
+
+    KateMetaInfoStore(const KateMetaInfoStore &) = delete;
+    KateMetaInfoStore &operator=(const KateMetaInfoStore &) = delete;
+
+    bool contains(const QString &url) const
+    {
+        return m_index.contains(url);
+    }
+
+    int size() const
+    {
+        return m_index.size();
+    }
+
+    /**
+     * Lookup the entry for the given url, marks the entry as used.
+     */
+    std::optional<Entry> value(const QString &url);
+
+    void insert(const QString &url, const Entry &entry);
+    void remove(const QString &url);
+
+    /**
+     * Remove all entries not written in the last @p days.
+     */
+    void removeOlderThan(int days);
+
+    /**
+     * Maximal number of entries to keep, least recently used ones are evicted first.
+     */
+    void setMaxEntries(int maxEntries);
+
+    /**
+     * Wait for all pending writes to reach the file.
+     */
+    void flush();
+
+private:
+    struct Slot {
+        qint64 offset = 0;
+        qint32 size = 0;
+        qint64 lastUse = 0;
+        // serialized record while it might not yet be written by the writer
+        QByteArray pending;
+    };
+
+    void load();
+    void compact();
+    void append(const QString &url, const QByteArray &record, bool isRemoval);
+    void evict();
+    std::optional<Entry> readRecord(Slot &slot);
+
+private:
+    const QString m_fileName;
+    QHash<QString, Slot> m_index;
+    int m_maxEntries = 10000;
+    qint64 m_fileEnd = 0;
+    qint64 m_liveBytes = 0;
+
+    // used on the calling thread for lookups
+    QFile m_readFile;
+
+    // only used by tasks of the single threaded writer pool
+    QThreadPool m_writer;
+    std::unique_ptr<QFile> m_writeFile;
+    std::atomic<qint64> m_flushedEnd = 0;
+};
@@ -0,0 +1,229 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kateopenserver.h"
+#include "katedebug.h"
+
+#include <QDataStream>
+#include <QLocalSocket>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+// message format version, bump on incompatible changes
+static constexpr quint32 RequestVersion = 1;
+
+// fixed stream format, client and server might be different builds
+static constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_5;
+
+// the acknowledgment the server sends once it got the complete request
+static constexpr char Acknowledgment = 'k';
+
+static void writeCursor(QDataStream &stream, KTextEditor::Cursor cursor)
+{
+    stream << qint32(cursor.line()) << qint32(cursor.column());
+}
+
+static KTextEditor::Cursor readCursor(QDataStream &stream)
+{
+    qint32 line = -1;
+    qint32 column = -1;
+    stream >> line >> column;
+    return {line, column};
+}
+
+QByteArray KateOpenRequest::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << RequestVersion << quint32(files.size());
+    for (const auto &file : files) {
+        stream << file.url;
+        writeCursor(stream, file.cursor);
+    }
+    stream << encoding << isTempFile << block << session << input.has_value() << input.value_or(QString());
+    writeCursor(stream, cursor);
+    stream << activationToken;
+    return data;
+}
+
+std::optional<KateOpenRequest> KateOpenRequest::deserialize(const QByteArray &data)
+{
+    QDataStream stream(data);
+    stream.setVersion(StreamVersion);
+
+    quint32 version = 0;
+    quint32 fileCount = 0;
+    stream >> version >> fileCount;
+    if (version != RequestVersion || stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+
+    KateOpenRequest request;
+    // don't trust the count for the allocation, each file needs some bytes in the data
+    request.files.reserve(std::min<qsizetype>(fileCount, data.size() / 8));
+    for (quint32 i = 0; i < fileCount && stream.status() == QDataStream::Ok; ++i) {
+        File file;
+        stream >> file.url;
+        file.cursor = readCursor(stream);
+        request.files.push_back(std::move(file));
+    }
+
+    bool hasInput = false;
+    QString input;
+    stream >> request.encoding >> request.isTempFile >> request.block >> request.session >> hasInput >> input;
+    request.cursor = readCursor(stream);
+    stream >> request.activationToken;
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+
+    if (hasInput) {
+        request.input = std::move(input);
+    }
+    return request;
+}
+
+KateOpenServer::KateOpenServer(Handler handler, QObject *parent)
+    : QObject(parent)
+    , m_handler(std::move(handler))
+{
+    m_server.setSocketOptions(QLocalServer::UserAccessOption);
+    connect(&m_server, &QLocalServer::newConnection, this, &KateOpenServer::newConnection);
+}
+
+KateOpenServer::~KateOpenServer()
+{
+    // blocking clients wait for their connection to close
+    m_server.close();
+}
+
+QString KateOpenServer::serverName(qint64 pid)
+{
+    // prefer the per user runtime dir, only accessible by us
+    const QString name = QStringLiteral("kate-open-%1").arg(pid);
+    const QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    return runtimeDir.isEmpty() ? name : runtimeDir + QLatin1Char('/') + name;
+}
+
+bool KateOpenServer::listen(qint64 pid)
+{
+    // a stale socket of a crashed instance with the same pid would block us
+    const QString name = serverName(pid);
+    QLocalServer::removeServer(name);
+    if (!m_server.listen(name)) {
+        qCWarning(LOG_KATE) << "Failed to listen for open requests on" << name << m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+void KateOpenServer::newConnection()
+{
+    while (auto socket = m_server.nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            readRequest(socket);
+        });
+        readRequest(socket);
+    }
+}
+
+void KateOpenServer::readRequest(QLocalSocket *socket)
+{
+    // the request might arrive in multiple chunks
+    QDataStream stream(socket);
+    stream.setVersion(StreamVersion);
+    stream.startTransaction();
+    QByteArray data;
+    stream >> data;
+    if (!stream.commitTransaction()) {
+        return;
+    }
+
+    // one request per connection
+    disconnect(socket, &QLocalSocket::readyRead, this, nullptr);
+
+    auto request = KateOpenRequest::deserialize(data);
+    if (!request) {
+        qCWarning(LOG_KATE) << "Received invalid open request";
+        socket->disconnectFromServer();
+        return;
+    }
+
+    // let the client go before we do the actual work
+    socket->write(&Acknowledgment, 1);
+    socket->flush();
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, socket = QPointer<QLocalSocket>(socket), request = std::move(*request)]() {
+            handleRequest(socket, request);
+        },
+        Qt::QueuedConnection);
+}
+
+void KateOpenServer::handleRequest(const QPointer<QLocalSocket> &socket, const KateOpenRequest &request)
+{
+    // the handler might run nested event loops, the client can be gone afterwards
+    auto documents = m_handler(request);
+    if (!socket) {
+        return;
+    }
+
+    std::sort(documents.begin(), documents.end());
+    documents.erase(std::unique(documents.begin(), documents.end()), documents.end());
+    documents.erase(std::remove(documents.begin(), documents.end(), nullptr), documents.end());
+    if (!request.block || documents.empty()) {
+        socket->disconnectFromServer();
+        return;
+    }
+
+    // close the connection once the last of the documents is gone, this unblocks the client
+    auto remaining = std::make_shared<size_t>(documents.size());
+    for (auto document : documents) {
+        connect(document, &QObject::destroyed, socket, [socket, remaining]() {
+            if (--*remaining == 0) {
+                socket->disconnectFromServer();
+            }
+        });
+    }
+}
+
+std::unique_ptr<QLocalSocket> KateOpenServer::connectToInstance(qint64 pid, int timeoutMs)
+{
+    auto socket = std::make_unique<QLocalSocket>();
+    socket->connectToServer(serverName(pid));
+    if (!socket->waitForConnected(timeoutMs)) {
+        return nullptr;
+    }
+    return socket;
+}
+
+bool KateOpenServer::sendRequest(QLocalSocket &socket, const KateOpenRequest &request, int timeoutMs)
+{
+    QDataStream stream(&socket);
+    stream.setVersion(StreamVersion);
+    stream << request.serialize();
+
+    while (socket.bytesToWrite() > 0) {
+        if (!socket.waitForBytesWritten(timeoutMs)) {
+            return false;
+        }
+    }
+
+    while (socket.bytesAvailable() < 1) {
+        if (!socket.waitForReadyRead(timeoutMs)) {
+            return false;
+        }
+    }
+
+    char answer = 0;
+    return socket.getChar(&answer) && answer == Acknowledgment;
+}
+
+#include "moc_kateopenserver.cpp"
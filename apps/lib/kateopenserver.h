@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <KTextEditor/Cursor>
+
+#include <QLocalServer>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class QLocalSocket;
+
+/**
+ * Everything a command line invocation wants a running instance to do,
+ * send as one message instead of one call per file.
+ */
+struct KATE_PRIVATE_EXPORT KateOpenRequest {
+    struct File {
+        QUrl url;
+        /// position given with the file name, invalid if none
+        KTextEditor::Cursor cursor = KTextEditor::Cursor::invalid();
+    };
+
+    std::vector<File> files;
+    QString encoding;
+    bool isTempFile = false;
+
+    /// keep the connection open until all opened documents are closed
+    bool block = false;
+
+    /// session to activate before opening anything, empty for none
+    QString session;
+
+    /// text read from stdin to open in a new document
+    std::optional<QString> input;
+
+    /// position to set in the active view after opening, invalid if none
+    KTextEditor::Cursor cursor = KTextEditor::Cursor::invalid();
+
+    /// startup notification or xdg activation token to activate the window with
+    QString activationToken;
+
+    QByteArray serialize() const;
+    static std::optional<KateOpenRequest> deserialize(const QByteArray &data);
+};
+
+/**
+ * Local socket server a running Kate instance listens on for open requests.
+ *
+ * A client connects, sends one serialized KateOpenRequest and gets a single byte
+ * back as acknowledgment before the request is handled, so it doesn't need to wait
+ * for the files to be loaded.
+ * For blocking requests the server closes the connection once all documents opened by the
+ * request are closed again or the instance exits, for others directly after handling.
+ */
+class KATE_PRIVATE_EXPORT KateOpenServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Handles the request, returns the opened documents.
+     */
+    using Handler = std::function<std::vector<QObject *>(const KateOpenRequest &)>;
+
+    KateOpenServer(Handler handler, QObject *parent = nullptr);
+    ~KateOpenServer() override;
+
+    /**
+     * Start listening on the socket for the given process id.
+     */
+    bool listen(qint64 pid);
+
+    /**
+     * Full name of the socket the instance with the given process id listens on.
+     */
+    static QString serverName(qint64 pid);
+
+    /**
+     * Connect to the instance with the given process id.
+     * Returns nullptr if the instance doesn't listen for requests, e.g. because it is too old.
+     */
+    static std::unique_ptr<QLocalSocket> connectToInstance(qint64 pid, int timeoutMs = 1000);
+
+    /**
+     * Send the request and wait until the instance acknowledged it.
+     * For blocking requests, wait for the disconnected signal of the socket afterwards.
+     */
+    static bool sendRequest(QLocalSocket &socket, const KateOpenRequest &request, int timeoutMs = 10000);
+
+private:
+    void newConnection();
+    void readRequest(QLocalSocket *socket);
+    void handleRequest(const QPointer<QLocalSocket> &socket, const KateOpenRequest &request);
+
+private:
+    const Handler m_handler;
+    QLocalServer m_server;
+};
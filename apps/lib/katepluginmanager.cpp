@@ -10,17 +10,123 @@
 
 #include "kateapp.h"
 #include "katemainwindow.h"
+#include "katemdi.h"
+#include "katetrace.h"
 
+#include <KActionCollection>
 #include <KConfig>
 #include <KConfigBase>
 #include <KConfigGroup>
+#include <KLocalizedString>
 #include <KPluginFactory>
+#include <KSharedConfig>
+#include <KTextEditor/Document>
 #include <KTextEditor/Plugin>
 #include <KTextEditor/SessionConfigInterface>
+#include <KXMLGUIClient>
 
 #include "kate_timings_debug.h"
+#include <QDir>
 #include <QElapsedTimer>
 #include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMimeDatabase>
+#include <QStandardPaths>
+#include <QTimer>
+
+// marks the placeholders of plugins waiting for their activation, the value is the save name of the plugin
+static const char PlaceholderProperty[] = "_kate_plugin_placeholder";
+
+static QString placeholderActionName(const QString &plugin, const QString &action)
+{
+    return QStringLiteral("kate_plugin_placeholder_%1_%2").arg(plugin, action);
+}
+
+/**
+ * Translates the "Text" of the given metadata object with the translation domain of the plugin,
+ * the plugin uses the same strings for its real tool views and actions.
+ */
+static QString translatedText(const QByteArray &domain, const QJsonObject &object)
+{
+    const QByteArray text = object.value(QLatin1String("Text")).toString().toUtf8();
+    const QByteArray context = object.value(QLatin1String("Context")).toString().toUtf8();
+    if (domain.isEmpty() || text.isEmpty()) {
+        return QString::fromUtf8(text);
+    }
+    return context.isEmpty() ? i18nd(domain.constData(), text.constData()) : i18ndc(domain.constData(), context.constData(), text.constData());
+}
+
+KatePluginActivation KatePluginActivation::fromMetaData(const KPluginMetaData &metaData)
+{
+    KatePluginActivation activation;
+    const QJsonObject object = metaData.rawData().value(QLatin1String("X-Kate-Activation")).toObject();
+    if (object.isEmpty()) {
+        return activation;
+    }
+
+    const QByteArray domain = object.value(QLatin1String("TranslationDomain")).toString().toUtf8();
+    activation.mimeTypes = object.value(QLatin1String("MimeTypes")).toVariant().toStringList();
+    activation.projectFiles = object.value(QLatin1String("ProjectFiles")).toVariant().toStringList();
+    const QStringList highlightingModes = object.value(QLatin1String("HighlightingModes")).toVariant().toStringList();
+    for (const auto &pattern : highlightingModes) {
+        activation.highlightingModes.push_back(QRegularExpression(pattern));
+    }
+    activation.configFiles = object.value(QLatin1String("ConfigFiles")).toVariant().toStringList();
+    activation.configEntries = object.value(QLatin1String("ConfigEntries")).toVariant().toStringList();
+
+    const QJsonArray toolViews = object.value(QLatin1String("ToolViews")).toArray();
+    for (const auto &value : toolViews) {
+        const QJsonObject toolViewObject = value.toObject();
+        ToolView toolView;
+        toolView.identifier = toolViewObject.value(QLatin1String("Identifier")).toString();
+        if (toolView.identifier.isEmpty()) {
+            continue;
+        }
+
+        const QString position = toolViewObject.value(QLatin1String("Position")).toString();
+        if (position == QLatin1String("Right")) {
+            toolView.position = KTextEditor::MainWindow::Right;
+        } else if (position == QLatin1String("Top")) {
+            toolView.position = KTextEditor::MainWindow::Top;
+        } else if (position == QLatin1String("Bottom")) {
+            toolView.position = KTextEditor::MainWindow::Bottom;
+        }
+
+        toolView.icon = toolViewObject.value(QLatin1String("Icon")).toString();
+        toolView.text = translatedText(domain, toolViewObject);
+        activation.toolViews.push_back(std::move(toolView));
+    }
+
+    const QJsonArray actions = object.value(QLatin1String("Actions")).toArray();
+    for (const auto &value : actions) {
+        const QJsonObject actionObject = value.toObject();
+        Action action;
+        action.name = actionObject.value(QLatin1String("Name")).toString();
+        if (action.name.isEmpty()) {
+            continue;
+        }
+
+        action.icon = actionObject.value(QLatin1String("Icon")).toString();
+        action.text = translatedText(domain, actionObject);
+        action.shortcut = actionObject.value(QLatin1String("Shortcut")).toString();
+        activation.actions.push_back(std::move(action));
+    }
+
+    return activation;
+}
+
+bool KatePluginActivation::isConfigured() const
+{
+    const QString configDir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    const bool hasFile = std::any_of(configFiles.cbegin(), configFiles.cend(), [&configDir](const QString &file) {
+        return QFileInfo::exists(configDir + QLatin1Char('/') + file);
+    });
+    return hasFile || std::any_of(configEntries.cbegin(), configEntries.cend(), [](const QString &entry) {
+               const qsizetype slash = entry.indexOf(QLatin1Char('/'));
+               return slash > 0 && KConfigGroup(KSharedConfig::openConfig(), entry.left(slash)).hasKey(entry.mid(slash + 1));
+           });
+}
 
 QString KatePluginInfo::saveName() const
 {
@@ -79,6 +185,7 @@ void KatePluginManager::setupPluginList()
     for (const auto &pluginMetaData : plugins) {
         KatePluginInfo info;
         info.metaData = pluginMetaData;
+        info.activation = KatePluginActivation::fromMetaData(pluginMetaData);
         const QString saveName = info.saveName();
 
         // only load plugins once, even if found multiple times!unique
@@ -106,6 +213,8 @@ void KatePluginManager::setupPluginList()
 
 void KatePluginManager::loadConfig(KConfig *config)
 {
+    KATE_TRACE_ZONE("plugins", "KatePluginManager::loadConfig");
+
     // first: unload the plugins
     unloadAllPlugins();
 
@@ -122,10 +231,17 @@ void KatePluginManager::loadConfig(KConfig *config)
     }
 
     /**
-     * load plugins
+     * load plugins, the ones with activation triggers only once they are needed
      */
+    const bool onDemand = KConfigGroup(KSharedConfig::openConfig(), QStringLiteral("General")).readEntry("Load Plugins On Demand", true);
+    m_checkedProjectDirs.clear();
     for (auto &pluginInfo : m_pluginList) {
         if (pluginInfo.load) {
+            if (onDemand && !pluginInfo.activation.isEmpty() && !pluginInfo.activation.isConfigured()) {
+                deferPlugin(&pluginInfo, config);
+                continue;
+            }
+
             /**
              * load plugin + trigger update of GUI for already existing main windows
              */
@@ -155,6 +271,9 @@ void KatePluginManager::writeConfig(KConfig *config)
         if (auto interface = qobject_cast<KTextEditor::SessionConfigInterface *>(plugin.plugin)) {
             KConfigGroup group(config, QStringLiteral("Plugin:%1:").arg(saveName));
             interface->writeSessionConfig(group);
+        } else if (plugin.deferred) {
+            // not activated yet, keep the config it was restored with
+            m_deferredConfig.group(QStringLiteral("Plugin:%1:").arg(saveName)).copyTo(config);
         }
     }
 }
@@ -162,7 +281,7 @@ void KatePluginManager::writeConfig(KConfig *config)
 void KatePluginManager::unloadAllPlugins()
 {
     for (auto &pluginInfo : m_pluginList) {
-        if (pluginInfo.plugin) {
+        if (pluginInfo.plugin || pluginInfo.deferred) {
             unloadPlugin(&pluginInfo);
         }
     }
@@ -173,9 +292,17 @@ void KatePluginManager::enableAllPluginsGUI(KateMainWindow *win, KConfigBase *co
     QElapsedTimer t;
     t.start();
     for (auto &pluginInfo : m_pluginList) {
-        if (pluginInfo.plugin) {
+        if (pluginInfo.deferred) {
+            // keep the view config until the plugin gets activated, all windows read the one of the first
+            const QString group = QStringLiteral("Plugin:%1:MainWindow:0").arg(pluginInfo.saveName());
+            if (config && !m_deferredConfig.hasGroup(group)) {
+                KConfigGroup(config, group).copyTo(&m_deferredConfig);
+            }
+            createPlaceholders(&pluginInfo, win);
+        } else if (pluginInfo.plugin) {
             t.restart();
             enablePluginGUI(&pluginInfo, win, config);
+            pluginInfo.loadTime += t.elapsed();
             qCDebug(LibKateTime, "-> %s load in %lld ms", qPrintable(pluginInfo.saveName()), t.elapsed());
         }
     }
@@ -184,7 +311,9 @@ void KatePluginManager::enableAllPluginsGUI(KateMainWindow *win, KConfigBase *co
 void KatePluginManager::disableAllPluginsGUI(KateMainWindow *win)
 {
     for (auto &pluginInfo : m_pluginList) {
-        if (pluginInfo.plugin) {
+        if (pluginInfo.deferred) {
+            removePlaceholders(&pluginInfo, win);
+        } else if (pluginInfo.plugin) {
             disablePluginGUI(&pluginInfo, win);
         }
     }
@@ -192,11 +321,25 @@ void KatePluginManager::disableAllPluginsGUI(KateMainWindow *win)
 
 bool KatePluginManager::loadPlugin(KatePluginInfo *item)
 {
+    // waiting for activation? the activation loads it together with the config it was restored with
+    if (item->deferred) {
+        return activatePlugin(item);
+    }
+
+    KateTrace::Zone zone("plugins", "loadPlugin");
+    if (zone.isActive()) {
+        zone.setDetail(item->saveName());
+    }
+
     /**
      * try to load the plugin
      */
+    QElapsedTimer t;
+    t.start();
     item->plugin = KPluginFactory::instantiatePlugin<KTextEditor::Plugin>(item->metaData, KateApp::self(), QVariantList() << item->saveName()).plugin;
     item->load = item->plugin != nullptr;
+    item->loadTime = item->plugin ? t.elapsed() : -1;
+    qCDebug(LibKateTime, "-> %s created in %lld ms", qPrintable(item->saveName()), t.elapsed());
 
     /**
      * tell the world about the success
@@ -210,11 +353,24 @@ bool KatePluginManager::loadPlugin(KatePluginInfo *item)
 
 void KatePluginManager::unloadPlugin(KatePluginInfo *item)
 {
+    // never activated, only the placeholders and the kept config are around
+    if (item->deferred) {
+        for (int i = 0; i < KateApp::self()->mainWindowsCount(); i++) {
+            removePlaceholders(item, KateApp::self()->mainWindow(i));
+        }
+        m_deferredConfig.deleteGroup(QStringLiteral("Plugin:%1:").arg(item->saveName()));
+        m_deferredConfig.deleteGroup(QStringLiteral("Plugin:%1:MainWindow:0").arg(item->saveName()));
+        item->deferred = false;
+        item->load = false;
+        return;
+    }
+
     disablePluginGUI(item);
     delete item->plugin;
     KTextEditor::Plugin *plugin = item->plugin;
     item->plugin = nullptr;
     item->load = false;
+    item->loadTime = -1;
     Q_EMIT KateApp::self()->wrapper()->pluginDeleted(item->saveName(), plugin);
 }
 
@@ -225,6 +381,11 @@ void KatePluginManager::enablePluginGUI(KatePluginInfo *item, KateMainWindow *wi
         return;
     }
 
+    KateTrace::Zone zone("plugins", "createPluginView");
+    if (zone.isActive()) {
+        zone.setDetail(item->saveName());
+    }
+
     // lookup if there is already a view for it..
     QObject *createdView = nullptr;
     if (!win->pluginViews().contains(item->plugin)) {
@@ -300,3 +461,192 @@ KTextEditor::Plugin *KatePluginManager::plugin(const QString &name)
     });
     return (it == m_pluginList.cend()) ? nullptr : it->plugin;
 }
+
+KTextEditor::Plugin *KatePluginManager::activatePlugin(const QString &name)
+{
+    const auto it = std::find_if(m_pluginList.begin(), m_pluginList.end(), [name](const KatePluginInfo &pi) {
+        return pi.saveName() == name;
+    });
+    if (it == m_pluginList.end()) {
+        return nullptr;
+    }
+
+    activatePlugin(&*it);
+    return it->plugin;
+}
+
+bool KatePluginManager::activatePlugin(KatePluginInfo *item)
+{
+    if (!item->deferred) {
+        return item->plugin != nullptr;
+    }
+    item->deferred = false;
+
+    KateTrace::Zone zone("plugins", "activatePlugin");
+    if (zone.isActive()) {
+        zone.setDetail(item->saveName());
+    }
+
+    // the real tool views and actions replace the placeholders
+    for (int i = 0; i < KateApp::self()->mainWindowsCount(); i++) {
+        removePlaceholders(item, KateApp::self()->mainWindow(i));
+    }
+
+    const QString pluginGroup = QStringLiteral("Plugin:%1:").arg(item->saveName());
+    if (loadPlugin(item)) {
+        if (auto interface = qobject_cast<KTextEditor::SessionConfigInterface *>(item->plugin)) {
+            KConfigGroup group(&m_deferredConfig, pluginGroup);
+            interface->readSessionConfig(group);
+        }
+
+        QElapsedTimer t;
+        t.start();
+        for (int i = 0; i < KateApp::self()->mainWindowsCount(); i++) {
+            enablePluginGUI(item, KateApp::self()->mainWindow(i), &m_deferredConfig);
+        }
+        item->loadTime += t.elapsed();
+        qCDebug(LibKateTime, "-> %s activated on demand in %lld ms", qPrintable(item->saveName()), item->loadTime);
+    }
+
+    m_deferredConfig.deleteGroup(pluginGroup);
+    m_deferredConfig.deleteGroup(QStringLiteral("Plugin:%1:MainWindow:0").arg(item->saveName()));
+    return item->plugin != nullptr;
+}
+
+void KatePluginManager::documentActivated(KTextEditor::Document *doc)
+{
+    const bool waiting = std::any_of(m_pluginList.cbegin(), m_pluginList.cend(), [](const KatePluginInfo &pi) {
+        return pi.deferred;
+    });
+    if (!doc || !waiting) {
+        return;
+    }
+
+    const QMimeType mimeType = QMimeDatabase().mimeTypeForName(doc->mimeType());
+
+    // directories to look for project files in, a directory already checked had its parents checked, too
+    QStringList dirs;
+    if (doc->url().isLocalFile()) {
+        QDir dir = QFileInfo(doc->url().toLocalFile()).absoluteDir();
+        while (!m_checkedProjectDirs.contains(dir.absolutePath())) {
+            m_checkedProjectDirs.insert(dir.absolutePath());
+            dirs.push_back(dir.absolutePath());
+            if (!dir.cdUp()) {
+                break;
+            }
+        }
+    }
+
+    for (auto &pluginInfo : m_pluginList) {
+        if (!pluginInfo.deferred) {
+            continue;
+        }
+
+        const auto &activation = pluginInfo.activation;
+        const bool mimeTypeMatches = mimeType.isValid() && std::any_of(activation.mimeTypes.cbegin(), activation.mimeTypes.cend(), [&mimeType](const QString &name) {
+                                         return mimeType.inherits(name);
+                                     });
+        const bool modeMatches = std::any_of(activation.highlightingModes.cbegin(), activation.highlightingModes.cend(), [doc](const QRegularExpression &re) {
+            return re.match(doc->highlightingMode()).hasMatch();
+        });
+        const bool projectMatches = std::any_of(dirs.cbegin(), dirs.cend(), [&activation](const QString &dir) {
+            return std::any_of(activation.projectFiles.cbegin(), activation.projectFiles.cend(), [&dir](const QString &file) {
+                return QFileInfo::exists(dir + QLatin1Char('/') + file);
+            });
+        });
+        if (mimeTypeMatches || modeMatches || projectMatches) {
+            activatePlugin(&pluginInfo);
+        }
+    }
+}
+
+void KatePluginManager::writeDeferredViewConfig(const KatePluginInfo &item, KConfigGroup &group)
+{
+    m_deferredConfig.group(QStringLiteral("Plugin:%1:MainWindow:0").arg(item.saveName())).copyTo(&group);
+}
+
+void KatePluginManager::deferPlugin(KatePluginInfo *item, KConfig *config)
+{
+    item->deferred = true;
+
+    // keep the session config for the activation
+    if (config) {
+        KConfigGroup(config, QStringLiteral("Plugin:%1:").arg(item->saveName())).copyTo(&m_deferredConfig);
+    }
+
+    // placeholders for already existing main windows, new ones get them in enableAllPluginsGUI
+    for (int i = 0; i < KateApp::self()->mainWindowsCount(); i++) {
+        createPlaceholders(item, KateApp::self()->mainWindow(i));
+    }
+}
+
+void KatePluginManager::createPlaceholders(KatePluginInfo *item, KateMainWindow *win)
+{
+    const QString name = item->saveName();
+
+    // showing a placeholder tool view activates the plugin and shows the real one instead
+    for (const auto &toolView : item->activation.toolViews) {
+        auto placeholder =
+            qobject_cast<KateMDI::ToolView *>(win->createToolView(nullptr, toolView.identifier, toolView.position, QIcon::fromTheme(toolView.icon), toolView.text));
+        if (!placeholder) {
+            continue;
+        }
+        placeholder->setProperty(PlaceholderProperty, name);
+
+        QObject::connect(placeholder, &KateMDI::ToolView::toolVisibleChanged, placeholder, [this, name, identifier = toolView.identifier, win](bool visible) {
+            if (!visible) {
+                return;
+            }
+
+            // not from within a signal of the placeholder the activation deletes
+            QTimer::singleShot(0, win, [this, name, identifier, win]() {
+                if (activatePlugin(name)) {
+                    if (auto toolView = win->toolviewForName(identifier)) {
+                        win->showToolView(toolView);
+                    }
+                }
+            });
+        });
+    }
+
+    // triggering a placeholder action activates the plugin and triggers the real one
+    for (const auto &action : item->activation.actions) {
+        QAction *placeholder = win->actionCollection()->addAction(placeholderActionName(name, action.name));
+        placeholder->setText(action.text);
+        placeholder->setIcon(QIcon::fromTheme(action.icon));
+        placeholder->setProperty(PlaceholderProperty, name);
+        if (!action.shortcut.isEmpty()) {
+            win->actionCollection()->setDefaultShortcut(placeholder, QKeySequence(action.shortcut));
+        }
+
+        QObject::connect(placeholder, &QAction::triggered, win, [this, name, actionName = action.name, win]() {
+            QTimer::singleShot(0, win, [this, name, actionName, win]() {
+                if (!activatePlugin(name)) {
+                    return;
+                }
+                if (auto client = dynamic_cast<KXMLGUIClient *>(win->pluginView(name))) {
+                    if (QAction *real = client->actionCollection()->action(actionName)) {
+                        real->trigger();
+                    }
+                }
+            });
+        });
+    }
+}
+
+void KatePluginManager::removePlaceholders(KatePluginInfo *item, KateMainWindow *win)
+{
+    const QString name = item->saveName();
+    for (const auto &toolView : item->activation.toolViews) {
+        QWidget *placeholder = win->toolviewForName(toolView.identifier);
+        if (placeholder && placeholder->property(PlaceholderProperty).toString() == name) {
+            delete placeholder;
+        }
+    }
+
+    for (const auto &action : item->activation.actions) {
+        if (QAction *placeholder = win->actionCollection()->action(placeholderActionName(name, action.name))) {
+            win->actionCollection()->removeAction(placeholder);
+        }
+    }
+}
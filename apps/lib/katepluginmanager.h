@@ -8,24 +8,87 @@
 
 #pragma once
 
+#include <KConfig>
 #include <KPluginMetaData>
+#include <KTextEditor/MainWindow>
 
-class KConfig;
+#include <QRegularExpression>
+#include <QSet>
+
+class KConfigGroup;
 class KateMainWindow;
 class KConfigBase;
 namespace KTextEditor
 {
+class Document;
 class Plugin;
 }
 
+/**
+ * Triggers to activate a plugin that is loaded on demand, read from the
+ * "X-Kate-Activation" object of the plugin metadata.
+ * Until the plugin is activated, placeholders for its tool views and actions are shown.
+ */
+class KatePluginActivation
+{
+public:
+    struct ToolView {
+        QString identifier;
+        KTextEditor::MainWindow::ToolViewPosition position = KTextEditor::MainWindow::Left;
+        QString icon;
+        // translated with the translation domain of the plugin
+        QString text;
+    };
+
+    struct Action {
+        QString name;
+        QString icon;
+        QString text;
+        QString shortcut;
+    };
+
+    // opening a document of one of these mime types (or inheriting from them)
+    QStringList mimeTypes;
+    // opening a document below a directory containing one of these files
+    QStringList projectFiles;
+    // activating a document with a highlighting mode matching one of these expressions
+    QList<QRegularExpression> highlightingModes;
+    // the plugin is loaded at startup if one of these files below the application config dir
+    // or one of these "group/key" entries of the application config exists, the user configured
+    // it and might rely on more than the triggers cover
+    QStringList configFiles;
+    QStringList configEntries;
+    // showing a placeholder tool view
+    std::vector<ToolView> toolViews;
+    // triggering a placeholder action, the action with the same name of the plugin view is triggered afterwards
+    std::vector<Action> actions;
+
+    bool isEmpty() const
+    {
+        return mimeTypes.isEmpty() && projectFiles.isEmpty() && highlightingModes.isEmpty() && toolViews.empty() && actions.empty();
+    }
+
+    static KatePluginActivation fromMetaData(const KPluginMetaData &metaData);
+
+    /**
+     * Did the user configure the plugin, see configFiles and configEntries?
+     */
+    bool isConfigured() const;
+};
+
 class KatePluginInfo
 {
 public:
     bool load = false;
     bool defaultLoad = false;
+    // enabled, but waiting for one of its activation triggers
+    bool deferred = false;
     KPluginMetaData metaData;
+    KatePluginActivation activation;
     KTextEditor::Plugin *plugin = nullptr;
     int sortOrder = 0;
+    // time in ms spent creating the plugin and its views, -1 if not loaded yet
+    qint64 loadTime = -1;
     QString saveName() const;
     bool operator<(const KatePluginInfo &other) const;
 };
@@ -60,13 +123,46 @@ public:
         return m_pluginList;
     }
 
+    /**
+     * The plugin with the given name, nullptr for plugins waiting for their activation.
+     */
     KTextEditor::Plugin *plugin(const QString &name);
 
+    /**
+     * Load a plugin that waits for its activation, see KatePluginActivation.
+     * @return the plugin, nullptr if not enabled or it failed to load
+     */
+    KTextEditor::Plugin *activatePlugin(const QString &name);
+    bool activatePlugin(KatePluginInfo *item);
+
+    /**
+     * Activate the plugins waiting for the mime type, highlighting mode or project of the given document.
+     */
+    void documentActivated(KTextEditor::Document *doc);
+
+    /**
+     * Write the view config a not yet activated plugin was restored with to @p group.
+     */
+    void writeDeferredViewConfig(const KatePluginInfo &item, KConfigGroup &group);
+
 private:
     void setupPluginList();
+    void deferPlugin(KatePluginInfo *item, KConfig *config);
+    void createPlaceholders(KatePluginInfo *item, KateMainWindow *win);
+    static void removePlaceholders(KatePluginInfo *item, KateMainWindow *win);
 
     /**
      * all known plugins
      */
     KatePluginList m_pluginList;
+
+    /**
+     * session config of plugins waiting for their activation
+     */
+    KConfig m_deferredConfig{QString(), KConfig::SimpleConfig};
+
+    /**
+     * directories of documents already checked for project files
+     */
+    QSet<QString> m_checkedProjectDirs;
 };
@@ -0,0 +1,183 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kateresourceusage.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QLocale>
+#include <QMutex>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// name of the entries for the whole process
+static const QString ProcessSubsystem = QStringLiteral("Process");
+
+// CPU time per subsystem, written from all threads
+static QMutex s_cpuMutex;
+static QHash<QByteArray, qint64> s_cpuTime;
+
+KateResourceUsage::Report::Report(const QString &subsystem, std::vector<Entry> &entries)
+    : m_subsystem(subsystem)
+    , m_entries(entries)
+{
+}
+
+void KateResourceUsage::Report::add(const QString &name, qint64 count, qint64 bytes)
+{
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [this, &name](const Entry &entry) {
+        return entry.subsystem == m_subsystem && entry.name == name;
+    });
+    if (it == m_entries.end()) {
+        m_entries.push_back(Entry{.subsystem = m_subsystem, .name = name, .count = count, .bytes = bytes});
+        return;
+    }
+
+    it->count += count;
+    if (bytes >= 0) {
+        it->bytes = std::max<qint64>(it->bytes, 0) + bytes;
+    }
+}
+
+KateResourceUsage::CpuScope::CpuScope(const char *subsystem)
+    : m_subsystem(subsystem)
+    , m_start(threadCpuTime())
+{
+}
+
+KateResourceUsage::CpuScope::~CpuScope()
+{
+    addCpuTime(m_subsystem, threadCpuTime() - m_start);
+}
+
+KateResourceUsage *KateResourceUsage::self()
+{
+    static QPointer<KateResourceUsage> s_self;
+    if (!s_self) {
+        s_self = new KateResourceUsage(QCoreApplication::instance());
+    }
+    return s_self;
+}
+
+KateResourceUsage::KateResourceUsage(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void KateResourceUsage::addReporter(const QString &subsystem, QObject *context, Reporter reporter)
+{
+    m_reporters.push_back(Registration{.subsystem = subsystem, .context = context, .reporter = std::move(reporter)});
+}
+
+static qint64 residentMemory()
+{
+#ifdef Q_OS_LINUX
+    // second field is the resident set in pages
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const auto fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return -1;
+}
+
+std::vector<KateResourceUsage::Entry> KateResourceUsage::snapshot() const
+{
+    // forget the reporters of destroyed subsystems
+    m_reporters.erase(std::remove_if(m_reporters.begin(),
+                                     m_reporters.end(),
+                                     [](const Registration &registration) {
+                                         return !registration.context;
+                                     }),
+                      m_reporters.end());
+
+    std::vector<Entry> entries;
+    if (const qint64 rss = residentMemory(); rss >= 0) {
+        entries.push_back(Entry{.subsystem = ProcessSubsystem, .name = QStringLiteral("Resident memory"), .count = 1, .bytes = rss});
+    }
+
+    for (const auto &registration : m_reporters) {
+        Report report(registration.subsystem, entries);
+        registration.reporter(report);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &l, const Entry &r) {
+        return l.subsystem < r.subsystem;
+    });
+    return entries;
+}
+
+QHash<QString, qint64> KateResourceUsage::cpuTime()
+{
+    QHash<QString, qint64> times;
+    {
+        QMutexLocker locker(&s_cpuMutex);
+        for (auto it = s_cpuTime.cbegin(); it != s_cpuTime.cend(); ++it) {
+            times.insert(QString::fromLatin1(it.key()), it.value());
+        }
+    }
+    // let chrono reduce the ratio, multiplying the ticks with 10^9 first overflows after hours
+    using ClockTicks = std::chrono::duration<qint64, std::ratio<1, CLOCKS_PER_SEC>>;
+    times.insert(ProcessSubsystem, std::chrono::duration_cast<std::chrono::nanoseconds>(ClockTicks(std::clock())).count());
+    return times;
+}
+
+void KateResourceUsage::addCpuTime(const char *subsystem, qint64 nsecs)
+{
+    // lookup without copying the name, the literal might be in a plugin that gets unloaded
+    QMutexLocker locker(&s_cpuMutex);
+    const auto key = QByteArray::fromRawData(subsystem, qsizetype(std::strlen(subsystem)));
+    if (auto it = s_cpuTime.find(key); it != s_cpuTime.end()) {
+        *it += nsecs;
+    } else {
+        s_cpuTime.insert(QByteArray(subsystem), nsecs);
+    }
+}
+
+qint64 KateResourceUsage::threadCpuTime()
+{
+#if defined(Q_OS_UNIX) && defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+#endif
+    // no per thread clock, wall time is the best we have
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+QString KateResourceUsage::dump() const
+{
+    const QLocale locale = QLocale::c();
+    QString text;
+    for (const auto &entry : snapshot()) {
+        text += QStringLiteral("%1 / %2: %3").arg(entry.subsystem, entry.name).arg(entry.count);
+        if (entry.bytes >= 0) {
+            text += QStringLiteral(", ~%1").arg(locale.formattedDataSize(entry.bytes));
+        }
+        text += QLatin1Char('\n');
+    }
+
+    const auto times = cpuTime();
+    auto subsystems = times.keys();
+    subsystems.sort();
+    for (const auto &subsystem : std::as_const(subsystems)) {
+        text += QStringLiteral("%1 / CPU time: %2 ms\n").arg(subsystem).arg(times.value(subsystem) / 1000000);
+    }
+    return text;
+}
+
+#include "moc_kateresourceusage.cpp"
@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+/**
+ * Accounting of the resources the different parts of Kate use, to find out where the
+ * memory and time goes without attaching a profiler.
+ *
+ * Subsystems register reporters that are asked for their current numbers (documents,
+ * matches, diagnostics, ...) whenever a snapshot is taken, e.g. by the resource usage
+ * tool view or the resourceUsage D-Bus call. Byte counts are estimates of the payload,
+ * not exact heap usage.
+ *
+ * CPU time is collected with CpuScope in the hot paths of the subsystems and can be
+ * recorded from any thread.
+ */
+class KATE_PRIVATE_EXPORT KateResourceUsage : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QString subsystem;
+        QString name;
+        qint64 count = 0;
+        /// approximate, -1 if unknown
+        qint64 bytes = -1;
+    };
+
+    /**
+     * Collects the entries of one reporter.
+     */
+    class KATE_PRIVATE_EXPORT Report
+    {
+    public:
+        void add(const QString &name, qint64 count, qint64 bytes = -1);
+
+    private:
+        friend class KateResourceUsage;
+        Report(const QString &subsystem, std::vector<Entry> &entries);
+
+        const QString &m_subsystem;
+        std::vector<Entry> &m_entries;
+    };
+
+    using Reporter = std::function<void(Report &)>;
+
+    /**
+     * Adds the CPU time the current thread spent until destruction to the subsystem.
+     * @p subsystem must be a string literal.
+     */
+    class KATE_PRIVATE_EXPORT CpuScope
+    {
+    public:
+        explicit CpuScope(const char *subsystem);
+        ~CpuScope();
+
+        CpuScope(const CpuScope &) = delete;
+        CpuScope &operator=(const CpuScope &) = delete;
+
+    private:
+        const char *const m_subsystem;
+        const qint64 m_start;
+    };
+
+    static KateResourceUsage *self();
+
+    /**
+     * Add a reporter for the subsystem, it is dropped once @p context is destroyed.
+     * Entries with the same name from multiple reporters of a subsystem add up,
+     * e.g. for one reporter per main window.
+     */
+    void addReporter(const QString &subsystem, QObject *context, Reporter reporter);
+
+    /**
+     * Ask all reporters for their current numbers, sorted by subsystem.
+     * Includes the resident memory and CPU time of the whole process.
+     */
+    std::vector<Entry> snapshot() const;
+
+    /**
+     * CPU time in nanoseconds per subsystem since startup, thread safe.
+     */
+    static QHash<QString, qint64> cpuTime();
+    static void addCpuTime(const char *subsystem, qint64 nsecs);
+
+    /**
+     * CPU time the calling thread used so far, in nanoseconds.
+     */
+    static qint64 threadCpuTime();
+
+    /**
+     * Snapshot and CPU times as plain text table.
+     */
+    QString dump() const;
+
+private:
+    explicit KateResourceUsage(QObject *parent);
+
+    struct Registration {
+        QString subsystem;
+        QPointer<QObject> context;
+        Reporter reporter;
+    };
+
+    mutable std::vector<Registration> m_reporters;
+};
@@ -0,0 +1,135 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kateresourceusageview.h"
+#include "kateresourceusage.h"
+
+#include <KLocalizedString>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QPushButton>
+#include <QSet>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+// refresh interval while the view is visible
+static constexpr int RefreshIntervalMs = 2000;
+
+enum Column {
+    NameColumn,
+    CountColumn,
+    MemoryColumn,
+    CpuColumn,
+    RecentCpuColumn,
+};
+
+KateResourceUsageView::KateResourceUsageView(QWidget *parent)
+    : QWidget(parent)
+    , m_tree(new QTreeWidget(this))
+{
+    m_tree->setHeaderLabels({i18n("Name"), i18n("Count"), i18n("Memory"), i18n("CPU Time"), i18n("Recent CPU Time")});
+    m_tree->setRootIsDecorated(true);
+    m_tree->setUniformRowHeights(true);
+    m_tree->header()->setSectionResizeMode(NameColumn, QHeaderView::Stretch);
+    m_tree->header()->setStretchLastSection(false);
+
+    auto refreshButton = new QPushButton(QIcon::fromTheme(QStringLiteral("view-refresh")), i18n("Refresh"), this);
+    connect(refreshButton, &QPushButton::clicked, this, &KateResourceUsageView::refresh);
+
+    auto copyButton = new QPushButton(QIcon::fromTheme(QStringLiteral("edit-copy")), i18n("Copy to Clipboard"), this);
+    connect(copyButton, &QPushButton::clicked, this, []() {
+        QApplication::clipboard()->setText(KateResourceUsage::self()->dump());
+    });
+
+    auto buttons = new QHBoxLayout;
+    buttons->addWidget(refreshButton);
+    buttons->addWidget(copyButton);
+    buttons->addStretch();
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins({});
+    layout->addLayout(buttons);
+    layout->addWidget(m_tree);
+
+    m_refreshTimer.setInterval(RefreshIntervalMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &KateResourceUsageView::refresh);
+}
+
+void KateResourceUsageView::showEvent(QShowEvent *event)
+{
+    refresh();
+    m_refreshTimer.start();
+    QWidget::showEvent(event);
+}
+
+void KateResourceUsageView::hideEvent(QHideEvent *event)
+{
+    m_refreshTimer.stop();
+    QWidget::hideEvent(event);
+}
+
+void KateResourceUsageView::refresh()
+{
+    const QLocale locale;
+    const auto formatTime = [&locale](qint64 nsecs) {
+        return i18nc("milliseconds", "%1 ms", locale.toString(nsecs / 1000000));
+    };
+
+    // keep the expansion state over refreshes
+    QSet<QString> collapsed;
+    for (int i = 0; i < m_tree->topLevelItemCount(); ++i) {
+        if (!m_tree->topLevelItem(i)->isExpanded()) {
+            collapsed.insert(m_tree->topLevelItem(i)->text(NameColumn));
+        }
+    }
+    m_tree->clear();
+
+    QHash<QString, QTreeWidgetItem *> subsystems;
+    const auto subsystemItem = [this, &subsystems](const QString &subsystem) {
+        auto &item = subsystems[subsystem];
+        if (!item) {
+            item = new QTreeWidgetItem(m_tree, {subsystem});
+        }
+        return item;
+    };
+
+    QHash<QString, qint64> subsystemBytes;
+    for (const auto &entry : KateResourceUsage::self()->snapshot()) {
+        auto item = new QTreeWidgetItem(subsystemItem(entry.subsystem), {entry.name, locale.toString(entry.count)});
+        if (entry.bytes >= 0) {
+            item->setText(MemoryColumn, locale.formattedDataSize(entry.bytes));
+            subsystemBytes[entry.subsystem] += entry.bytes;
+        }
+        item->setTextAlignment(CountColumn, Qt::AlignRight);
+        item->setTextAlignment(MemoryColumn, Qt::AlignRight);
+    }
+
+    const auto cpuTime = KateResourceUsage::cpuTime();
+    for (auto it = cpuTime.cbegin(); it != cpuTime.cend(); ++it) {
+        auto item = subsystemItem(it.key());
+        item->setText(CpuColumn, formatTime(it.value()));
+        item->setText(RecentCpuColumn, formatTime(it.value() - m_lastCpuTime.value(it.key(), it.value())));
+    }
+    m_lastCpuTime = cpuTime;
+
+    for (auto it = subsystems.cbegin(); it != subsystems.cend(); ++it) {
+        if (const qint64 bytes = subsystemBytes.value(it.key(), -1); bytes >= 0) {
+            it.value()->setText(MemoryColumn, locale.formattedDataSize(bytes));
+        }
+        for (int column = CountColumn; column <= RecentCpuColumn; ++column) {
+            it.value()->setTextAlignment(column, Qt::AlignRight);
+        }
+        it.value()->setExpanded(!collapsed.contains(it.key()));
+    }
+
+    m_tree->sortItems(NameColumn, Qt::AscendingOrder);
+}
+
+#include "moc_kateresourceusageview.cpp"
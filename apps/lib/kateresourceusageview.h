@@ -0,0 +1,37 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QTimer>
+#include <QWidget>
+
+class QTreeWidget;
+
+/**
+ * Tool view showing the KateResourceUsage snapshot, refreshed while visible.
+ */
+class KateResourceUsageView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit KateResourceUsageView(QWidget *parent);
+
+    void refresh();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    QTreeWidget *const m_tree;
+    QTimer m_refreshTimer;
+
+    // to show the CPU time since the last refresh
+    QHash<QString, qint64> m_lastCpuTime;
+};
@@ -16,11 +16,52 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QStringDecoder>
+#include <QStringEncoder>
 #include <QUrl>
+#include <QUuid>
 
 #include <memory>
 
+/**
+ * Write the stashed text, runs in the writer thread.
+ */
+static void writeStashFile(const QString &fileName, const QString &text, const QString &encoding)
+{
+    // use the document encoding, popDocument reads the file back with it
+    // if the text can't be represented, use UTF-8 with BOM, the BOM overrides the encoding on load
+    QStringEncoder encoder(encoding.toUtf8().constData());
+    QByteArray data;
+    if (encoder.isValid()) {
+        data = encoder.encode(text);
+    }
+    if (!encoder.isValid() || encoder.hasError()) {
+        QStringEncoder utf8(QStringEncoder::Utf8, QStringEncoder::Flag::WriteBom);
+        data = utf8.encode(text);
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(LOG_KATE) << "Could not write to stash file" << fileName << file.errorString();
+    }
+}
+
+KateStashManager::KateStashManager()
+{
+    m_writer.setMaxThreadCount(1);
+}
+
+KateStashManager::~KateStashManager()
+{
+    waitForStashWrites();
+}
+
+void KateStashManager::waitForStashWrites()
+{
+    m_writer.waitForDone();
+}
+
 void KateStashManager::clearStashForSession(const KateSession::Ptr session)
 {
     // we should avoid to kill stuff for these, they can't be stashed
@@ -40,12 +81,49 @@ void KateStashManager::clearStashForSession(const KateSession::Ptr session)
     }
 }
 
-void KateStashManager::stashDocuments(KConfig *config, std::span<KTextEditor::Document *const> documents) const
+void KateStashManager::stashDocuments(KConfig *config, std::span<KTextEditor::Document *const> documents)
 {
     if (!canStash()) {
         return;
     }
 
+    const QDir dir(stashDirectory());
+
+    // forget about closed documents, the stash of other sessions is still referenced by them
+    for (auto it = m_stashes.begin(); it != m_stashes.end();) {
+        if (it->second.doc) {
+            ++it;
+            continue;
+        }
+        if (QFileInfo(it->second.file).path() == dir.path()) {
+            m_writer.start([file = it->second.file]() {
+                QFile::remove(file);
+            });
+        }
+        it = m_stashes.erase(it);
+    }
+
+    int i = 0;
+    for (KTextEditor::Document *doc : documents) {
+        KConfigGroup cg(config, QStringLiteral("Document %1").arg(i));
+        i++;
+
+        // not yet loaded documents keep the stash they were restored with
+        if (KateApp::self()->documentManager()->isPendingRestore(doc)) {
+            continue;
+        }
+
+        // stash the file content
+        if (doc->isModified() && willStashDoc(doc)) {
+            stashDocument(doc, cg, dir.path());
+        } else {
+            unstashDocument(doc, cg, dir.path());
+        }
+    }
+}
+
+QString KateStashManager::stashDirectory() const
+{
     // prepare stash directory
     const QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir dir(appDataPath);
@@ -55,24 +133,19 @@ void KateStashManager::stashDocuments(KConfig *config, std::span<KTextEditor::Do
     const QString stashName = QFileInfo(KateApp::self()->sessionManager()->activeSession()->file()).fileName();
     dir.mkdir(stashName);
     dir.cd(stashName);
-
-    int i = 0;
-    for (KTextEditor::Document *doc : documents) {
-        // stash the file content
-        if (doc->isModified()) {
-            const QString entryName = QStringLiteral("Document %1").arg(i);
-            KConfigGroup cg(config, entryName);
-            stashDocument(doc, entryName, cg, dir.path());
-        }
-
-        i++;
-    }
+    return dir.path();
 }
 
 bool KateStashManager::willStashDoc(KTextEditor::Document *doc) const
 {
     Q_ASSERT(canStash());
 
+    // a hibernated document is empty, its changes wait in the stash file it got hibernated with
+    const auto docManager = KateApp::self()->documentManager();
+    if (docManager->isPendingRestore(doc)) {
+        return docManager->hasUnsavedChanges(doc);
+    }
+
     if (doc->isEmpty()) {
         return false;
     }
@@ -89,29 +162,71 @@ bool KateStashManager::willStashDoc(KTextEditor::Document *doc) const
     return false;
 }
 
-void KateStashManager::stashDocument(KTextEditor::Document *doc, const QString &stashfileName, KConfigGroup &kconfig, const QString &path) const
+void KateStashManager::stashDocument(KTextEditor::Document *doc, KConfigGroup &kconfig, const QString &path)
 {
     if (!willStashDoc(doc)) {
         return;
     }
 
-    // Stash changes
-    QString stashedFile = path + QStringLiteral("/") + stashfileName;
+    // each document keeps its stash file as long as it lives, the document index might change
+    auto &stash = m_stashes[doc];
+    if (stash.doc != doc || QFileInfo(stash.file).path() != path) {
+        stash = Stash{.doc = doc, .file = path + QStringLiteral("/") + QUuid::createUuid().toString(QUuid::WithoutBraces), .revision = -1};
+    }
 
-    // save the current document changes to stash
-    if (!doc->saveAs(QUrl::fromLocalFile(stashedFile))) {
-        qCWarning(LOG_KATE) << "Could not write to stash file" << stashedFile;
-        return;
+    // only write the content again if it changed, the text is copied here, encoded and written in the background
+    const qint64 revision = doc->revision();
+    if (stash.revision != revision || !QFileInfo::exists(stash.file)) {
+        m_writer.start([file = stash.file, text = doc->text(), encoding = doc->encoding()]() {
+            writeStashFile(file, text, encoding);
+        });
+        stash.revision = revision;
     }
 
     // write stash metadata to config
-    kconfig.writeEntry("stashedFile", stashedFile);
+    kconfig.writeEntry("stashedFile", stash.file);
     if (doc->url().isValid()) {
         // save checksum for already-saved documents
         kconfig.writeEntry("checksum", doc->checksum());
     }
+}
+
+bool KateStashManager::stashForHibernation(KTextEditor::Document *doc, KConfigGroup &kconfig)
+{
+    if (!canStash()) {
+        return false;
+    }
+
+    // a stash from an auto save is superseded
+    const QString path = stashDirectory();
+    unstashDocument(doc, kconfig, path);
+
+    const QString stashedFile = path + QStringLiteral("/") + QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_writer.start([file = stashedFile, text = doc->text(), encoding = doc->encoding()]() {
+        writeStashFile(file, text, encoding);
+    });
+    kconfig.writeEntry("stashedFile", stashedFile);
+    return true;
+}
+
+void KateStashManager::unstashDocument(KTextEditor::Document *doc, KConfigGroup &kconfig, const QString &path)
+{
+    // an auto save might have stashed the document before it got saved
+    if (kconfig.hasKey("stashedFile")) {
+        kconfig.deleteEntry("stashedFile");
+        kconfig.deleteEntry("checksum");
+    }
 
-    kconfig.sync();
+    const auto it = m_stashes.find(doc);
+    if (it == m_stashes.end()) {
+        return;
+    }
+    if (it->second.doc == doc && QFileInfo(it->second.file).path() == path) {
+        m_writer.start([file = it->second.file]() {
+            QFile::remove(file);
+        });
+    }
+    m_stashes.erase(it);
 }
 
 bool KateStashManager::canStash() const
@@ -131,6 +246,14 @@ void KateStashManager::popDocument(KTextEditor::Document *doc, const KConfigGrou
     const auto stashedFile = kconfig.readEntry("stashedFile");
     const auto url = QUrl(kconfig.readEntry("URL"));
 
+    // the stash might still be written, e.g. if we switch back to a session just left
+    waitForStashWrites();
+    if (!QFile::exists(stashedFile)) {
+        // e.g. crashed before the stash got written, keep the document as is
+        qCWarning(LOG_KATE) << "Stash file is missing" << stashedFile;
+        return;
+    }
+
     bool checksumOk = true;
     if (url.isValid()) {
         const auto sum = kconfig.readEntry(QStringLiteral("checksum")).toUtf8();
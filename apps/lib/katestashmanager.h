@@ -9,19 +9,28 @@
 #include "katesession.h"
 #include "kconfiggroup.h"
 
-#include <span>
+#include <KTextEditor/Document>
 
-namespace KTextEditor
-{
-class Document;
-}
+#include <QPointer>
+#include <QThreadPool>
+
+#include <span>
+#include <unordered_map>
 
 class KateViewManager;
 
 class KateStashManager
 {
 public:
-    KateStashManager() = default;
+    KateStashManager();
+
+    /**
+     * Waits for pending stash file writes.
+     */
+    ~KateStashManager();
+
+    KateStashManager(const KateStashManager &) = delete;
+    KateStashManager &operator=(const KateStashManager &) = delete;
 
     bool stashUnsavedChanges() const
     {
@@ -45,16 +54,52 @@ public:
 
     bool canStash() const;
 
-    void stashDocuments(KConfig *cfg, std::span<KTextEditor::Document *const> documents) const;
+    /**
+     * Stash the unsaved changes of the given documents and write the stash entries
+     * into the matching "Document %1" groups of @p cfg, the caller needs to sync it.
+     * The stash files are written in the background, a document is only written
+     * again if it was changed since it was stashed the last time.
+     */
+    void stashDocuments(KConfig *cfg, std::span<KTextEditor::Document *const> documents);
 
     bool willStashDoc(KTextEditor::Document *doc) const;
 
-    void stashDocument(KTextEditor::Document *doc, const QString &stashfileName, KConfigGroup &kconfig, const QString &path) const;
-    static void popDocument(KTextEditor::Document *doc, const KConfigGroup &kconfig);
+    void stashDocument(KTextEditor::Document *doc, KConfigGroup &kconfig, const QString &path);
+
+    /**
+     * Stash the content of a document that gets hibernated, the stash entry is written to @p kconfig.
+     * @return false if we can't stash for the current session
+     */
+    bool stashForHibernation(KTextEditor::Document *doc, KConfigGroup &kconfig);
+    void popDocument(KTextEditor::Document *doc, const KConfigGroup &kconfig);
 
     static void clearStashForSession(const KateSession::Ptr session);
 
+    /**
+     * Wait until all stash files are written.
+     */
+    void waitForStashWrites();
+
+private:
+    /**
+     * Stash directory of the active session, created if needed.
+     */
+    QString stashDirectory() const;
+
+    void unstashDocument(KTextEditor::Document *doc, KConfigGroup &kconfig, const QString &path);
+
 private:
     bool m_stashUnsavedChanges = false;
     bool m_stashNewUnsavedFiles = true;
+
+    struct Stash {
+        // guards against a new document reusing the address of a deleted one
+        QPointer<KTextEditor::Document> doc;
+        QString file;
+        qint64 revision = -1;
+    };
+    std::unordered_map<KTextEditor::Document *, Stash> m_stashes;
+
+    // single threaded, a later write of a stash file must not overtake an earlier one
+    QThreadPool m_writer;
 };
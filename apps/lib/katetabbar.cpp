@@ -24,6 +24,18 @@
 
 #include <KTextEditor/Document>
 
+/**
+ * Placeholders of a lazy session restore and hibernated documents have no url and name yet,
+ * ask the document manager for the ones they will get.
+ */
+static QString tabText(DocOrWidget d)
+{
+    if (auto doc = d.doc()) {
+        return KateApp::self()->documentManager()->documentName(doc);
+    }
+    return d.widget()->windowTitle();
+}
+
 /**
  * Creates a new tab bar with the given \a parent.
  */
@@ -89,7 +101,7 @@ void KateTabBar::readConfig()
                     break;
                 }
                 DocOrWidget doc = i.second;
-                const auto idx = addTab(doc.doc() ? doc.doc()->documentName() : doc.widget()->windowTitle());
+                const auto idx = addTab(tabText(doc));
                 setTabDocument(idx, doc);
             }
         }
@@ -325,11 +337,12 @@ void KateTabBar::setTabDocument(int idx, DocOrWidget d)
 
     auto *doc = d.doc();
     // BUG: 441340 We need to escape the & because it is used for accelerators/shortcut mnemonic by default
-    QString tabName = d.doc() ? d.doc()->documentName() : d.widget()->windowTitle();
+    QString tabName = tabText(d);
     tabName.replace(QLatin1Char('&'), QLatin1String("&&"));
     setTabText(idx, tabName);
     if (d.doc()) {
-        setTabToolTip(idx, doc->url().isValid() ? doc->url().toDisplayString(QUrl::PreferLocalFile) : doc->documentName());
+        const QUrl url = KateApp::self()->documentManager()->documentUrl(doc);
+        setTabToolTip(idx, url.isValid() ? url.toDisplayString(QUrl::PreferLocalFile) : doc->documentName());
         setModifiedStateIcon(idx, doc);
     } else {
         setTabIcon(idx, d.widget()->windowIcon());
@@ -361,7 +374,7 @@ void KateTabBar::setCurrentDocument(DocOrWidget docOrWidget)
     if ((m_tabCountLimit == 0) || (count() < m_tabCountLimit)) {
         m_beingAdded = docOrWidget;
         int index = m_openNewTabInFrontOfCurrent && currentIndex() != -1 ? currentIndex() + 1 : -1;
-        insertTab(index, docOrWidget.doc() ? docOrWidget.doc()->documentName() : docOrWidget.widget()->windowTitle());
+        insertTab(index, tabText(docOrWidget));
         return;
     }
 
@@ -0,0 +1,57 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katetaskindicator.h"
+#include "katetaskscheduler.h"
+
+#include <KLocalizedString>
+
+#include <QIcon>
+#include <QStyle>
+
+KateTaskIndicator::KateTaskIndicator(QWidget *parent)
+    : QLabel(parent)
+{
+    const int size = style()->pixelMetric(QStyle::PM_SmallIconSize, nullptr, this);
+    setPixmap(QIcon::fromTheme(QStringLiteral("view-refresh")).pixmap(size));
+    setContentsMargins(2, 0, 2, 0);
+    hide();
+
+    m_showDelay.setSingleShot(true);
+    m_showDelay.setInterval(500);
+    connect(&m_showDelay, &QTimer::timeout, this, [this]() {
+        setVisible(KateTaskScheduler::self()->runningCount() > 0);
+    });
+
+    connect(KateTaskScheduler::self(), &KateTaskScheduler::activityChanged, this, &KateTaskIndicator::updateActivity);
+}
+
+void KateTaskIndicator::updateActivity()
+{
+    const auto scheduler = KateTaskScheduler::self();
+    const int running = scheduler->runningCount();
+    if (running == 0) {
+        m_showDelay.stop();
+        hide();
+        return;
+    }
+
+    QString toolTip = i18np("%1 background task running:", "%1 background tasks running:", running);
+    const auto names = scheduler->runningTaskNames();
+    for (const auto &name : names) {
+        toolTip += QLatin1Char('\n') + name;
+    }
+    if (const int pending = scheduler->pendingCount(); pending > 0) {
+        toolTip += QLatin1Char('\n') + i18np("%1 more waiting", "%1 more waiting", pending);
+    }
+    setToolTip(toolTip);
+
+    if (isHidden() && !m_showDelay.isActive()) {
+        m_showDelay.start();
+    }
+}
+
+#include "moc_katetaskindicator.cpp"
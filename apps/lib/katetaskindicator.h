@@ -0,0 +1,29 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QLabel>
+#include <QTimer>
+
+/**
+ * Small icon next to the status bar, shown while the KateTaskScheduler runs tasks.
+ * The tool tip lists them.
+ */
+class KateTaskIndicator : public QLabel
+{
+    Q_OBJECT
+
+public:
+    explicit KateTaskIndicator(QWidget *parent);
+
+private:
+    void updateActivity();
+
+private:
+    // don't flicker for short tasks
+    QTimer m_showDelay;
+};
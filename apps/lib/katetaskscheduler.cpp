@@ -0,0 +1,354 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katetaskscheduler.h"
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QEvent>
+#include <QPointer>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+// how long the user has to be quiet before background respective idle tasks run
+static constexpr qint64 BackgroundQuietMs = 500;
+static constexpr qint64 IdleQuietMs = 2000;
+
+// tasks with a CPU budget run this long before they pause
+static constexpr qint64 SliceMs = 50;
+
+// granularity of the pauses, bounds how long a canceled task keeps sleeping
+static constexpr unsigned long PausePollMs = 50;
+
+struct KateTaskScheduler::TaskState {
+    explicit TaskState(Priority p)
+        : priority(p)
+    {
+    }
+
+    const Priority priority;
+    std::atomic<bool> canceled = false;
+    // guarded by m_doneMutex for the wait condition
+    bool done = false;
+};
+
+struct KateTaskScheduler::Task {
+    explicit Task(Priority priority)
+        : state(priority)
+    {
+    }
+
+    quint64 id = 0;
+    QString name;
+    Work work;
+    // only compared, the object might be gone already
+    const QObject *context = nullptr;
+    TaskState state;
+};
+
+static qint64 quietTime(KateTaskScheduler::Priority priority)
+{
+    switch (priority) {
+    case KateTaskScheduler::Background:
+        return BackgroundQuietMs;
+    case KateTaskScheduler::Idle:
+        return IdleQuietMs;
+    default:
+        return 0;
+    }
+}
+
+KateTaskScheduler::Token::Token(KateTaskScheduler *scheduler, TaskState *state)
+    : m_scheduler(scheduler)
+    , m_state(state)
+{
+    m_slice.start();
+}
+
+bool KateTaskScheduler::Token::isCanceled() const
+{
+    return m_state->canceled;
+}
+
+bool KateTaskScheduler::Token::checkpoint()
+{
+    const auto priority = m_state->priority;
+    if (m_state->canceled || priority < Background) {
+        return !m_state->canceled;
+    }
+
+    // step back while the user is active
+    if (m_scheduler->isUserActive(priority)) {
+        while (m_scheduler->isUserActive(priority) && !m_state->canceled) {
+            QThread::msleep(PausePollMs);
+        }
+        m_slice.restart();
+    }
+
+    // sleep after each slice to use at most our share of the time,
+    // in short steps, cancelAndWait() might block the GUI thread on us
+    const int budget = m_scheduler->m_cpuBudgets[priority];
+    const qint64 elapsed = m_slice.elapsed();
+    if (budget < 100 && elapsed >= SliceMs) {
+        QDeadlineTimer pause(elapsed * (100 - budget) / std::max(budget, 1));
+        while (!pause.hasExpired() && !m_state->canceled) {
+            QThread::msleep(std::min<qint64>(PausePollMs, std::max<qint64>(pause.remainingTime(), 1)));
+        }
+        m_slice.restart();
+    }
+
+    return !m_state->canceled;
+}
+
+KateTaskScheduler *KateTaskScheduler::self()
+{
+    static QPointer<KateTaskScheduler> s_self;
+    if (!s_self) {
+        s_self = new KateTaskScheduler(QCoreApplication::instance());
+    }
+    return s_self;
+}
+
+KateTaskScheduler::KateTaskScheduler(QObject *parent)
+    : QObject(parent)
+{
+    const int cores = std::max(1, QThread::idealThreadCount());
+    m_coreLimits = {cores, cores, std::max(1, cores / 2), 1};
+    m_pool.setMaxThreadCount(cores + cores + std::max(1, cores / 2) + 1);
+
+    m_cpuBudgets[Interactive] = 100;
+    m_cpuBudgets[Visible] = 100;
+    m_cpuBudgets[Background] = 50;
+    m_cpuBudgets[Idle] = 25;
+
+    m_clock.start();
+
+    m_resumeTimer.setSingleShot(true);
+    m_resumeTimer.setInterval(BackgroundQuietMs);
+    connect(&m_resumeTimer, &QTimer::timeout, this, &KateTaskScheduler::dispatch);
+
+    if (auto app = QCoreApplication::instance()) {
+        app->installEventFilter(this);
+    }
+}
+
+KateTaskScheduler::~KateTaskScheduler()
+{
+    for (auto &queue : m_pending) {
+        queue.clear();
+    }
+    for (const auto &task : std::as_const(m_runningTasks)) {
+        task->state.canceled = true;
+    }
+    m_pool.waitForDone();
+}
+
+quint64 KateTaskScheduler::schedule(Priority priority, const QString &name, Work work, QObject *context)
+{
+    auto task = std::make_shared<Task>(priority);
+    task->id = m_nextId++;
+    task->name = name;
+    task->work = std::move(work);
+    task->context = context;
+
+    if (context && !m_contexts.contains(context)) {
+        m_contexts.insert(context);
+        connect(context, &QObject::destroyed, this, [this, context]() {
+            m_contexts.remove(context);
+            cancelAndWait(context);
+        });
+    }
+
+    m_pending[priority].push_back(task);
+    dispatch();
+    return task->id;
+}
+
+void KateTaskScheduler::cancel(quint64 id)
+{
+    for (auto &queue : m_pending) {
+        auto it = std::find_if(queue.begin(), queue.end(), [id](const auto &task) {
+            return task->id == id;
+        });
+        if (it != queue.end()) {
+            queue.erase(it);
+            Q_EMIT activityChanged();
+            return;
+        }
+    }
+
+    if (auto task = m_runningTasks.value(id)) {
+        task->state.canceled = true;
+    }
+}
+
+void KateTaskScheduler::cancelAndWait(const QObject *context)
+{
+    for (auto &queue : m_pending) {
+        queue.erase(std::remove_if(queue.begin(),
+                                   queue.end(),
+                                   [context](const auto &task) {
+                                       return task->context == context;
+                                   }),
+                    queue.end());
+    }
+
+    std::vector<std::shared_ptr<Task>> running;
+    for (const auto &task : std::as_const(m_runningTasks)) {
+        if (task->context == context) {
+            task->state.canceled = true;
+            running.push_back(task);
+        }
+    }
+
+    QMutexLocker locker(&m_doneMutex);
+    for (const auto &task : running) {
+        while (!task->state.done) {
+            m_doneCondition.wait(&m_doneMutex);
+        }
+    }
+}
+
+void KateTaskScheduler::setCoreLimit(Priority priority, int limit)
+{
+    m_coreLimits[priority] = std::max(1, limit);
+
+    int threads = 0;
+    for (int coreLimit : m_coreLimits) {
+        threads += coreLimit;
+    }
+    m_pool.setMaxThreadCount(threads);
+    dispatch();
+}
+
+void KateTaskScheduler::setCpuBudget(Priority priority, int percent)
+{
+    m_cpuBudgets[priority] = std::clamp(percent, 1, 100);
+}
+
+bool KateTaskScheduler::isUserActive(Priority priority) const
+{
+    const qint64 quiet = quietTime(priority);
+    return quiet > 0 && m_clock.elapsed() - m_lastInput < quiet;
+}
+
+void KateTaskScheduler::notifyUserInput()
+{
+    m_lastInput = m_clock.elapsed();
+}
+
+int KateTaskScheduler::pendingCount() const
+{
+    int count = 0;
+    for (const auto &queue : m_pending) {
+        count += int(queue.size());
+    }
+    return count;
+}
+
+QStringList KateTaskScheduler::runningTaskNames() const
+{
+    QStringList names;
+    for (const auto &task : std::as_const(m_runningTasks)) {
+        names.push_back(task->name);
+    }
+    names.sort();
+    return names;
+}
+
+bool KateTaskScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::Wheel:
+        notifyUserInput();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+bool KateTaskScheduler::canStart(Priority priority) const
+{
+    // higher priorities first, even if they just wait for a free slot
+    for (int higher = Interactive; higher < priority; ++higher) {
+        if (!m_pending[higher].empty()) {
+            return false;
+        }
+        if (priority == Idle && m_running[higher] > 0) {
+            return false;
+        }
+    }
+    return m_running[priority] < m_coreLimits[priority];
+}
+
+void KateTaskScheduler::dispatch()
+{
+    bool deferred = false;
+    for (int priority = Interactive; priority <= Idle; ++priority) {
+        auto &queue = m_pending[priority];
+        while (!queue.empty()) {
+            if (isUserActive(Priority(priority))) {
+                deferred = true;
+                break;
+            }
+            if (!canStart(Priority(priority))) {
+                break;
+            }
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            start(task);
+        }
+    }
+
+    if (deferred && !m_resumeTimer.isActive()) {
+        m_resumeTimer.start();
+    }
+}
+
+void KateTaskScheduler::start(const std::shared_ptr<Task> &task)
+{
+    ++m_running[task->state.priority];
+    m_runningTasks.insert(task->id, task);
+
+    m_pool.start([this, task]() {
+        Token token(this, &task->state);
+        task->work(token);
+
+        // destroy the captures here, their code might be in a plugin that is unloaded once we are done
+        task->work = nullptr;
+        {
+            QMutexLocker locker(&m_doneMutex);
+            task->state.done = true;
+        }
+        m_doneCondition.wakeAll();
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, id = task->id]() {
+                finished(id);
+            },
+            Qt::QueuedConnection);
+    });
+
+    Q_EMIT activityChanged();
+}
+
+void KateTaskScheduler::finished(quint64 id)
+{
+    if (auto task = m_runningTasks.take(id)) {
+        --m_running[task->state.priority];
+    }
+
+    Q_EMIT activityChanged();
+    dispatch();
+}
+
+#include "moc_katetaskscheduler.cpp"
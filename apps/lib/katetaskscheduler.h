@@ -0,0 +1,185 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QWaitCondition>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+/**
+ * Application wide scheduler for work that runs outside of the main thread,
+ * shared by all plugins so that indexing, analysis and co. don't compete with each other
+ * and with the user.
+ *
+ * Tasks are queued by priority, a task only starts if no task of a higher priority waits.
+ * Each priority has a limit of tasks running in parallel, idle tasks only run if nothing else does.
+ * Background and idle tasks don't start while the user types or clicks around,
+ * running ones pause in Token::checkpoint() and are throttled to their CPU budget there.
+ *
+ * Tasks can be canceled by id or via their context object. Owners of tasks that use their
+ * members must call cancelAndWait(this) in their own destructor: once QObject::destroyed
+ * is emitted, the members of derived classes are gone already. Destroying the context
+ * still cancels and waits as a fallback, as the code of a task might live in a plugin
+ * that is about to be unloaded.
+ */
+class KATE_PRIVATE_EXPORT KateTaskScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        /// the user waits for the result, e.g. an explicit search
+        Interactive,
+        /// the result is shown, e.g. the file list of an opened project
+        Visible,
+        /// nice to have soon, e.g. index updates
+        Background,
+        /// only if there is nothing else to do, e.g. cache cleanup
+        Idle,
+    };
+    Q_ENUM(Priority)
+
+    struct TaskState;
+
+    /**
+     * Passed to the running task to cooperate with the scheduler.
+     */
+    class KATE_PRIVATE_EXPORT Token
+    {
+    public:
+        bool isCanceled() const;
+
+        /**
+         * Call this regularly in long running tasks.
+         * For background and idle tasks this blocks while the user is active and to keep the task
+         * within its CPU budget. Returns false once the task is canceled, it should stop then.
+         */
+        bool checkpoint();
+
+    private:
+        friend class KateTaskScheduler;
+        Token(KateTaskScheduler *scheduler, TaskState *state);
+
+        KateTaskScheduler *const m_scheduler;
+        TaskState *const m_state;
+        QElapsedTimer m_slice;
+    };
+
+    using Work = std::function<void(Token &)>;
+
+    static KateTaskScheduler *self();
+
+    ~KateTaskScheduler() override;
+
+    /**
+     * Queue @p work to run in a worker thread, @p name is shown to the user while it runs.
+     * Returns an id to cancel the task.
+     */
+    quint64 schedule(Priority priority, const QString &name, Work work, QObject *context = nullptr);
+
+    /**
+     * Drop the task if it is still pending, ask it to stop if it runs.
+     */
+    void cancel(quint64 id);
+
+    /**
+     * Cancel all tasks of the context and block until the running ones are done.
+     * Call this in the destructor of the context, before its members are destroyed.
+     */
+    void cancelAndWait(const QObject *context);
+
+    /**
+     * Maximal number of tasks of the given priority running at once.
+     */
+    void setCoreLimit(Priority priority, int limit);
+
+    /**
+     * Share of the time in percent a task of the given priority may run between pauses.
+     * Only applies to tasks calling Token::checkpoint().
+     */
+    void setCpuBudget(Priority priority, int percent);
+
+    /**
+     * Did the user type or click recently enough that the given priority has to wait?
+     */
+    bool isUserActive(Priority priority) const;
+
+    /**
+     * Mark the user as active now, done for all key and mouse input automatically.
+     */
+    void notifyUserInput();
+
+    int runningCount() const
+    {
+        return int(m_runningTasks.size());
+    }
+
+    int pendingCount() const;
+
+    /**
+     * Names of the running tasks, for the activity indicator.
+     */
+    QStringList runningTaskNames() const;
+
+Q_SIGNALS:
+    /**
+     * Tasks were started or finished.
+     */
+    void activityChanged();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Task;
+
+    explicit KateTaskScheduler(QObject *parent);
+
+    void dispatch();
+    void start(const std::shared_ptr<Task> &task);
+    void finished(quint64 id);
+    bool canStart(Priority priority) const;
+
+private:
+    static constexpr int PriorityCount = Idle + 1;
+
+    std::array<std::deque<std::shared_ptr<Task>>, PriorityCount> m_pending;
+    QHash<quint64, std::shared_ptr<Task>> m_runningTasks;
+    std::array<int, PriorityCount> m_running = {};
+    std::array<int, PriorityCount> m_coreLimits = {};
+    std::array<std::atomic<int>, PriorityCount> m_cpuBudgets = {};
+    quint64 m_nextId = 1;
+
+    // contexts we cancel the tasks for once they are destroyed
+    QSet<const QObject *> m_contexts;
+
+    QThreadPool m_pool;
+
+    // to wait for running tasks of a context
+    QMutex m_doneMutex;
+    QWaitCondition m_doneCondition;
+
+    // last user input, read by the worker threads, too
+    QElapsedTimer m_clock;
+    std::atomic<qint64> m_lastInput = -1000000;
+
+    // dispatch again once the user stopped typing
+    QTimer m_resumeTimer;
+};
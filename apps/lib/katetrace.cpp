@@ -0,0 +1,182 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "katetrace.h"
+#include "katedebug.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// bound the memory if tracing is left on for a long time
+static constexpr size_t MaxEventsPerThread = 1 << 20;
+
+namespace
+{
+struct Event {
+    const char *category;
+    const char *name;
+    qint64 start;
+    qint64 end;
+    QString detail;
+};
+
+// events are recorded per thread, the lock is only contended while flushing
+struct ThreadBuffer {
+    QMutex mutex;
+    qint64 tid = 0;
+    QString threadName;
+    std::vector<Event> events;
+    qint64 dropped = 0;
+};
+
+struct Tracer {
+    QMutex mutex;
+    QString fileName;
+    QElapsedTimer clock;
+    // buffers stay around after their thread finished, the events are written at exit
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+}
+
+static Tracer &tracer()
+{
+    static Tracer s_tracer;
+    return s_tracer;
+}
+
+static ThreadBuffer *threadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        auto &t = tracer();
+        QMutexLocker locker(&t.mutex);
+        auto newBuffer = std::make_unique<ThreadBuffer>();
+        newBuffer->tid = qint64(t.buffers.size()) + 1;
+
+        const auto thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            newBuffer->threadName = QStringLiteral("main");
+        } else if (!thread->objectName().isEmpty()) {
+            newBuffer->threadName = thread->objectName();
+        } else {
+            newBuffer->threadName = QStringLiteral("thread %1").arg(newBuffer->tid);
+        }
+
+        buffer = newBuffer.get();
+        t.buffers.push_back(std::move(newBuffer));
+    }
+    return buffer;
+}
+
+std::atomic<bool> KateTrace::Private::enabled = false;
+
+qint64 KateTrace::Private::now()
+{
+    return tracer().clock.nsecsElapsed();
+}
+
+void KateTrace::Private::record(const char *category, const char *name, qint64 start, qint64 end, const QString &detail)
+{
+    auto buffer = threadBuffer();
+    QMutexLocker locker(&buffer->mutex);
+    if (buffer->events.size() >= MaxEventsPerThread) {
+        ++buffer->dropped;
+        return;
+    }
+    buffer->events.push_back({.category = category, .name = name, .start = start, .end = end, .detail = detail});
+}
+
+void KateTrace::enable(const QString &fileName)
+{
+    if (fileName.isEmpty() || isEnabled()) {
+        return;
+    }
+
+    auto &t = tracer();
+    {
+        QMutexLocker locker(&t.mutex);
+        t.fileName = QFileInfo(fileName).absoluteFilePath();
+        t.clock.start();
+    }
+    Private::enabled = true;
+
+    // the tracer was created above, it outlives this handler
+    std::atexit([]() {
+        flush();
+    });
+}
+
+void KateTrace::enableFromEnvironment()
+{
+    enable(qEnvironmentVariable("KATE_TRACE"));
+}
+
+void KateTrace::flush()
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    auto &t = tracer();
+    QMutexLocker locker(&t.mutex);
+    QSaveFile file(t.fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LOG_KATE) << "Failed to write trace" << t.fileName << file.errorString();
+        return;
+    }
+
+    // one event per line, still valid json
+    const qint64 pid = QCoreApplication::applicationPid();
+    bool first = true;
+    const auto writeEvent = [&file, &first](const QJsonObject &event) {
+        file.write(first ? "\n" : ",\n");
+        file.write(QJsonDocument(event).toJson(QJsonDocument::Compact));
+        first = false;
+    };
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (const auto &buffer : t.buffers) {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        writeEvent(QJsonObject{{QStringLiteral("name"), QStringLiteral("thread_name")},
+                               {QStringLiteral("ph"), QStringLiteral("M")},
+                               {QStringLiteral("pid"), pid},
+                               {QStringLiteral("tid"), buffer->tid},
+                               {QStringLiteral("args"), QJsonObject{{QStringLiteral("name"), buffer->threadName}}}});
+
+        for (const auto &event : buffer->events) {
+            QJsonObject object{{QStringLiteral("name"), QString::fromLatin1(event.name)},
+                               {QStringLiteral("cat"), QString::fromLatin1(event.category)},
+                               {QStringLiteral("ph"), QStringLiteral("X")},
+                               {QStringLiteral("ts"), double(event.start) / 1000.0},
+                               {QStringLiteral("dur"), double(event.end - event.start) / 1000.0},
+                               {QStringLiteral("pid"), pid},
+                               {QStringLiteral("tid"), buffer->tid}};
+            if (!event.detail.isEmpty()) {
+                object.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("detail"), event.detail}});
+            }
+            writeEvent(object);
+        }
+
+        if (buffer->dropped > 0) {
+            qCWarning(LOG_KATE) << "Trace buffer of" << buffer->threadName << "full, dropped" << buffer->dropped << "events";
+        }
+    }
+    file.write("\n]}\n");
+
+    if (!file.commit()) {
+        qCWarning(LOG_KATE) << "Failed to write trace" << t.fileName << file.errorString();
+    }
+}
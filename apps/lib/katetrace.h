@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 Kate Developers <kwrite-devel@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kateprivate_export.h"
+
+#include <QString>
+
+#include <atomic>
+
+/**
+ * Lightweight tracing of the startup and hot paths.
+ *
+ * Tracing is enabled with the --trace <file> command line option or the KATE_TRACE=<file>
+ * environment variable, the recorded zones are written in the Chrome trace event format
+ * at exit and can be inspected with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * If tracing is disabled, a zone costs one relaxed atomic load.
+ *
+ * Usage:
+ *   KATE_TRACE_ZONE("startup", "KateApp::startupKate");
+ * or, to attach some detail that is only computed if tracing:
+ *   KateTrace::Zone zone("plugins", "loadPlugin");
+ *   if (zone.isActive()) {
+ *       zone.setDetail(name);
+ *   }
+ *
+ * Category and name must be string literals.
+ */
+namespace KateTrace
+{
+namespace Private
+{
+KATE_PRIVATE_EXPORT extern std::atomic<bool> enabled;
+KATE_PRIVATE_EXPORT qint64 now();
+KATE_PRIVATE_EXPORT void record(const char *category, const char *name, qint64 start, qint64 end, const QString &detail);
+}
+
+inline bool isEnabled()
+{
+    return Private::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start tracing, the events are written to @p fileName by flush(), at the latest at exit.
+ */
+KATE_PRIVATE_EXPORT void enable(const QString &fileName);
+
+/**
+ * Start tracing if the KATE_TRACE environment variable names a file.
+ */
+KATE_PRIVATE_EXPORT void enableFromEnvironment();
+
+/**
+ * Write all events recorded so far.
+ */
+KATE_PRIVATE_EXPORT void flush();
+
+/**
+ * Records the time between its construction and destruction.
+ */
+class Zone
+{
+public:
+    Zone(const char *category, const char *name)
+        : m_category(category)
+        , m_name(name)
+        , m_start(isEnabled() ? Private::now() : -1)
+    {
+    }
+
+    ~Zone()
+    {
+        if (m_start >= 0) {
+            Private::record(m_category, m_name, m_start, Private::now(), m_detail);
+        }
+    }
+
+    Zone(const Zone &) = delete;
+    Zone &operator=(const Zone &) = delete;
+
+    bool isActive() const
+    {
+        return m_start >= 0;
+    }
+
+    void setDetail(const QString &detail)
+    {
+        if (isActive()) {
+            m_detail = detail;
+        }
+    }
+
+private:
+    const char *const m_category;
+    const char *const m_name;
+    const qint64 m_start;
+    QString m_detail;
+};
+}
+
+#define KATE_TRACE_CONCAT_IMPL(a, b) a##b
+#define KATE_TRACE_CONCAT(a, b) KATE_TRACE_CONCAT_IMPL(a, b)
+#define KATE_TRACE_ZONE(category, name) const KateTrace::Zone KATE_TRACE_CONCAT(kateTraceZone, __LINE__)(category, name)
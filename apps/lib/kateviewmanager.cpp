@@ -34,6 +34,8 @@
 #include <QScrollBar>
 #include <QTimer>
 
+#include <functional>
+
 // END Includes
 
 static constexpr qint64 FileSizeAboveToAskUserIfProceedWithOpen = 10 * 1024 * 1024; // 10MB should suffice
@@ -104,6 +106,8 @@ void KateViewManager::readConfig()
     KSharedConfig::Ptr config = KSharedConfig::openConfig();
     KConfigGroup cgGeneral = KConfigGroup(config, QStringLiteral("General"));
     m_sdiMode = cgGeneral.readEntry("SDI Mode", false);
+    m_viewLimit = std::max(cgGeneral.readEntry("View Limit", 0), 0);
+    recycleViews();
 }
 
 void KateViewManager::slotScrollSynchedViews(KTextEditor::View *view)
@@ -553,6 +557,7 @@ void KateViewManager::openUrlOrProject(const QUrl &url)
 
     // try to open the folder
     static const QString projectPluginId = QStringLiteral("kateprojectplugin");
+    KateApp::self()->pluginManager()->activatePlugin(projectPluginId);
     QObject *projectPluginView = mainWindow()->pluginView(projectPluginId);
     if (!projectPluginView) {
         // try to find and enable the Projects plugin
@@ -678,9 +683,11 @@ KTextEditor::View *KateViewManager::createView(KTextEditor::Document *doc, KateV
         return nullptr;
     }
 
-    // create doc
+    // create doc, or load it if it is a placeholder from a lazy session restore
     if (!doc) {
         doc = KateApp::self()->documentManager()->createDoc();
+    } else {
+        KateApp::self()->documentManager()->loadPendingDocument(doc);
     }
 
     /**
@@ -766,6 +773,37 @@ bool KateViewManager::deleteView(KTextEditor::View *view)
     return true;
 }
 
+void KateViewManager::recycleViews()
+{
+    if (m_viewLimit <= 0 || m_views.size() <= size_t(m_viewLimit) || m_blockViewCreationAndActivation) {
+        return;
+    }
+
+    // oldest views first, the largest age is the least recently used view
+    std::vector<std::pair<qint64, KTextEditor::View *>> candidates;
+    candidates.reserve(m_views.size());
+    for (const auto &[view, data] : m_views) {
+        // never touch what is visible or part of the scroll synchronisation
+        KateViewSpace *viewspace = static_cast<KateViewSpace *>(view->parent()->parent());
+        if (view == m_guiMergedView || view == viewspace->currentView() || m_scrollSynchronisation.viewScrollInfo.contains(view)) {
+            continue;
+        }
+        candidates.emplace_back(data.lruAge, view);
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater{});
+
+    for (const auto &[age, view] : candidates) {
+        if (m_views.size() <= size_t(m_viewLimit)) {
+            break;
+        }
+
+        // the view space saves the view config, plugins see the view vanish and get a viewCreated once it is back
+        static_cast<KateViewSpace *>(view->parent()->parent())->recycleView(view);
+        m_views.erase(view);
+        delete view;
+    }
+}
+
 KateViewSpace *KateViewManager::activeViewSpace()
 {
     for (auto vs : m_viewSpaceList) {
@@ -903,6 +941,9 @@ void KateViewManager::activateView(KTextEditor::View *view)
         Q_EMIT viewChanged(view);
 
         updateViewSpaceActions();
+
+        // the previous view went to the background, we might be above the limit now
+        recycleViews();
     }
 }
 
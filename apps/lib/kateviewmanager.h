@@ -126,6 +126,12 @@ public:
 
     bool deleteView(KTextEditor::View *view);
 
+    /**
+     * Delete the least recently used views of background tabs until we are within the view limit.
+     * The tabs stay, new views are created on activation, see KateViewSpace::recycleView().
+     */
+    void recycleViews();
+
 private:
     void moveViewtoSplit(KTextEditor::View *view);
     void moveViewtoStack(KTextEditor::View *view);
@@ -463,6 +469,11 @@ private:
      */
     bool m_sdiMode = false;
 
+    /**
+     * maximal number of views to keep alive, 0 for no limit
+     */
+    int m_viewLimit = 0;
+
     /**
      * was the welcome view already shown?
      * ensures it doesn't auto popup multiple times
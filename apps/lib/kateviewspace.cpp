@@ -366,7 +366,12 @@ KTextEditor::View *KateViewSpace::createView(KTextEditor::Document *doc)
     v->setStatusBarEnabled(true);
 
     // restore the config of this view if possible
-    if (!m_group.isEmpty()) {
+    const QString recycledGroup = QString::number(quintptr(doc));
+    if (m_recycledViewConfigs.hasGroup(recycledGroup)) {
+        // we had a view before that got recycled, that is the most recent state
+        v->readSessionConfig(KConfigGroup(&m_recycledViewConfigs, recycledGroup));
+        m_recycledViewConfigs.deleteGroup(recycledGroup);
+    } else if (!m_group.isEmpty()) {
         if (KateSession::Ptr as = KateApp::self()->sessionManager()->activeSession(); as->config()) {
             // try id first
             QString id = QString::number(KateApp::self()->documentManager()->documentInfo(v->document())->sessionConfigId);
@@ -462,6 +467,24 @@ void KateViewSpace::removeView(KTextEditor::View *v)
     }
 }
 
+void KateViewSpace::recycleView(KTextEditor::View *v)
+{
+    const auto it = m_docToView.find(v->document());
+    if (it == m_docToView.end() || it->second != v) {
+        return;
+    }
+    Q_ASSERT(v != currentView());
+
+    // keep the session up to date, like for a closed view, and remember the state for the next view
+    saveViewConfig(v);
+    KConfigGroup cg(&m_recycledViewConfigs, QString::number(quintptr(v->document())));
+    v->writeSessionConfig(cg);
+
+    // the document stays registered, activating its tab will create a new view
+    m_docToView.erase(it);
+    stack->removeWidget(v);
+}
+
 void KateViewSpace::saveViewConfig(KTextEditor::View *v)
 {
     if (!v) {
@@ -797,6 +820,7 @@ void KateViewSpace::documentDestroyed(QObject *doc)
      * we shall have no views for this document at this point in time!
      */
     Q_ASSERT(!m_docToView.contains(invalidDoc));
+    m_recycledViewConfigs.deleteGroup(QString::number(quintptr(invalidDoc)));
 
     // disconnect entirely
     disconnect(doc, nullptr, this, nullptr);
@@ -813,7 +837,7 @@ void KateViewSpace::updateDocumentName(KTextEditor::Document *doc)
     const int buttonId = m_tabBar->documentIdx(doc);
     if (buttonId >= 0) {
         // BUG: 441278 We need to escape the & because it is used for accelerators/shortcut mnemonic by default
-        QString tabName = doc->documentName();
+        QString tabName = KateApp::self()->documentManager()->documentName(doc);
         tabName.replace(QLatin1Char('&'), QLatin1String("&&"));
         m_tabBar->setTabText(buttonId, tabName);
     }
@@ -1265,6 +1289,10 @@ void KateViewSpace::saveConfig(KConfigBase *config, int myIndex, const QString &
         auto it = m_docToView.find(doc);
         if (it != m_docToView.end()) {
             views.push_back(it->second);
+        } else if (const QString recycledGroup = QString::number(quintptr(doc)); m_recycledViewConfigs.hasGroup(recycledGroup)) {
+            // store the state of recycled views, it is used once the view is created again
+            KConfigGroup viewGroup(config, QStringLiteral("%1 %2").arg(groupname, QString::number(sessionId)));
+            KConfigGroup(&m_recycledViewConfigs, recycledGroup).copyTo(&viewGroup);
         }
     }
 
@@ -15,6 +15,8 @@
 #include "kateprivate_export.h"
 #include "katetabbar.h"
 
+#include <KConfig>
+
 #include <QWidget>
 
 class KConfigBase;
@@ -63,6 +65,15 @@ public:
     KTextEditor::View *createView(KTextEditor::Document *doc);
     void removeView(KTextEditor::View *v);
 
+    /**
+     * Take the view out of this view space to free its resources, the document stays
+     * registered and keeps its tab. The view config is remembered and applied
+     * again once createView() is called for the document.
+     * The caller is responsible to delete the view.
+     * @param v view to recycle, must not be the current view
+     */
+    void recycleView(KTextEditor::View *v);
+
     bool showView(KTextEditor::View *view)
     {
         return showView(view->document());
@@ -351,6 +362,9 @@ private:
     // note: the number of entries match stack->count();
     std::unordered_map<KTextEditor::Document *, KTextEditor::View *> m_docToView;
 
+    // config of recycled views, one group per document, see recycleView()
+    KConfig m_recycledViewConfigs{QString(), KConfig::SimpleConfig};
+
     // tab bar that contains viewspace tabs
     KateTabBar *m_tabBar;
 
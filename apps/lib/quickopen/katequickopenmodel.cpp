@@ -8,6 +8,7 @@
 #include "katequickopenmodel.h"
 
 #include "kateapp.h"
+#include "katedocmanager.h"
 #include "katemainwindow.h"
 
 #include <KLocalizedString>
@@ -66,7 +67,7 @@ QVariant KateQuickOpenModel::data(const QModelIndex &idx, int role) const
     case Qt::DecorationRole:
         return QIcon::fromTheme(QMimeDatabase().mimeTypeForFile(entry.fileName, QMimeDatabase::MatchExtension).iconName());
     case Qt::UserRole:
-        return !entry.document ? QUrl::fromLocalFile(entry.filePath) : entry.document->url();
+        return !entry.document ? QUrl::fromLocalFile(entry.filePath) : KateApp::self()->documentManager()->documentUrl(entry.document);
     case Role::Score:
         return entry.score;
     case Role::Document:
@@ -123,9 +124,10 @@ void KateQuickOpenModel::refresh(KateMainWindow *mainWindow)
             return;
         }
 
-        // document with set url => use the url for displaying
-        if (!doc->url().isEmpty()) {
-            auto path = doc->url().toString(QUrl::NormalizePathSegments | QUrl::PreferLocalFile);
+        // document with set url => use the url for displaying, hibernated documents still know their url
+        const QUrl url = KateApp::self()->documentManager()->documentUrl(doc);
+        if (!url.isEmpty()) {
+            auto path = url.toString(QUrl::NormalizePathSegments | QUrl::PreferLocalFile);
             openedDocUrls.insert(path);
             allDocuments.push_back({QFileInfo(path).fileName(), path, doc, -1});
             return;
@@ -9,8 +9,11 @@
 #include "katesessionmanagedialog.h"
 
 #include "kateapp.h"
+#include "katedebug.h"
+#include "katefilewatcher.h"
 #include "katemainwindow.h"
 #include "katepluginmanager.h"
+#include "katetrace.h"
 
 #ifdef WITH_DBUS
 #include "katerunninginstanceinfo.h"
@@ -27,10 +30,13 @@
 #include <QApplication>
 #include <QCryptographicHash>
 #include <QDir>
+#include <QFileInfo>
 #include <QInputDialog>
 #include <QTimer>
 #include <QUrl>
 
+#include <memory>
+
 #ifndef Q_OS_WIN
 #include <unistd.h>
 #endif
@@ -62,13 +68,18 @@ KateSessionManager::KateSessionManager(QObject *parent, const QString &sessionsD
     Q_ASSERT(!m_sessionsDir.isEmpty());
     QDir().mkpath(m_sessionsDir);
 
-    // monitor our session directory for outside changes
-    m_dirWatch.addPath(m_sessionsDir);
-    connect(&m_dirWatch, &QFileSystemWatcher::directoryChanged, this, &KateSessionManager::updateSessionList);
+    // monitor our session directory for outside changes, session files are saved atomically
+    KateFileWatcher::Options options;
+    options.modifications = true;
+    m_dirWatch = KateFileWatcher::self()->watch(m_sessionsDir, options, this);
+    connect(m_dirWatch, &KateFileWatch::changed, this, &KateSessionManager::updateSessionList);
 
     // initial creation of the session list from disk files
     updateSessionList();
 
+    // session files are written in the background, one after the other
+    m_sessionWriter.setMaxThreadCount(1);
+
     // init the session auto save
     m_sessionSaveTimer.setInterval(5000);
     m_sessionSaveTimer.setSingleShot(true);
@@ -91,6 +102,9 @@ KateSessionManager::~KateSessionManager()
 {
     // write jump list actions to disk in the kate.desktop file
     updateJumpListActions();
+
+    // ensure the last session state reached the disk
+    waitForSessionWrites();
 }
 
 void KateSessionManager::updateSessionList()
@@ -99,10 +113,15 @@ void KateSessionManager::updateSessionList()
     bool changed = false;
     // Add new sessions to our list
     for (const QString &session : std::as_const(list)) {
-        if (!m_sessions.contains(session)) {
+        const auto it = m_sessions.constFind(session);
+        if (it == m_sessions.cend()) {
             const QString file = sessionFileForName(session);
             m_sessions.insert(session, KateSession::create(file, session));
             changed = true;
+        } else if (it.value() != activeSession() && QFileInfo(it.value()->file()).lastModified() != it.value()->timestamp()) {
+            // rewritten outside, e.g. by another instance, reload timestamp and documents
+            m_sessions.insert(session, KateSession::create(it.value()->file(), session));
+            changed = true;
         }
     }
 
@@ -195,6 +214,11 @@ bool KateSessionManager::activateSession(KateSession::Ptr session, const bool cl
 
 void KateSessionManager::loadSession(const KateSession::Ptr &session) const
 {
+    KateTrace::Zone zone("session", "KateSessionManager::loadSession");
+    if (zone.isActive()) {
+        zone.setDetail(session->name());
+    }
+
     // open the new session
     KSharedConfigPtr sharedConfig = KSharedConfig::openConfig();
     KConfig *sc = session->config();
@@ -303,6 +327,8 @@ bool KateSessionManager::deleteSession(KateSession::Ptr session)
         c.sync();
     }
 
+    // a pending write would resurrect the file
+    waitForSessionWrites();
     QFile::remove(session->file());
 
     // ensure session list is updated
@@ -321,6 +347,7 @@ QString KateSessionManager::copySession(const KateSession::Ptr &session, const Q
 
     const QString newFile = sessionFileForName(name);
 
+    waitForSessionWrites();
     KateSession::Ptr ns = KateSession::createFrom(session, newFile, name);
     ns->config()->sync();
 
@@ -340,6 +367,8 @@ QString KateSessionManager::renameSession(KateSession::Ptr session, const QStrin
 
     const QString newFile = sessionFileForName(name);
 
+    // the file must be complete before we move it away
+    waitForSessionWrites();
     session->config()->sync();
 
     if (!QFile::rename(session->file(), newFile)) {
@@ -366,7 +395,7 @@ QString KateSessionManager::renameSession(KateSession::Ptr session, const QStrin
     return name;
 }
 
-void KateSessionManager::saveSessionTo(KConfig *sc, bool isAutoSave)
+void KateSessionManager::saveSessionTo(KConfig *sc, bool isAutoSave, bool stashDocuments)
 {
     if (!isAutoSave) {
         // Clear the session file to avoid to accumulate outdated entries
@@ -401,22 +430,48 @@ void KateSessionManager::saveSessionTo(KConfig *sc, bool isAutoSave)
         }
     }
 
-    sc->sync();
+    // stash unsaved changes, the stash entries are part of the document groups
+    if (stashDocuments) {
+        KateApp::self()->stashManager()->stashDocuments(sc, KateApp::self()->documentManager()->documentList());
+    }
+
+    writeSessionFile(sc);
+}
+
+void KateSessionManager::writeSessionFile(KConfig *sc)
+{
+    // the copy is only touched by the writer, we can go on modifying the original
+    // all entries of the copy are dirty, therefore it will write the complete state incl. deletions
+    // KConfig syncs via QSaveFile, the file is replaced atomically
+    std::shared_ptr<KConfig> snapshot(sc->copyTo(sc->name()));
+    sc->markAsClean();
+
+    m_sessionWriter.start([snapshot]() {
+        if (!snapshot->sync()) {
+            qCWarning(LOG_KATE) << "Failed to write session file" << snapshot->name();
+            return;
+        }
 
-    /**
-     * try to sync file to disk
-     */
-    QFile fileToSync(sc->name());
-    if (fileToSync.open(QIODevice::ReadOnly)) {
+        /**
+         * try to sync file to disk
+         */
+        QFile fileToSync(snapshot->name());
+        if (fileToSync.open(QIODevice::ReadOnly)) {
 #ifndef Q_OS_WIN
-        // ensure that the file is written to disk
+            // ensure that the file is written to disk
 #ifdef HAVE_FDATASYNC
-        fdatasync(fileToSync.handle());
+            fdatasync(fileToSync.handle());
 #else
-        fsync(fileToSync.handle());
+            fsync(fileToSync.handle());
 #endif
 #endif
-    }
+        }
+    });
+}
+
+void KateSessionManager::waitForSessionWrites()
+{
+    m_sessionWriter.waitForDone();
 }
 
 bool KateSessionManager::saveActiveSession(bool rememberAsLast, bool isAutoSave)
@@ -427,7 +482,7 @@ bool KateSessionManager::saveActiveSession(bool rememberAsLast, bool isAutoSave)
 
     KConfig *sc = activeSession()->config();
 
-    saveSessionTo(sc, isAutoSave);
+    saveSessionTo(sc, isAutoSave, /*stashDocuments=*/true);
 
     if (rememberAsLast && !activeSession()->isAnonymous()) {
         KSharedConfigPtr c = KSharedConfig::openConfig();
@@ -482,6 +537,7 @@ void KateSessionManager::sessionSaveAs()
         return;
     }
 
+    waitForSessionWrites();
     activeSession()->config()->sync();
 
     KateSession::Ptr ns = KateSession::createFrom(activeSession(), sessionFileForName(newName), newName);
@@ -8,11 +8,13 @@
 
 #include "katesession.h"
 
-#include <QFileSystemWatcher>
 #include <QHash>
 #include <QObject>
+#include <QThreadPool>
 #include <QTimer>
 
+class KateFileWatch;
+
 typedef QList<KateSession::Ptr> KateSessionList;
 
 class KATE_PRIVATE_EXPORT KateSessionManager : public QObject
@@ -77,12 +79,18 @@ public:
     bool activateAnonymousSession();
 
     /**
-     * save current session
+     * save current session, unsaved changes are stashed if enabled
+     * the session file is written in the background, see waitForSessionWrites()
      * @param rememberAsLast remember this session as last used?
      * @return success
      */
     bool saveActiveSession(bool rememberAsLast = false, bool isAutoSave = false);
 
+    /**
+     * wait until all session files scheduled for writing are on disk
+     */
+    void waitForSessionWrites();
+
     /**
      * return the current active session
      * sessionFile == empty means we have no session around for this instance of kate
@@ -233,8 +241,14 @@ private:
 
     /**
      * helper function to save the session to a given config object
+     * @param stashDocuments stash unsaved changes, only valid for the active session
+     */
+    void saveSessionTo(KConfig *sc, bool isAutoSave, bool stashDocuments = false);
+
+    /**
+     * snapshot the given config and write it to its file in the background
      */
-    static void saveSessionTo(KConfig *sc, bool isAutoSave);
+    void writeSessionFile(KConfig *sc);
 
     /**
      * restore sessions documents, windows, etc...
@@ -279,7 +293,7 @@ private:
      * watcher for the session directory
      * allows to monitor outside changes
      */
-    QFileSystemWatcher m_dirWatch;
+    KateFileWatch *m_dirWatch = nullptr;
 
     /**
      * timer for session auto saving
@@ -291,4 +305,9 @@ private:
      * needed e.g. during some session manipulation and window/application closing
      */
     unsigned int m_sessionSaveTimerBlocked = 0;
+
+    /**
+     * single threaded pool writing the session files, keeps the writes in order
+     */
+    QThreadPool m_sessionWriter;
 };